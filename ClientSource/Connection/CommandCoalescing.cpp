@@ -0,0 +1,115 @@
+/*  Command Coalescing
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/NintendoSwitch/NintendoSwitch_Protocol_PushButtons.h"
+#include "CommandCoalescing.h"
+
+namespace PokemonAutomation{
+
+
+
+template <typename Params>
+bool read_params(Params& params, const BotBaseMessage& message){
+    if (message.body.size() != sizeof(Params)){
+        return false;
+    }
+    memcpy(&params, message.body.data(), sizeof(Params));
+    return true;
+}
+template <typename Params>
+void write_params(BotBaseMessage& message, const Params& params){
+    memcpy(&message.body[0], &params, sizeof(Params));
+}
+
+//  Add two 16-bit tick counts. Fails if it would overflow.
+bool add_ticks(uint16_t& total, uint16_t x, uint16_t y){
+    uint32_t ticks = (uint32_t)x + y;
+    if (ticks > 0xffff){
+        return false;
+    }
+    total = (uint16_t)ticks;
+    return true;
+}
+
+//  All the hold/release commands release everything at the end. Appending a
+//  wait just extends the release.
+template <typename Params>
+bool extend_release(BotBaseMessage& held, uint16_t ticks){
+    Params params;
+    if (!read_params(params, held)){
+        return false;
+    }
+    uint16_t release_ticks;
+    if (!add_ticks(release_ticks, params.release_ticks, ticks)){
+        return false;
+    }
+    params.release_ticks = release_ticks;
+    write_params(held, params);
+    return true;
+}
+
+
+
+bool try_coalesce_commands(BotBaseMessage& held, const BotBaseMessage& next){
+    switch (next.type){
+    case PABB_MSG_COMMAND_PBF_WAIT:{
+        pabb_pbf_wait wait;
+        if (!read_params(wait, next)){
+            return false;
+        }
+        switch (held.type){
+        case PABB_MSG_COMMAND_PBF_WAIT:{
+            pabb_pbf_wait params;
+            uint16_t ticks;
+            if (!read_params(params, held) || !add_ticks(ticks, params.ticks, wait.ticks)){
+                return false;
+            }
+            params.ticks = ticks;
+            write_params(held, params);
+            return true;
+        }
+        case PABB_MSG_COMMAND_PBF_PRESS_BUTTON:
+            return extend_release<pabb_pbf_press_button>(held, wait.ticks);
+        case PABB_MSG_COMMAND_PBF_PRESS_DPAD:
+            return extend_release<pabb_pbf_press_dpad>(held, wait.ticks);
+        case PABB_MSG_COMMAND_PBF_MOVE_JOYSTICK_L:
+        case PABB_MSG_COMMAND_PBF_MOVE_JOYSTICK_R:
+            return extend_release<pabb_pbf_move_joystick>(held, wait.ticks);
+        }
+        return false;
+    }
+    case PABB_MSG_CONTROLLER_STATE:{
+        if (held.type != PABB_MSG_CONTROLLER_STATE){
+            return false;
+        }
+        pabb_controller_state params, state;
+        if (!read_params(params, held) || !read_params(state, next)){
+            return false;
+        }
+        if (params.button           != state.button ||
+            params.dpad             != state.dpad ||
+            params.left_joystick_x  != state.left_joystick_x ||
+            params.left_joystick_y  != state.left_joystick_y ||
+            params.right_joystick_x != state.right_joystick_x ||
+            params.right_joystick_y != state.right_joystick_y
+        ){
+            return false;
+        }
+        uint32_t ticks = (uint32_t)params.ticks + state.ticks;
+        if (ticks > 0xff){
+            return false;
+        }
+        params.ticks = (uint8_t)ticks;
+        write_params(held, params);
+        return true;
+    }
+    }
+    return false;
+}
+
+
+
+}
@@ -0,0 +1,34 @@
+/*  Command Coalescing
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Merge consecutive controller commands into one when the device would
+ *  do exactly the same thing either way. Each command occupies a slot in the
+ *  device's command queue regardless of how long it runs. So a long series
+ *  of short commands can starve the queue while the host waits on acks.
+ *  Merging them lets each slot hold more controller time.
+ *
+ *  The merged command is always one of the existing message types. Nothing
+ *  changes on the device side.
+ *
+ */
+
+#ifndef PokemonAutomation_CommandCoalescing_H
+#define PokemonAutomation_CommandCoalescing_H
+
+#include "BotBaseMessage.h"
+
+namespace PokemonAutomation{
+
+
+//  Try to append "next" to the end of "held". Returns true if "held" was
+//  updated to run both commands. Returns false and leaves "held" untouched if
+//  the two cannot be merged without changing the controller output.
+//
+//  The seqnums of both messages are ignored.
+bool try_coalesce_commands(BotBaseMessage& held, const BotBaseMessage& next);
+
+
+
+}
+#endif
@@ -0,0 +1,350 @@
+/*  Loopback Device
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/CRC32.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/PokemonSwSh/PokemonProgramIDs.h"
+#include "Common/NintendoSwitch/NintendoSwitch_Protocol_PushButtons.h"
+#include "LoopbackDevice.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+LoopbackDevice::LoopbackDevice(std::chrono::microseconds tick_duration)
+    : m_tick_duration(tick_duration)
+    , m_stopping(false)
+    , m_expected_seqnum(0)
+    , m_device_seqnum(1)
+    , m_next_command_interrupt(false)
+    , m_running(false)
+    , m_idle(false)
+    , m_commands_received(0)
+    , m_commands_dropped(0)
+    , m_commands_finished(0)
+    , m_ticks_executed(0)
+    , m_ticks_starved(0)
+    , m_thread(run_with_catch, "LoopbackDevice::thread_loop()", [this]{ thread_loop(); })
+{}
+LoopbackDevice::~LoopbackDevice(){
+    stop();
+}
+void LoopbackDevice::stop(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    if (m_thread.joinable()){
+        m_thread.join();
+    }
+}
+
+uint64_t LoopbackDevice::commands_received() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_commands_received;
+}
+uint64_t LoopbackDevice::commands_dropped() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_commands_dropped;
+}
+uint64_t LoopbackDevice::commands_finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_commands_finished;
+}
+uint64_t LoopbackDevice::ticks_executed() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_ticks_executed;
+}
+uint64_t LoopbackDevice::ticks_starved() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_ticks_starved;
+}
+
+uint32_t LoopbackDevice::command_ticks(const BotBaseMessage& message){
+    switch (message.type){
+    case PABB_MSG_COMMAND_PBF_WAIT:
+        if (message.body.size() == sizeof(pabb_pbf_wait)){
+            const auto* params = (const pabb_pbf_wait*)message.body.data();
+            return params->ticks;
+        }
+        return 0;
+    case PABB_MSG_COMMAND_PBF_PRESS_BUTTON:
+        if (message.body.size() == sizeof(pabb_pbf_press_button)){
+            const auto* params = (const pabb_pbf_press_button*)message.body.data();
+            return (uint32_t)params->hold_ticks + params->release_ticks;
+        }
+        return 0;
+    case PABB_MSG_COMMAND_PBF_PRESS_DPAD:
+        if (message.body.size() == sizeof(pabb_pbf_press_dpad)){
+            const auto* params = (const pabb_pbf_press_dpad*)message.body.data();
+            return (uint32_t)params->hold_ticks + params->release_ticks;
+        }
+        return 0;
+    case PABB_MSG_COMMAND_PBF_MOVE_JOYSTICK_L:
+    case PABB_MSG_COMMAND_PBF_MOVE_JOYSTICK_R:
+        if (message.body.size() == sizeof(pabb_pbf_move_joystick)){
+            const auto* params = (const pabb_pbf_move_joystick*)message.body.data();
+            return (uint32_t)params->hold_ticks + params->release_ticks;
+        }
+        return 0;
+    case PABB_MSG_COMMAND_MASH_BUTTON:
+        if (message.body.size() == sizeof(pabb_pbf_mash_button)){
+            const auto* params = (const pabb_pbf_mash_button*)message.body.data();
+            return params->ticks;
+        }
+        return 0;
+    case PABB_MSG_CONTROLLER_STATE:
+        if (message.body.size() == sizeof(pabb_controller_state)){
+            const auto* params = (const pabb_controller_state*)message.body.data();
+            return params->ticks;
+        }
+        return 0;
+    default:
+        //  Everything else is treated as instant.
+        return 0;
+    }
+}
+
+
+void LoopbackDevice::send(const void* data, size_t bytes){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_recv_buffer.append((const char*)data, bytes);
+    parse_messages();
+    m_cv.notify_all();
+}
+void LoopbackDevice::parse_messages(){
+    //  Same framing rules as PABotBaseConnection::on_recv().
+    size_t index = 0;
+    while (index < m_recv_buffer.size()){
+        if (m_recv_buffer[index] == 0){
+            index++;
+            continue;
+        }
+        uint8_t length = ~m_recv_buffer[index];
+        if (length < PABB_PROTOCOL_OVERHEAD || length > PABB_MAX_PACKET_SIZE){
+            index++;
+            continue;
+        }
+        if (index + length > m_recv_buffer.size()){
+            break;
+        }
+
+        const char* message = &m_recv_buffer[index];
+        uint32_t checksumA = pabb_crc32(0xffffffff, message, length - sizeof(uint32_t));
+        uint32_t checksumE;
+        memcpy(&checksumE, message + length - sizeof(uint32_t), sizeof(uint32_t));
+        if (checksumA != checksumE){
+            index++;
+            continue;
+        }
+
+        process_message(BotBaseMessage(message[1], std::string(message + 2, length - PABB_PROTOCOL_OVERHEAD)));
+        index += length;
+    }
+    m_recv_buffer.erase(0, index);
+}
+void LoopbackDevice::process_message(BotBaseMessage message){
+    if (!PABB_MSG_IS_REQUEST_OR_COMMAND(message.type)){
+        //  Acks for our finish messages. Nothing is ever lost here so there's
+        //  nothing to retransmit.
+        return;
+    }
+    if (message.body.size() < sizeof(seqnum_t)){
+        return;
+    }
+    seqnum_t seqnum;
+    memcpy(&seqnum, message.body.data(), sizeof(seqnum_t));
+
+    if (message.type == PABB_MSG_SEQNUM_RESET){
+        m_expected_seqnum = (seqnum_t)(seqnum + 1);
+        clear_queue();
+        pabb_MsgAckRequest ack;
+        ack.seqnum = seqnum;
+        reply(BotBaseMessage(PABB_MSG_ACK_REQUEST, ack));
+        return;
+    }
+
+    int32_t diff = (int32_t)(seqnum - m_expected_seqnum);
+
+    //  Skipped a seqnum. Ignore it and wait for the retransmit.
+    if (diff > 0){
+        return;
+    }
+
+    //  Retransmit of something we already processed. Ack it again.
+    if (diff < 0){
+        if (PABB_MSG_IS_COMMAND(message.type)){
+            pabb_MsgAckCommand ack;
+            ack.seqnum = seqnum;
+            reply(BotBaseMessage(PABB_MSG_ACK_COMMAND, ack));
+        }else{
+            process_request(message);
+        }
+        return;
+    }
+
+    if (PABB_MSG_IS_COMMAND(message.type)){
+        process_command(message);
+    }else{
+        m_expected_seqnum++;
+        process_request(message);
+    }
+}
+void LoopbackDevice::process_request(const BotBaseMessage& message){
+    seqnum_t seqnum;
+    memcpy(&seqnum, message.body.data(), sizeof(seqnum_t));
+
+    switch (message.type){
+    case PABB_MSG_REQUEST_PROTOCOL_VERSION:
+    case PABB_MSG_REQUEST_PROGRAM_VERSION:
+    case PABB_MSG_REQUEST_CLOCK:{
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        switch (message.type){
+        case PABB_MSG_REQUEST_PROTOCOL_VERSION:
+            ack.data = PABB_PROTOCOL_VERSION;
+            break;
+        case PABB_MSG_REQUEST_PROGRAM_VERSION:
+            ack.data = PABB_PROGRAM_VERSION;
+            break;
+        default:
+            ack.data = (uint32_t)(m_ticks_executed + m_ticks_starved);
+        }
+        reply(BotBaseMessage(PABB_MSG_ACK_REQUEST_I32, ack));
+        return;
+    }
+    case PABB_MSG_REQUEST_PROGRAM_ID:{
+        pabb_MsgAckRequestI8 ack;
+        ack.seqnum = seqnum;
+        ack.data = PABB_PID_PABOTBASE_31KB;
+        reply(BotBaseMessage(PABB_MSG_ACK_REQUEST_I8, ack));
+        return;
+    }
+    case PABB_MSG_REQUEST_STOP:
+        clear_queue();
+        break;
+    case PABB_MSG_REQUEST_NEXT_CMD_INTERRUPT:
+        m_next_command_interrupt = true;
+        break;
+    }
+
+    pabb_MsgAckRequest ack;
+    ack.seqnum = seqnum;
+    reply(BotBaseMessage(PABB_MSG_ACK_REQUEST, ack));
+}
+void LoopbackDevice::process_command(const BotBaseMessage& message){
+    seqnum_t seqnum;
+    memcpy(&seqnum, message.body.data(), sizeof(seqnum_t));
+
+    if (m_next_command_interrupt){
+        m_next_command_interrupt = false;
+        clear_queue();
+    }
+
+    //  Queue is full. Drop it without advancing the seqnum. The host will
+    //  resend it later.
+    if (m_queue.size() >= PABB_DEVICE_QUEUE_SIZE){
+        m_commands_dropped++;
+        pabb_MsgInfoCommandDropped error;
+        error.seqnum = seqnum;
+        reply(BotBaseMessage(PABB_MSG_ERROR_COMMAND_DROPPED, error));
+        return;
+    }
+
+    m_expected_seqnum++;
+    m_commands_received++;
+    m_queue.emplace_back(QueuedCommand{seqnum, command_ticks(message)});
+
+    pabb_MsgAckCommand ack;
+    ack.seqnum = seqnum;
+    reply(BotBaseMessage(PABB_MSG_ACK_COMMAND, ack));
+}
+void LoopbackDevice::clear_queue(){
+    m_queue.clear();
+    m_running = false;
+    m_idle = false;
+}
+void LoopbackDevice::reply(const BotBaseMessage& message){
+    size_t total_bytes = PABB_PROTOCOL_OVERHEAD + message.body.size();
+    std::string buffer;
+    buffer += ~(uint8_t)total_bytes;
+    buffer += message.type;
+    buffer += message.body;
+    buffer += std::string(sizeof(uint32_t), 0);
+    pabb_crc32_write_to_message(&buffer[0], buffer.size());
+    m_replies.emplace_back(std::move(buffer));
+}
+
+
+
+void LoopbackDevice::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (!m_stopping){
+        //  Send out the replies without holding the lock.
+        if (!m_replies.empty()){
+            std::deque<std::string> replies = std::move(m_replies);
+            m_replies.clear();
+            lg.unlock();
+            for (const std::string& message : replies){
+                on_recv(message.data(), message.size());
+            }
+            lg.lock();
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+
+        //  Finish the current command.
+        if (m_running && now >= m_command_end){
+            const QueuedCommand& command = m_queue.front();
+            pabb_MsgRequestCommandFinished params;
+            params.seqnum = m_device_seqnum++;
+            params.seq_of_original_command = command.seqnum;
+            params.finish_time = (uint32_t)(m_ticks_executed + command.ticks);
+            reply(BotBaseMessage(PABB_MSG_REQUEST_COMMAND_FINISHED, params));
+
+            m_commands_finished++;
+            m_ticks_executed += command.ticks;
+            m_queue.pop_front();
+            m_running = false;
+            m_idle = true;
+            m_idle_since = m_command_end;
+        }
+
+        //  Start the next one.
+        if (!m_running && !m_queue.empty()){
+            //  Keep the timeline continuous if we woke up late.
+            auto start = now;
+            if (m_idle){
+                uint64_t gap = (now - m_idle_since) / m_tick_duration;
+                m_ticks_starved += gap;
+                start = m_idle_since + gap * m_tick_duration;
+            }
+            m_running = true;
+            m_idle = false;
+            m_command_end = start + m_queue.front().ticks * m_tick_duration;
+            continue;
+        }
+
+        if (!m_replies.empty()){
+            continue;
+        }
+        if (m_running){
+            m_cv.wait_until(lg, m_command_end);
+        }else{
+            m_cv.wait(lg);
+        }
+    }
+}
+
+
+
+}
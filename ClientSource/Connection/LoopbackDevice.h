@@ -0,0 +1,114 @@
+/*  Loopback Device
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      An emulated PABotBase device that sits behind a StreamConnection.
+ *  Instead of writing to a serial port, everything that is sent is parsed
+ *  using the same framing as the real device (see MessageProtocol.h). It acks
+ *  requests and commands, runs commands from a queue of the same size as the
+ *  real device, and reports when each command finishes.
+ *
+ *  No buttons are pressed. Commands simply take the number of ticks that they
+ *  would have taken on the real device. This is used to test the connection
+ *  and command pipeline without any hardware.
+ *
+ */
+
+#ifndef PokemonAutomation_LoopbackDevice_H
+#define PokemonAutomation_LoopbackDevice_H
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include "Common/Microcontroller/MessageProtocol.h"
+#include "BotBaseMessage.h"
+#include "StreamInterface.h"
+
+namespace PokemonAutomation{
+
+
+class LoopbackDevice : public StreamConnection{
+public:
+    //  "tick_duration" is how long a single controller tick takes. The real
+    //  device runs at 125 ticks/second.
+    LoopbackDevice(std::chrono::microseconds tick_duration = std::chrono::microseconds(8000));
+    virtual ~LoopbackDevice();
+
+    virtual void stop() override;
+    virtual void send(const void* data, size_t bytes) override;
+
+public:
+    //  Statistics for whatever has run so far.
+    uint64_t commands_received() const;
+    uint64_t commands_dropped() const;
+    uint64_t commands_finished() const;
+    uint64_t ticks_executed() const;
+
+    //  Number of ticks that the device sat idle with nothing to run. Idle
+    //  time before the first command and after the last is not counted.
+    uint64_t ticks_starved() const;
+
+    //  Returns the number of ticks that this command runs for.
+    static uint32_t command_ticks(const BotBaseMessage& message);
+
+
+private:
+    struct QueuedCommand{
+        seqnum_t seqnum;
+        uint32_t ticks;
+    };
+
+    void parse_messages();
+    void process_message(BotBaseMessage message);
+    void process_request(const BotBaseMessage& message);
+    void process_command(const BotBaseMessage& message);
+    void clear_queue();
+    void reply(const BotBaseMessage& message);
+
+    void thread_loop();
+
+
+private:
+    const std::chrono::microseconds m_tick_duration;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+
+    //  Raw bytes from the host that haven't been parsed yet.
+    std::string m_recv_buffer;
+
+    //  Replies waiting to be sent back to the host. These are sent from the
+    //  device thread so that the host never gets called back from inside its
+    //  own "send()".
+    std::deque<std::string> m_replies;
+
+    seqnum_t m_expected_seqnum;
+    seqnum_t m_device_seqnum;
+    bool m_next_command_interrupt;
+
+    std::deque<QueuedCommand> m_queue;
+    bool m_running;
+    std::chrono::steady_clock::time_point m_command_end;
+
+    //  Set when the last command finished and nothing has replaced it yet.
+    bool m_idle;
+    std::chrono::steady_clock::time_point m_idle_since;
+
+    uint64_t m_commands_received;
+    uint64_t m_commands_dropped;
+    uint64_t m_commands_finished;
+    uint64_t m_ticks_executed;
+    uint64_t m_ticks_starved;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
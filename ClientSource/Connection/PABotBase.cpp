@@ -8,8 +8,10 @@
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/PanicDump.h"
 #include "Common/Cpp/Concurrency/SpinPause.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "Common/Microcontroller/DeviceRoutines.h"
+#include "CommandCoalescing.h"
 #include "PABotBase.h"
 
 //#include <iostream>
@@ -34,20 +36,23 @@ namespace PokemonAutomation{
 PABotBase::PABotBase(
     Logger& logger,
     std::unique_ptr<StreamConnection> connection,
-    MessageLogger* message_logger,
+    MessageSniffer* sniffer,
     std::chrono::milliseconds retransmit_delay
 )
-    : PABotBaseConnection(logger, std::move(connection))
+    : PABotBaseConnection(logger, std::move(connection), sniffer)
     , m_logger(logger)
     , m_send_seq(1)
     , m_retransmit_delay(retransmit_delay)
     , m_last_ack(current_time())
+    , m_request_ack_latency(std::make_shared<HdrHistogram>())
+    , m_command_ack_latency(std::make_shared<HdrHistogram>())
+    , m_trace_id(TraceRecorder::instance().unique_id() << 48)
+    , m_command_held(false)
+    , m_commands_coalesced(0)
     , m_state(State::RUNNING)
     , m_error(false)
     , m_retransmit_thread(run_with_catch, "PABotBase::retransmit_thread()", [this]{ retransmit_thread(); })
-{
-    set_sniffer(message_logger);
-}
+{}
 PABotBase::~PABotBase(){
     stop();
     while (m_state.load(std::memory_order_acquire) != State::STOPPED){
@@ -112,6 +117,9 @@ void PABotBase::stop(){
     //  calls into this class which touch its fields.
     safely_stop();
 
+    m_logger.log("Request Ack Latency: " + m_request_ack_latency->dump(" ms", 1000));
+    m_logger.log("Command Ack Latency: " + m_command_ack_latency->dump(" ms", 1000));
+
     //  Now the receiver thread is dead. Nobody else is touching this class so
     //  it is safe to destruct.
     m_state.store(State::STOPPED, std::memory_order_release);
@@ -139,7 +147,7 @@ void PABotBase::wait_for_all_requests(const Cancellable* cancelled){
                 COLOR_DARKGREEN
             );
 #endif
-            if (m_pending_requests.empty() && m_pending_commands.empty()){
+            if (m_pending_requests.empty() && m_pending_commands.empty() && !m_command_held){
                 break;
             }
         }
@@ -168,6 +176,7 @@ bool PABotBase::try_stop_all_commands(){
 
     m_sanitizer.check_usage();
 
+    drop_held_command();
     uint64_t seqnum = try_issue_request(nullptr, Microcontroller::DeviceRequest_request_stop(), true, MAX_PENDING_REQUESTS);
     if (seqnum != 0){
         clear_all_active_commands(seqnum);
@@ -195,12 +204,14 @@ void PABotBase::stop_all_commands(){
 
     m_sanitizer.check_usage();
 
+    drop_held_command();
     uint64_t seqnum = issue_request(nullptr, Microcontroller::DeviceRequest_request_stop(), true);
     clear_all_active_commands(seqnum);
 }
 bool PABotBase::try_next_command_interrupt(){
     m_sanitizer.check_usage();
 
+    drop_held_command();
     uint64_t seqnum = try_issue_request(nullptr, Microcontroller::DeviceRequest_next_command_interrupt(), true, MAX_PENDING_REQUESTS);
     if (seqnum != 0){
         clear_all_active_commands(seqnum);
@@ -212,6 +223,7 @@ bool PABotBase::try_next_command_interrupt(){
 void PABotBase::next_command_interrupt(){
     m_sanitizer.check_usage();
 
+    drop_held_command();
     uint64_t seqnum = issue_request(nullptr, Microcontroller::DeviceRequest_next_command_interrupt(), true);
     clear_all_active_commands(seqnum);
 }
@@ -241,6 +253,17 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
 
     m_cv.notify_all();
 }
+void PABotBase::drop_held_command(){
+    m_sanitizer.check_usage();
+
+    //  The held command was issued before the stop/interrupt that is about to
+    //  be sent. So it must never reach the device after it.
+    std::lock_guard<std::mutex> lg0(m_sleep_lock);
+    SpinLockGuard lg1(m_state_lock, "PABotBase::drop_held_command()");
+    m_command_held = false;
+    m_held_command = BotBaseMessage();
+    m_cv.notify_all();
+}
 template <typename Map>
 uint64_t PABotBase::infer_full_seqnum(const Map& map, seqnum_t seqnum) const{
     m_sanitizer.check_usage();
@@ -313,12 +336,17 @@ void PABotBase::process_ack_request(BotBaseMessage message){
 
         state = iter->second.state;
         if (state == AckState::NOT_ACKED){
+            m_request_ack_latency->record(std::chrono::duration_cast<std::chrono::microseconds>(
+                current_time() - iter->second.first_sent
+            ).count());
+            trace_async_end("serial", "request", m_trace_id | full_seqnum);
             if (iter->second.silent_remove){
                 m_pending_requests.erase(iter);
             }else{
                 iter->second.state = AckState::ACKED;
                 iter->second.ack = std::move(message);
             }
+            try_send_held_command(MAX_PENDING_REQUESTS);
         }
     }
 
@@ -370,6 +398,10 @@ void PABotBase::process_ack_command(BotBaseMessage message){
     switch (iter->second.state){
     case AckState::NOT_ACKED:
 //        std::cout << "acked: " << full_seqnum << std::endl;
+        m_command_ack_latency->record(std::chrono::duration_cast<std::chrono::microseconds>(
+            current_time() - iter->second.first_sent
+        ).count());
+        trace_async_end("serial", "command", m_trace_id | full_seqnum);
         iter->second.state = AckState::ACKED;
         iter->second.ack = std::move(message);
         return;
@@ -430,6 +462,11 @@ void PABotBase::process_command_finished(BotBaseMessage message){
         if (iter->second.silent_remove){
             m_pending_commands.erase(iter);
         }
+
+        //  A slot just opened up. Send the held command right away so the
+        //  device queue doesn't run dry.
+        try_send_held_command(MAX_PENDING_REQUESTS);
+
         m_cv.notify_all();
         return;
     case AckState::FINISHED:
@@ -497,6 +534,16 @@ void PABotBase::retransmit_thread(){
             continue;
         }
 
+        //  Normally the held command is sent when a command finishes. But it
+        //  can also be stuck behind inflight requests.
+        {
+            std::lock_guard<std::mutex> lg0(m_sleep_lock);
+            SpinLockGuard lg1(m_state_lock, "PABotBase::retransmit_thread() - held");
+            if (m_command_held && try_send_held_command(MAX_PENDING_REQUESTS)){
+                m_cv.notify_all();
+            }
+        }
+
         //  Process retransmits.
         SpinLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
 //        std::cout << "retransmit_thread - m_pending_messages.size(): " << m_pending_messages.size() << std::endl;
@@ -511,6 +558,7 @@ void PABotBase::retransmit_thread(){
                 item.second.state == AckState::NOT_ACKED &&
                 current_time() - item.second.first_sent >= m_retransmit_delay
             ){
+                trace_instant("serial", "retransmit request", item.first);
                 send_message(item.second.request, true);
             }
         }
@@ -520,6 +568,7 @@ void PABotBase::retransmit_thread(){
                 item.second.state == AckState::NOT_ACKED &&
                 current_time() - item.second.first_sent >= m_retransmit_delay
             ){
+                trace_instant("serial", "retransmit command", item.first);
                 send_message(item.second.request, true);
             }
         }
@@ -591,56 +640,36 @@ uint64_t PABotBase::try_issue_request(
     handle.request = std::move(message);
     handle.first_sent = current_time();
 
+    trace_async_begin("serial", "request", m_trace_id | seqnum, seqnum);
     send_message(handle.request, false);
 
     return seqnum;
 }
-uint64_t PABotBase::try_issue_command(
-    const Cancellable* cancelled,
-    const BotBaseRequest& request, bool silent_remove,
-    size_t queue_limit
-){
+bool PABotBase::command_slot_available(size_t queue_limit){
     m_sanitizer.check_usage();
 
-    BotBaseMessage message = request.message();
-    if (message.body.size() < sizeof(uint32_t)){
-        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too short.");
-    }
-    if (message.body.size() > PABB_MAX_MESSAGE_SIZE){
-        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
-    }
-
-    SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_command()");
-    if (cancelled != nullptr && cancelled->cancelled()){
-        throw OperationCancelledException();
-    }
-
-    State state = m_state.load(std::memory_order_acquire);
-    if (state != State::RUNNING){
-        throw InvalidConnectionStateException();
-    }
-    if (m_error.load(std::memory_order_acquire)){
-        throw ConnectionException(&m_logger, "Serial connection was interrupted.");
-    }
-
     //  Command queue is full.
     if (m_pending_commands.size() >= queue_limit){
 //        cout << "Command queue is full" << endl;
-        return 0;
+        return false;
     }
 
     //  Too many unacked requests in flight.
     if (inflight_requests() >= queue_limit){
-        m_logger.log("Message throttled due to too many inflight requests.");
-        return 0;
+        return false;
     }
 
     //  Don't get too far ahead of the oldest seqnum.
-    uint64_t seqnum = m_send_seq;
-    if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
-        return 0;
+    if (m_send_seq - oldest_live_seqnum() > MAX_SEQNUM_GAP){
+        return false;
     }
 
+    return true;
+}
+void PABotBase::send_command(BotBaseMessage message, bool silent_remove){
+    m_sanitizer.check_usage();
+
+    uint64_t seqnum = m_send_seq;
     seqnum_t seqnum_s = (seqnum_t)seqnum;
     memcpy(&message.body[0], &seqnum_s, sizeof(seqnum_t));
 
@@ -661,9 +690,75 @@ uint64_t PABotBase::try_issue_command(
     handle.request = std::move(message);
     handle.first_sent = current_time();
 
+    trace_async_begin("serial", "command", m_trace_id | seqnum, seqnum);
     send_message(handle.request, false);
+}
+bool PABotBase::try_send_held_command(size_t queue_limit){
+    m_sanitizer.check_usage();
 
-    return seqnum;
+    if (!m_command_held || !command_slot_available(queue_limit)){
+        return false;
+    }
+    m_command_held = false;
+    send_command(std::move(m_held_command), true);
+    m_held_command = BotBaseMessage();
+    return true;
+}
+bool PABotBase::try_issue_command(
+    const Cancellable* cancelled,
+    const BotBaseRequest& request, bool silent_remove,
+    size_t queue_limit
+){
+    m_sanitizer.check_usage();
+
+    BotBaseMessage message = request.message();
+    if (message.body.size() < sizeof(uint32_t)){
+        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too short.");
+    }
+    if (message.body.size() > PABB_MAX_MESSAGE_SIZE){
+        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
+    }
+
+    SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_command()");
+    if (cancelled != nullptr && cancelled->cancelled()){
+        throw OperationCancelledException();
+    }
+
+    State state = m_state.load(std::memory_order_acquire);
+    if (state != State::RUNNING){
+        throw InvalidConnectionStateException();
+    }
+    if (m_error.load(std::memory_order_acquire)){
+        throw ConnectionException(&m_logger, "Serial connection was interrupted.");
+    }
+
+    //  Commands must reach the device in order. So if one is being held, this
+    //  one either merges into it or goes after it.
+    if (m_command_held){
+        if (try_coalesce_commands(m_held_command, message)){
+            m_commands_coalesced++;
+            return true;
+        }
+        if (!try_send_held_command(queue_limit)){
+            return false;
+        }
+    }
+
+    if (command_slot_available(queue_limit)){
+        send_command(std::move(message), silent_remove);
+        return true;
+    }
+
+    //  Somebody is waiting on this command. Don't sit on it.
+    if (!silent_remove){
+        return false;
+    }
+
+    //  The device can't take it yet. Hold it here so that the commands issued
+    //  after it can be merged in while we wait for a slot.
+    m_command_held = true;
+    m_held_command = std::move(message);
+    return true;
 }
 uint64_t PABotBase::issue_request(
     const Cancellable* cancelled,
@@ -707,7 +802,7 @@ uint64_t PABotBase::issue_request(
         m_cv.wait(lg);
     }
 }
-uint64_t PABotBase::issue_command(
+void PABotBase::issue_command(
     const Cancellable* cancelled,
     const BotBaseRequest& request, bool silent_remove
 ){
@@ -732,9 +827,8 @@ uint64_t PABotBase::issue_command(
     //
 
     while (true){
-        uint64_t seqnum = try_issue_command(cancelled, request, silent_remove, MAX_PENDING_REQUESTS);
-        if (seqnum != 0){
-            return seqnum;
+        if (try_issue_command(cancelled, request, silent_remove, MAX_PENDING_REQUESTS)){
+            return;
         }
         std::unique_lock<std::mutex> lg(m_sleep_lock);
         if (cancelled != nullptr && cancelled->cancelled()){
@@ -759,7 +853,7 @@ bool PABotBase::try_issue_request(
     if (!request.is_command()){
         return try_issue_request(cancelled, request, true, MAX_PENDING_REQUESTS) != 0;
     }else{
-        return try_issue_command(cancelled, request, true, MAX_PENDING_REQUESTS) != 0;
+        return try_issue_command(cancelled, request, true, MAX_PENDING_REQUESTS);
     }
 }
 void PABotBase::issue_request(
@@ -14,6 +14,11 @@
  *  Requests and commands may be asynchronous. They may return before the device
  *  executes it.
  * 
+ *  When the device's command queue is full, the newest command is held back on
+ *  this side instead of blocking the caller. Any commands issued after it that
+ *  can be merged into it (see CommandCoalescing.h) are merged. It is sent as
+ *  soon as a slot opens up on the device.
+ * 
  * 
  *      Note that button commands will only work if the device is running PABotBase
  *  and is not already running a command. The regular programs do not listen to
@@ -33,6 +38,7 @@
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "ClientSource/Connection/MessageLogger.h"
 #include "ClientSource/Connection/PABotBaseConnection.h"
+#include "Common/Cpp/Metrics/HdrHistogram.h"
 #include "BotBase.h"
 #include "BotBaseMessage.h"
 
@@ -48,7 +54,7 @@ public:
     PABotBase(
         Logger& logger,
         std::unique_ptr<StreamConnection> connection,
-        MessageLogger* message_logger = nullptr,
+        MessageSniffer* sniffer = nullptr,
         std::chrono::milliseconds retransmit_delay = std::chrono::milliseconds(PABB_RETRANSMIT_DELAY_MILLIS)
     );
     virtual ~PABotBase();
@@ -62,6 +68,20 @@ public:
         return m_last_ack.load(std::memory_order_acquire);
     }
 
+    //  Microseconds from when a request/command was first sent to when it
+    //  was acked. Includes any retransmits.
+    const std::shared_ptr<HdrHistogram>& request_ack_latency() const{
+        return m_request_ack_latency;
+    }
+    const std::shared_ptr<HdrHistogram>& command_ack_latency() const{
+        return m_command_ack_latency;
+    }
+
+    //  Number of commands that were merged into an earlier command.
+    uint64_t commands_coalesced() const{
+        return m_commands_coalesced.load(std::memory_order_relaxed);
+    }
+
     virtual Logger& logger() override{
         return m_logger;
     }
@@ -124,19 +144,27 @@ private:
     virtual void on_recv_message(BotBaseMessage message) override;
 
     void clear_all_active_commands(uint64_t seqnum);
+    void drop_held_command();
 
     void retransmit_thread();
 
 private:
     size_t inflight_requests();
 
+    //  These must be called under m_state_lock.
+    bool command_slot_available(size_t queue_limit);
+    void send_command(BotBaseMessage message, bool silent_remove);
+    bool try_send_held_command(size_t queue_limit);
+
     //  Returns the seqnum of the request. If failed, returns zero.
     uint64_t try_issue_request(
         const Cancellable* cancelled,
         const BotBaseRequest& request, bool silent_remove,
         size_t queue_limit
     );
-    uint64_t try_issue_command(
+    //  Returns true if the command was sent, held or merged into the held
+    //  command.
+    bool try_issue_command(
         const Cancellable* cancelled,
         const BotBaseRequest& request, bool silent_remove,
         size_t queue_limit
@@ -147,7 +175,7 @@ private:
         const Cancellable* cancelled,
         const BotBaseRequest& request, bool silent_remove
     );
-    uint64_t issue_command(
+    void issue_command(
         const Cancellable* cancelled,
         const BotBaseRequest& request, bool silent_remove
     );
@@ -173,10 +201,21 @@ private:
     uint64_t m_send_seq;
     std::chrono::milliseconds m_retransmit_delay;
     std::atomic<std::chrono::time_point<std::chrono::system_clock>> m_last_ack;
+    std::shared_ptr<HdrHistogram> m_request_ack_latency;
+    std::shared_ptr<HdrHistogram> m_command_ack_latency;
+
+    //  Upper bits of the trace ids for this connection. The lower bits are
+    //  the seqnum.
+    uint64_t m_trace_id;
 
     std::map<uint64_t, PendingRequest> m_pending_requests;
     std::map<uint64_t, PendingCommand> m_pending_commands;
 
+    //  The command that is waiting for space in the device queue.
+    bool m_command_held;
+    BotBaseMessage m_held_command;
+    std::atomic<uint64_t> m_commands_coalesced;
+
     //  If you need both locks, always acquire m_sleep_lock first!
     SpinLock m_state_lock;
     std::mutex m_sleep_lock;
@@ -184,9 +223,11 @@ private:
     std::condition_variable m_cv;
     std::atomic<State> m_state;
     std::atomic<bool> m_error;
-    std::thread m_retransmit_thread;
 
     LifetimeSanitizer m_sanitizer;
+
+    //  Last so that everything is constructed before the thread starts.
+    std::thread m_retransmit_thread;
 };
 
 
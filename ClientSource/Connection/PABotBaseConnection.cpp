@@ -4,6 +4,7 @@
  * 
  */
 
+#include <string.h>
 #include "Common/CRC32.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "ClientSource/Libraries/Logging.h"
@@ -19,10 +20,14 @@ namespace PokemonAutomation{
 
 MessageSniffer null_sniffer;
 
-PABotBaseConnection::PABotBaseConnection(Logger& logger, std::unique_ptr<StreamConnection> connection)
+PABotBaseConnection::PABotBaseConnection(
+    Logger& logger,
+    std::unique_ptr<StreamConnection> connection,
+    MessageSniffer* sniffer
+)
     : m_connection(std::move(connection))
     , m_logger(logger)
-    , m_sniffer(&null_sniffer)
+    , m_sniffer(sniffer == nullptr ? &null_sniffer : sniffer)
 {
     m_connection->add_listener(*this);
 }
@@ -83,48 +88,49 @@ void PABotBaseConnection::send_message(const BotBaseMessage& message, bool is_re
 
 
 void PABotBaseConnection::on_recv(const void* data, size_t bytes){
-    //  Push into receive buffer.
-    for (size_t c = 0; c < bytes; c++){
-        m_recv_buffer.emplace_back(((const char*)data)[c]);
-    }
+    //  Append to the receive buffer. Everything that hasn't been parsed yet
+    //  stays contiguous so messages can be checked in place.
+    m_recv_buffer.insert(m_recv_buffer.end(), (const char*)data, (const char*)data + bytes);
 
-    while (!m_recv_buffer.empty()){
-        uint8_t length = ~m_recv_buffer[0];
+    size_t start = 0;
+    while (start < m_recv_buffer.size()){
+        const char* ptr = m_recv_buffer.data() + start;
+        size_t available = m_recv_buffer.size() - start;
+        uint8_t length = ~ptr[0];
 
-        if (m_recv_buffer[0] == 0){
+        if (ptr[0] == 0){
             m_sniffer->log("Skipping zero byte.");
-            m_recv_buffer.pop_front();
+            start++;
             continue;
         }
 
         //  Message is too short.
         if (length < PABB_PROTOCOL_OVERHEAD){
             m_sniffer->log("Message is too short: bytes = " + std::to_string(length));
-            m_recv_buffer.pop_front();
+            start++;
             continue;
         }
 
         //  Message is too long.
         if (length > PABB_MAX_PACKET_SIZE){
             m_sniffer->log("Message is too long: bytes = " + std::to_string(length));
-            m_recv_buffer.pop_front();
+            start++;
             continue;
         }
 
         //  Message is incomplete.
-        if (length > m_recv_buffer.size()){
-            return;
+        if (length > available){
+            break;
         }
 
-        std::string message(m_recv_buffer.begin(), m_recv_buffer.begin() + length);
-
         //  Verify checksum
         {
             //  Calculate checksum.
-            uint32_t checksumA = pabb_crc32(0xffffffff, &message[0], length - sizeof(uint32_t));
+            uint32_t checksumA = pabb_crc32(0xffffffff, ptr, length - sizeof(uint32_t));
 
             //  Read the checksum from the message.
-            uint32_t checksumE = ((uint32_t*)(&message[0] + length))[-1];
+            uint32_t checksumE;
+            memcpy(&checksumE, ptr + length - sizeof(uint32_t), sizeof(uint32_t));
 
             //  Compare
 //            std::cout << checksumA << " / " << checksumE << std::endl;
@@ -132,17 +138,20 @@ void PABotBaseConnection::on_recv(const void* data, size_t bytes){
                 m_sniffer->log("Invalid Checksum: bytes = " + std::to_string(length));
 //                std::cout << checksumA << " / " << checksumE << std::endl;
 //                log(message_to_string(message[1], &message[2], length - PABB_PROTOCOL_OVERHEAD));
-                m_recv_buffer.pop_front();
+                start++;
                 continue;
             }
         }
-        m_recv_buffer.erase(m_recv_buffer.begin(), m_recv_buffer.begin() + length);
 
-        BotBaseMessage msg(message[1], std::string(&message[2], length - PABB_PROTOCOL_OVERHEAD));
+        BotBaseMessage msg(ptr[1], std::string(ptr + 2, length - PABB_PROTOCOL_OVERHEAD));
+        start += length;
+
         m_sniffer->on_recv(msg);
         on_recv_message(std::move(msg));
     }
-}
 
+    //  Whatever is left is less than one message. Move it to the front.
+    m_recv_buffer.erase(m_recv_buffer.begin(), m_recv_buffer.begin() + start);
+}
 
 }
@@ -16,7 +16,7 @@
 
 #include <memory>
 #include <string>
-#include <deque>
+#include <vector>
 #include "Common/Compiler.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "BotBase.h"
@@ -30,9 +30,16 @@ namespace PokemonAutomation{
 //  the child class to wrap and make them thread-safe.
 class PABotBaseConnection : public StreamListener{
 public:
-    PABotBaseConnection(Logger& logger, std::unique_ptr<StreamConnection> connection);
+    //  "sniffer" sees every message from the start. (optional)
+    PABotBaseConnection(
+        Logger& logger,
+        std::unique_ptr<StreamConnection> connection,
+        MessageSniffer* sniffer = nullptr
+    );
     virtual ~PABotBaseConnection();
 
+    //  Not thread-safe with sends or receives. Pass the sniffer to the
+    //  constructor instead if the connection is already in use.
     void set_sniffer(MessageSniffer* sniffer);
 
 public:
@@ -49,7 +56,7 @@ private:
 
 private:
     std::unique_ptr<StreamConnection> m_connection;
-    std::deque<char> m_recv_buffer;
+    std::vector<char> m_recv_buffer;
 
 protected:
     Logger& m_logger;
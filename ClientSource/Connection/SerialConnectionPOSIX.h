@@ -2,6 +2,11 @@
  * 
  *  From: https://github.com/PokemonAutomation/Arduino-Source
  * 
+ *      The port is non-blocking and is serviced by the shared SerialReactor
+ *  instead of its own thread. Sends are written immediately if possible.
+ *  Whatever doesn't fit in the OS buffer is queued and written by the reactor
+ *  when the port becomes writable.
+ * 
  */
 
 #ifndef PokemonAutomation_SerialConnectionPOSIX_H
@@ -9,22 +14,28 @@
 
 #include <string>
 #include <atomic>
-#include <thread>
+#include <mutex>
+#include <errno.h>
 #include <fcntl.h>
 #include <termios.h>
 #include <unistd.h>
 #include "Common/Cpp/Exceptions.h"
-#include "Common/Cpp/PanicDump.h"
-#include "Common/Cpp/Concurrency/SpinLock.h"
 #include "StreamInterface.h"
+#include "SerialReactorPOSIX.h"
 
 namespace PokemonAutomation{
 
-class SerialConnection : public StreamConnection{
+class SerialConnection : public StreamConnection, private SerialReactor::Handler{
+public:
+    //  If the device stops reading, drop anything beyond this much unsent
+    //  data. The protocol will retransmit anything that matters.
+    static constexpr size_t MAX_SEND_BUFFER = 64 * 1024;
+
 public:
     //  UTF-8
     SerialConnection(const std::string& name, uint32_t baud_rate)
         : m_exit(false)
+        , m_bytes_dropped(0)
     {
         speed_t baud = B9600;
         switch (baud_rate){
@@ -118,9 +129,9 @@ public:
             throw ConnectionException(nullptr, "Unable to set output baud rate.");
         }
 
-        //  Start receiver thread.
+        //  Start receiving.
         try{
-            m_listener = std::thread(run_with_catch, "SerialConnection::SerialConnection()", [this]{ recv_loop(); });
+            SerialReactor::instance().add(m_fd, *this);
         }catch (...){
             close(m_fd);
             throw;
@@ -135,33 +146,87 @@ public:
 
     virtual void stop() final{
         m_exit.store(true, std::memory_order_release);
+        SerialReactor::instance().remove(m_fd);
         close(m_fd);
-        m_listener.join();
+    }
+
+    //  Bytes that were dropped because the send buffer was full.
+    uint64_t bytes_dropped() const{
+        return m_bytes_dropped.load(std::memory_order_relaxed);
     }
 
 private:
     virtual void send(const void* data, size_t bytes){
-        SpinLockGuard lg(m_send_lock, "SerialConnection::send()");
-        bytes = write(m_fd, data, bytes);
+        std::lock_guard<std::mutex> lg(m_send_lock);
+        const char* ptr = (const char*)data;
+
+        //  Nothing queued. Try to write it directly.
+        if (m_send_buffer.empty()){
+            size_t written = write_some(ptr, bytes);
+            ptr += written;
+            bytes -= written;
+        }
+        if (bytes == 0){
+            return;
+        }
+
+        if (m_send_buffer.size() + bytes > MAX_SEND_BUFFER){
+            m_bytes_dropped.fetch_add(bytes, std::memory_order_relaxed);
+            return;
+        }
+        m_send_buffer.append(ptr, bytes);
+        SerialReactor::instance().set_write_interest(m_fd, true);
     }
 
-    void recv_loop(){
-        char buffer[32];
-        while (!m_exit.load(std::memory_order_acquire)){
-            int actual = read(m_fd, buffer, sizeof(buffer));
+    //  Returns the # of bytes written.
+    size_t write_some(const char* data, size_t bytes){
+        size_t total = 0;
+        while (total < bytes){
+            ssize_t actual = write(m_fd, data + total, bytes - total);
             if (actual > 0){
-                on_recv(buffer, actual);
+                total += actual;
+                continue;
             }
+            if (actual < 0 && errno == EINTR){
+                continue;
+            }
+            break;
         }
+        return total;
+    }
+
+    virtual void on_writable() override{
+        std::lock_guard<std::mutex> lg(m_send_lock);
+        size_t written = write_some(m_send_buffer.data(), m_send_buffer.size());
+        m_send_buffer.erase(0, written);
+        if (m_send_buffer.empty()){
+            SerialReactor::instance().set_write_interest(m_fd, false);
+        }
+    }
+    virtual void on_readable() override{
+        char buffer[256];
+        ssize_t actual = read(m_fd, buffer, sizeof(buffer));
+        if (actual > 0){
+            on_recv(buffer, actual);
+            return;
+        }
+        if (actual < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)){
+            return;
+        }
+
+        //  The device is gone. Stop listening to it so the reactor doesn't
+        //  spin on the hangup.
+        SerialReactor::instance().remove(m_fd);
     }
-    
 
 
 private:
     int m_fd;
     std::atomic<bool> m_exit;
-    SpinLock m_send_lock;
-    std::thread m_listener;
+    std::atomic<uint64_t> m_bytes_dropped;
+
+    std::mutex m_send_lock;
+    std::string m_send_buffer;
 };
 
 
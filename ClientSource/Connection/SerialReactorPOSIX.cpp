@@ -0,0 +1,277 @@
+/*  Serial Reactor for POSIX
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef _WIN32
+
+#include <vector>
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <sys/select.h>
+#endif
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "SerialReactorPOSIX.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+SerialReactor& SerialReactor::instance(){
+    static SerialReactor reactor;
+    return reactor;
+}
+
+
+SerialReactor::SerialReactor()
+    : m_poll_fd(-1)
+    , m_dispatching(-1)
+    , m_stopping(false)
+{
+    int fds[2];
+    if (pipe(fds) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "pipe() failed. Error = " + std::to_string(error));
+    }
+    m_wake_read = fds[0];
+    m_wake_write = fds[1];
+    fcntl(m_wake_read, F_SETFL, fcntl(m_wake_read, F_GETFL) | O_NONBLOCK);
+    fcntl(m_wake_write, F_SETFL, fcntl(m_wake_write, F_GETFL) | O_NONBLOCK);
+
+    try{
+#ifdef __linux__
+        m_poll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (m_poll_fd == -1){
+            int error = errno;
+            throw ConnectionException(nullptr, "epoll_create1() failed. Error = " + std::to_string(error));
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = m_wake_read;
+        if (epoll_ctl(m_poll_fd, EPOLL_CTL_ADD, m_wake_read, &event) == -1){
+            int error = errno;
+            throw ConnectionException(nullptr, "epoll_ctl() failed. Error = " + std::to_string(error));
+        }
+#endif
+        m_thread = std::thread(run_with_catch, "SerialReactor::SerialReactor()", [this]{ run(); });
+    }catch (...){
+        if (m_poll_fd != -1){
+            close(m_poll_fd);
+        }
+        close(m_wake_read);
+        close(m_wake_write);
+        throw;
+    }
+}
+SerialReactor::~SerialReactor(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+    }
+    wake();
+    m_thread.join();
+    if (m_poll_fd != -1){
+        close(m_poll_fd);
+    }
+    close(m_wake_read);
+    close(m_wake_write);
+}
+
+
+void SerialReactor::wake(){
+    char ch = 0;
+    ssize_t ret = write(m_wake_write, &ch, 1);
+    (void)ret;  //  If the pipe is full, the thread is already being woken up.
+}
+void SerialReactor::update(int fd, const Entry& entry, bool add){
+#ifdef __linux__
+    epoll_event event{};
+    event.events = EPOLLIN | (entry.want_write ? (uint32_t)EPOLLOUT : 0);
+    event.data.fd = fd;
+    if (epoll_ctl(m_poll_fd, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "epoll_ctl() failed. Error = " + std::to_string(error));
+    }
+#else
+    (void)fd;
+    (void)entry;
+    (void)add;
+    //  The sets are rebuilt on every iteration.
+    wake();
+#endif
+}
+
+
+void SerialReactor::add(int fd, Handler& handler){
+    std::lock_guard<std::mutex> lg(m_lock);
+#ifndef __linux__
+    if (fd >= FD_SETSIZE){
+        throw ConnectionException(nullptr, "Too many open files for select(): fd = " + std::to_string(fd));
+    }
+#endif
+    Entry entry{&handler, false};
+    if (!m_entries.emplace(fd, entry).second){
+        throw ConnectionException(nullptr, "Serial port is already registered: fd = " + std::to_string(fd));
+    }
+    try{
+        update(fd, entry, true);
+    }catch (...){
+        m_entries.erase(fd);
+        throw;
+    }
+}
+void SerialReactor::remove(int fd){
+    std::unique_lock<std::mutex> lg(m_lock);
+    if (m_entries.erase(fd) == 0){
+        return;
+    }
+#ifdef __linux__
+    epoll_ctl(m_poll_fd, EPOLL_CTL_DEL, fd, nullptr);
+#else
+    wake();
+#endif
+
+    //  If we're inside the handler, it will return on its own.
+    if (std::this_thread::get_id() == m_thread.get_id()){
+        return;
+    }
+    m_cv.wait(lg, [&]{ return m_dispatching != fd; });
+}
+void SerialReactor::set_write_interest(int fd, bool enabled){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_entries.find(fd);
+    if (iter == m_entries.end() || iter->second.want_write == enabled){
+        return;
+    }
+    iter->second.want_write = enabled;
+    update(fd, iter->second, false);
+}
+
+
+
+void SerialReactor::run(){
+    std::vector<std::pair<int, int>> ready;  //  (fd, 1 = read | 2 = write)
+#ifndef __linux__
+    std::vector<int> fds;
+#endif
+
+    while (true){
+        ready.clear();
+        bool woken = false;
+
+#ifdef __linux__
+        epoll_event events[16];
+        int count = epoll_wait(m_poll_fd, events, 16, -1);
+        if (count < 0){
+            continue;   //  EINTR
+        }
+        for (int c = 0; c < count; c++){
+            int fd = events[c].data.fd;
+            if (fd == m_wake_read){
+                woken = true;
+                continue;
+            }
+            int flags = 0;
+            if (events[c].events & (EPOLLIN | EPOLLHUP | EPOLLERR)){
+                flags |= 1;
+            }
+            if (events[c].events & EPOLLOUT){
+                flags |= 2;
+            }
+            ready.emplace_back(fd, flags);
+        }
+#else
+        fd_set read_set;
+        fd_set write_set;
+        FD_ZERO(&read_set);
+        FD_ZERO(&write_set);
+        FD_SET(m_wake_read, &read_set);
+        int max_fd = m_wake_read;
+        fds.clear();
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            for (const auto& item : m_entries){
+                FD_SET(item.first, &read_set);
+                if (item.second.want_write){
+                    FD_SET(item.first, &write_set);
+                }
+                max_fd = std::max(max_fd, item.first);
+                fds.emplace_back(item.first);
+            }
+        }
+        int count = select(max_fd + 1, &read_set, &write_set, nullptr, nullptr);
+        if (count < 0){
+            continue;   //  EINTR or a port was closed under us.
+        }
+        woken = FD_ISSET(m_wake_read, &read_set);
+        for (int fd : fds){
+            int flags = 0;
+            if (FD_ISSET(fd, &read_set)){
+                flags |= 1;
+            }
+            if (FD_ISSET(fd, &write_set)){
+                flags |= 2;
+            }
+            if (flags != 0){
+                ready.emplace_back(fd, flags);
+            }
+        }
+#endif
+
+        if (woken){
+            char buffer[64];
+            while (read(m_wake_read, buffer, sizeof(buffer)) > 0);
+            std::lock_guard<std::mutex> lg(m_lock);
+            if (m_stopping){
+                return;
+            }
+        }
+
+        for (const auto& item : ready){
+            int fd = item.first;
+            for (int flag = 1; flag <= 2; flag <<= 1){
+                if ((item.second & flag) == 0){
+                    continue;
+                }
+
+                //  Look it up again each time since the previous handler
+                //  call may have removed it.
+                Handler* handler;
+                {
+                    std::lock_guard<std::mutex> lg(m_lock);
+                    auto iter = m_entries.find(fd);
+                    if (iter == m_entries.end()){
+                        break;
+                    }
+                    handler = iter->second.handler;
+                    m_dispatching = fd;
+                }
+                if (flag == 1){
+                    handler->on_readable();
+                }else{
+                    handler->on_writable();
+                }
+                {
+                    std::lock_guard<std::mutex> lg(m_lock);
+                    m_dispatching = -1;
+                }
+                m_cv.notify_all();
+            }
+        }
+    }
+}
+
+
+
+}
+#endif
@@ -0,0 +1,86 @@
+/*  Serial Reactor for POSIX
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A single thread that services the file descriptors of all the serial
+ *  connections. Instead of one blocking receive thread per port, every port
+ *  is registered here and the thread waits on all of them at once. (epoll on
+ *  Linux, select() elsewhere since macOS can't poll tty devices)
+ *
+ *  Handlers are called on the reactor thread. They must not block.
+ *
+ */
+
+#ifndef PokemonAutomation_SerialReactorPOSIX_H
+#define PokemonAutomation_SerialReactorPOSIX_H
+
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace PokemonAutomation{
+
+
+class SerialReactor{
+public:
+    class Handler{
+    public:
+        virtual ~Handler() = default;
+
+        //  The fd has data to read or has been closed/errored.
+        virtual void on_readable() = 0;
+
+        //  The fd can be written to. Only called while write interest is on.
+        virtual void on_writable() = 0;
+    };
+
+public:
+    //  The reactor shared by all serial connections in this process.
+    static SerialReactor& instance();
+
+    SerialReactor();
+    ~SerialReactor();
+
+    //  Start servicing "fd". "fd" must be non-blocking.
+    void add(int fd, Handler& handler);
+
+    //  Stop servicing "fd". When this returns, the handler is not running and
+    //  will never be called again. Safe to call from inside a handler.
+    void remove(int fd);
+
+    //  Turn on/off notifications for when "fd" becomes writable.
+    void set_write_interest(int fd, bool enabled);
+
+
+private:
+    struct Entry{
+        Handler* handler;
+        bool want_write;
+    };
+
+    void wake();
+    void update(int fd, const Entry& entry, bool add);
+    void run();
+
+
+private:
+    int m_poll_fd;      //  epoll instance. (unused with select())
+    int m_wake_read;
+    int m_wake_write;
+
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::map<int, Entry> m_entries;
+
+    //  The fd whose handler is currently being called.
+    int m_dispatching;
+    bool m_stopping;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
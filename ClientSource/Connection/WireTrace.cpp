@@ -0,0 +1,240 @@
+/*  Wire Trace
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "Common/Cpp/PanicDump.h"
+#include "BotBaseMessage.h"
+#include "WireTrace.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+WireTraceRecord WireTraceRecord::make(WireDirection direction, const BotBaseMessage& message){
+    WireTraceRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    record.direction = direction;
+    record.type = message.type;
+    record.body_size = (uint8_t)std::min<size_t>(message.body.size(), 255);
+    memcpy(record.body, message.body.data(), std::min(message.body.size(), MAX_BODY));
+
+    //  Requests, commands and acks all start with the seqnum.
+    if ((PABB_MSG_IS_REQUEST_OR_COMMAND(message.type) || PABB_MSG_IS_ACK(message.type)) &&
+        message.body.size() >= sizeof(seqnum_t)
+    ){
+        seqnum_t seqnum;
+        memcpy(&seqnum, message.body.data(), sizeof(seqnum_t));
+        record.seqnum = seqnum;
+        record.flags |= FLAG_HAS_SEQNUM;
+    }
+    return record;
+}
+
+
+
+static size_t round_up_power_of_two(size_t x){
+    size_t ret = 1;
+    while (ret < x){
+        ret <<= 1;
+    }
+    return ret;
+}
+
+WireTraceWriter::WireTraceWriter(
+    std::string path,
+    MessageSniffer* next,
+    size_t capacity,
+    std::chrono::milliseconds flush_interval,
+    uint64_t max_file_bytes
+)
+    : m_path(std::move(path))
+    , m_next(next)
+    , m_flush_interval(flush_interval)
+    , m_max_file_bytes(max_file_bytes)
+    , m_mask(round_up_power_of_two(capacity < 2 ? 2 : capacity) - 1)
+    , m_slots(new Slot[m_mask + 1])
+    , m_head(0)
+    , m_tail(0)
+    , m_written(0)
+    , m_dropped(0)
+    , m_file(nullptr)
+    , m_file_bytes(0)
+    , m_stopping(false)
+{
+    for (size_t c = 0; c <= m_mask; c++){
+        m_slots[c].sequence.store(c, std::memory_order_relaxed);
+    }
+    m_thread = std::thread(run_with_catch, "WireTraceWriter::flush_thread()", [this]{ flush_thread(); });
+}
+WireTraceWriter::~WireTraceWriter(){
+    {
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    flush();
+    if (m_file != nullptr){
+        fclose(m_file);
+    }
+}
+
+
+void WireTraceWriter::log(std::string msg){
+    if (m_next){
+        m_next->log(std::move(msg));
+    }
+}
+void WireTraceWriter::on_send(const BotBaseMessage& message, bool is_retransmit){
+    push(WireTraceRecord::make(is_retransmit ? WireDirection::RESEND : WireDirection::SEND, message));
+    if (m_next){
+        m_next->on_send(message, is_retransmit);
+    }
+}
+void WireTraceWriter::on_recv(const BotBaseMessage& message){
+    push(WireTraceRecord::make(WireDirection::RECEIVE, message));
+    if (m_next){
+        m_next->on_recv(message);
+    }
+}
+
+
+void WireTraceWriter::push(const WireTraceRecord& record){
+    uint64_t position = m_head.load(std::memory_order_relaxed);
+    while (true){
+        Slot& slot = m_slots[position & m_mask];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == position){
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                slot.record = record;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return;
+            }
+        }else if (sequence < position){
+            //  Full. The flusher hasn't caught up.
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }else{
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+bool WireTraceWriter::append_file(){
+    FILE* file = fopen(m_path.c_str(), "rb");
+    if (file == nullptr){
+        return false;
+    }
+    WireTraceFileHeader header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 &&
+        memcmp(header.magic, WireTraceFileHeader::MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == WireTraceFileHeader::VERSION &&
+        header.record_size == sizeof(WireTraceRecord);
+    long bytes = -1;
+    if (valid && fseek(file, 0, SEEK_END) == 0){
+        bytes = ftell(file);
+    }
+    fclose(file);
+
+    //  A partial record means the last session crashed mid-write. Appending
+    //  after it would misalign everything that follows.
+    if (bytes < (long)sizeof(header) ||
+        (uint64_t)bytes >= m_max_file_bytes ||
+        (bytes - sizeof(header)) % sizeof(WireTraceRecord) != 0
+    ){
+        return false;
+    }
+
+    m_file = fopen(m_path.c_str(), "ab");
+    if (m_file == nullptr){
+        return false;
+    }
+    m_file_bytes = bytes;
+    return true;
+}
+bool WireTraceWriter::open_file(){
+    if (append_file()){
+        return true;
+    }
+
+    //  Keep the previous file around.
+    std::string old = m_path + ".1";
+    remove(old.c_str());
+    rename(m_path.c_str(), old.c_str());
+
+    m_file = fopen(m_path.c_str(), "wb");
+    if (m_file == nullptr){
+        return false;
+    }
+    WireTraceFileHeader header;
+    memcpy(header.magic, WireTraceFileHeader::MAGIC, sizeof(header.magic));
+    header.version = WireTraceFileHeader::VERSION;
+    header.record_size = sizeof(WireTraceRecord);
+    fwrite(&header, sizeof(header), 1, m_file);
+    m_file_bytes = sizeof(header);
+    return true;
+}
+void WireTraceWriter::flush(){
+    std::lock_guard<std::mutex> lg(m_flush_lock);
+    flush_unprotected();
+}
+void WireTraceWriter::flush_unprotected(){
+    std::vector<WireTraceRecord> records;
+    while (true){
+        Slot& slot = m_slots[m_tail & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1){
+            break;
+        }
+        records.emplace_back(slot.record);
+        slot.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+        m_tail++;
+    }
+    if (records.empty()){
+        return;
+    }
+
+    if (m_file != nullptr && m_file_bytes >= m_max_file_bytes){
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    if (m_file == nullptr && !open_file()){
+        m_dropped.fetch_add(records.size(), std::memory_order_relaxed);
+        return;
+    }
+
+    fwrite(records.data(), sizeof(WireTraceRecord), records.size(), m_file);
+    fflush(m_file);
+    m_file_bytes += records.size() * sizeof(WireTraceRecord);
+    m_written.fetch_add(records.size(), std::memory_order_relaxed);
+}
+void WireTraceWriter::flush_thread(){
+    while (true){
+        {
+            std::unique_lock<std::mutex> lg(m_sleep_lock);
+            if (m_stopping){
+                return;
+            }
+            m_cv.wait_for(lg, m_flush_interval);
+            if (m_stopping){
+                return;
+            }
+        }
+        flush();
+    }
+}
+
+
+
+}
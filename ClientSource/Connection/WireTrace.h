@@ -0,0 +1,147 @@
+/*  Wire Trace
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      An always-on binary trace of every message sent to and received from
+ *  the device. Each message becomes a fixed-size record that is pushed into a
+ *  lock-free ring. A background thread periodically flushes the ring to a
+ *  file. Nothing is converted to text on the hot path.
+ *
+ *  Use "WireTraceDecoder.h" to read the file back.
+ *
+ *  This is a MessageSniffer. Anything it sees is also forwarded to "next" so
+ *  it can sit in front of the regular MessageLogger.
+ *
+ */
+
+#ifndef PokemonAutomation_WireTrace_H
+#define PokemonAutomation_WireTrace_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include "Common/Microcontroller/MessageProtocol.h"
+#include "MessageSniffer.h"
+
+namespace PokemonAutomation{
+
+
+enum class WireDirection : uint8_t{
+    SEND,
+    RESEND,
+    RECEIVE,
+};
+
+struct WireTraceRecord{
+    static constexpr uint8_t FLAG_HAS_SEQNUM = 0x01;
+    static constexpr size_t MAX_BODY = 16;
+
+    uint64_t timestamp_us;  //  Since the epoch of "std::chrono::system_clock".
+    uint32_t seqnum;        //  Only valid if "FLAG_HAS_SEQNUM" is set.
+    WireDirection direction;
+    uint8_t type;
+    uint8_t body_size;      //  Size of the original body. May exceed MAX_BODY.
+    uint8_t flags;
+    char body[MAX_BODY];
+
+    static WireTraceRecord make(WireDirection direction, const BotBaseMessage& message);
+};
+static_assert(sizeof(WireTraceRecord) == 32, "WireTraceRecord must be 32 bytes.");
+static_assert(PABB_MAX_MESSAGE_SIZE <= WireTraceRecord::MAX_BODY, "Messages no longer fit in a trace record.");
+
+//  The file is this header followed by the records.
+struct WireTraceFileHeader{
+    static constexpr char MAGIC[8] = {'P', 'A', 'B', 'B', 'W', 'I', 'R', 'E'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+
+
+class WireTraceWriter : public MessageSniffer{
+public:
+    //  "capacity" is the # of records the ring can hold. It is rounded up to
+    //  a power of two. If the ring fills up before it is flushed, new records
+    //  are dropped.
+    //
+    //  An existing trace at "path" is appended to. So reconnecting to the
+    //  same port continues the same trace. Once the file reaches
+    //  "max_file_bytes" (or isn't a valid trace) it is renamed to "path.1"
+    //  (replacing the previous one) and a new file is started. So at most
+    //  twice that is kept on disk.
+    WireTraceWriter(
+        std::string path,
+        MessageSniffer* next = nullptr,
+        size_t capacity = 4096,
+        std::chrono::milliseconds flush_interval = std::chrono::milliseconds(1000),
+        uint64_t max_file_bytes = 32 * 1024 * 1024
+    );
+    ~WireTraceWriter();
+
+    const std::string& path() const{ return m_path; }
+
+    uint64_t records_written() const{ return m_written.load(std::memory_order_relaxed); }
+    uint64_t records_dropped() const{ return m_dropped.load(std::memory_order_relaxed); }
+
+    //  Write everything in the ring to the file now.
+    void flush();
+
+    virtual void log(std::string msg) override;
+    virtual void on_send(const BotBaseMessage& message, bool is_retransmit) override;
+    virtual void on_recv(const BotBaseMessage& message) override;
+
+
+private:
+    void push(const WireTraceRecord& record);
+    bool append_file();
+    bool open_file();
+    void flush_unprotected();
+    void flush_thread();
+
+
+private:
+    struct Slot{
+        std::atomic<uint64_t> sequence;
+        WireTraceRecord record;
+    };
+
+    const std::string m_path;
+    MessageSniffer* m_next;
+    const std::chrono::milliseconds m_flush_interval;
+    const uint64_t m_max_file_bytes;
+
+    //  Bounded multi-producer, single-consumer ring. Each slot's sequence
+    //  says whether it is free to write (== position) or ready to read
+    //  (== position + 1).
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<uint64_t> m_head;
+    uint64_t m_tail;
+
+    std::atomic<uint64_t> m_written;
+    std::atomic<uint64_t> m_dropped;
+
+    //  Protects the consumer side and the file.
+    std::mutex m_flush_lock;
+    FILE* m_file;
+    uint64_t m_file_bytes;
+
+    std::mutex m_sleep_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
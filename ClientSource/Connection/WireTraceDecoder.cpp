@@ -0,0 +1,163 @@
+/*  Wire Trace Decoder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <map>
+#include "Common/Cpp/Exceptions.h"
+#include "ClientSource/Libraries/MessageConverter.h"
+#include "BotBaseMessage.h"
+#include "WireTraceDecoder.h"
+
+namespace PokemonAutomation{
+
+
+std::vector<WireTraceRecord> read_wire_trace(const std::string& path){
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", path);
+    }
+
+    WireTraceFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, WireTraceFileHeader::MAGIC, sizeof(header.magic)) != 0
+    ){
+        fclose(file);
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not a wire trace file.", path);
+    }
+    if (header.version != WireTraceFileHeader::VERSION || header.record_size != sizeof(WireTraceRecord)){
+        fclose(file);
+        throw FileException(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Unsupported wire trace version: " + std::to_string(header.version),
+            path
+        );
+    }
+
+    std::vector<WireTraceRecord> records;
+    WireTraceRecord buffer[256];
+    while (true){
+        size_t count = fread(buffer, sizeof(WireTraceRecord), 256, file);
+        records.insert(records.end(), buffer, buffer + count);
+        if (count < 256){
+            break;
+        }
+    }
+    fclose(file);
+    return records;
+}
+
+
+BotBaseMessage wire_trace_message(const WireTraceRecord& record){
+    size_t bytes = record.body_size < WireTraceRecord::MAX_BODY ? record.body_size : WireTraceRecord::MAX_BODY;
+    return BotBaseMessage(record.type, std::string(record.body, bytes));
+}
+
+std::string wire_trace_to_string(const WireTraceRecord& record){
+#if _WIN32 && _MSC_VER
+#pragma warning(disable:4996)
+#endif
+    time_t seconds = (time_t)(record.timestamp_us / 1000000);
+    tm local_tm = *localtime(&seconds);
+    char time[64];
+    snprintf(
+        time, sizeof(time), "%04d-%02d-%02d %02d:%02d:%02d.%06u",
+        local_tm.tm_year + 1900, local_tm.tm_mon + 1, local_tm.tm_mday,
+        local_tm.tm_hour, local_tm.tm_min, local_tm.tm_sec,
+        (unsigned)(record.timestamp_us % 1000000)
+    );
+
+    std::string str = time;
+    switch (record.direction){
+    case WireDirection::SEND:
+        str += " Sending: ";
+        break;
+    case WireDirection::RESEND:
+        str += " Re-Send: ";
+        break;
+    case WireDirection::RECEIVE:
+        str += " Receive: ";
+        break;
+    }
+    str += message_to_string(wire_trace_message(record));
+    return str;
+}
+
+
+
+std::string WireTraceStats::to_string() const{
+    std::string str;
+    str += "Sent: " + std::to_string(sent);
+    str += ", Re-Sent: " + std::to_string(resent);
+    str += ", Received: " + std::to_string(received) + "\n";
+    str += "Messages Retransmitted: " + std::to_string(messages_retransmitted);
+    str += ", Never Acked: " + std::to_string(unacked) + "\n";
+    str += "Request Ack Latency: " + request_ack_latency.dump(" ms", 1000) + "\n";
+    str += "Command Ack Latency: " + command_ack_latency.dump(" ms", 1000) + "\n";
+    return str;
+}
+
+void compute_wire_trace_stats(WireTraceStats& stats, const std::vector<WireTraceRecord>& records){
+    struct Outstanding{
+        uint64_t first_sent_us;
+        bool is_command;
+        bool retransmitted;
+    };
+
+    //  Requests and commands that we sent which haven't been acked yet.
+    std::map<uint32_t, Outstanding> outstanding;
+
+    for (const WireTraceRecord& record : records){
+        bool has_seqnum = record.flags & WireTraceRecord::FLAG_HAS_SEQNUM;
+        switch (record.direction){
+        case WireDirection::SEND:
+            stats.sent++;
+            if (has_seqnum && PABB_MSG_IS_REQUEST_OR_COMMAND(record.type)){
+                outstanding[record.seqnum] = Outstanding{
+                    record.timestamp_us,
+                    (bool)PABB_MSG_IS_COMMAND(record.type),
+                    false,
+                };
+            }
+            break;
+        case WireDirection::RESEND:{
+            stats.resent++;
+            auto iter = outstanding.find(record.seqnum);
+            if (has_seqnum && iter != outstanding.end() && !iter->second.retransmitted){
+                iter->second.retransmitted = true;
+                stats.messages_retransmitted++;
+            }
+            break;
+        }
+        case WireDirection::RECEIVE:{
+            stats.received++;
+            if (!has_seqnum || !PABB_MSG_IS_ACK(record.type)){
+                break;
+            }
+            auto iter = outstanding.find(record.seqnum);
+            if (iter == outstanding.end()){
+                break;
+            }
+            uint64_t sent = iter->second.first_sent_us;
+            uint64_t latency = record.timestamp_us > sent ? record.timestamp_us - sent : 0;
+            if (iter->second.is_command){
+                stats.command_ack_latency.record(latency);
+            }else{
+                stats.request_ack_latency.record(latency);
+            }
+            outstanding.erase(iter);
+            break;
+        }
+        }
+    }
+
+    stats.unacked += outstanding.size();
+}
+
+
+
+}
@@ -0,0 +1,59 @@
+/*  Wire Trace Decoder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Read back the files written by WireTraceWriter. Turns the records back
+ *  into the same text that MessageLogger would have printed and computes
+ *  retransmit and ack latency statistics.
+ *
+ */
+
+#ifndef PokemonAutomation_WireTraceDecoder_H
+#define PokemonAutomation_WireTraceDecoder_H
+
+#include <string>
+#include <vector>
+#include "Common/Cpp/Metrics/HdrHistogram.h"
+#include "WireTrace.h"
+
+namespace PokemonAutomation{
+
+struct BotBaseMessage;
+
+
+//  Throws FileException if the file can't be read or isn't a wire trace.
+//  A partial record at the end of the file is ignored.
+std::vector<WireTraceRecord> read_wire_trace(const std::string& path);
+
+//  The message as it was sent/received. The body is truncated if it didn't
+//  fit in the record.
+BotBaseMessage wire_trace_message(const WireTraceRecord& record);
+
+//  "<time> Sending: <message>"
+std::string wire_trace_to_string(const WireTraceRecord& record);
+
+
+struct WireTraceStats{
+    uint64_t sent = 0;
+    uint64_t resent = 0;
+    uint64_t received = 0;
+
+    //  Requests/commands that were resent at least once.
+    uint64_t messages_retransmitted = 0;
+
+    //  Requests/commands that were never acked within the trace.
+    uint64_t unacked = 0;
+
+    //  Microseconds from when a request/command was first sent to its
+    //  first ack.
+    HdrHistogram request_ack_latency;
+    HdrHistogram command_ack_latency;
+
+    std::string to_string() const;
+};
+void compute_wire_trace_stats(WireTraceStats& stats, const std::vector<WireTraceRecord>& records);
+
+
+
+}
+#endif
@@ -14,12 +14,14 @@
 namespace PokemonAutomation{
 
 std::string current_time_to_str(){
+    return time_to_str(std::chrono::system_clock::now());
+}
+std::string time_to_str(std::chrono::system_clock::time_point now){
     //  Based off of: https://stackoverflow.com/questions/15957805/extract-year-month-day-etc-from-stdchronotime-point-in-c
 
     using namespace std;
     using namespace std::chrono;
     typedef duration<int, ratio_multiply<hours::period, ratio<24> >::type> days;
-    system_clock::time_point now = system_clock::now();
     system_clock::duration tp = now.time_since_epoch();
     days d = duration_cast<days>(tp);
     tp -= d;
@@ -31,19 +33,27 @@ std::string current_time_to_str(){
     tp -= s;
     auto micros = 1000000 * tp.count() * system_clock::duration::period::num / system_clock::duration::period::den;
     time_t tt = system_clock::to_time_t(now);
-//    tm utc_tm = *gmtime(&tt);
-    tm local_tm = *localtime(&tt);
-
-    std::ostringstream ss;
-    ss << local_tm.tm_year + 1900 << '-';
-    ss << tostr_padded(2, local_tm.tm_mon + 1) << '-';
-    ss << tostr_padded(2, local_tm.tm_mday) << ' ';
-    ss << tostr_padded(2, local_tm.tm_hour) << ':';
-    ss << tostr_padded(2, local_tm.tm_min) << ':';
-    ss << tostr_padded(2, local_tm.tm_sec) << '.';
-    ss << tostr_padded(6, micros);
-
-    return ss.str();
+
+    //  localtime() is slow. The log writer formats every line, so only redo
+    //  the date part when the second changes.
+    thread_local time_t cached_time = (time_t)-1;
+    thread_local std::string cached_str;
+    if (tt != cached_time){
+//        tm utc_tm = *gmtime(&tt);
+        tm local_tm = *localtime(&tt);
+
+        std::ostringstream ss;
+        ss << local_tm.tm_year + 1900 << '-';
+        ss << tostr_padded(2, local_tm.tm_mon + 1) << '-';
+        ss << tostr_padded(2, local_tm.tm_mday) << ' ';
+        ss << tostr_padded(2, local_tm.tm_hour) << ':';
+        ss << tostr_padded(2, local_tm.tm_min) << ':';
+        ss << tostr_padded(2, local_tm.tm_sec) << '.';
+        cached_str = ss.str();
+        cached_time = tt;
+    }
+
+    return cached_str + tostr_padded(6, micros);
 }
 
 
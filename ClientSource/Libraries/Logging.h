@@ -9,6 +9,7 @@
 
 #include <string>
 #include <sstream>
+#include <chrono>
 
 namespace PokemonAutomation{
 
@@ -17,6 +18,7 @@ void log(const std::ostringstream& ss);
 void log(const std::string& msg);
 
 std::string current_time_to_str();
+std::string time_to_str(std::chrono::system_clock::time_point time);
 
 
 
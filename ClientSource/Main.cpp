@@ -20,6 +20,9 @@ namespace PokemonAutomation{
 //  Device Logger
 void device_logger              (const std::string& device_name = "");
 
+//  Print a wire trace file from SerialPrograms.
+void wire_trace_decoder         (const std::string& path = "");
+
 //  Sample Programs
 void program_TurboA             (const std::string& device_name = "");
 void program_ClothingBuyer      (const std::string& device_name = "");
@@ -67,6 +70,9 @@ int main(){
         //  By default, this program runs the logging program.
         device_logger();
 
+        //  Decode a wire trace file.
+//        wire_trace_decoder();
+
         //  You can also run programs directly from the computer.
 //        program_TurboA();
 //        program_ClothingBuyer();
@@ -12,7 +12,10 @@ CURRENT += Libraries/Utilities.cpp
 CURRENT += Connection/Unicode.cpp
 CURRENT += Connection/PABotBaseConnection.cpp
 CURRENT += Connection/PABotBase.cpp
+CURRENT += Connection/WireTrace.cpp
+CURRENT += Connection/WireTraceDecoder.cpp
 CURRENT += Programs/DeviceLogger.cpp
+CURRENT += Programs/WireTraceDecoder.cpp
 CURRENT += Programs/TurboA.cpp
 CURRENT += Programs/ClothingBuyer.cpp
 CURRENT += Programs/BallThrower.cpp
@@ -0,0 +1,35 @@
+/*  Wire Trace Decoder
+ * 
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ * 
+ *      Print the messages of a wire trace (.pabbwire) file as text followed
+ *  by retransmit and ack latency statistics.
+ * 
+ */
+
+#include <iostream>
+#include "ClientSource/Connection/WireTraceDecoder.h"
+
+namespace PokemonAutomation{
+
+
+void wire_trace_decoder(const std::string& path){
+    std::string file = path;
+    if (file.empty()){
+        std::cout << "Wire Trace File: ";
+        std::getline(std::cin, file);
+    }
+
+    std::vector<WireTraceRecord> records = read_wire_trace(file);
+    for (const WireTraceRecord& record : records){
+        std::cout << wire_trace_to_string(record) << std::endl;
+    }
+
+    WireTraceStats stats;
+    compute_wire_trace_stats(stats, records);
+    std::cout << std::endl;
+    std::cout << stats.to_string();
+}
+
+
+}
@@ -22,6 +22,115 @@ const size_t BUFFER_CHECK_TOP = (size_t)0xc72bf73f0559cfe4;
 namespace PokemonAutomation{
 
 
+
+static void heap_free(void* ptr){
+    size_t* ret = (size_t*)ptr;
+    size_t free_int = ret[-3];
+    free((void*)free_int);
+}
+
+
+//  Freed blocks of the current thread. Ordered from oldest to newest.
+struct FrameArena{
+    struct Block{
+        void* ptr;
+        size_t bytes;
+        uint64_t frame;
+    };
+
+    uint64_t frame = 0;
+    size_t count = 0;
+    size_t total_bytes = 0;
+    Block blocks[FrameArenaScope::MAX_BLOCKS];
+
+    ~FrameArena(){
+        while (count > 0){
+            evict_oldest();
+        }
+    }
+
+    void* take(size_t bytes, size_t alignment){
+        //  Newest first since it's the most likely to still be in cache.
+        for (size_t c = count; c-- > 0;){
+            const Block& block = blocks[c];
+            if (block.bytes != bytes || ((size_t)block.ptr & (alignment - 1)) != 0){
+                continue;
+            }
+            void* ptr = block.ptr;
+            memmove(blocks + c, blocks + c + 1, (count - c - 1) * sizeof(Block));
+            count--;
+            total_bytes -= bytes;
+            return ptr;
+        }
+        return nullptr;
+    }
+    bool give(void* ptr, size_t bytes){
+        if (bytes > FrameArenaScope::MAX_BYTES){
+            return false;
+        }
+        if (count == FrameArenaScope::MAX_BLOCKS){
+            evict_oldest();
+        }
+        blocks[count++] = {ptr, bytes, frame};
+        total_bytes += bytes;
+        while (total_bytes > FrameArenaScope::MAX_BYTES){
+            evict_oldest();
+        }
+        return true;
+    }
+    void evict_oldest(){
+        heap_free(blocks[0].ptr);
+        total_bytes -= blocks[0].bytes;
+        count--;
+        memmove(blocks, blocks + 1, count * sizeof(Block));
+    }
+
+    //  Called at the end of each frame. Free everything that was left over
+    //  from the previous frame and wasn't reused in this one.
+    void end_frame(){
+        size_t kept = 0;
+        for (size_t c = 0; c < count; c++){
+            const Block& block = blocks[c];
+            if (block.frame == frame){
+                blocks[kept++] = block;
+            }else{
+                heap_free(block.ptr);
+                total_bytes -= block.bytes;
+            }
+        }
+        count = kept;
+        frame++;
+    }
+};
+
+static FrameArena& thread_arena(){
+    thread_local FrameArena arena;
+    return arena;
+}
+
+static thread_local bool t_arena_active = false;
+static thread_local AlignedMallocCounters t_counters;
+
+
+AlignedMallocCounters aligned_malloc_counters(){
+    return t_counters;
+}
+
+FrameArenaScope::FrameArenaScope()
+    : m_previous(t_arena_active)
+{
+    thread_arena();
+    t_arena_active = true;
+}
+FrameArenaScope::~FrameArenaScope(){
+    t_arena_active = m_previous;
+    if (!m_previous){
+        thread_arena().end_frame();
+    }
+}
+
+
+
 void* aligned_malloc(size_t bytes, size_t alignment){
     if (alignment < sizeof(size_t)){
         alignment = sizeof(size_t);
@@ -32,6 +141,15 @@ void* aligned_malloc(size_t bytes, size_t alignment){
     }
 #endif
 
+    if (t_arena_active){
+        void* ptr = thread_arena().take(bytes, alignment);
+        if (ptr != nullptr){
+            t_counters.recycled_allocs++;
+            return ptr;
+        }
+    }
+    t_counters.heap_allocs++;
+
     size_t actual_bytes = bytes + alignment + sizeof(size_t)*4;
     void* free_ptr = malloc(actual_bytes);
     if (free_ptr == nullptr){
@@ -51,9 +169,9 @@ void* aligned_malloc(size_t bytes, size_t alignment){
 
     size_t* ret = (size_t*)ret_address;
     ret[-3] = free_address;
+    ret[-2] = bytes;
 
 #ifdef PA_ENABLE_MALLOC_CHECKING
-    ret[-2] = bytes;
     ret[-1] = BUFFER_CHECK_BOT;
     memcpy((char*)ret + bytes, &BUFFER_CHECK_TOP, sizeof(size_t));
 #endif
@@ -67,11 +185,11 @@ void aligned_free(void* ptr){
 
     check_aligned_ptr(ptr);
 
-    size_t* ret = (size_t*)ptr;
-    size_t free_int = ret[-3];
-
-    ptr = (void*)free_int;
-    free(ptr);
+    size_t bytes = ((const size_t*)ptr)[-2];
+    if (t_arena_active && thread_arena().give(ptr, bytes)){
+        return;
+    }
+    heap_free(ptr);
 }
 void check_aligned_ptr(const void* ptr){
 #ifdef PA_ENABLE_MALLOC_CHECKING
@@ -8,6 +8,7 @@
 #define PokemonAutomation_AlignedMalloc_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace PokemonAutomation{
 
@@ -17,5 +18,49 @@ void aligned_free(void* ptr);
 void check_aligned_ptr(const void *ptr);
 
 
+
+//  Allocation counts of the current thread.
+struct AlignedMallocCounters{
+    uint64_t heap_allocs = 0;       //  Went to the heap.
+    uint64_t recycled_allocs = 0;   //  Reused a block from the frame arena.
+};
+AlignedMallocCounters aligned_malloc_counters();
+
+
+
+//  While this is alive, blocks that are freed on this thread are kept in a
+//  thread-local arena instead of going back to the heap. Later allocations on
+//  this thread of the exact same size reuse them.
+//
+//  This is meant for code that allocates and frees the same temporary images
+//  and matrices over and over. (e.g. once per video frame) So after the first
+//  frame, nearly every allocation is a reuse.
+//
+//  The blocks are ordinary "aligned_malloc()" blocks. So anything that
+//  escapes the scope can still be freed from anywhere.
+//
+//  The arena only holds on to one frame. When the outermost scope exits, the
+//  blocks that were freed during that scope are kept for the next one and
+//  everything older is freed. So it never holds more than what one frame
+//  freed, rather than accumulating across frames. On top of that, it keeps at
+//  most "MAX_BLOCKS" blocks and "MAX_BYTES" bytes. Past that, the oldest
+//  blocks are freed first. Whatever is left is freed when the thread exits.
+class FrameArenaScope{
+public:
+    static constexpr size_t MAX_BLOCKS = 64;
+    static constexpr size_t MAX_BYTES = (size_t)32 << 20;
+
+public:
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    void operator=(const FrameArenaScope&) = delete;
+
+    FrameArenaScope();
+    ~FrameArenaScope();
+
+private:
+    bool m_previous;
+};
+
+
 }
 #endif
@@ -0,0 +1,161 @@
+/*  HDR Histogram
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/PrettyPrint.h"
+#include "HdrHistogram.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+static size_t bitlength(uint64_t x){
+    size_t bits = 0;
+    for (size_t shift = 32; shift != 0; shift >>= 1){
+        if (x >> shift){
+            x >>= shift;
+            bits += shift;
+        }
+    }
+    return bits + (size_t)(x != 0);
+}
+
+size_t HdrHistogram::bucket_index(uint64_t value){
+    if (value > MAX_VALUE){
+        value = MAX_VALUE;
+    }
+    if (value < SUB_BUCKETS){
+        return (size_t)value;
+    }
+    //  Keep the top "SUB_BUCKET_BITS + 1" bits.
+    size_t shift = bitlength(value) - SUB_BUCKET_BITS - 1;
+    return shift * SUB_BUCKETS + (size_t)(value >> shift);
+}
+uint64_t HdrHistogram::bucket_min(size_t index){
+    if (index < 2 * SUB_BUCKETS){
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t top = index - shift * SUB_BUCKETS;
+    return top << shift;
+}
+uint64_t HdrHistogram::bucket_max(size_t index){
+    if (index < 2 * SUB_BUCKETS){
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t top = index - shift * SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+
+
+HdrHistogram::HdrHistogram(){
+    clear();
+}
+HdrHistogram::HdrHistogram(const HdrHistogram& x){
+    *this = x;
+}
+void HdrHistogram::operator=(const HdrHistogram& x){
+    for (size_t c = 0; c < BUCKETS; c++){
+        m_buckets[c].store(x.m_buckets[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    m_count.store(x.m_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_sum.store(x.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_min.store(x.m_min.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_max.store(x.m_max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+void HdrHistogram::clear(){
+    for (std::atomic<uint64_t>& bucket : m_buckets){
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store((uint64_t)-1, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+
+void HdrHistogram::record(uint64_t value){
+    m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    current = m_max.load(std::memory_order_relaxed);
+    while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+void HdrHistogram::operator+=(const HdrHistogram& x){
+    for (size_t c = 0; c < BUCKETS; c++){
+        uint64_t count = x.m_buckets[c].load(std::memory_order_relaxed);
+        if (count != 0){
+            m_buckets[c].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+    m_count.fetch_add(x.m_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_sum.fetch_add(x.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    uint64_t value = x.m_min.load(std::memory_order_relaxed);
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    value = x.m_max.load(std::memory_order_relaxed);
+    current = m_max.load(std::memory_order_relaxed);
+    while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+
+uint64_t HdrHistogram::min() const{
+    return count() == 0 ? 0 : m_min.load(std::memory_order_relaxed);
+}
+double HdrHistogram::mean() const{
+    uint64_t samples = count();
+    return samples == 0 ? 0 : (double)sum() / samples;
+}
+uint64_t HdrHistogram::percentile(double percentile) const{
+    uint64_t total = 0;
+    for (const std::atomic<uint64_t>& bucket : m_buckets){
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0){
+        return 0;
+    }
+
+    //  1-based rank of the sample we want.
+    uint64_t rank = (uint64_t)(percentile * total + 0.5);
+    rank = rank < 1 ? 1 : rank;
+    rank = rank > total ? total : rank;
+
+    uint64_t seen = 0;
+    for (size_t c = 0; c < BUCKETS; c++){
+        seen += m_buckets[c].load(std::memory_order_relaxed);
+        if (seen >= rank){
+            uint64_t value = bucket_max(c);
+            uint64_t max_value = max();
+            return value < max_value ? value : max_value;
+        }
+    }
+    return max();
+}
+
+
+std::string HdrHistogram::dump(const char* units, double divider) const{
+    divider = 1. / divider;
+    std::string str;
+    str += "Count = " + tostr_u_commas(count());
+    str += ", Mean = " + tostr_default(mean() * divider) + units;
+    str += ", p50 = " + tostr_default(percentile(0.50) * divider) + units;
+    str += ", p90 = " + tostr_default(percentile(0.90) * divider) + units;
+    str += ", p99 = " + tostr_default(percentile(0.99) * divider) + units;
+    str += ", Max = " + tostr_default(max() * divider) + units;
+    return str;
+}
+
+
+
+}
@@ -0,0 +1,79 @@
+/*  HDR Histogram
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A log-linear histogram for latencies and other non-negative integers.
+ *  Each power of two is split into 32 linear sub-buckets. So any recorded
+ *  value is known to within ~3% regardless of its magnitude. This is what
+ *  lets you ask for the p99 instead of only the mean and stddev.
+ *
+ *  Recording is lock-free. (a few relaxed atomic adds) It's safe to record
+ *  from multiple threads while other threads read the stats.
+ *
+ */
+
+#ifndef PokemonAutomation_HdrHistogram_H
+#define PokemonAutomation_HdrHistogram_H
+
+#include <stdint.h>
+#include <string>
+#include <atomic>
+
+namespace PokemonAutomation{
+
+
+class HdrHistogram{
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKETS = (size_t)1 << SUB_BUCKET_BITS;
+
+    //  Larger values are recorded as 2^MAX_VALUE_BITS - 1.
+    //  (~19 hours if recording microseconds)
+    static constexpr size_t MAX_VALUE_BITS = 36;
+    static constexpr uint64_t MAX_VALUE = ((uint64_t)1 << MAX_VALUE_BITS) - 1;
+
+    static constexpr size_t BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+public:
+    HdrHistogram();
+
+    //  Copying takes a snapshot.
+    HdrHistogram(const HdrHistogram& x);
+    void operator=(const HdrHistogram& x);
+
+    void clear();
+    void record(uint64_t value);
+    void operator+=(uint64_t value){ record(value); }
+    void operator+=(const HdrHistogram& x);
+
+    uint64_t count() const{ return m_count.load(std::memory_order_relaxed); }
+    uint64_t sum() const{ return m_sum.load(std::memory_order_relaxed); }
+    uint64_t min() const;
+    uint64_t max() const{ return m_max.load(std::memory_order_relaxed); }
+    double mean() const;
+
+    //  The value that "percentile" (0 - 1) of the samples are at or below.
+    //  Accurate to the width of its bucket. Returns zero if empty.
+    uint64_t percentile(double percentile) const;
+
+    std::string dump(const char* units, double divider) const;
+
+
+public:
+    static size_t bucket_index(uint64_t value);
+    static uint64_t bucket_min(size_t index);
+    static uint64_t bucket_max(size_t index);
+
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKETS];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,228 @@
+/*  Metrics Registry
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QSaveFile>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "MetricsRegistry.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+MetricsRegistry& MetricsRegistry::instance(){
+    static MetricsRegistry registry;
+    return registry;
+}
+
+std::string MetricsRegistry::label(const std::string& key, const std::string& value){
+    std::string str = key + "=\"";
+    for (char ch : value){
+        switch (ch){
+        case '\\':
+            str += "\\\\";
+            break;
+        case '"':
+            str += "\\\"";
+            break;
+        case '\n':
+            str += "\\n";
+            break;
+        default:
+            str += ch;
+        }
+    }
+    str += "\"";
+    return str;
+}
+
+MetricsRegistry::MetricsRegistry()
+    : m_period(0)
+    , m_stopping(false)
+{}
+MetricsRegistry::~MetricsRegistry(){
+    stop_export();
+}
+
+
+std::shared_ptr<MetricsRegistry::Counter> MetricsRegistry::counter(const std::string& name, const std::string& labels){
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::shared_ptr<Counter>& ret = m_counters[Key(name, labels)];
+    if (!ret){
+        ret = std::make_shared<Counter>(0);
+    }
+    return ret;
+}
+std::shared_ptr<HdrHistogram> MetricsRegistry::histogram(const std::string& name, const std::string& labels){
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::shared_ptr<HdrHistogram>& ret = m_histograms[Key(name, labels)];
+    if (!ret){
+        ret = std::make_shared<HdrHistogram>();
+    }
+    return ret;
+}
+void MetricsRegistry::add_histogram(const std::string& name, const std::string& labels, std::shared_ptr<HdrHistogram> histogram){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_histograms[Key(name, labels)] = std::move(histogram);
+}
+
+
+
+static std::string with_labels(const std::string& name, const std::string& labels, const std::string& extra = ""){
+    std::string str = name;
+    if (labels.empty() && extra.empty()){
+        return str;
+    }
+    str += "{";
+    str += labels;
+    if (!labels.empty() && !extra.empty()){
+        str += ",";
+    }
+    str += extra;
+    str += "}";
+    return str;
+}
+
+std::string MetricsRegistry::to_prometheus() const{
+    static const std::pair<const char*, double> QUANTILES[] = {
+        {"0.5", 0.50},
+        {"0.9", 0.90},
+        {"0.99", 0.99},
+        {"0.999", 0.999},
+    };
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::string str;
+
+    const std::string* last_name = nullptr;
+    for (const auto& item : m_counters){
+        const std::string& name = item.first.first;
+        if (last_name == nullptr || *last_name != name){
+            str += "# TYPE " + name + " counter\n";
+            last_name = &name;
+        }
+        str += with_labels(name, item.first.second);
+        str += " " + std::to_string(item.second->load(std::memory_order_relaxed)) + "\n";
+    }
+
+    last_name = nullptr;
+    for (const auto& item : m_histograms){
+        const std::string& name = item.first.first;
+        const std::string& labels = item.first.second;
+        if (last_name == nullptr || *last_name != name){
+            str += "# TYPE " + name + " summary\n";
+            last_name = &name;
+        }
+        //  Snapshot so the quantiles are consistent with each other.
+        HdrHistogram histogram(*item.second);
+        for (const auto& quantile : QUANTILES){
+            str += with_labels(name, labels, std::string("quantile=\"") + quantile.first + "\"");
+            str += " " + std::to_string(histogram.percentile(quantile.second)) + "\n";
+        }
+        str += with_labels(name + "_sum", labels) + " " + std::to_string(histogram.sum()) + "\n";
+        str += with_labels(name + "_count", labels) + " " + std::to_string(histogram.count()) + "\n";
+    }
+
+    return str;
+}
+JsonValue MetricsRegistry::to_json() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    JsonArray counters;
+    for (const auto& item : m_counters){
+        JsonObject obj;
+        obj["Name"] = item.first.first;
+        obj["Labels"] = item.first.second;
+        obj["Value"] = item.second->load(std::memory_order_relaxed);
+        counters.push_back(std::move(obj));
+    }
+
+    JsonArray histograms;
+    for (const auto& item : m_histograms){
+        HdrHistogram histogram(*item.second);
+        JsonObject obj;
+        obj["Name"] = item.first.first;
+        obj["Labels"] = item.first.second;
+        obj["Count"] = histogram.count();
+        obj["Sum"] = histogram.sum();
+        obj["Min"] = histogram.min();
+        obj["Max"] = histogram.max();
+        obj["Mean"] = histogram.mean();
+        obj["P50"] = histogram.percentile(0.50);
+        obj["P90"] = histogram.percentile(0.90);
+        obj["P99"] = histogram.percentile(0.99);
+        obj["P999"] = histogram.percentile(0.999);
+        histograms.push_back(std::move(obj));
+    }
+
+    JsonObject root;
+    root["Counters"] = std::move(counters);
+    root["Histograms"] = std::move(histograms);
+    return root;
+}
+void MetricsRegistry::write_snapshot(const std::string& path_prefix) const{
+    //  Both files are written to a temporary file and renamed over the old
+    //  one. So readers never see a partial file or a missing one.
+    {
+        std::string str = to_prometheus();
+        QSaveFile file(QString::fromStdString(path_prefix + ".prom"));
+        if (file.open(QFile::WriteOnly) && file.write(str.data(), str.size()) == (qint64)str.size()){
+            file.commit();
+        }
+    }
+
+    //  "string_to_file()" does the same.
+    try{
+        to_json().dump(path_prefix + ".json");
+    }catch (FileException&){}
+}
+
+
+
+void MetricsRegistry::start_export(std::string path_prefix, std::chrono::milliseconds period){
+    stop_export();
+    m_path_prefix = std::move(path_prefix);
+    m_period = period;
+    m_stopping = false;
+    m_thread = std::thread(run_with_catch, "MetricsRegistry::export_thread()", [this]{ export_thread(); });
+}
+void MetricsRegistry::stop_export(){
+    if (!m_thread.joinable()){
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    write_snapshot(m_path_prefix);
+}
+void MetricsRegistry::export_thread(){
+    while (true){
+        {
+            std::unique_lock<std::mutex> lg(m_sleep_lock);
+            if (m_stopping){
+                return;
+            }
+            m_cv.wait_for(lg, m_period);
+            if (m_stopping){
+                return;
+            }
+        }
+        write_snapshot(m_path_prefix);
+    }
+}
+
+
+
+}
@@ -0,0 +1,91 @@
+/*  Metrics Registry
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A process-wide list of named counters and histograms that can be
+ *  written out as a snapshot file. Once the export thread is started, it
+ *  periodically writes the snapshot both in the Prometheus text format
+ *  ("<prefix>.prom") and as JSON ("<prefix>.json").
+ *
+ *  Metrics are looked up by name once and then updated directly. Nothing on
+ *  the hot path touches the registry itself.
+ *
+ *  A metric is identified by its name and its labels. The labels are in the
+ *  Prometheus format without the braces. (e.g. 'port="COM3"')
+ *
+ */
+
+#ifndef PokemonAutomation_MetricsRegistry_H
+#define PokemonAutomation_MetricsRegistry_H
+
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include "HdrHistogram.h"
+
+namespace PokemonAutomation{
+
+class JsonValue;
+
+
+class MetricsRegistry{
+public:
+    using Counter = std::atomic<uint64_t>;
+
+public:
+    static MetricsRegistry& instance();
+
+    //  Returns 'key="value"' with "value" escaped.
+    static std::string label(const std::string& key, const std::string& value);
+
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    //  Returns the metric with this name and labels. It is created if it
+    //  doesn't exist yet.
+    std::shared_ptr<Counter> counter(const std::string& name, const std::string& labels = "");
+    std::shared_ptr<HdrHistogram> histogram(const std::string& name, const std::string& labels = "");
+
+    //  Export a histogram that is owned by something else. Replaces any
+    //  existing histogram with the same name and labels.
+    void add_histogram(const std::string& name, const std::string& labels, std::shared_ptr<HdrHistogram> histogram);
+
+    std::string to_prometheus() const;
+    JsonValue to_json() const;
+    void write_snapshot(const std::string& path_prefix) const;
+
+    //  Write a snapshot every "period" until "stop_export()" is called.
+    //  Also writes one last snapshot when stopped.
+    void start_export(std::string path_prefix, std::chrono::milliseconds period);
+    void stop_export();
+
+
+private:
+    void export_thread();
+
+
+private:
+    using Key = std::pair<std::string, std::string>;
+
+    mutable std::mutex m_lock;
+    std::map<Key, std::shared_ptr<Counter>> m_counters;
+    std::map<Key, std::shared_ptr<HdrHistogram>> m_histograms;
+
+    std::string m_path_prefix;
+    std::chrono::milliseconds m_period;
+    std::mutex m_sleep_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,248 @@
+/*  Trace Recorder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
+#include "TraceRecorder.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+//
+//  Each buffer has exactly one writer. (the thread that owns it)
+//
+//  The writer bumps "started" before it touches a slot and "finished"
+//  after. A reader copies the slots and then drops everything the writer may
+//  have overwritten in the meantime. This is the ring buffer version of a
+//  seqlock.
+//
+struct TraceRecorder::ThreadBuffer{
+    uint32_t thread;
+    std::atomic<uint64_t> started;
+    std::atomic<uint64_t> finished;
+    TraceEvent events[EVENTS_PER_THREAD];
+
+    ThreadBuffer(uint32_t p_thread)
+        : thread(p_thread)
+        , started(0)
+        , finished(0)
+    {}
+
+    TraceEvent& begin_write(){
+        uint64_t index = started.load(std::memory_order_relaxed);
+        started.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return events[index % EVENTS_PER_THREAD];
+    }
+    void end_write(){
+        finished.store(started.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    void read(std::vector<TraceEvent>& output) const{
+        uint64_t end = finished.load(std::memory_order_acquire);
+        uint64_t start = end < EVENTS_PER_THREAD ? 0 : end - EVENTS_PER_THREAD;
+
+        std::vector<TraceEvent> copy;
+        copy.reserve((size_t)(end - start));
+        for (uint64_t c = start; c < end; c++){
+            copy.emplace_back(events[c % EVENTS_PER_THREAD]);
+        }
+
+        //  Anything the writer started since then may have overwritten the
+        //  oldest slots.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t writes = started.load(std::memory_order_relaxed);
+        uint64_t valid = writes < EVENTS_PER_THREAD ? 0 : writes - EVENTS_PER_THREAD;
+        for (uint64_t c = std::max(start, valid); c < end; c++){
+            output.emplace_back(copy[(size_t)(c - start)]);
+        }
+    }
+};
+
+//  Returns the buffer to the free list when the thread exits so that
+//  short-lived threads don't leak buffers.
+struct TraceRecorder::ThreadHandle{
+    ThreadBuffer* buffer = nullptr;
+
+    ~ThreadHandle(){
+        if (buffer == nullptr){
+            return;
+        }
+        TraceRecorder& recorder = TraceRecorder::instance();
+        std::lock_guard<std::mutex> lg(recorder.m_lock);
+        recorder.m_free_buffers.emplace_back(buffer);
+    }
+};
+
+
+
+TraceRecorder& TraceRecorder::instance(){
+    static TraceRecorder recorder;
+    return recorder;
+}
+TraceRecorder::TraceRecorder()
+    : m_epoch(std::chrono::steady_clock::now())
+    , m_enabled(false)
+    , m_next_id(1)
+    , m_next_thread(1)
+{}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::thread_buffer(){
+    thread_local ThreadHandle handle;
+    if (handle.buffer != nullptr){
+        return *handle.buffer;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!m_free_buffers.empty()){
+        handle.buffer = m_free_buffers.back();
+        m_free_buffers.pop_back();
+        handle.buffer->thread = m_next_thread++;
+    }else{
+        m_buffers.emplace_back(new ThreadBuffer(m_next_thread++));
+        handle.buffer = m_buffers.back().get();
+    }
+    return *handle.buffer;
+}
+
+void TraceRecorder::record(
+    char phase, const char* category, const char* name,
+    uint64_t start_us, uint64_t duration_us,
+    uint64_t id,
+    const char* detail,
+    bool has_value, uint64_t value
+){
+    ThreadBuffer& buffer = thread_buffer();
+    TraceEvent& event = buffer.begin_write();
+    event.category = category;
+    event.name = name;
+    event.start_us = start_us;
+    event.duration_us = duration_us;
+    event.id = id;
+    event.value = value;
+    event.thread = buffer.thread;
+    event.phase = phase;
+    event.has_value = has_value;
+    if (detail == nullptr){
+        event.detail[0] = '\0';
+    }else{
+        size_t length = strnlen(detail, TraceEvent::MAX_DETAIL);
+        memcpy(event.detail, detail, length);
+        event.detail[length] = '\0';
+    }
+    buffer.end_write();
+}
+
+
+
+std::vector<TraceEvent> TraceRecorder::events() const{
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers){
+            buffer->read(events);
+        }
+    }
+    std::stable_sort(
+        events.begin(), events.end(),
+        [](const TraceEvent& x, const TraceEvent& y){
+            return x.start_us < y.start_us;
+        }
+    );
+    return events;
+}
+
+static void append_json_string(std::string& str, const char* value){
+    str += '"';
+    for (const char* ptr = value; *ptr != '\0'; ptr++){
+        char ch = *ptr;
+        switch (ch){
+        case '"':
+            str += "\\\"";
+            break;
+        case '\\':
+            str += "\\\\";
+            break;
+        default:
+            if ((unsigned char)ch < 0x20){
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned char)ch);
+                str += buffer;
+            }else{
+                str += ch;
+            }
+        }
+    }
+    str += '"';
+}
+
+std::string TraceRecorder::to_chrome_json() const{
+    std::vector<TraceEvent> events = this->events();
+
+    std::string str = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const TraceEvent& event : events){
+        if (!first){
+            str += ",\n";
+        }
+        first = false;
+
+        str += "{\"ph\":\"";
+        str += event.phase;
+        str += "\",\"cat\":";
+        append_json_string(str, event.category);
+        str += ",\"name\":";
+        append_json_string(str, event.name);
+        str += ",\"pid\":1,\"tid\":" + std::to_string(event.thread);
+        str += ",\"ts\":" + std::to_string(event.start_us);
+        switch (event.phase){
+        case 'X':
+            str += ",\"dur\":" + std::to_string(event.duration_us);
+            break;
+        case 'i':
+            str += ",\"s\":\"t\"";
+            break;
+        case 'b':
+        case 'e':
+            str += ",\"id\":\"" + std::to_string(event.id) + "\"";
+            break;
+        }
+        if (event.has_value || event.detail[0] != '\0'){
+            str += ",\"args\":{";
+            if (event.has_value){
+                str += "\"value\":" + std::to_string(event.value);
+            }
+            if (event.detail[0] != '\0'){
+                str += event.has_value ? ",\"detail\":" : "\"detail\":";
+                append_json_string(str, event.detail);
+            }
+            str += "}";
+        }
+        str += "}";
+    }
+    str += "\n]}\n";
+    return str;
+}
+
+bool TraceRecorder::dump(const std::string& path) const{
+    std::string str = to_chrome_json();
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr){
+        return false;
+    }
+    bool ok = fwrite(str.data(), 1, str.size(), file) == str.size();
+    ok &= fclose(file) == 0;
+    return ok;
+}
+
+
+
+}
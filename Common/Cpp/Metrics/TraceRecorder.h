@@ -0,0 +1,171 @@
+/*  Trace Recorder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Lightweight timeline of what each thread was doing. Used to figure out
+ *  which stage of the pipeline (capture, conversion, inference, serial) was
+ *  slow when a program misses something.
+ *
+ *  Each thread records into its own fixed-size ring buffer. So recording an
+ *  event is only a few stores with no locks or allocations. Old events are
+ *  overwritten once the ring is full.
+ *
+ *  Nothing is recorded until "set_enabled(true)" is called.
+ *
+ *  The buffers can be dumped at any time into the Chrome trace event format.
+ *  Open it with "chrome://tracing" or https://ui.perfetto.dev.
+ *
+ *  The category and name must be string literals. (or otherwise outlive the
+ *  recorder) Only the pointers are stored.
+ *
+ */
+
+#ifndef PokemonAutomation_TraceRecorder_H
+#define PokemonAutomation_TraceRecorder_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+namespace PokemonAutomation{
+
+
+struct TraceEvent{
+    static constexpr size_t MAX_DETAIL = 31;
+
+    const char* category;
+    const char* name;
+    uint64_t start_us;
+    uint64_t duration_us;
+    uint64_t id;            //  Matches async begin/end pairs.
+    uint64_t value;
+    uint32_t thread;
+    char phase;             //  Chrome phase: 'X', 'i', 'b' or 'e'.
+    bool has_value;
+    char detail[MAX_DETAIL + 1];
+};
+
+
+class TraceRecorder{
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 4096;
+
+public:
+    static TraceRecorder& instance();
+
+    bool enabled() const{ return m_enabled.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled){ m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    //  Microseconds since the recorder was created.
+    uint64_t now() const{
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_epoch
+        ).count();
+    }
+
+    //  Returns a new unique number. Use it to keep async ids from different
+    //  objects from colliding.
+    uint64_t unique_id(){ return m_next_id.fetch_add(1, std::memory_order_relaxed); }
+
+    void record(
+        char phase, const char* category, const char* name,
+        uint64_t start_us, uint64_t duration_us,
+        uint64_t id = 0,
+        const char* detail = nullptr,
+        bool has_value = false, uint64_t value = 0
+    );
+
+    //  Snapshot of all events still in the buffers sorted by start time.
+    std::vector<TraceEvent> events() const;
+
+    std::string to_chrome_json() const;
+
+    //  Write the trace to "path". Returns false if the file couldn't be written.
+    bool dump(const std::string& path) const;
+
+
+private:
+    struct ThreadBuffer;
+    struct ThreadHandle;
+
+    TraceRecorder();
+    ThreadBuffer& thread_buffer();
+
+
+private:
+    const std::chrono::steady_clock::time_point m_epoch;
+    std::atomic<bool> m_enabled;
+    std::atomic<uint64_t> m_next_id;
+
+    mutable std::mutex m_lock;
+    uint32_t m_next_thread;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::vector<ThreadBuffer*> m_free_buffers;
+};
+
+
+
+//  Records the time from construction to destruction as one event.
+class TraceScope{
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_detail(nullptr)
+        , m_start(TraceRecorder::instance().enabled() ? TraceRecorder::instance().now() : (uint64_t)-1)
+    {}
+    TraceScope(const char* category, const char* name, const std::string& detail)
+        : m_category(category)
+        , m_name(name)
+        , m_detail(detail.c_str())
+        , m_start(TraceRecorder::instance().enabled() ? TraceRecorder::instance().now() : (uint64_t)-1)
+    {}
+    ~TraceScope(){
+        if (m_start == (uint64_t)-1){
+            return;
+        }
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.record('X', m_category, m_name, m_start, recorder.now() - m_start, 0, m_detail);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    void operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    const char* m_detail;
+    uint64_t m_start;
+};
+
+
+inline void trace_instant(const char* category, const char* name, uint64_t value){
+    TraceRecorder& recorder = TraceRecorder::instance();
+    if (recorder.enabled()){
+        recorder.record('i', category, name, recorder.now(), 0, 0, nullptr, true, value);
+    }
+}
+
+//  An interval that may start and end on different threads.
+//  "id" must be the same for the begin and the end.
+inline void trace_async_begin(const char* category, const char* name, uint64_t id, uint64_t value){
+    TraceRecorder& recorder = TraceRecorder::instance();
+    if (recorder.enabled()){
+        recorder.record('b', category, name, recorder.now(), 0, id, nullptr, true, value);
+    }
+}
+inline void trace_async_end(const char* category, const char* name, uint64_t id){
+    TraceRecorder& recorder = TraceRecorder::instance();
+    if (recorder.enabled()){
+        recorder.record('e', category, name, recorder.now(), 0, id);
+    }
+}
+
+
+
+}
+#endif
@@ -76,6 +76,9 @@ public:
 protected:
     virtual void convert(void* out, const void* in, size_t count) = 0;
 
+    //  Bytes of a partial object left over from the last "push_bytes()".
+    size_t pending_bytes() const{ return m_edge_size; }
+
 private:
     size_t m_object_size_in;
     size_t m_object_size_out;
@@ -74,9 +74,14 @@ SOURCES += \
     ../3rdParty/QtWavFile/WavFile.cpp \
     ../3rdParty/TesseractPA/TesseractPA.cpp \
     ../ClientSource/Connection/BotBase.cpp \
+    ../ClientSource/Connection/CommandCoalescing.cpp \
+    ../ClientSource/Connection/LoopbackDevice.cpp \
     ../ClientSource/Connection/MessageLogger.cpp \
     ../ClientSource/Connection/PABotBase.cpp \
     ../ClientSource/Connection/PABotBaseConnection.cpp \
+    ../ClientSource/Connection/SerialReactorPOSIX.cpp \
+    ../ClientSource/Connection/WireTrace.cpp \
+    ../ClientSource/Connection/WireTraceDecoder.cpp \
     ../ClientSource/Libraries/Logging.cpp \
     ../ClientSource/Libraries/MessageConverter.cpp \
     ../Common/CRC32.cpp \
@@ -98,6 +103,9 @@ SOURCES += \
     ../Common/Cpp/Json/JsonTools.cpp \
     ../Common/Cpp/Json/JsonValue.cpp \
     ../Common/Cpp/LifetimeSanitizer.cpp \
+    ../Common/Cpp/Metrics/HdrHistogram.cpp \
+    ../Common/Cpp/Metrics/MetricsRegistry.cpp \
+    ../Common/Cpp/Metrics/TraceRecorder.cpp \
     ../Common/Cpp/Options/BatchOption.cpp \
     ../Common/Cpp/Options/BooleanCheckBoxOption.cpp \
     ../Common/Cpp/Options/ConfigOption.cpp \
@@ -154,10 +162,13 @@ SOURCES += \
     Source/CommonFramework/AudioPipeline/AudioTemplate.cpp \
     Source/CommonFramework/AudioPipeline/Backends/AudioPassthroughPairQt.cpp \
     Source/CommonFramework/AudioPipeline/Backends/AudioPassthroughPairQtThread.cpp \
+    Source/CommonFramework/AudioPipeline/IO/AudioFileAnalyzer.cpp \
+    Source/CommonFramework/AudioPipeline/IO/AudioFileDecoder.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioFileLoader.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioSink.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioSource.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.cpp \
+    Source/CommonFramework/AudioPipeline/Spectrum/FFTGeometry.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp \
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.cpp \
@@ -190,6 +201,7 @@ SOURCES += \
     Source/CommonFramework/ImageMatch/SubObjectTemplateMatcher.cpp \
     Source/CommonFramework/ImageMatch/WaterfillTemplateMatcher.cpp \
     Source/CommonFramework/ImageTools/BinaryImage_FilterRgb32.cpp \
+    Source/CommonFramework/ImageTools/BinaryMatrixCache.cpp \
     Source/CommonFramework/ImageTools/ColorClustering.cpp \
     Source/CommonFramework/ImageTools/FloatPixel.cpp \
     Source/CommonFramework/ImageTools/ImageBoxes.cpp \
@@ -197,6 +209,7 @@ SOURCES += \
     Source/CommonFramework/ImageTools/ImageGradient.cpp \
     Source/CommonFramework/ImageTools/ImageManip.cpp \
     Source/CommonFramework/ImageTools/ImageStats.cpp \
+    Source/CommonFramework/ImageTools/ImageStatsCache.cpp \
     Source/CommonFramework/ImageTools/SolidColorTest.cpp \
     Source/CommonFramework/ImageTools/WaterfillUtilities.cpp \
     Source/CommonFramework/ImageTypes/BinaryImage.cpp \
@@ -234,6 +247,7 @@ SOURCES += \
     Source/CommonFramework/Notifications/SenderNotificationTable.cpp \
     Source/CommonFramework/OCR/OCR_DictionaryMatcher.cpp \
     Source/CommonFramework/OCR/OCR_DictionaryOCR.cpp \
+    Source/CommonFramework/OCR/OCR_GlyphClassifier.cpp \
     Source/CommonFramework/OCR/OCR_LargeDictionaryMatcher.cpp \
     Source/CommonFramework/OCR/OCR_NumberReader.cpp \
     Source/CommonFramework/OCR/OCR_RawOCR.cpp \
@@ -263,6 +277,7 @@ SOURCES += \
     Source/CommonFramework/Panels/UI/PanelWidget.cpp \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.cpp \
     Source/CommonFramework/PersistentSettings.cpp \
+    Source/CommonFramework/PersistentSettingsWriter.cpp \
     Source/CommonFramework/ProgramSession.cpp \
     Source/CommonFramework/Resources/SpriteDatabase.cpp \
     Source/CommonFramework/SetupSettings.cpp \
@@ -283,15 +298,19 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt5.cpp \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.cpp \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.cpp \
+    Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt6.cpp \
     Source/CommonFramework/VideoPipeline/CameraOption.cpp \
+    Source/CommonFramework/VideoPipeline/LazyVideoFrame.cpp \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.cpp \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWindow.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoOverlayWidget.cpp \
+    Source/CommonFramework/VideoPipeline/VideoFeed.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayOption.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlaySession.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayTypes.cpp \
+    Source/CommonFramework/VideoPipeline/VideoRecordingRing.cpp \
     Source/CommonFramework/Windows/ButtonDiagram.cpp \
     Source/CommonFramework/Windows/DpiScaler.cpp \
     Source/CommonFramework/Windows/MainWindow.cpp \
@@ -318,6 +337,8 @@ SOURCES += \
     Source/Kernels/Algorithm/Kernels_Algorithm_DisjointSet.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_Default.cpp \
+    Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_x86_AVX2.cpp \
+    Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_x86_AVX512.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_x86_SSE41.cpp \
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.cpp \
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters_Core_64x16_x64_AVX2.cpp \
@@ -339,6 +360,11 @@ SOURCES += \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX2.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX512.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_SSE42.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_Default.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX2.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX512.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_SSE41.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_Default.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_arm64_NEON.cpp \
@@ -351,6 +377,9 @@ SOURCES += \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_x64_AVX2.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_x64_AVX512.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrIntegral.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrIntegral_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrIntegral_x64_SSE41.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_Default.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX2.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX512.cpp \
@@ -519,6 +548,7 @@ SOURCES += \
     Source/PokemonHome/PokemonHome_Panels.cpp \
     Source/PokemonHome/PokemonHome_Settings.cpp \
     Source/PokemonHome/Programs/PokemonHome_BoxSorting.cpp \
+    Source/PokemonHome/Programs/PokemonHome_BoxSortingPlanner.cpp \
     Source/PokemonHome/Programs/PokemonHome_GenerateNameOCR.cpp \
     Source/PokemonHome/Programs/PokemonHome_PageSwap.cpp \
     Source/PokemonLA/Inference/Battles/PokemonLA_BattleMenuDetector.cpp \
@@ -718,6 +748,7 @@ SOURCES += \
     Source/PokemonSV/Programs/TeraRaids/PokemonSV_TeraRoutines.cpp \
     Source/PokemonSV/Programs/TeraRaids/PokemonSV_TeraSelfFarmer.cpp \
     Source/PokemonSV/Programs/TestPrograms/PokemonSV_SoundListener.cpp \
+    Source/PokemonSV/Programs/TestPrograms/PokemonSV_TrainTeraCodeOCR.cpp \
     Source/PokemonSV/Programs/Trading/PokemonSV_SelfBoxTrade.cpp \
     Source/PokemonSV/Programs/Trading/PokemonSV_TradeRoutines.cpp \
     Source/PokemonSV/Resources/PokemonSV_AuctionItemNames.cpp \
@@ -766,6 +797,7 @@ SOURCES += \
     Source/PokemonSwSh/InferenceTraining/PokemonSwSh_GenerateNameOCRPokedex.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.cpp \
+    Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathSearch.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_SelectItem.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_SelectMove.cpp \
@@ -916,6 +948,7 @@ SOURCES += \
     Source/Tests/CommonFramework_Tests.cpp \
     Source/Tests/Kernels_Tests.cpp \
     Source/Tests/NintendoSwitch_Tests.cpp \
+    Source/Tests/PokemonHome_Tests.cpp \
     Source/Tests/PokemonLA_Tests.cpp \
     Source/Tests/PokemonSV_Tests.cpp \
     Source/Tests/PokemonSwSh_Tests.cpp \
@@ -1001,6 +1034,8 @@ HEADERS += \
     ../3rdParty/nlohmann/json.hpp \
     ../ClientSource/Connection/BotBase.h \
     ../ClientSource/Connection/BotBaseMessage.h \
+    ../ClientSource/Connection/CommandCoalescing.h \
+    ../ClientSource/Connection/LoopbackDevice.h \
     ../ClientSource/Connection/MessageLogger.h \
     ../ClientSource/Connection/MessageSniffer.h \
     ../ClientSource/Connection/PABotBase.h \
@@ -1008,7 +1043,10 @@ HEADERS += \
     ../ClientSource/Connection/SerialConnection.h \
     ../ClientSource/Connection/SerialConnectionPOSIX.h \
     ../ClientSource/Connection/SerialConnectionWinAPI.h \
+    ../ClientSource/Connection/SerialReactorPOSIX.h \
     ../ClientSource/Connection/StreamInterface.h \
+    ../ClientSource/Connection/WireTrace.h \
+    ../ClientSource/Connection/WireTraceDecoder.h \
     ../ClientSource/Libraries/Logging.h \
     ../ClientSource/Libraries/MessageConverter.h \
     ../Common/CRC32.h \
@@ -1047,6 +1085,9 @@ HEADERS += \
     ../Common/Cpp/Json/JsonTools.h \
     ../Common/Cpp/Json/JsonValue.h \
     ../Common/Cpp/LifetimeSanitizer.h \
+    ../Common/Cpp/Metrics/HdrHistogram.h \
+    ../Common/Cpp/Metrics/MetricsRegistry.h \
+    ../Common/Cpp/Metrics/TraceRecorder.h \
     ../Common/Cpp/Options/BatchOption.h \
     ../Common/Cpp/Options/BooleanCheckBoxOption.h \
     ../Common/Cpp/Options/ConfigOption.h \
@@ -1127,10 +1168,13 @@ HEADERS += \
     Source/CommonFramework/AudioPipeline/AudioTemplate.h \
     Source/CommonFramework/AudioPipeline/Backends/AudioPassthroughPairQt.h \
     Source/CommonFramework/AudioPipeline/Backends/AudioPassthroughPairQtThread.h \
+    Source/CommonFramework/AudioPipeline/IO/AudioFileAnalyzer.h \
+    Source/CommonFramework/AudioPipeline/IO/AudioFileDecoder.h \
     Source/CommonFramework/AudioPipeline/IO/AudioFileLoader.h \
     Source/CommonFramework/AudioPipeline/IO/AudioSink.h \
     Source/CommonFramework/AudioPipeline/IO/AudioSource.h \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.h \
+    Source/CommonFramework/AudioPipeline/Spectrum/FFTGeometry.h \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.h \
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.h \
@@ -1176,6 +1220,7 @@ HEADERS += \
     Source/CommonFramework/ImageMatch/SubObjectTemplateMatcher.h \
     Source/CommonFramework/ImageMatch/WaterfillTemplateMatcher.h \
     Source/CommonFramework/ImageTools/BinaryImage_FilterRgb32.h \
+    Source/CommonFramework/ImageTools/BinaryMatrixCache.h \
     Source/CommonFramework/ImageTools/ColorClustering.h \
     Source/CommonFramework/ImageTools/DistanceToLine.h \
     Source/CommonFramework/ImageTools/FloatPixel.h \
@@ -1184,6 +1229,7 @@ HEADERS += \
     Source/CommonFramework/ImageTools/ImageGradient.h \
     Source/CommonFramework/ImageTools/ImageManip.h \
     Source/CommonFramework/ImageTools/ImageStats.h \
+    Source/CommonFramework/ImageTools/ImageStatsCache.h \
     Source/CommonFramework/ImageTools/SolidColorTest.h \
     Source/CommonFramework/ImageTools/WaterfillUtilities.h \
     Source/CommonFramework/ImageTypes/BinaryImage.h \
@@ -1227,6 +1273,7 @@ HEADERS += \
     Source/CommonFramework/Notifications/SenderNotificationTable.h \
     Source/CommonFramework/OCR/OCR_DictionaryMatcher.h \
     Source/CommonFramework/OCR/OCR_DictionaryOCR.h \
+    Source/CommonFramework/OCR/OCR_GlyphClassifier.h \
     Source/CommonFramework/OCR/OCR_LargeDictionaryMatcher.h \
     Source/CommonFramework/OCR/OCR_NumberReader.h \
     Source/CommonFramework/OCR/OCR_RawOCR.h \
@@ -1258,6 +1305,7 @@ HEADERS += \
     Source/CommonFramework/Panels/UI/PanelWidget.h \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.h \
     Source/CommonFramework/PersistentSettings.h \
+    Source/CommonFramework/PersistentSettingsWriter.h \
     Source/CommonFramework/ProgramSession.h \
     Source/CommonFramework/Resources/SpriteDatabase.h \
     Source/CommonFramework/SetupSettings.h \
@@ -1278,9 +1326,11 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt5.h \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.h \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.h \
+    Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt6.h \
     Source/CommonFramework/VideoPipeline/CameraInfo.h \
     Source/CommonFramework/VideoPipeline/CameraOption.h \
     Source/CommonFramework/VideoPipeline/CameraSession.h \
+    Source/CommonFramework/VideoPipeline/LazyVideoFrame.h \
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.h \
@@ -1294,6 +1344,7 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/VideoOverlayScopes.h \
     Source/CommonFramework/VideoPipeline/VideoOverlaySession.h \
     Source/CommonFramework/VideoPipeline/VideoOverlayTypes.h \
+    Source/CommonFramework/VideoPipeline/VideoRecordingRing.h \
     Source/CommonFramework/Windows/ButtonDiagram.h \
     Source/CommonFramework/Windows/DpiScaler.h \
     Source/CommonFramework/Windows/MainWindow.h \
@@ -1357,9 +1408,12 @@ HEADERS += \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_Routines.h \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrIntegral.h \
     Source/Kernels/Kernels_Alignment.h \
     Source/Kernels/Kernels_BitScan.h \
     Source/Kernels/Kernels_BitSet.h \
@@ -1543,6 +1597,7 @@ HEADERS += \
     Source/PokemonHome/PokemonHome_Panels.h \
     Source/PokemonHome/PokemonHome_Settings.h \
     Source/PokemonHome/Programs/PokemonHome_BoxSorting.h \
+    Source/PokemonHome/Programs/PokemonHome_BoxSortingPlanner.h \
     Source/PokemonHome/Programs/PokemonHome_GenerateNameOCR.h \
     Source/PokemonHome/Programs/PokemonHome_PageSwap.h \
     Source/PokemonLA/Inference/Battles/PokemonLA_BattleMenuDetector.h \
@@ -1744,6 +1799,7 @@ HEADERS += \
     Source/PokemonSV/Programs/TeraRaids/PokemonSV_TeraRoutines.h \
     Source/PokemonSV/Programs/TeraRaids/PokemonSV_TeraSelfFarmer.h \
     Source/PokemonSV/Programs/TestPrograms/PokemonSV_SoundListener.h \
+    Source/PokemonSV/Programs/TestPrograms/PokemonSV_TrainTeraCodeOCR.h \
     Source/PokemonSV/Programs/Trading/PokemonSV_SelfBoxTrade.h \
     Source/PokemonSV/Programs/Trading/PokemonSV_TradeRoutines.h \
     Source/PokemonSV/Resources/PokemonSV_AuctionItemNames.h \
@@ -1799,6 +1855,7 @@ HEADERS += \
     Source/PokemonSwSh/InferenceTraining/PokemonSwSh_GenerateNameOCRPokedex.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.h \
+    Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathSearch.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Tools.h \
     Source/PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_CatchScreenTracker.h \
@@ -1923,6 +1980,7 @@ HEADERS += \
     Source/PokemonSwSh/Programs/RNG/PokemonSwSh_CramomaticRNG.h \
     Source/PokemonSwSh/Programs/RNG/PokemonSwSh_SeedFinder.h \
     Source/PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128Plus.h \
+    Source/PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128PlusLanes.h \
     Source/PokemonSwSh/Programs/ReleaseHelpers.h \
     Source/PokemonSwSh/Programs/ShinyHuntAutonomous/PokemonSwSh_ShinyHuntAutonomous-BerryTree.h \
     Source/PokemonSwSh/Programs/ShinyHuntAutonomous/PokemonSwSh_ShinyHuntAutonomous-Fishing.h \
@@ -1953,6 +2011,7 @@ HEADERS += \
     Source/Tests/CommonFramework_Tests.h \
     Source/Tests/Kernels_Tests.h \
     Source/Tests/NintendoSwitch_Tests.h \
+    Source/Tests/PokemonHome_Tests.h \
     Source/Tests/PokemonLA_Tests.h \
     Source/Tests/PokemonSV_Tests.h \
     Source/Tests/PokemonSwSh_Tests.h \
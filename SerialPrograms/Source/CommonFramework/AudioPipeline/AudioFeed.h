@@ -11,6 +11,7 @@
 #include <vector>
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Containers/AlignedVector.h"
+#include "Spectrum/FFTGeometry.h"
 
 namespace PokemonAutomation{
 
@@ -52,7 +53,25 @@ public:
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) = 0;
 
+    //  Start/stop computing the spectrums of a non-default "geometry". Calls
+    //  are counted. The geometry is dropped when the last listener is removed.
+    virtual void add_geometry_listener(const FFTGeometry&){}
+    virtual void remove_geometry_listener(const FFTGeometry&){}
+
+    //  Same as above, but for the spectrums of "geometry". The stamps are
+    //  separate for each geometry.
+    //  By default, only the default geometry is supported. Anything else
+    //  returns nothing. A non-default geometry returns nothing unless it has
+    //  a listener.
+    virtual std::vector<AudioSpectrum> geometry_spectrums_since(const FFTGeometry& geometry, uint64_t starting_seqnum){
+        return geometry.is_default() ? spectrums_since(starting_seqnum) : std::vector<AudioSpectrum>();
+    }
+    virtual std::vector<AudioSpectrum> geometry_spectrums_latest(const FFTGeometry& geometry, size_t num_last_spectrums){
+        return geometry.is_default() ? spectrums_latest(num_last_spectrums) : std::vector<AudioSpectrum>();
+    }
+
     //  Add visual overlay to the spectrums starting at `starting_stamp` and before `end_stamp` with `color`.
+    //  The stamps are those of the default geometry.
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) = 0;
 };
 
@@ -12,19 +12,21 @@
 namespace PokemonAutomation{
 
 struct FFTListener;
+struct FFTGeometry;
 
 
 //  Represents an audio source/sink pair where audio is passed through from
 //  source -> sink with minimal latency.
 //
-//  If desired, listeners can be attached to receive the FFT spectrums.
+//  If desired, listeners can be attached to receive the FFT spectrums. Each
+//  listener picks the FFT geometry it wants.
 //
 //  This class is fully thread-safe. Both source and sink can be changed
 //  asynchronously. Listeners can be attached/detached asynchronously.
 //
 class AudioPassthroughPair{
 public:
-    virtual void add_listener(FFTListener& listener) = 0;
+    virtual void add_listener(FFTListener& listener, const FFTGeometry& geometry) = 0;
     virtual void remove_listener(FFTListener& listener) = 0;
 
 public:
@@ -4,6 +4,7 @@
  *
  */
 
+#include <list>
 #include "Common/Cpp/AbstractLogger.h"
 #include "CommonFramework/GlobalServices.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
@@ -18,6 +19,56 @@ namespace PokemonAutomation{
 
 
 
+//  History of the spectrums of one non-default geometry. Same interface as
+//  the spectrum holder, but without anything for the display.
+class AudioSession::GeometryFeed final : public FFTListener{
+public:
+    static constexpr size_t HISTORY_LENGTH = 40;
+
+    //  Protected by AudioSession::m_geometry_lock.
+    size_t listeners = 0;
+
+    //  Stamps keep counting up so readers never see one twice.
+    void clear(){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_spectrums.clear();
+    }
+    virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override{
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_spectrums.emplace_front(m_next_stamp++, sample_rate, std::move(fft_output));
+        if (m_spectrums.size() > HISTORY_LENGTH){
+            m_spectrums.pop_back();
+        }
+    }
+
+    std::vector<AudioSpectrum> spectrums_since(uint64_t starting_stamp){
+        std::vector<AudioSpectrum> spectrums;
+        std::lock_guard<std::mutex> lg(m_lock);
+        for (const AudioSpectrum& spectrum : m_spectrums){
+            if (spectrum.stamp < starting_stamp){
+                break;
+            }
+            spectrums.emplace_back(spectrum);
+        }
+        return spectrums;
+    }
+    std::vector<AudioSpectrum> spectrums_latest(size_t num_latest_spectrums){
+        std::vector<AudioSpectrum> spectrums;
+        std::lock_guard<std::mutex> lg(m_lock);
+        for (const AudioSpectrum& spectrum : m_spectrums){
+            if (spectrums.size() == num_latest_spectrums){
+                break;
+            }
+            spectrums.emplace_back(spectrum);
+        }
+        return spectrums;
+    }
+
+private:
+    std::mutex m_lock;
+    uint64_t m_next_stamp = 0;
+    std::list<AudioSpectrum> m_spectrums;
+};
 
 
 
@@ -44,12 +95,15 @@ AudioSession::AudioSession(Logger& logger, AudioOption& option)
      , m_devices(new AudioPassthroughPairQtThread(logger))
 {
     AudioSession::reset();
-    m_devices->add_listener(*this);
+    m_devices->add_listener(*this, FFTGeometry());
     global_watchdog().add(*this, std::chrono::seconds(5));
 }
 AudioSession::~AudioSession(){
     global_watchdog().remove(*this);
     m_devices->remove_listener(*this);
+    for (auto& item : m_geometry_feeds){
+        m_devices->remove_listener(*item.second);
+    }
 }
 
 
@@ -115,6 +169,12 @@ void AudioSession::clear_audio_input(){
     std::lock_guard<std::mutex> lg(m_lock);
     m_logger.log("Clearing audio input...");
     m_spectrum_holder.clear();
+    {
+        std::lock_guard<std::mutex> lg1(m_geometry_lock);
+        for (auto& item : m_geometry_feeds){
+            item.second->clear();
+        }
+    }
     m_devices->clear_audio_source();
     m_option.m_input_file.clear();
     m_option.m_input_device = AudioDeviceInfo();
@@ -248,6 +308,63 @@ std::vector<AudioSpectrum> AudioSession::spectrums_since(uint64_t starting_seqnu
 std::vector<AudioSpectrum> AudioSession::spectrums_latest(size_t num_last_spectrums){
     return m_spectrum_holder.spectrums_latest(num_last_spectrums);
 }
+void AudioSession::add_geometry_listener(const FFTGeometry& geometry){
+    if (geometry.is_default()){
+        return;
+    }
+    std::lock_guard<std::mutex> lg(m_geometry_lock);
+    auto iter = m_geometry_feeds.find(geometry);
+    if (iter == m_geometry_feeds.end()){
+        geometry.validate();
+        m_logger.log("Starting FFT geometry: " + geometry.to_string());
+        iter = m_geometry_feeds.emplace(geometry, std::make_shared<GeometryFeed>()).first;
+        try{
+            m_devices->add_listener(*iter->second, geometry);
+        }catch (...){
+            m_geometry_feeds.erase(iter);
+            throw;
+        }
+    }
+    iter->second->listeners++;
+}
+void AudioSession::remove_geometry_listener(const FFTGeometry& geometry){
+    if (geometry.is_default()){
+        return;
+    }
+    std::lock_guard<std::mutex> lg(m_geometry_lock);
+    auto iter = m_geometry_feeds.find(geometry);
+    if (iter == m_geometry_feeds.end()){
+        return;
+    }
+    if (--iter->second->listeners != 0){
+        return;
+    }
+    m_logger.log("Stopping FFT geometry: " + geometry.to_string());
+    m_devices->remove_listener(*iter->second);
+    m_geometry_feeds.erase(iter);
+}
+std::shared_ptr<AudioSession::GeometryFeed> AudioSession::geometry_feed(const FFTGeometry& geometry){
+    std::lock_guard<std::mutex> lg(m_geometry_lock);
+    auto iter = m_geometry_feeds.find(geometry);
+    if (iter == m_geometry_feeds.end()){
+        return nullptr;
+    }
+    return iter->second;
+}
+std::vector<AudioSpectrum> AudioSession::geometry_spectrums_since(const FFTGeometry& geometry, uint64_t starting_seqnum){
+    if (geometry.is_default()){
+        return m_spectrum_holder.spectrums_since(starting_seqnum);
+    }
+    std::shared_ptr<GeometryFeed> feed = geometry_feed(geometry);
+    return feed ? feed->spectrums_since(starting_seqnum) : std::vector<AudioSpectrum>();
+}
+std::vector<AudioSpectrum> AudioSession::geometry_spectrums_latest(const FFTGeometry& geometry, size_t num_last_spectrums){
+    if (geometry.is_default()){
+        return m_spectrum_holder.spectrums_latest(num_last_spectrums);
+    }
+    std::shared_ptr<GeometryFeed> feed = geometry_feed(geometry);
+    return feed ? feed->spectrums_latest(num_last_spectrums) : std::vector<AudioSpectrum>();
+}
 void AudioSession::add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color){
     m_spectrum_holder.add_overlay(starting_seqnum, end_seqnum, color);
 }
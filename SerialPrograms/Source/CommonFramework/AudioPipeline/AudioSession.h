@@ -16,6 +16,7 @@
 #ifndef PokemonAutomation_AudioPipeline_AudioSession_H
 #define PokemonAutomation_AudioPipeline_AudioSession_H
 
+#include <map>
 #include "Common/Cpp/Concurrency/Watchdog.h"
 #include "AudioFeed.h"
 #include "AudioPassthroughPair.h"
@@ -73,10 +74,20 @@ public:
     virtual void reset() override;
     virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) override;
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override;
+    virtual void add_geometry_listener(const FFTGeometry& geometry) override;
+    virtual void remove_geometry_listener(const FFTGeometry& geometry) override;
+    virtual std::vector<AudioSpectrum> geometry_spectrums_since(const FFTGeometry& geometry, uint64_t starting_seqnum) override;
+    virtual std::vector<AudioSpectrum> geometry_spectrums_latest(const FFTGeometry& geometry, size_t num_last_spectrums) override;
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override;
 
 
 private:
+    class GeometryFeed;
+
+    //  Returns the spectrums of a non-default geometry. Null if it has no
+    //  listeners.
+    std::shared_ptr<GeometryFeed> geometry_feed(const FFTGeometry& geometry);
+
     virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override;
     virtual void on_watchdog_timeout() override;
 
@@ -93,6 +104,9 @@ private:
 
     mutable std::mutex m_lock;
     std::set<Listener*> m_listeners;
+
+    std::mutex m_geometry_lock;
+    std::map<FFTGeometry, std::shared_ptr<GeometryFeed>> m_geometry_feeds;
 };
 
 
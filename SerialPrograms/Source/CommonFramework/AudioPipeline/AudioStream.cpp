@@ -69,6 +69,7 @@ AudioStreamToFloat::AudioStreamToFloat(
     , m_samples_per_frame(samples_per_frame)
     , m_volume_multiplier(volume_multiplier)
     , m_reverse_channels(reverse_channels)
+    , m_passthrough(input_format == AudioSampleFormat::FLOAT32 && volume_multiplier == 1.0 && !reverse_channels)
     , m_sample_size(sample_size(input_format))
     , m_frame_size(m_sample_size * samples_per_frame)
 {
@@ -80,53 +81,53 @@ AudioStreamToFloat::AudioStreamToFloat(
     }
     MisalignedStreamConverter::add_listener(*this);
 }
+void AudioStreamToFloat::push_bytes(const void* data, size_t bytes){
+    if (m_passthrough && pending_bytes() == 0 && (size_t)data % alignof(float) == 0){
+        size_t frames = bytes / m_frame_size;
+        if (frames > 0){
+            on_objects(data, frames);
+            data = (const char*)data + frames * m_frame_size;
+            bytes -= frames * m_frame_size;
+        }
+    }
+    MisalignedStreamConverter::push_bytes(data, bytes);
+}
 void AudioStreamToFloat::on_objects(const void* data, size_t objects){
     for (AudioFloatStreamListener* listener : m_listeners){
         listener->on_samples((const float*)data, objects);
     }
 }
 void AudioStreamToFloat::convert(void* out, const void* in, size_t count){
+    //  Volume and channel reversal are done in the same pass as the format
+    //  conversion.
     switch (m_format){
     case AudioSampleFormat::UINT8:
         Kernels::AudioStreamConversion::convert_audio_uint8_to_float(
-            (float*)out, (const uint8_t*)in, count * m_samples_per_frame, m_volume_multiplier
+            (float*)out, (const uint8_t*)in, count * m_samples_per_frame, m_volume_multiplier, m_reverse_channels
         );
         break;
     case AudioSampleFormat::SINT16:
         Kernels::AudioStreamConversion::convert_audio_sint16_to_float(
-            (float*)out, (const int16_t*)in, count * m_samples_per_frame, m_volume_multiplier
+            (float*)out, (const int16_t*)in, count * m_samples_per_frame, m_volume_multiplier, m_reverse_channels
         );
         break;
     case AudioSampleFormat::SINT32:
         Kernels::AudioStreamConversion::convert_audio_sint32_to_float(
-            (float*)out, (const int32_t*)in, count * m_samples_per_frame, m_volume_multiplier
+            (float*)out, (const int32_t*)in, count * m_samples_per_frame, m_volume_multiplier, m_reverse_channels
         );
         break;
     case AudioSampleFormat::FLOAT32:
-        if (m_volume_multiplier == 1.0){
+        if (m_passthrough){
             memcpy(out, in, count * m_frame_size);
         }else{
-            float volume_multiplier = m_volume_multiplier;
-            float* o = (float*)out;
-            const float* i = (float*)in;
-            size_t stop = count * m_samples_per_frame;
-            for (size_t c = 0; c < stop; c++){
-                o[c] = i[c] * volume_multiplier;
-            }
+            Kernels::AudioStreamConversion::convert_audio_float_to_float(
+                (float*)out, (const float*)in, count * m_samples_per_frame, m_volume_multiplier, m_reverse_channels
+            );
         }
         break;
     case AudioSampleFormat::INVALID:
         break;
     }
-    if (m_reverse_channels){
-        float* ptr = (float*)out;
-        for (size_t c = 0; c < count; c++){
-            float r0 = ptr[2*c + 0];
-            float r1 = ptr[2*c + 1];
-            ptr[2*c + 0] = r1;
-            ptr[2*c + 1] = r0;
-        }
-    }
 }
 
 
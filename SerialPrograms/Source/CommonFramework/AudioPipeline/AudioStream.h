@@ -42,7 +42,9 @@ public:
     );
     virtual ~AudioStreamToFloat();
 
-    using MisalignedStreamConverter::push_bytes;
+    //  If the input is already float at full volume and isn't reversed, whole
+    //  frames are sent to the listeners straight from "data" without a copy.
+    void push_bytes(const void* data, size_t bytes);
 
 private:
     virtual void on_objects(const void* data, size_t objects) override;
@@ -53,6 +55,7 @@ private:
     size_t m_samples_per_frame;
     float m_volume_multiplier;
     bool m_reverse_channels;
+    bool m_passthrough;
     size_t m_sample_size;
     size_t m_frame_size;
     std::set<AudioFloatStreamListener*> m_listeners;
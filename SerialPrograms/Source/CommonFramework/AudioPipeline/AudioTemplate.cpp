@@ -36,7 +36,12 @@ AudioTemplate::AudioTemplate(size_t frequencies, size_t windows)
 {}
 
 
-AudioTemplate loadAudioTemplate(const std::string& filename, size_t sample_rate){
+AudioTemplate loadAudioTemplate(
+    const std::string& filename, size_t sample_rate,
+    const FFTGeometry& geometry
+){
+    geometry.validate();
+
     QAudioFormat outputAudioFormat;
     outputAudioFormat.setChannelCount(1);
 #if QT_VERSION_MAJOR == 5
@@ -55,9 +60,11 @@ AudioTemplate loadAudioTemplate(const std::string& filename, size_t sample_rate)
         return AudioTemplate();
     }
 
-    size_t numFrequencies = NUM_FFT_SAMPLES / 2;
-    AlignedVector<float> input_buffer(NUM_FFT_SAMPLES);
+    const size_t numFFTSamples = geometry.num_samples();
+    const size_t numFrequencies = geometry.num_frequencies();
+    AlignedVector<float> input_buffer(numFFTSamples);
     AlignedVector<float> output_buffer(numFrequencies);
+    const AlignedVector<float> window = make_fft_window(geometry);
 
     size_t numWindows = 0;
     AudioTemplate audio_template;
@@ -65,22 +72,24 @@ AudioTemplate loadAudioTemplate(const std::string& filename, size_t sample_rate)
     // If sample count < FFT input requirement, we pad zeros in the end to do one FFT.
     // Otherwise, we don't pad zeros and compute FFT as much as possible using fixed
     // window step.
-    if (numSamples < NUM_FFT_SAMPLES){
+    if (numSamples < numFFTSamples){
         numWindows = 1;
         audio_template = AudioTemplate(numFrequencies, 1);
 
-        memset(input_buffer.data(), 0, sizeof(float) * NUM_FFT_SAMPLES);
+        memset(input_buffer.data(), 0, sizeof(float) * numFFTSamples);
         memcpy(input_buffer.data(), data, sizeof(float) * numSamples);
-        Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, output_buffer.data(), input_buffer.data());
+        apply_fft_window(window, input_buffer.data());
+        Kernels::AbsFFT::fft_abs(geometry.length_power_of_two, output_buffer.data(), input_buffer.data());
         memcpy(audio_template.getWindow(0), output_buffer.data(), sizeof(float) * numFrequencies);
     }else{
-        numWindows = (numSamples - NUM_FFT_SAMPLES) / FFT_SLIDING_WINDOW_STEP + 1;
+        numWindows = (numSamples - numFFTSamples) / geometry.step + 1;
         audio_template = AudioTemplate(numFrequencies, numWindows);
 
-        for (size_t i = 0, start = 0; start+NUM_FFT_SAMPLES <= numSamples; i++, start += FFT_SLIDING_WINDOW_STEP){
+        for (size_t i = 0, start = 0; start+numFFTSamples <= numSamples; i++, start += geometry.step){
             assert(i < numWindows);
-            memcpy(input_buffer.data(), data + start, sizeof(float) * NUM_FFT_SAMPLES);
-            Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, output_buffer.data(), input_buffer.data());
+            memcpy(input_buffer.data(), data + start, sizeof(float) * numFFTSamples);
+            apply_fft_window(window, input_buffer.data());
+            Kernels::AbsFFT::fft_abs(geometry.length_power_of_two, output_buffer.data(), input_buffer.data());
             memcpy(audio_template.getWindow(i), output_buffer.data(), sizeof(float) * numFrequencies);
         }
     }
@@ -88,7 +97,7 @@ AudioTemplate loadAudioTemplate(const std::string& filename, size_t sample_rate)
 
     std::stringstream ss;
     ss << "Built audio template with sample rate " << sample_rate << ", " << numWindows << " windows and " << numFrequencies <<
-        " frequencies from " << filename;
+        " frequencies (FFT " << geometry.to_string() << ") from " << filename;
     global_logger_tagged().log(ss.str());
 
     return audio_template;
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include "Common/Cpp/Containers/AlignedVector.h"
+#include "Spectrum/FFTGeometry.h"
 
 namespace PokemonAutomation{
 
@@ -54,7 +55,12 @@ private:
 
 // Load AudioTemplate from disk. Accept .wav format on any OS.
 // Loading .mp3 format however is dependent on Qt's platform-dependent backend.
-AudioTemplate loadAudioTemplate(const std::string& filename, size_t sample_rate = 48000);
+// The spectrogram is computed with `geometry`. It must match the geometry of the spectrums
+// that it will be matched against.
+AudioTemplate loadAudioTemplate(
+    const std::string& filename, size_t sample_rate = 48000,
+    const FFTGeometry& geometry = FFTGeometry()
+);
 
 
 
@@ -21,17 +21,6 @@ namespace PokemonAutomation{
 
 
 
-void AudioPassthroughPairQt::add_listener(FFTListener& listener){
-    SpinLockGuard lg(m_lock);
-    m_listeners.insert(&listener);
-}
-void AudioPassthroughPairQt::remove_listener(FFTListener& listener){
-    SpinLockGuard lg(m_lock);
-    m_listeners.erase(&listener);
-}
-
-
-
 class AudioPassthroughPairQt::SampleListener final : public AudioFloatStreamListener{
 public:
     SampleListener(AudioPassthroughPairQt& parent, size_t samples_per_frame)
@@ -61,10 +50,11 @@ private:
 
 class AudioPassthroughPairQt::InternalFFTListener final : public FFTListener{
 public:
-    InternalFFTListener(AudioPassthroughPairQt& parent)
+    InternalFFTListener(AudioPassthroughPairQt& parent, const FFTGeometry& geometry)
         : m_parent(parent)
+        , m_geometry(geometry)
     {
-        parent.m_fft_runner->add_listener(*this);
+        parent.m_fft_runner->add_listener(*this, geometry);
     }
     ~InternalFFTListener(){
         m_parent.m_fft_runner->remove_listener(*this);
@@ -72,19 +62,49 @@ public:
     virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override{
         //  This is already inside the lock.
 //        SpinLockGuard lg(m_parent.m_lock);
-        for (FFTListener* listener : m_parent.m_listeners){
-            listener->on_fft(sample_rate, fft_output);
+        for (const auto& item : m_parent.m_listeners){
+            if (item.second == m_geometry){
+                item.first->on_fft(sample_rate, fft_output);
+            }
         }
     }
 
 private:
     AudioPassthroughPairQt& m_parent;
+    FFTGeometry m_geometry;
 };
 
 
 
 
 
+void AudioPassthroughPairQt::add_listener(FFTListener& listener, const FFTGeometry& geometry){
+    SpinLockGuard lg(m_lock);
+    m_listeners[&listener] = geometry;
+    if (m_fft_runner && m_fft_listeners.find(geometry) == m_fft_listeners.end()){
+        m_fft_listeners.emplace(geometry, std::make_unique<InternalFFTListener>(*this, geometry));
+    }
+}
+void AudioPassthroughPairQt::remove_listener(FFTListener& listener){
+    SpinLockGuard lg(m_lock);
+    auto iter = m_listeners.find(&listener);
+    if (iter == m_listeners.end()){
+        return;
+    }
+    FFTGeometry geometry = iter->second;
+    m_listeners.erase(iter);
+
+    //  Stop computing this geometry if nobody else wants it.
+    for (const auto& item : m_listeners){
+        if (item.second == geometry){
+            return;
+        }
+    }
+    m_fft_listeners.erase(geometry);
+}
+
+
+
 AudioPassthroughPairQt::~AudioPassthroughPairQt(){}
 
 AudioPassthroughPairQt::AudioPassthroughPairQt(Logger& logger)
@@ -100,7 +120,7 @@ void AudioPassthroughPairQt::reset(
     QMetaObject::invokeMethod(this, [this, file, output, output_volume]{
         SpinLockGuard lg(m_lock);
         if (m_reader){
-            m_fft_listener.reset();
+            m_fft_listeners.clear();
             m_fft_runner.reset();
             m_writer.reset();
             m_sample_listener.reset();
@@ -114,7 +134,7 @@ void AudioPassthroughPairQt::reset(
         m_output_volume = output_volume;
         init_audio_sink();
         m_fft_runner = make_FFT_streamer(m_input_format);
-        m_fft_listener.reset(new InternalFFTListener(*this));
+        start_fft_listeners();
     });
 }
 void AudioPassthroughPairQt::reset(
@@ -125,7 +145,7 @@ void AudioPassthroughPairQt::reset(
     QMetaObject::invokeMethod(this, [this, format, output, output_volume, input]{
         SpinLockGuard lg(m_lock);
         if (m_reader){
-            m_fft_listener.reset();
+            m_fft_listeners.clear();
             m_fft_runner.reset();
             m_writer.reset();
             m_sample_listener.reset();
@@ -140,7 +160,7 @@ void AudioPassthroughPairQt::reset(
             m_sample_listener.reset(new SampleListener(*this, m_reader->samples_per_frame()));
             init_audio_sink();
             m_fft_runner = make_FFT_streamer(m_input_format);
-            m_fft_listener.reset(new InternalFFTListener(*this));
+            start_fft_listeners();
         }
     });
 }
@@ -148,7 +168,7 @@ void AudioPassthroughPairQt::clear_audio_source(){
     QMetaObject::invokeMethod(this, [this]{
         SpinLockGuard lg(m_lock);
         if (m_reader){
-            m_fft_listener.reset();
+            m_fft_listeners.clear();
             m_fft_runner.reset();
             m_sample_listener.reset();
             m_reader.reset();
@@ -160,7 +180,7 @@ void AudioPassthroughPairQt::set_audio_source(const std::string& file){
     QMetaObject::invokeMethod(this, [this, file]{
         SpinLockGuard lg(m_lock);
         if (m_reader){
-            m_fft_listener.reset();
+            m_fft_listeners.clear();
             m_fft_runner.reset();
             m_writer.reset();
             m_sample_listener.reset();
@@ -172,14 +192,14 @@ void AudioPassthroughPairQt::set_audio_source(const std::string& file){
         m_sample_listener.reset(new SampleListener(*this, m_reader->samples_per_frame()));
         init_audio_sink();
         m_fft_runner = make_FFT_streamer(m_input_format);
-        m_fft_listener.reset(new InternalFFTListener(*this));
+        start_fft_listeners();
     });
 }
 void AudioPassthroughPairQt::set_audio_source(const AudioDeviceInfo& device, AudioChannelFormat format){
     QMetaObject::invokeMethod(this, [this, format, device]{
         SpinLockGuard lg(m_lock);
         if (m_reader){
-            m_fft_listener.reset();
+            m_fft_listeners.clear();
             m_fft_runner.reset();
             m_writer.reset();
             m_sample_listener.reset();
@@ -192,7 +212,7 @@ void AudioPassthroughPairQt::set_audio_source(const AudioDeviceInfo& device, Aud
             m_sample_listener.reset(new SampleListener(*this, m_reader->samples_per_frame()));
             init_audio_sink();
             m_fft_runner = make_FFT_streamer(m_input_format);
-            m_fft_listener.reset(new InternalFFTListener(*this));
+            start_fft_listeners();
         }
     });
 }
@@ -243,6 +263,16 @@ void AudioPassthroughPairQt::init_audio_sink(){
 }
 
 
+void AudioPassthroughPairQt::start_fft_listeners(){
+    m_fft_listeners.clear();
+    for (const auto& item : m_listeners){
+        if (m_fft_listeners.find(item.second) == m_fft_listeners.end()){
+            m_fft_listeners.emplace(item.second, std::make_unique<InternalFFTListener>(*this, item.second));
+        }
+    }
+}
+
+
 void AudioPassthroughPairQt::set_sink_volume(double volume){
     QMetaObject::invokeMethod(this, [this, volume]{
         SpinLockGuard lg(m_lock);
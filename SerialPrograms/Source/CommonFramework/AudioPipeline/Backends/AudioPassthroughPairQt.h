@@ -8,10 +8,11 @@
 #define PokemonAutomation_AudioPipeline_AudioPassthroughPairQt_H
 
 #include <memory>
-#include <set>
+#include <map>
 #include <QObject>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "CommonFramework/AudioPipeline/AudioPassthroughPair.h"
+#include "CommonFramework/AudioPipeline/Spectrum/FFTGeometry.h"
 
 namespace PokemonAutomation{
 
@@ -23,7 +24,7 @@ class AudioFloatToFFT;
 
 class AudioPassthroughPairQt final : public QObject, public AudioPassthroughPair{
 public:
-    virtual void add_listener(FFTListener& listener) override;
+    virtual void add_listener(FFTListener& listener, const FFTGeometry& geometry) override;
     virtual void remove_listener(FFTListener& listener) override;
 
 
@@ -56,6 +57,10 @@ private:
 
     void init_audio_sink();
 
+    //  Attach one internal listener to "m_fft_runner" for each geometry that
+    //  is in use.
+    void start_fft_listeners();
+
 
 private:
     Logger& m_logger;
@@ -77,9 +82,9 @@ private:
     std::unique_ptr<AudioSink> m_writer;
 
     std::unique_ptr<AudioFloatToFFT> m_fft_runner;
-    std::unique_ptr<InternalFFTListener> m_fft_listener;    //  Attaches to m_fft_runner"".
+    std::map<FFTGeometry, std::unique_ptr<InternalFFTListener>> m_fft_listeners;    //  Attaches to m_fft_runner"".
 
-    std::set<FFTListener*> m_listeners;
+    std::map<FFTListener*, FFTGeometry> m_listeners;
 };
 
 
@@ -16,9 +16,9 @@
 namespace PokemonAutomation{
 
 
-void AudioPassthroughPairQtThread::add_listener(FFTListener& listener){
+void AudioPassthroughPairQtThread::add_listener(FFTListener& listener, const FFTGeometry& geometry){
     AudioPassthroughPairQt* body = m_body.load(std::memory_order_relaxed);
-    body->add_listener(listener);
+    body->add_listener(listener, geometry);
 }
 void AudioPassthroughPairQtThread::remove_listener(FFTListener& listener){
     AudioPassthroughPairQt* body = m_body.load(std::memory_order_relaxed);
@@ -21,7 +21,7 @@ class AudioPassthroughPairQt;
 
 class AudioPassthroughPairQtThread : private QThread, public AudioPassthroughPair{
 public:
-    virtual void add_listener(FFTListener& listener) override;
+    virtual void add_listener(FFTListener& listener, const FFTGeometry& geometry) override;
     virtual void remove_listener(FFTListener& listener) override;
 
 public:
@@ -0,0 +1,92 @@
+/*  Audio File Analyzer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/AudioPipeline/AudioStream.h"
+#include "CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h"
+#include "AudioFileDecoder.h"
+#include "AudioFileAnalyzer.h"
+
+namespace PokemonAutomation{
+
+
+
+AudioFileAnalyzer::AudioFileAnalyzer(const std::string& filename, size_t preferred_sample_rate)
+    : m_decoder(open_audio_file(filename, preferred_sample_rate))
+{
+    size_t channels = m_decoder->channels();
+    if (channels > 2){
+        throw FileException(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Only mono and stereo are supported: " + std::to_string(channels) + " channels",
+            filename
+        );
+    }
+
+    //  Stereo is averaged down to mono. Same as a dual-channel device.
+    m_reader.reset(new AudioStreamToFloat(m_decoder->format(), channels, 1.0, false));
+    m_fft.reset(new AudioFloatToFFT(m_decoder->sample_rate(), channels, channels == 2));
+    m_reader->add_listener(*m_fft);
+
+    m_buffer = AlignedVector<char>(CHUNK_FRAMES * m_decoder->frame_size());
+}
+AudioFileAnalyzer::~AudioFileAnalyzer(){
+    if (m_reader){
+        m_reader->remove_listener(*m_fft);
+    }
+}
+
+size_t AudioFileAnalyzer::sample_rate() const{
+    return m_decoder->sample_rate();
+}
+
+void AudioFileAnalyzer::add_listener(FFTListener& listener, const FFTGeometry& geometry){
+    m_fft->add_listener(listener, geometry);
+}
+void AudioFileAnalyzer::remove_listener(FFTListener& listener){
+    m_fft->remove_listener(listener);
+}
+
+bool AudioFileAnalyzer::process_chunk(){
+    size_t frames = m_decoder->read(m_buffer.data(), CHUNK_FRAMES);
+    if (frames == 0){
+        return false;
+    }
+    m_reader->push_bytes(m_buffer.data(), frames * m_decoder->frame_size());
+    m_frames_decoded += frames;
+    return true;
+}
+uint64_t AudioFileAnalyzer::run(){
+    while (process_chunk());
+    return m_frames_decoded;
+}
+
+
+
+std::vector<AudioSpectrum> load_audio_spectrums(
+    const std::string& filename,
+    size_t preferred_sample_rate,
+    const FFTGeometry& geometry
+){
+    struct Collector : public FFTListener{
+        std::vector<AudioSpectrum> spectrums;
+        virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override{
+            spectrums.emplace_back(spectrums.size(), sample_rate, std::move(fft_output));
+        }
+    };
+
+    Collector collector;
+    AudioFileAnalyzer analyzer(filename, preferred_sample_rate);
+    analyzer.add_listener(collector, geometry);
+    analyzer.run();
+    analyzer.remove_listener(collector);
+    return std::move(collector.spectrums);
+}
+
+
+
+}
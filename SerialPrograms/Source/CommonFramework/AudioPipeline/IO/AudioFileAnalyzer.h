@@ -0,0 +1,80 @@
+/*  Audio File Analyzer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Run an audio file through the same AudioStreamToFloat -> AudioFloatToFFT
+ *  chain as a live audio device, as fast as the CPU allows. Use this for
+ *  offline analysis of long recordings. (e.g. regression runs of audio
+ *  detectors)
+ *
+ *  The FFT listeners get the same spectrums that they would get if the file
+ *  were played into the pipeline. That includes the windows that overlap the
+ *  silence before the start of the file.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioFileAnalyzer_H
+#define PokemonAutomation_AudioPipeline_AudioFileAnalyzer_H
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "CommonFramework/AudioPipeline/Spectrum/FFTGeometry.h"
+
+namespace PokemonAutomation{
+
+class AudioFileDecoder;
+class AudioStreamToFloat;
+class AudioFloatToFFT;
+struct FFTListener;
+
+
+class AudioFileAnalyzer{
+public:
+    //  Frames decoded and pushed through the pipeline at a time.
+    static constexpr size_t CHUNK_FRAMES = 65536;
+
+public:
+    //  Throws FileException if the file can't be decoded. Also throws if it
+    //  has more than 2 channels.
+    AudioFileAnalyzer(const std::string& filename, size_t preferred_sample_rate = 48000);
+    ~AudioFileAnalyzer();
+
+    size_t sample_rate() const;
+
+    void add_listener(FFTListener& listener, const FFTGeometry& geometry = FFTGeometry());
+    void remove_listener(FFTListener& listener);
+
+    //  Decode and transform the next chunk. Returns false at the end of the
+    //  file.
+    bool process_chunk();
+
+    //  Run the rest of the file. Returns the total # of frames decoded.
+    uint64_t run();
+
+    uint64_t frames_decoded() const{ return m_frames_decoded; }
+
+private:
+    std::unique_ptr<AudioFileDecoder> m_decoder;
+    std::unique_ptr<AudioStreamToFloat> m_reader;
+    std::unique_ptr<AudioFloatToFFT> m_fft;
+    AlignedVector<char> m_buffer;
+    uint64_t m_frames_decoded = 0;
+};
+
+
+//  All the spectrums of "filename" for "geometry". They are ordered from
+//  oldest to newest with stamps starting at 0. (the reverse of AudioFeed)
+std::vector<AudioSpectrum> load_audio_spectrums(
+    const std::string& filename,
+    size_t preferred_sample_rate = 48000,
+    const FFTGeometry& geometry = FFTGeometry()
+);
+
+
+
+}
+#endif
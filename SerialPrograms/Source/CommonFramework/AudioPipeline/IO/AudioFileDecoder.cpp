@@ -0,0 +1,247 @@
+/*  Audio File Decoder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include <fstream>
+#include <QAudioFormat>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/AudioPipeline/Tools/AudioFormatUtils.h"
+#include "AudioFileLoader.h"
+#include "AudioFileDecoder.h"
+
+namespace PokemonAutomation{
+
+
+
+//  Reads the RIFF container directly. Supports 8/16/24/32-bit PCM and 32-bit
+//  float. 24-bit samples are widened to 32-bit since the rest of the pipeline
+//  doesn't have a 24-bit format.
+class WavFileDecoder : public AudioFileDecoder{
+public:
+    WavFileDecoder(const std::string& filename)
+        : m_filename(filename)
+        , m_file(filename, std::ios::binary)
+    {
+        if (!m_file){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", filename);
+        }
+
+        char header[12];
+        if (!read_exact(header, 12) || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not a RIFF/WAVE file.", filename);
+        }
+
+        bool have_format = false;
+        while (true){
+            char chunk[8];
+            if (!read_exact(chunk, 8)){
+                throw FileException(nullptr, PA_CURRENT_FUNCTION, "No data chunk found.", filename);
+            }
+            uint32_t size = read_u32(chunk + 4);
+            if (memcmp(chunk, "fmt ", 4) == 0){
+                std::vector<char> fmt(size);
+                if (size < 16 || !read_exact(fmt.data(), size)){
+                    throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid format chunk.", filename);
+                }
+                parse_format(fmt.data(), size);
+                have_format = true;
+            }else if (memcmp(chunk, "data", 4) == 0){
+                if (!have_format){
+                    throw FileException(nullptr, PA_CURRENT_FUNCTION, "Data chunk found before format chunk.", filename);
+                }
+                m_frames_left = size / m_file_frame_size;
+                return;
+            }else{
+                m_file.seekg(size, std::ios::cur);
+            }
+            //  Chunks are padded to an even size.
+            if (size & 1){
+                m_file.seekg(1, std::ios::cur);
+            }
+        }
+    }
+
+    virtual size_t read(void* data, size_t max_frames) override{
+        size_t frames = (size_t)std::min<uint64_t>(max_frames, m_frames_left);
+        if (frames == 0){
+            return 0;
+        }
+
+        if (m_bytes_per_sample != 3){
+            m_file.read((char*)data, frames * m_file_frame_size);
+            frames = (size_t)m_file.gcount() / m_file_frame_size;
+            m_frames_left = frames == 0 ? 0 : m_frames_left - frames;
+            return frames;
+        }
+
+        m_buffer.resize(frames * m_file_frame_size);
+        m_file.read(m_buffer.data(), m_buffer.size());
+        frames = (size_t)m_file.gcount() / m_file_frame_size;
+        m_frames_left = frames == 0 ? 0 : m_frames_left - frames;
+
+        const uint8_t* in = (const uint8_t*)m_buffer.data();
+        uint32_t* out = (uint32_t*)data;
+        size_t samples = frames * m_channels;
+        for (size_t c = 0; c < samples; c++){
+            out[c] = ((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24);
+            in += 3;
+        }
+        return frames;
+    }
+
+private:
+    static uint16_t read_u16(const char* ptr){
+        const uint8_t* p = (const uint8_t*)ptr;
+        return (uint16_t)(p[0] | (p[1] << 8));
+    }
+    static uint32_t read_u32(const char* ptr){
+        const uint8_t* p = (const uint8_t*)ptr;
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    bool read_exact(char* data, size_t bytes){
+        m_file.read(data, bytes);
+        return (size_t)m_file.gcount() == bytes;
+    }
+
+    void parse_format(const char* fmt, size_t size){
+        uint16_t tag = read_u16(fmt + 0);
+        m_channels = read_u16(fmt + 2);
+        m_sample_rate = read_u32(fmt + 4);
+        uint16_t block_align = read_u16(fmt + 12);
+        uint16_t bits = read_u16(fmt + 14);
+
+        //  WAVE_FORMAT_EXTENSIBLE: The real tag is at the start of the
+        //  sub-format GUID.
+        if (tag == 0xfffe && size >= 26){
+            tag = read_u16(fmt + 24);
+        }
+
+        if (m_channels == 0 || m_sample_rate == 0){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid channel count or sample rate.", m_filename);
+        }
+
+        switch (tag){
+        case 1:     //  PCM
+            switch (bits){
+            case 8:
+                m_format = AudioSampleFormat::UINT8;
+                break;
+            case 16:
+                m_format = AudioSampleFormat::SINT16;
+                break;
+            case 24:
+            case 32:
+                m_format = AudioSampleFormat::SINT32;
+                break;
+            }
+            break;
+        case 3:     //  IEEE float
+            if (bits == 32){
+                m_format = AudioSampleFormat::FLOAT32;
+            }
+            break;
+        }
+        if (m_format == AudioSampleFormat::INVALID){
+            throw FileException(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Unsupported wav format: tag = " + std::to_string(tag) + ", bits = " + std::to_string(bits),
+                m_filename
+            );
+        }
+
+        m_bytes_per_sample = bits / 8;
+        m_file_frame_size = m_bytes_per_sample * m_channels;
+        if (block_align != m_file_frame_size){
+            throw FileException(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Unsupported wav block alignment: " + std::to_string(block_align),
+                m_filename
+            );
+        }
+    }
+
+private:
+    std::string m_filename;
+    std::ifstream m_file;
+    size_t m_bytes_per_sample = 0;
+    size_t m_file_frame_size = 0;
+    uint64_t m_frames_left = 0;
+    std::vector<char> m_buffer;
+};
+
+
+
+//  Anything that isn't a .wav goes through QAudioDecoder. It
+//  doesn't stream, so the whole file is decoded up front and then handed out
+//  in chunks.
+class QtAudioFileDecoder : public AudioFileDecoder{
+public:
+    QtAudioFileDecoder(const std::string& filename, size_t sample_rate){
+        QAudioFormat format;
+        format.setChannelCount(1);
+#if QT_VERSION_MAJOR == 5
+        format.setCodec("audio/pcm");
+#endif
+        format.setSampleRate((int)sample_rate);
+        setSampleFormatToFloat(format);
+
+        m_loader.reset(new AudioFileLoader(nullptr, filename, format));
+        const auto ret = m_loader->loadFullAudio();
+        m_data = std::get<0>(ret);
+        m_bytes_left = std::get<1>(ret);
+        if (m_data == nullptr){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to decode file.", filename);
+        }
+
+        m_sample_rate = sample_rate;
+        m_channels = 1;
+        m_format = AudioSampleFormat::FLOAT32;
+    }
+
+    virtual size_t read(void* data, size_t max_frames) override{
+        size_t frames = std::min(max_frames, m_bytes_left / sizeof(float));
+        size_t bytes = frames * sizeof(float);
+        memcpy(data, m_data, bytes);
+        m_data += bytes;
+        m_bytes_left -= bytes;
+        return frames;
+    }
+
+private:
+    std::unique_ptr<AudioFileLoader> m_loader;
+    const char* m_data;
+    size_t m_bytes_left;
+};
+
+
+
+static std::string lowercase_extension(const std::string& filename){
+    size_t dot = filename.rfind('.');
+    if (dot == std::string::npos){
+        return "";
+    }
+    std::string extension = filename.substr(dot + 1);
+    for (char& ch : extension){
+        if ('A' <= ch && ch <= 'Z'){
+            ch += 'a' - 'A';
+        }
+    }
+    return extension;
+}
+
+std::unique_ptr<AudioFileDecoder> open_audio_file(const std::string& filename, size_t preferred_sample_rate){
+    if (lowercase_extension(filename) == "wav"){
+        return std::make_unique<WavFileDecoder>(filename);
+    }
+    return std::make_unique<QtAudioFileDecoder>(filename, preferred_sample_rate);
+}
+
+
+
+}
@@ -0,0 +1,54 @@
+/*  Audio File Decoder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Decode an audio file into raw samples, one chunk at a time, as fast as
+ *  the file can be read. Unlike AudioFileLoader, nothing is paced to the
+ *  sample rate and the whole file is never held in memory at once.
+ *
+ *  .wav files are decoded natively. Other formats fall back to QAudioDecoder.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioFileDecoder_H
+#define PokemonAutomation_AudioPipeline_AudioFileDecoder_H
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include "CommonFramework/AudioPipeline/AudioInfo.h"
+
+namespace PokemonAutomation{
+
+
+class AudioFileDecoder{
+public:
+    virtual ~AudioFileDecoder() = default;
+
+    size_t sample_rate() const{ return m_sample_rate; }
+    size_t channels() const{ return m_channels; }
+    AudioSampleFormat format() const{ return m_format; }
+    size_t frame_size() const{ return m_channels * sample_size(m_format); }
+
+    //  Read up to "max_frames" frames into "data". Returns the # of frames
+    //  read. Returns 0 at the end of the file.
+    virtual size_t read(void* data, size_t max_frames) = 0;
+
+protected:
+    size_t m_sample_rate = 0;
+    size_t m_channels = 0;
+    AudioSampleFormat m_format = AudioSampleFormat::INVALID;
+};
+
+
+//  Open a file with the decoder that handles its extension.
+//  .wav files keep their own sample rate. Everything else is resampled to
+//  "preferred_sample_rate".
+//  Throws FileException if the file can't be opened or its format isn't
+//  supported.
+std::unique_ptr<AudioFileDecoder> open_audio_file(const std::string& filename, size_t preferred_sample_rate = 48000);
+
+
+
+}
+#endif
@@ -0,0 +1,72 @@
+/*  FFT Geometry
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "FFTGeometry.h"
+
+namespace PokemonAutomation{
+
+
+void FFTGeometry::validate() const{
+    //  The kernels need at least a full SIMD vector of output.
+    if (length_power_of_two < 6 || length_power_of_two > 16){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "FFT length must be between 2^6 and 2^16: 2^" + std::to_string(length_power_of_two)
+        );
+    }
+    if (step == 0 || step > num_samples()){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "FFT step must be between 1 and the transform length: " + std::to_string(step)
+        );
+    }
+}
+
+std::string FFTGeometry::to_string() const{
+    std::string str = std::to_string(num_samples()) + "-" + std::to_string(step);
+    switch (window){
+    case FFTWindowFunction::RECTANGULAR:
+        str += "-rect";
+        break;
+    case FFTWindowFunction::HANN:
+        str += "-hann";
+        break;
+    }
+    return str;
+}
+
+
+AlignedVector<float> make_fft_window(const FFTGeometry& geometry){
+    size_t length = geometry.num_samples();
+    switch (geometry.window){
+    case FFTWindowFunction::RECTANGULAR:
+        return AlignedVector<float>();
+    case FFTWindowFunction::HANN:{
+        AlignedVector<float> window(length);
+        const double PI = 3.14159265358979323846;
+        for (size_t c = 0; c < length; c++){
+            window[c] = (float)(0.5 - 0.5 * std::cos(2 * PI * (double)c / (double)length));
+        }
+        return window;
+    }
+    }
+    throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid window function: " + std::to_string((int)geometry.window));
+}
+
+void apply_fft_window(const AlignedVector<float>& window, float* samples){
+    const float* coefficients = window.data();
+    size_t length = window.size();
+    for (size_t c = 0; c < length; c++){
+        samples[c] *= coefficients[c];
+    }
+}
+
+
+
+}
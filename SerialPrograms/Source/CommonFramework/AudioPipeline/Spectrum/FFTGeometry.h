@@ -0,0 +1,83 @@
+/*  FFT Geometry
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      The shape of the sliding window FFT: the transform length, how far the
+ *  window moves between transforms, and the window function.
+ *
+ *  Short windows react sooner to transient sounds. Long windows have better
+ *  frequency resolution. The default is the geometry that the whole audio
+ *  pipeline used before it was configurable. All the existing templates and
+ *  thresholds were tuned on it.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_FFTGeometry_H
+#define PokemonAutomation_AudioPipeline_FFTGeometry_H
+
+#include <stddef.h>
+#include <string>
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "CommonFramework/AudioPipeline/AudioConstants.h"
+
+namespace PokemonAutomation{
+
+
+enum class FFTWindowFunction{
+    RECTANGULAR,    //  No windowing.
+    HANN,
+};
+
+
+struct FFTGeometry{
+    //  Transform length is 2^length_power_of_two.
+    int length_power_of_two = FFT_LENGTH_POWER_OF_TWO;
+
+    //  Samples between the start of one window and the next.
+    size_t step = FFT_SLIDING_WINDOW_STEP;
+
+    FFTWindowFunction window = FFTWindowFunction::RECTANGULAR;
+
+    FFTGeometry() = default;
+    FFTGeometry(int p_length_power_of_two, size_t p_step, FFTWindowFunction p_window = FFTWindowFunction::RECTANGULAR)
+        : length_power_of_two(p_length_power_of_two)
+        , step(p_step)
+        , window(p_window)
+    {}
+
+    size_t num_samples() const{ return (size_t)1 << length_power_of_two; }
+    size_t num_frequencies() const{ return num_samples() / 2; }
+
+    bool is_default() const{ return *this == FFTGeometry(); }
+
+    //  Throws if the transform length or step is out of range.
+    void validate() const;
+
+    //  e.g. "4096-1024-rect". Used in logs and as a cache key.
+    std::string to_string() const;
+
+    friend bool operator==(const FFTGeometry& x, const FFTGeometry& y){
+        return x.length_power_of_two == y.length_power_of_two && x.step == y.step && x.window == y.window;
+    }
+    friend bool operator!=(const FFTGeometry& x, const FFTGeometry& y){
+        return !(x == y);
+    }
+    friend bool operator<(const FFTGeometry& x, const FFTGeometry& y){
+        if (x.length_power_of_two != y.length_power_of_two) return x.length_power_of_two < y.length_power_of_two;
+        if (x.step != y.step) return x.step < y.step;
+        return x.window < y.window;
+    }
+};
+
+
+//  The coefficients to multiply each window by before the transform.
+//  Returns an empty vector for RECTANGULAR.
+AlignedVector<float> make_fft_window(const FFTGeometry& geometry);
+
+//  Multiply "samples" by "window". Does nothing if "window" is empty.
+void apply_fft_window(const AlignedVector<float>& window, float* samples);
+
+
+
+}
+#endif
@@ -4,6 +4,7 @@
  *
  */
 
+#include <atomic>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels/AbsFFT/Kernels_AbsFFT.h"
@@ -35,11 +36,81 @@ std::unique_ptr<AudioFloatToFFT> make_FFT_streamer(AudioChannelFormat format){
 
 
 
-void AudioFloatToFFT::add_listener(FFTListener& listener){
-    m_listeners.insert(&listener);
+struct AudioFloatToFFT::GeometryState{
+    FFTGeometry geometry;
+
+    //  The stream position where the next window ends.
+    uint64_t next_end;
+
+    AlignedVector<float> input;
+    AlignedVector<float> window;
+
+    std::vector<std::shared_ptr<AlignedVector<float>>> output_pool;
+    size_t output_pool_next = 0;
+    std::vector<std::shared_ptr<AlignedVector<float>>> batch;
+
+    std::set<FFTListener*> listeners;
+
+    GeometryState(const FFTGeometry& p_geometry, uint64_t start)
+        : geometry(p_geometry)
+        , next_end(start)
+        , input(geometry.num_samples())
+        , window(make_fft_window(geometry))
+    {}
+
+    std::shared_ptr<AlignedVector<float>> get_output(){
+        //  Only this class hands out references to pooled outputs. So once
+        //  the count drops to 1, nobody else can raise it again.
+        //  Outputs are usually released in the order they were sent. So the
+        //  next one in round-robin order is almost always free.
+        size_t size = output_pool.size();
+        for (size_t c = 0; c < size; c++){
+            std::shared_ptr<AlignedVector<float>>& output = output_pool[output_pool_next];
+            output_pool_next++;
+            if (output_pool_next == size){
+                output_pool_next = 0;
+            }
+            if (output.use_count() == 1){
+                //  Order our writes after the last reads of the listener that
+                //  released it.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return output;
+            }
+        }
+
+        std::shared_ptr<AlignedVector<float>> output = std::make_shared<AlignedVector<float>>(geometry.num_frequencies());
+        if (size < MAX_POOLED_OUTPUTS){
+            output_pool.emplace_back(output);
+        }
+        return output;
+    }
+};
+
+
+
+void AudioFloatToFFT::add_listener(FFTListener& listener, const FFTGeometry& geometry){
+    auto iter = m_geometries.find(geometry);
+    if (iter == m_geometries.end()){
+        geometry.validate();
+        reserve(geometry);
+        iter = m_geometries.emplace(
+            geometry,
+            std::make_unique<GeometryState>(geometry, m_written)
+        ).first;
+    }
+    iter->second->listeners.insert(&listener);
 }
 void AudioFloatToFFT::remove_listener(FFTListener& listener){
-    m_listeners.erase(&listener);
+    for (auto iter = m_geometries.begin(); iter != m_geometries.end(); ++iter){
+        std::set<FFTListener*>& listeners = iter->second->listeners;
+        if (listeners.erase(&listener) == 0){
+            continue;
+        }
+        if (listeners.empty()){
+            m_geometries.erase(iter);
+        }
+        return;
+    }
 }
 
 AudioFloatToFFT::AudioFloatToFFT(
@@ -50,9 +121,8 @@ AudioFloatToFFT::AudioFloatToFFT(
     , m_sample_rate(sample_rate)
     , m_average(average_pairs)
     , m_fft_sample_size(average_pairs ? 2 : 1)
-    , m_buffer(NUM_FFT_SAMPLES)
-    , m_buffered(NUM_FFT_SAMPLES)
-    , m_fft_input(NUM_FFT_SAMPLES)
+    , m_buffer(NUM_FFT_SAMPLES + FFT_SLIDING_WINDOW_STEP * (MAX_BATCH_WINDOWS - 1))
+    , m_written(m_buffer.size())
 {
     if (samples_per_frame == 0 || samples_per_frame > 2){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Channels must be 1 or 2.");
@@ -60,12 +130,43 @@ AudioFloatToFFT::AudioFloatToFFT(
     memset(m_buffer.data(), 0, m_buffer.size() * sizeof(float));
 }
 AudioFloatToFFT::~AudioFloatToFFT(){}
+void AudioFloatToFFT::reserve(const FFTGeometry& geometry){
+    size_t max_samples = geometry.num_samples();
+    size_t max_step = geometry.step;
+    for (const auto& item : m_geometries){
+        max_samples = std::max(max_samples, item.first.num_samples());
+        max_step = std::max(max_step, item.first.step);
+    }
+    size_t capacity = max_samples + max_step * (MAX_BATCH_WINDOWS - 1);
+    size_t old_capacity = m_buffer.size();
+    if (capacity <= old_capacity){
+        return;
+    }
+
+    //  Move everything that is still buffered to its new position. Anything
+    //  older than that becomes zeros.
+    AlignedVector<float> buffer(capacity);
+    memset(buffer.data(), 0, capacity * sizeof(float));
+    for (uint64_t c = m_written - old_capacity; c < m_written; c++){
+        buffer[(size_t)(c % capacity)] = m_buffer[(size_t)(c % old_capacity)];
+    }
+    m_buffer = std::move(buffer);
+}
 void AudioFloatToFFT::on_samples(const float* data, size_t frames){
 //    cout << "objects = " << objects << endl;
+    const size_t capacity = m_buffer.size();
     const float* ptr = data;
     while (frames > 0){
+        //  Don't overwrite anything that a pending window still needs.
+        uint64_t oldest = m_written;
+        for (const auto& item : m_geometries){
+            oldest = std::min(oldest, item.second->next_end - item.first.num_samples());
+        }
+        size_t space = capacity - (size_t)(m_written - oldest);
+
         //  Figure out how much space we can write contiguously.
-        size_t block = m_buffer.size() - std::max(m_buffered, m_end);
+        size_t end = (size_t)(m_written % capacity);
+        size_t block = std::min(space, capacity - end);
 
         //  Don't write more than we have.
         block = std::min(block, frames);
@@ -73,20 +174,14 @@ void AudioFloatToFFT::on_samples(const float* data, size_t frames){
 //        cout << "block = " << block << endl;
 
         //  Write it.
-        convert(&m_buffer[m_end], ptr, block);
-        m_buffered += block;
-        m_end += block;
-        if (m_end == m_buffer.size()){
-            m_end = 0;
-        }
+        convert(&m_buffer[end], ptr, block);
+        m_written += block;
         ptr += block * m_fft_sample_size;
         frames -= block;
 
-        //  Buffer is full. Time to run FFT!
-        if (m_buffered == m_buffer.size()){
-//            cout << "run_fft()" << endl;
-            run_fft();
-            drop_from_front(FFT_SLIDING_WINDOW_STEP);
+        //  Buffer is full or we're out of samples. Time to run the FFTs!
+        if (block == space || frames == 0){
+            run_ffts();
         }
     }
 }
@@ -99,38 +194,45 @@ void AudioFloatToFFT::convert(float* fft_input, const float* audio_stream, size_
         fft_input[c] = (audio_stream[2*c + 0] + audio_stream[2*c + 1]) * 0.5f;
     }
 }
-void AudioFloatToFFT::run_fft(){
-    float* ptr = m_fft_input.data();
-    size_t remaining = NUM_FFT_SAMPLES;
-    size_t index = m_start;
-    while (remaining > 0){
-        size_t block = std::min(remaining, m_buffer.size() - index);
-        memcpy(ptr, &m_buffer[index], block * sizeof(float));
-        ptr += block;
-        remaining -= block;
-        index += block;
-        if (index == m_buffer.size()){
-            index = 0;
-        }
-    }
-    std::shared_ptr<AlignedVector<float>> out = std::make_unique<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
-    Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), m_fft_input.data());
-    for (FFTListener* listener : m_listeners){
-        listener->on_fft(m_sample_rate, out);
+void AudioFloatToFFT::run_ffts(){
+    for (auto& item : m_geometries){
+        run_ffts(*item.second);
     }
 }
-void AudioFloatToFFT::drop_from_front(size_t frames){
-    if (frames >= m_buffered){
-        m_buffered = 0;
-        m_start = 0;
-        m_end = 0;
-        return;
+void AudioFloatToFFT::run_ffts(GeometryState& state){
+    const size_t capacity = m_buffer.size();
+    const size_t length = state.geometry.num_samples();
+
+    //  Transform every window that is ready first. Then send them out.
+    state.batch.clear();
+    while (state.next_end <= m_written){
+        //  The transform is destructive on its input. So the window needs to
+        //  be copied out of the ring buffer either way.
+        float* ptr = state.input.data();
+        size_t remaining = length;
+        size_t index = (size_t)((state.next_end - length) % capacity);
+        while (remaining > 0){
+            size_t block = std::min(remaining, capacity - index);
+            memcpy(ptr, &m_buffer[index], block * sizeof(float));
+            ptr += block;
+            remaining -= block;
+            index += block;
+            if (index == capacity){
+                index = 0;
+            }
+        }
+        apply_fft_window(state.window, state.input.data());
+        std::shared_ptr<AlignedVector<float>> out = state.get_output();
+        Kernels::AbsFFT::fft_abs(state.geometry.length_power_of_two, out->data(), state.input.data());
+        state.batch.emplace_back(std::move(out));
+        state.next_end += state.geometry.step;
     }
-    m_buffered -= frames;
-    m_start += frames;
-    while (m_start >= m_buffer.size()){
-        m_start -= m_buffer.size();
+    for (std::shared_ptr<AlignedVector<float>>& out : state.batch){
+        for (FFTListener* listener : state.listeners){
+            listener->on_fft(m_sample_rate, out);
+        }
     }
+    state.batch.clear();
 }
 
 
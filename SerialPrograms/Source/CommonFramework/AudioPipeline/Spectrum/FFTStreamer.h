@@ -7,7 +7,11 @@
 #ifndef PokemonAutomation_AudioPipeline_FFTStreamer_H
 #define PokemonAutomation_AudioPipeline_FFTStreamer_H
 
+#include <stdint.h>
+#include <vector>
+#include <map>
 #include "CommonFramework/AudioPipeline/AudioStream.h"
+#include "FFTGeometry.h"
 
 namespace PokemonAutomation{
 
@@ -20,9 +24,31 @@ struct FFTListener{
 
 
 //  Listen to an audio stream and compute FFTs on it.
+//
+//  Each listener subscribes to one FFT geometry. All the geometries that have
+//  listeners are computed from the same sample buffer. Each listener gets the
+//  outputs of its geometry in order.
+//
+//  The FFT outputs are recycled. Once all the listeners have dropped their
+//  reference to an output, it gets reused for a later FFT. So listeners must
+//  not hold onto them through anything other than the shared_ptr.
+//
 class AudioFloatToFFT : public AudioFloatStreamListener{
 public:
-    void add_listener(FFTListener& listener);
+    //  How many windows can be pending at once. If the audio thread falls
+    //  behind and delivers a large chunk at once, up to this many windows are
+    //  buffered and transformed back-to-back.
+    static constexpr size_t MAX_BATCH_WINDOWS = 4;
+
+    //  Upper bound on the recycled outputs. Past this (listeners are holding
+    //  onto a lot of them), new outputs are allocated and not recycled.
+    static constexpr size_t MAX_POOLED_OUTPUTS = 128;
+
+public:
+    //  A listener added after the stream has started gets its first window
+    //  right away. The samples from before its geometry was added may be
+    //  zeros if they are no longer buffered.
+    void add_listener(FFTListener& listener, const FFTGeometry& geometry = FFTGeometry());
     void remove_listener(FFTListener& listener);
 
 public:
@@ -34,9 +60,12 @@ public:
     virtual void on_samples(const float* data, size_t frames) override;
 
 private:
+    struct GeometryState;
+
     void convert(float* fft_input, const float* audio_stream, size_t frames);
-    void run_fft();
-    void drop_from_front(size_t frames);
+    void reserve(const FFTGeometry& geometry);
+    void run_ffts();
+    void run_ffts(GeometryState& state);
 
 private:
     size_t m_sample_rate;
@@ -44,14 +73,13 @@ private:
     bool m_average;
     size_t m_fft_sample_size;
 
+    //  Ring buffer of the converted samples. Sample "i" of the stream is at
+    //  "m_buffer[i % m_buffer.size()]".
+    //  The stream starts with a buffer's worth of zeros.
     AlignedVector<float> m_buffer;
-    size_t m_buffered = 0;
-    size_t m_start = 0;
-    size_t m_end = 0;
-
-    AlignedVector<float> m_fft_input;
+    uint64_t m_written;
 
-    std::set<FFTListener*> m_listeners;
+    std::map<FFTGeometry, std::unique_ptr<GeometryState>> m_geometries;
 };
 
 
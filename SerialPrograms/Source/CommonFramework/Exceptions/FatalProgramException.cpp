@@ -16,7 +16,9 @@ namespace PokemonAutomation{
 
 FatalProgramException::FatalProgramException(ScreenshotException&& e)
     : ScreenshotException(e.m_send_error_report, std::move(e.m_message), std::move(e.m_screenshot))
-{}
+{
+    m_console_logger = e.m_console_logger;
+}
 FatalProgramException::FatalProgramException(ErrorReport error_report, Logger& logger, std::string message)
     : ScreenshotException(error_report, std::move(message))
 {
@@ -41,7 +43,7 @@ void FatalProgramException::send_notification(ProgramEnvironment& env, EventNoti
     }
     if (m_send_error_report == ErrorReport::SEND_ERROR_REPORT && m_screenshot){
         std::string label = name();
-        std::string filename = dump_image_alone(env.logger(), env.program_info(), label, *m_screenshot);
+        std::string filename = dump_image_alone(env.logger(), env.program_info(), label, *m_screenshot, m_console_logger);
         send_program_telemetry(
             env.logger(), true, COLOR_RED,
             env.program_info(),
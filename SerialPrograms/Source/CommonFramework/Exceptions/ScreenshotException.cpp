@@ -24,6 +24,7 @@ ScreenshotException::ScreenshotException(ErrorReport error_report, std::string m
 ScreenshotException::ScreenshotException(ErrorReport error_report, ConsoleHandle& console, std::string message, bool take_screenshot)
     : m_send_error_report(error_report)
     , m_message(std::move(message))
+    , m_console_logger(&console.logger())
 {
     if (take_screenshot){
         m_screenshot = console.video().snapshot().frame;
@@ -18,6 +18,7 @@ class EventNotificationOption;
 struct ProgramInfo;
 class ProgramEnvironment;
 class ConsoleHandle;
+class Logger;
 
 
 enum class ErrorReport{
@@ -46,6 +47,10 @@ public:
     ErrorReport m_send_error_report;
     std::string m_message;
     std::shared_ptr<const ImageRGB32> m_screenshot;
+
+    //  The logger of the console this was thrown on. Only used to find its
+    //  recent video for the error dump. Never dereferenced. (may be null)
+    const Logger* m_console_logger = nullptr;
 };
 
 
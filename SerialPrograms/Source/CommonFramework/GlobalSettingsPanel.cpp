@@ -8,6 +8,7 @@
 #include <set>
 #include <QCryptographicHash>
 #include "Common/Cpp/LifetimeSanitizer.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
@@ -52,6 +53,43 @@ ResolutionOption::ResolutionOption(
 
 
 
+VideoRecordingOption::VideoRecordingOption()
+    : GroupOption("Recent Video Recording", LockWhileRunning::LOCKED, true, false)
+    , DESCRIPTION(
+        "Keep the last few seconds of video of each console in memory. "
+        "When a program error is saved to ErrorDumps, the video is saved next to it as an .mjpeg file. "
+        "Frames are downscaled and compressed in the background. Changes take effect when the program panel is reopened."
+    )
+    , SECONDS(
+        "<b>Seconds:</b><br>How many seconds of video to keep.",
+        LockWhileRunning::LOCKED,
+        30, 1, 600
+    )
+    , FRAMES_PER_SECOND(
+        "<b>Frames per Second:</b>",
+        LockWhileRunning::LOCKED,
+        5, 1, 30
+    )
+    , MAX_WIDTH(
+        "<b>Max Width:</b><br>Frames wider than this are downscaled.",
+        LockWhileRunning::LOCKED,
+        640, 160
+    )
+    , MAX_MEMORY_MB(
+        "<b>Max Memory (MB):</b><br>Per console. The oldest frames are dropped to stay under this.",
+        LockWhileRunning::LOCKED,
+        64, 1
+    )
+{
+    PA_ADD_STATIC(DESCRIPTION);
+    PA_ADD_OPTION(SECONDS);
+    PA_ADD_OPTION(FRAMES_PER_SECOND);
+    PA_ADD_OPTION(MAX_WIDTH);
+    PA_ADD_OPTION(MAX_MEMORY_MB);
+}
+
+
+
 
 PreloadSettings::PreloadSettings(){}
 PreloadSettings& PreloadSettings::instance(){
@@ -94,6 +132,7 @@ GlobalSettings& GlobalSettings::instance(){
     return settings;
 }
 GlobalSettings::~GlobalSettings(){
+    ENABLE_PIPELINE_TRACE.remove_listener(*this);
     ENABLE_LIFETIME_SANITIZER.remove_listener(*this);
 }
 GlobalSettings::GlobalSettings()
@@ -156,6 +195,14 @@ GlobalSettings::GlobalSettings()
         LockWhileRunning::UNLOCKED,
         false
     )
+    , SCREENSHOT_REUSE_THRESHOLD(
+        "<b>Screenshot Reuse Threshold:</b><br>"
+        "If a notification screenshot looks the same as a recently sent one, send the file that was already saved instead of saving a new one. "
+        "This is the largest difference (0-255) in the average color of any part of the screen that still counts as the same. "
+        "Only program status updates reuse screenshots. Set to zero to always save a new file.",
+        LockWhileRunning::UNLOCKED,
+        0
+    )
     , REALTIME_THREAD_PRIORITY0(
         "<b>Realtime Thread Priority:</b><br>"
         "Thread priority of real-time threads. (UI thread, audio threads)<br>"
@@ -209,12 +256,30 @@ GlobalSettings::GlobalSettings()
         LockWhileRunning::UNLOCKED,
         true
     )
+    , ENABLE_LAZY_FRAME_CONVERSION(
+        "<b>Enable Lazy Frame Conversion:</b><br>"
+        "Only convert the parts of each video frame that the inference callbacks actually look at.",
+        LockWhileRunning::UNLOCKED,
+        true
+    )
+    , ENABLE_INFERENCE_CACHES(
+        "<b>Enable Inference Caches:</b><br>"
+        "Let the inference callbacks on the same video frame share box stats and binarized boxes.",
+        LockWhileRunning::UNLOCKED,
+        true
+    )
     , ENABLE_LIFETIME_SANITIZER(
         "<b>Enable Lifetime Sanitizer: (for debugging)</b><br>"
         "Check for C++ object lifetime violations. Terminate program with stack dump if violations are found.",
         LockWhileRunning::UNLOCKED,
         IS_BETA_VERSION
     )
+    , ENABLE_PIPELINE_TRACE(
+        "<b>Record Pipeline Trace: (for debugging)</b><br>"
+        "Keep a timeline of the video, inference and serial pipeline. Error dumps will include it as a Chrome trace.",
+        LockWhileRunning::UNLOCKED,
+        false
+    )
     , DEVELOPER_TOKEN(
         true,
         "<b>Developer Token:</b><br>Restart application to take full effect after changing this.",
@@ -237,6 +302,7 @@ GlobalSettings::GlobalSettings()
     PA_ADD_OPTION(SAVE_DEBUG_IMAGES);
 //    PA_ADD_OPTION(NAUGHTY_MODE);
     PA_ADD_OPTION(HIDE_NOTIF_DISCORD_LINK);
+    PA_ADD_OPTION(SCREENSHOT_REUSE_THRESHOLD);
 
     PA_ADD_OPTION(REALTIME_THREAD_PRIORITY0);
     PA_ADD_OPTION(INFERENCE_PRIORITY0);
@@ -253,7 +319,13 @@ GlobalSettings::GlobalSettings()
 #if QT_VERSION_MAJOR == 5
     PA_ADD_OPTION(ENABLE_FRAME_SCREENSHOTS);
 #endif
+#if QT_VERSION_MAJOR == 6
+    PA_ADD_OPTION(ENABLE_LAZY_FRAME_CONVERSION);
+#endif
+    PA_ADD_OPTION(ENABLE_INFERENCE_CACHES);
+    PA_ADD_OPTION(VIDEO_RECORDING);
     PA_ADD_OPTION(ENABLE_LIFETIME_SANITIZER);
+    PA_ADD_OPTION(ENABLE_PIPELINE_TRACE);
 
     PA_ADD_OPTION(PROCESSOR_LEVEL0);
 
@@ -261,6 +333,7 @@ GlobalSettings::GlobalSettings()
 
     GlobalSettings::value_changed();
     ENABLE_LIFETIME_SANITIZER.add_listener(*this);
+    ENABLE_PIPELINE_TRACE.add_listener(*this);
 }
 
 void GlobalSettings::load_json(const JsonValue& json){
@@ -372,6 +445,8 @@ JsonValue GlobalSettings::to_json() const{
 }
 
 void GlobalSettings::value_changed(){
+    TraceRecorder::instance().set_enabled(ENABLE_PIPELINE_TRACE);
+
     bool enabled = ENABLE_LIFETIME_SANITIZER;
     LifetimeSanitizer::set_enabled(enabled);
     if (enabled){
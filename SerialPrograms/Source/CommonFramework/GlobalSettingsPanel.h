@@ -44,6 +44,19 @@ public:
 
 
 
+class VideoRecordingOption : public GroupOption{
+public:
+    VideoRecordingOption();
+
+    StaticTextOption DESCRIPTION;
+    SimpleIntegerOption<uint16_t> SECONDS;
+    SimpleIntegerOption<uint8_t> FRAMES_PER_SECOND;
+    SimpleIntegerOption<uint32_t> MAX_WIDTH;
+    SimpleIntegerOption<uint32_t> MAX_MEMORY_MB;
+};
+
+
+
 struct DebugSettings{
     bool COLOR_CHECK = false;
     bool IMAGE_TEMPLATE_MATCHING = false;
@@ -99,6 +112,7 @@ public:
 //    BooleanCheckBoxOption NAUGHTY_MODE_OPTION;
 
     BooleanCheckBoxOption HIDE_NOTIF_DISCORD_LINK;
+    SimpleIntegerOption<uint8_t> SCREENSHOT_REUSE_THRESHOLD;
 
 //    ProcessPriorityOption PROCESS_PRIORITY0;
     ThreadPriorityOption REALTIME_THREAD_PRIORITY0;
@@ -112,7 +126,11 @@ public:
     BooleanCheckBoxOption ENABLE_AUTO_RESET_AUDIO;
     VideoBackendOption VIDEO_BACKEND;
     BooleanCheckBoxOption ENABLE_FRAME_SCREENSHOTS;
+    BooleanCheckBoxOption ENABLE_LAZY_FRAME_CONVERSION;
+    BooleanCheckBoxOption ENABLE_INFERENCE_CACHES;
+    VideoRecordingOption VIDEO_RECORDING;
     BooleanCheckBoxOption ENABLE_LIFETIME_SANITIZER;
+    BooleanCheckBoxOption ENABLE_PIPELINE_TRACE;
 
     ProcessorLevelOption PROCESSOR_LEVEL0;
 
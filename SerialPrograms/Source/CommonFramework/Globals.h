@@ -32,6 +32,8 @@ const auto SERIAL_REFRESH_RATE = std::chrono::milliseconds(1000);
 
 extern const std::string SETTINGS_PATH;
 extern const std::string SCREENSHOTS_PATH;
+extern const std::string METRICS_PATH;
+extern const std::string WIRE_TRACES_PATH;
 const std::string& RESOURCE_PATH();
 const std::string& TRAINING_PATH();
 
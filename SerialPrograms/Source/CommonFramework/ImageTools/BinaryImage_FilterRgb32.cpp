@@ -8,6 +8,7 @@
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
 #include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "BinaryMatrixCache.h"
 #include "BinaryImage_FilterRgb32.h"
 
 //#include <iostream>
@@ -110,18 +111,22 @@ PackedBinaryMatrix compress_rgb32_to_binary_range(
     uint8_t min_green, uint8_t max_green,
     uint8_t min_blue, uint8_t max_blue
 ){
-    PackedBinaryMatrix ret(image.width(), image.height());
-    Kernels::compress_rgb32_to_binary_range(
-        image.data(), image.bytes_per_row(), ret,
+    return compress_rgb32_to_binary_range(
+        image,
         ((uint32_t)min_alpha << 24) | ((uint32_t)min_red << 16) | ((uint32_t)min_green << 8) | (uint32_t)min_blue,
         ((uint32_t)max_alpha << 24) | ((uint32_t)max_red << 16) | ((uint32_t)max_green << 8) | (uint32_t)max_blue
     );
-    return ret;
 }
 PackedBinaryMatrix compress_rgb32_to_binary_range(
     const ImageViewRGB32& image,
     uint32_t mins, uint32_t maxs
 ){
+    //  Another callback may have already done this on the same frame.
+    std::shared_ptr<const PackedBinaryMatrix> cached = BinaryMatrixCache::get_current(image, mins, maxs);
+    if (cached){
+        return cached->copy();
+    }
+
     PackedBinaryMatrix ret(image.width(), image.height());
     Kernels::compress_rgb32_to_binary_range(
         image.data(), image.bytes_per_row(),
@@ -134,6 +139,15 @@ std::vector<PackedBinaryMatrix> compress_rgb32_to_binary_range(
     const std::vector<std::pair<uint32_t, uint32_t>>& filters
 ){
     std::vector<PackedBinaryMatrix> ret;
+
+    std::vector<std::shared_ptr<const PackedBinaryMatrix>> cached = BinaryMatrixCache::get_current(image, filters);
+    if (!cached.empty()){
+        for (const std::shared_ptr<const PackedBinaryMatrix>& matrix : cached){
+            ret.emplace_back(matrix->copy());
+        }
+        return ret;
+    }
+
     FixedLimitVector<Kernels::CompressRgb32ToBinaryRangeFilter> vec(filters.size());
     for (size_t c = 0; c < filters.size(); c++){
         ret.emplace_back(image.width(), image.height());
@@ -0,0 +1,202 @@
+/*  Binary Matrix Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/VideoPipeline/LazyVideoFrame.h"
+#include "BinaryMatrixCache.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+struct BinaryMatrixCacheMetrics{
+    std::shared_ptr<MetricsRegistry::Counter> hits;
+    std::shared_ptr<MetricsRegistry::Counter> misses;
+
+    BinaryMatrixCacheMetrics()
+        : hits(MetricsRegistry::instance().counter("binary_matrix_cache_hits"))
+        , misses(MetricsRegistry::instance().counter("binary_matrix_cache_misses"))
+    {}
+};
+static BinaryMatrixCacheMetrics& binary_matrix_cache_metrics(){
+    static BinaryMatrixCacheMetrics metrics;
+    return metrics;
+}
+
+
+
+BinaryMatrixCache::BinaryMatrixCache(std::shared_ptr<const ImageRGB32> frame, History history)
+    : m_frame(std::move(frame))
+    , m_image(*m_frame)
+    , m_expected(std::move(history))
+{}
+BinaryMatrixCache::BinaryMatrixCache(std::shared_ptr<LazyVideoFrame> frame, History history)
+    : m_lazy(std::move(frame))
+    , m_image(m_lazy->backing_image())
+    , m_expected(std::move(history))
+{}
+
+
+bool BinaryMatrixCache::locate(Region& region, const ImageViewRGB32& image) const{
+    if (!image || image.bytes_per_row() != m_image.bytes_per_row()){
+        return false;
+    }
+    if (image.width() * image.height() < MIN_CACHED_PIXELS){
+        return false;
+    }
+
+    //  Recover the position of the image within the frame.
+    uintptr_t base = (uintptr_t)m_image.data();
+    uintptr_t ptr = (uintptr_t)image.data();
+    if (ptr < base){
+        return false;
+    }
+    size_t offset = ptr - base;
+    size_t bytes_per_row = m_image.bytes_per_row();
+    if (offset % bytes_per_row % sizeof(uint32_t) != 0){
+        return false;
+    }
+    region.min_x = offset % bytes_per_row / sizeof(uint32_t);
+    region.min_y = offset / bytes_per_row;
+    region.width = image.width();
+    region.height = image.height();
+    return region.min_x + region.width <= m_image.width() && region.min_y + region.height <= m_image.height();
+}
+
+void BinaryMatrixCache::run_filters(const Region& region, const ImageViewRGB32& image, const std::vector<Filter>& filters){
+    std::map<Filter, Entry>& results = m_results[region];
+
+    std::vector<Filter> pending;
+    for (const Filter& filter : filters){
+        if (results.find(filter) == results.end()){
+            pending.emplace_back(filter);
+        }
+    }
+    if (pending.empty()){
+        return;
+    }
+
+    //  Add everything that the last frame asked for on this region. They
+    //  are almost free once we're already reading the pixels.
+    auto expected = m_expected.find(region);
+    if (expected != m_expected.end()){
+        for (const Filter& filter : expected->second){
+            if (results.find(filter) == results.end() && std::find(pending.begin(), pending.end(), filter) == pending.end()){
+                pending.emplace_back(filter);
+            }
+        }
+        m_expected.erase(expected);
+    }
+
+    std::vector<std::shared_ptr<PackedBinaryMatrix>> matrices;
+    FixedLimitVector<Kernels::CompressRgb32ToBinaryRangeFilter> kernels(pending.size());
+    for (const Filter& filter : pending){
+        matrices.emplace_back(std::make_shared<PackedBinaryMatrix>(image.width(), image.height()));
+        kernels.emplace_back(*matrices.back(), filter.first, filter.second);
+    }
+    Kernels::compress_rgb32_to_binary_range(
+        image.data(), image.bytes_per_row(),
+        kernels.data(), kernels.size()
+    );
+    for (size_t c = 0; c < pending.size(); c++){
+        results[pending[c]].matrix = std::move(matrices[c]);
+    }
+}
+
+std::shared_ptr<const PackedBinaryMatrix> BinaryMatrixCache::get(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+){
+    std::vector<std::shared_ptr<const PackedBinaryMatrix>> ret = get(image, {{mins, maxs}});
+    return ret.empty() ? nullptr : std::move(ret[0]);
+}
+std::vector<std::shared_ptr<const PackedBinaryMatrix>> BinaryMatrixCache::get(
+    const ImageViewRGB32& image,
+    const std::vector<Filter>& filters
+){
+    std::vector<std::shared_ptr<const PackedBinaryMatrix>> ret;
+    Region region;
+    if (!locate(region, image)){
+        return ret;
+    }
+
+    BinaryMatrixCacheMetrics& metrics = binary_matrix_cache_metrics();
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::map<Filter, Entry>& results = m_results[region];
+    size_t hits = 0;
+    for (const Filter& filter : filters){
+        hits += results.find(filter) != results.end();
+    }
+    metrics.hits->fetch_add(hits, std::memory_order_relaxed);
+    metrics.misses->fetch_add(filters.size() - hits, std::memory_order_relaxed);
+
+    run_filters(region, image, filters);
+
+    for (const Filter& filter : filters){
+        Entry& entry = results[filter];
+        entry.requested = true;
+        ret.emplace_back(entry.matrix);
+    }
+    return ret;
+}
+
+BinaryMatrixCache::History BinaryMatrixCache::history() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    History ret;
+    for (const auto& region : m_results){
+        std::vector<Filter> filters;
+        for (const auto& item : region.second){
+            if (item.second.requested){
+                filters.emplace_back(item.first);
+            }
+        }
+        if (!filters.empty()){
+            ret.emplace(region.first, std::move(filters));
+        }
+    }
+    return ret;
+}
+
+
+
+thread_local BinaryMatrixCache* current_binary_matrix_cache = nullptr;
+
+std::shared_ptr<const PackedBinaryMatrix> BinaryMatrixCache::get_current(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+){
+    BinaryMatrixCache* cache = current_binary_matrix_cache;
+    return cache == nullptr ? nullptr : cache->get(image, mins, maxs);
+}
+std::vector<std::shared_ptr<const PackedBinaryMatrix>> BinaryMatrixCache::get_current(
+    const ImageViewRGB32& image,
+    const std::vector<Filter>& filters
+){
+    BinaryMatrixCache* cache = current_binary_matrix_cache;
+    return cache == nullptr
+        ? std::vector<std::shared_ptr<const PackedBinaryMatrix>>()
+        : cache->get(image, filters);
+}
+
+BinaryMatrixCacheScope::BinaryMatrixCacheScope(BinaryMatrixCache* cache)
+    : m_previous(current_binary_matrix_cache)
+{
+    current_binary_matrix_cache = cache;
+}
+BinaryMatrixCacheScope::~BinaryMatrixCacheScope(){
+    current_binary_matrix_cache = m_previous;
+}
+
+
+
+}
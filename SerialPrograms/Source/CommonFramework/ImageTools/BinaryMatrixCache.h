@@ -0,0 +1,136 @@
+/*  Binary Matrix Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Caches the results of "compress_rgb32_to_binary_range()" over a single
+ *  frame. Different callbacks on the same frame often binarize the same box
+ *  with the same color range. (e.g. white text, black borders) With this,
+ *  only the first one pays for it.
+ *
+ *  Results are keyed by the box within the frame and the filter range. They
+ *  are shared and immutable.
+ *
+ *  The cache also remembers which filters were asked for on each box. The
+ *  cache of the next frame starts with that list. The first time a box is
+ *  asked for on the next frame, all the filters that are expected on that box
+ *  are run together in one pass over the pixels.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_BinaryMatrixCache_H
+#define PokemonAutomation_CommonFramework_BinaryMatrixCache_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+
+namespace PokemonAutomation{
+
+class ImageRGB32;
+class LazyVideoFrame;
+
+
+class BinaryMatrixCache{
+public:
+    //  Boxes smaller than this many pixels are cheaper to just redo.
+    static constexpr size_t MIN_CACHED_PIXELS = 64 * 64;
+
+    struct Region{
+        size_t min_x;
+        size_t min_y;
+        size_t width;
+        size_t height;
+
+        friend bool operator<(const Region& a, const Region& b){
+            if (a.min_x != b.min_x) return a.min_x < b.min_x;
+            if (a.min_y != b.min_y) return a.min_y < b.min_y;
+            if (a.width != b.width) return a.width < b.width;
+            return a.height < b.height;
+        }
+    };
+    using Filter = std::pair<uint32_t, uint32_t>;
+
+    //  The filters that were asked for on each box.
+    using History = std::map<Region, std::vector<Filter>>;
+
+public:
+    BinaryMatrixCache(std::shared_ptr<const ImageRGB32> frame, History history = History());
+    BinaryMatrixCache(std::shared_ptr<LazyVideoFrame> frame, History history = History());
+
+    //  Same as "compress_rgb32_to_binary_range()". Returns null if "image"
+    //  isn't a sub-image of this frame or is too small to cache.
+    std::shared_ptr<const PackedBinaryMatrix> get(
+        const ImageViewRGB32& image,
+        uint32_t mins, uint32_t maxs
+    );
+
+    //  Same as above, but for many filters at once. Any that aren't cached
+    //  yet are run in one pass. Returns an empty vector if "image" can't be
+    //  cached.
+    std::vector<std::shared_ptr<const PackedBinaryMatrix>> get(
+        const ImageViewRGB32& image,
+        const std::vector<Filter>& filters
+    );
+
+    //  Same as above, but using the cache of the current thread (if any).
+    //  See BinaryMatrixCacheScope.
+    static std::shared_ptr<const PackedBinaryMatrix> get_current(
+        const ImageViewRGB32& image,
+        uint32_t mins, uint32_t maxs
+    );
+    static std::vector<std::shared_ptr<const PackedBinaryMatrix>> get_current(
+        const ImageViewRGB32& image,
+        const std::vector<Filter>& filters
+    );
+
+    //  Pass this to the cache of the next frame.
+    History history() const;
+
+
+private:
+    struct Entry{
+        std::shared_ptr<const PackedBinaryMatrix> matrix;
+        bool requested = false;
+    };
+
+    bool locate(Region& region, const ImageViewRGB32& image) const;
+
+    //  Run "filters" and everything that is still expected on this region.
+    void run_filters(const Region& region, const ImageViewRGB32& image, const std::vector<Filter>& filters);
+
+
+private:
+    std::shared_ptr<const ImageRGB32> m_frame;
+    std::shared_ptr<LazyVideoFrame> m_lazy;
+    ImageViewRGB32 m_image;
+
+    mutable std::mutex m_lock;
+    std::map<Region, std::map<Filter, Entry>> m_results;
+    History m_expected;
+};
+
+
+
+//  While this is alive, all the calls to "compress_rgb32_to_binary_range()"
+//  on this thread will use "cache" for any image that is a sub-image of its
+//  frame.
+class BinaryMatrixCacheScope{
+public:
+    BinaryMatrixCacheScope(const BinaryMatrixCacheScope&) = delete;
+    void operator=(const BinaryMatrixCacheScope&) = delete;
+
+    BinaryMatrixCacheScope(BinaryMatrixCache* cache);
+    ~BinaryMatrixCacheScope();
+
+private:
+    BinaryMatrixCache* m_previous;
+};
+
+
+
+}
+#endif
@@ -9,6 +9,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "ImageBoxes.h"
+#include "ImageStatsCache.h"
 #include "ImageStats.h"
 
 #include <iostream>
@@ -19,26 +20,28 @@ namespace PokemonAutomation{
 
 
 
-FloatPixel image_average(const ImageViewRGB32& image){
+//  If the image is part of a frame with a stats cache, the sums come from the
+//  cache instead. See ImageStatsCache.h.
+static Kernels::PixelSums pixel_sums(const ImageViewRGB32& image){
     Kernels::PixelSums sums;
+    if (ImageStatsCache::try_current(sums, image)){
+        return sums;
+    }
     Kernels::pixel_sum_sqr(
         sums, image.width(), image.height(),
         image.data(), image.bytes_per_row(),
         image.data(), image.bytes_per_row()
     );
+    return sums;
+}
+
 
+FloatPixel image_average(const Kernels::PixelSums& sums){
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
 
     return sum / (double)sums.count;
 }
-FloatPixel image_stddev(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
-
+FloatPixel image_stddev(const Kernels::PixelSums& sums){
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
 
@@ -50,14 +53,7 @@ FloatPixel image_stddev(const ImageViewRGB32& image){
         std::sqrt(variance.b)
     );
 }
-ImageStats image_stats(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
-
+ImageStats image_stats(const Kernels::PixelSums& sums){
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
 
@@ -70,7 +66,18 @@ ImageStats image_stats(const ImageViewRGB32& image){
         std::sqrt(variance.b)
     );
 
-    ImageStats stats(average, stddev, sums.count);
+    return ImageStats(average, stddev, sums.count);
+}
+
+
+FloatPixel image_average(const ImageViewRGB32& image){
+    return image_average(pixel_sums(image));
+}
+FloatPixel image_stddev(const ImageViewRGB32& image){
+    return image_stddev(pixel_sums(image));
+}
+ImageStats image_stats(const ImageViewRGB32& image){
+    ImageStats stats = image_stats(pixel_sums(image));
 
     if (PreloadSettings::debug().COLOR_CHECK){
         std::cout << "Compute imageStats: avg " << stats.average.to_string() << " (sum " << stats.average.sum()
@@ -11,6 +11,9 @@
 
 namespace PokemonAutomation{
     class ImageViewRGB32;
+namespace Kernels{
+    struct PixelSums;
+}
 
 // Store basic stats of a group of pixels
 struct ImageStats{
@@ -31,6 +34,11 @@ FloatPixel image_average(const ImageViewRGB32& image);
 FloatPixel image_stddev(const ImageViewRGB32& image);
 ImageStats image_stats(const ImageViewRGB32& image);
 
+//  Same as above, but from sums that have already been computed.
+FloatPixel image_average(const Kernels::PixelSums& sums);
+FloatPixel image_stddev(const Kernels::PixelSums& sums);
+ImageStats image_stats(const Kernels::PixelSums& sums);
+
 
 ImageStats image_border_stats(const ImageViewRGB32& image);
 
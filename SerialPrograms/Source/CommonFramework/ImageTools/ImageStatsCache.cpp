@@ -0,0 +1,351 @@
+/*  Image Stats Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrIntegral.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/VideoPipeline/LazyVideoFrame.h"
+#include "ImageStatsCache.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+static constexpr size_t LANES = Kernels::PIXEL_INTEGRAL_LANES;
+static constexpr size_t INTEGRAL_SIZE = (ImageStatsCache::TILE_SIZE + 1) * (ImageStatsCache::TILE_SIZE + 1) * LANES;
+
+
+//  A new cache is made for every frame. Recycle the integral buffers so that
+//  each frame isn't paying to fault in fresh memory.
+class IntegralBufferPool{
+public:
+    std::unique_ptr<uint32_t[]> get(){
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            if (!m_buffers.empty()){
+                std::unique_ptr<uint32_t[]> ret = std::move(m_buffers.back());
+                m_buffers.pop_back();
+                return ret;
+            }
+        }
+        return std::unique_ptr<uint32_t[]>(new uint32_t[INTEGRAL_SIZE]);
+    }
+    void put(std::vector<std::unique_ptr<uint32_t[]>>& buffers){
+        std::lock_guard<std::mutex> lg(m_lock);
+        for (std::unique_ptr<uint32_t[]>& buffer : buffers){
+            if (m_buffers.size() >= MAX_BUFFERS){
+                break;
+            }
+            m_buffers.emplace_back(std::move(buffer));
+        }
+    }
+
+private:
+    static constexpr size_t MAX_BUFFERS = 256;
+    std::mutex m_lock;
+    std::vector<std::unique_ptr<uint32_t[]>> m_buffers;
+};
+IntegralBufferPool& integral_buffer_pool(){
+    static IntegralBufferPool pool;
+    return pool;
+}
+
+
+struct ImageStatsCache::Tile{
+    size_t min_x;
+    size_t min_y;
+    size_t width;
+    size_t height;
+
+    bool has_pixels = false;
+    bool has_totals = false;
+    Kernels::PixelSums totals;
+
+    //  Number of queries that have touched this tile.
+    size_t hits = 0;
+
+    //  Integral image with (height + 1) rows of (width + 1) entries. Row 0
+    //  and column 0 are zero. A 32x32 tile can't overflow 32 bits even for
+    //  the sums of squares.
+    std::unique_ptr<uint32_t[]> integral;
+
+    size_t stride() const{ return (width + 1) * LANES; }
+
+    //  Add the sums over [x0, x1) x [y0, y1) in tile coordinates.
+    void add_sums(Kernels::PixelSums& sums, size_t x0, size_t y0, size_t x1, size_t y1) const{
+        const uint32_t* top = integral.get() + y0 * stride();
+        const uint32_t* bot = integral.get() + y1 * stride();
+        uint32_t lanes[LANES];
+        for (size_t l = 0; l < LANES; l++){
+            lanes[l] = bot[x1*LANES + l] - top[x1*LANES + l] - bot[x0*LANES + l] + top[x0*LANES + l];
+        }
+        sums.count += lanes[Kernels::PIXEL_INTEGRAL_COUNT];
+        sums.sumR += lanes[Kernels::PIXEL_INTEGRAL_SUM_R];
+        sums.sumG += lanes[Kernels::PIXEL_INTEGRAL_SUM_G];
+        sums.sumB += lanes[Kernels::PIXEL_INTEGRAL_SUM_B];
+        sums.sqrR += lanes[Kernels::PIXEL_INTEGRAL_SQR_R];
+        sums.sqrG += lanes[Kernels::PIXEL_INTEGRAL_SQR_G];
+        sums.sqrB += lanes[Kernels::PIXEL_INTEGRAL_SQR_B];
+    }
+};
+
+
+
+ImageStatsCache::ImageStatsCache(std::shared_ptr<const ImageRGB32> frame)
+    : m_frame(std::move(frame))
+    , m_image(*m_frame)
+    , m_width(m_image.width())
+    , m_height(m_image.height())
+    , m_tiles_x((m_width + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles_y((m_height + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles(m_tiles_x * m_tiles_y)
+{
+    for (size_t ty = 0; ty < m_tiles_y; ty++){
+        for (size_t tx = 0; tx < m_tiles_x; tx++){
+            Tile& tile = m_tiles[ty * m_tiles_x + tx];
+            tile.min_x = tx * TILE_SIZE;
+            tile.min_y = ty * TILE_SIZE;
+            tile.width = std::min(TILE_SIZE, m_width - tile.min_x);
+            tile.height = std::min(TILE_SIZE, m_height - tile.min_y);
+            tile.has_pixels = true;
+        }
+    }
+}
+ImageStatsCache::ImageStatsCache(std::shared_ptr<LazyVideoFrame> frame)
+    : m_lazy(std::move(frame))
+    , m_image(m_lazy->backing_image())
+    , m_width(m_image.width())
+    , m_height(m_image.height())
+    , m_tiles_x((m_width + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles_y((m_height + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles(m_tiles_x * m_tiles_y)
+{
+    for (size_t ty = 0; ty < m_tiles_y; ty++){
+        for (size_t tx = 0; tx < m_tiles_x; tx++){
+            Tile& tile = m_tiles[ty * m_tiles_x + tx];
+            tile.min_x = tx * TILE_SIZE;
+            tile.min_y = ty * TILE_SIZE;
+            tile.width = std::min(TILE_SIZE, m_width - tile.min_x);
+            tile.height = std::min(TILE_SIZE, m_height - tile.min_y);
+        }
+    }
+}
+ImageStatsCache::~ImageStatsCache(){
+    std::vector<std::unique_ptr<uint32_t[]>> buffers;
+    for (Tile& tile : m_tiles){
+        if (tile.integral){
+            buffers.emplace_back(std::move(tile.integral));
+        }
+    }
+    integral_buffer_pool().put(buffers);
+}
+
+
+
+void ImageStatsCache::ensure_tile_pixels(size_t tx, size_t ty){
+    Tile& tile = m_tiles[ty * m_tiles_x + tx];
+    if (tile.has_pixels){
+        return;
+    }
+    m_lazy->extract_box_reference(ImagePixelBox(
+        tile.min_x, tile.min_y,
+        tile.min_x + tile.width, tile.min_y + tile.height
+    ));
+    tile.has_pixels = true;
+}
+const Kernels::PixelSums& ImageStatsCache::tile_totals(size_t tx, size_t ty){
+    Tile& tile = m_tiles[ty * m_tiles_x + tx];
+    if (tile.has_totals){
+        return tile.totals;
+    }
+
+    if (tile.integral){
+        tile.add_sums(tile.totals, 0, 0, tile.width, tile.height);
+    }else{
+        ensure_tile_pixels(tx, ty);
+        ImageViewRGB32 pixels = m_image.sub_image(tile.min_x, tile.min_y, tile.width, tile.height);
+        Kernels::pixel_sum_sqr(
+            tile.totals, tile.width, tile.height,
+            pixels.data(), pixels.bytes_per_row(),
+            pixels.data(), pixels.bytes_per_row()
+        );
+    }
+
+    tile.has_totals = true;
+    return tile.totals;
+}
+const ImageStatsCache::Tile& ImageStatsCache::tile_integral(size_t tx, size_t ty){
+    Tile& tile = m_tiles[ty * m_tiles_x + tx];
+    if (tile.integral){
+        return tile;
+    }
+    ensure_tile_pixels(tx, ty);
+
+    ImageViewRGB32 pixels = m_image.sub_image(tile.min_x, tile.min_y, tile.width, tile.height);
+    tile.integral = integral_buffer_pool().get();
+    Kernels::pixel_sum_sqr_integral(
+        tile.integral.get(), tile.stride(),
+        tile.width, tile.height,
+        pixels.data(), pixels.bytes_per_row()
+    );
+
+    return tile;
+}
+
+
+
+Kernels::PixelSums ImageStatsCache::pixel_sums(const ImagePixelBox& box){
+    Kernels::PixelSums sums;
+
+    size_t min_x = std::min(box.min_x, m_width);
+    size_t min_y = std::min(box.min_y, m_height);
+    size_t max_x = std::min(box.max_x, m_width);
+    size_t max_y = std::min(box.max_y, m_height);
+    if (min_x >= max_x || min_y >= max_y){
+        return sums;
+    }
+
+    size_t tile_min_x = min_x / TILE_SIZE;
+    size_t tile_min_y = min_y / TILE_SIZE;
+    size_t tile_max_x = (max_x + TILE_SIZE - 1) / TILE_SIZE;
+    size_t tile_max_y = (max_y + TILE_SIZE - 1) / TILE_SIZE;
+
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    //  If any tile isn't ready yet, scan the box directly. So a box that is
+    //  only asked for once costs the same as without the cache. Tiles are
+    //  only built when they are touched a second time.
+    bool ready = true;
+    for (size_t ty = tile_min_y; ty < tile_max_y; ty++){
+        for (size_t tx = tile_min_x; tx < tile_max_x; tx++){
+            Tile& tile = m_tiles[ty * m_tiles_x + tx];
+            bool full =
+                min_x <= tile.min_x && tile.min_x + tile.width <= max_x &&
+                min_y <= tile.min_y && tile.min_y + tile.height <= max_y;
+            if (full ? tile.has_totals : tile.integral != nullptr){
+                continue;
+            }
+            if (tile.hits++ == 0){
+                ready = false;
+                continue;
+            }
+            if (full){
+                tile_totals(tx, ty);
+            }else{
+                tile_integral(tx, ty);
+            }
+        }
+    }
+    if (!ready){
+        if (m_lazy){
+            m_lazy->extract_box_reference(ImagePixelBox(min_x, min_y, max_x, max_y));
+        }
+        ImageViewRGB32 pixels = m_image.sub_image(min_x, min_y, max_x - min_x, max_y - min_y);
+        Kernels::pixel_sum_sqr(
+            sums, pixels.width(), pixels.height(),
+            pixels.data(), pixels.bytes_per_row(),
+            pixels.data(), pixels.bytes_per_row()
+        );
+        return sums;
+    }
+
+    for (size_t ty = tile_min_y; ty < tile_max_y; ty++){
+        for (size_t tx = tile_min_x; tx < tile_max_x; tx++){
+            const Tile& tile = m_tiles[ty * m_tiles_x + tx];
+
+            //  The part of the box inside this tile in tile coordinates.
+            size_t x0 = std::max(min_x, tile.min_x) - tile.min_x;
+            size_t y0 = std::max(min_y, tile.min_y) - tile.min_y;
+            size_t x1 = std::min(max_x, tile.min_x + tile.width) - tile.min_x;
+            size_t y1 = std::min(max_y, tile.min_y + tile.height) - tile.min_y;
+
+            if (x0 == 0 && y0 == 0 && x1 == tile.width && y1 == tile.height){
+                sums.count += tile.totals.count;
+                sums.sumR += tile.totals.sumR;
+                sums.sumG += tile.totals.sumG;
+                sums.sumB += tile.totals.sumB;
+                sums.sqrR += tile.totals.sqrR;
+                sums.sqrG += tile.totals.sqrG;
+                sums.sqrB += tile.totals.sqrB;
+            }else{
+                tile.add_sums(sums, x0, y0, x1, y1);
+            }
+        }
+    }
+
+    return sums;
+}
+bool ImageStatsCache::try_pixel_sums(Kernels::PixelSums& sums, const ImageViewRGB32& image){
+    if (!image || image.bytes_per_row() != m_image.bytes_per_row()){
+        return false;
+    }
+    if (image.width() * image.height() < MIN_CACHED_PIXELS){
+        return false;
+    }
+
+    //  Recover the position of the image within the frame.
+    uintptr_t base = (uintptr_t)m_image.data();
+    uintptr_t ptr = (uintptr_t)image.data();
+    if (ptr < base){
+        return false;
+    }
+    size_t offset = ptr - base;
+    size_t bytes_per_row = m_image.bytes_per_row();
+    if (offset % bytes_per_row % sizeof(uint32_t) != 0){
+        return false;
+    }
+    size_t min_y = offset / bytes_per_row;
+    size_t min_x = offset % bytes_per_row / sizeof(uint32_t);
+    if (min_x + image.width() > m_width || min_y + image.height() > m_height){
+        return false;
+    }
+
+    sums = pixel_sums(ImagePixelBox(min_x, min_y, min_x + image.width(), min_y + image.height()));
+    return true;
+}
+
+ImageStats ImageStatsCache::image_stats(const ImagePixelBox& box){
+    return PokemonAutomation::image_stats(pixel_sums(box));
+}
+ImageStats ImageStatsCache::image_stats(const ImageFloatBox& box){
+    //  Same rounding as "extract_box_reference()".
+    size_t min_x = (size_t)(m_width * box.x + 0.5);
+    size_t min_y = (size_t)(m_height * box.y + 0.5);
+    size_t width = (size_t)(m_width * box.width + 0.5);
+    size_t height = (size_t)(m_height * box.height + 0.5);
+    return image_stats(ImagePixelBox(min_x, min_y, min_x + width, min_y + height));
+}
+FloatPixel ImageStatsCache::image_average(const ImageFloatBox& box){
+    return image_stats(box).average;
+}
+FloatPixel ImageStatsCache::image_stddev(const ImageFloatBox& box){
+    return image_stats(box).stddev;
+}
+
+
+
+thread_local ImageStatsCache* current_image_stats_cache = nullptr;
+
+bool ImageStatsCache::try_current(Kernels::PixelSums& sums, const ImageViewRGB32& image){
+    ImageStatsCache* cache = current_image_stats_cache;
+    return cache != nullptr && cache->try_pixel_sums(sums, image);
+}
+
+ImageStatsCacheScope::ImageStatsCacheScope(ImageStatsCache* cache)
+    : m_previous(current_image_stats_cache)
+{
+    current_image_stats_cache = cache;
+}
+ImageStatsCacheScope::~ImageStatsCacheScope(){
+    current_image_stats_cache = m_previous;
+}
+
+
+
+}
@@ -0,0 +1,117 @@
+/*  Image Stats Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Caches pixel sums over a single frame so that many detectors can ask
+ *  for the stats of overlapping boxes without rescanning the same pixels.
+ *
+ *  The frame is split into tiles. Tiles that are fully inside a box only need
+ *  their totals. Tiles that are cut by the edge of a box get an integral image
+ *  of the sums and sums of squares. Once the tiles under a box are built, the
+ *  box is answered from a handful of lookups per tile.
+ *
+ *  Tiles are only built the second time they are touched. Until then, boxes
+ *  are scanned directly. So boxes that are only looked at once don't cost
+ *  more than they did before.
+ *
+ *  Everything is built on demand. Tiles that are never looked at are never
+ *  read. For lazy frames, they are never converted either.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageStatsCache_H
+#define PokemonAutomation_CommonFramework_ImageStatsCache_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "ImageBoxes.h"
+#include "ImageStats.h"
+
+namespace PokemonAutomation{
+
+class ImageRGB32;
+class LazyVideoFrame;
+
+
+class ImageStatsCache{
+public:
+    //  Smaller tiles mean less to build along the edges of each box.
+    //  Larger tiles mean fewer tiles to add up inside each box.
+    static constexpr size_t TILE_SIZE = 32;
+
+    //  Boxes smaller than this many pixels are cheaper to just scan.
+    static constexpr size_t MIN_CACHED_PIXELS = 64 * 64;
+
+public:
+    ImageStatsCache(std::shared_ptr<const ImageRGB32> frame);
+    ImageStatsCache(std::shared_ptr<LazyVideoFrame> frame);
+    ~ImageStatsCache();
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+    //  Same as the functions in ImageStats.h, but for a box of this frame.
+    FloatPixel image_average(const ImageFloatBox& box);
+    FloatPixel image_stddev(const ImageFloatBox& box);
+    ImageStats image_stats(const ImageFloatBox& box);
+    ImageStats image_stats(const ImagePixelBox& box);
+
+    //  Return the pixel sums of the box. The box is clipped to the frame.
+    Kernels::PixelSums pixel_sums(const ImagePixelBox& box);
+
+    //  If "image" is a sub-image of this frame, return its pixel sums from
+    //  the cache and return true. Otherwise return false.
+    bool try_pixel_sums(Kernels::PixelSums& sums, const ImageViewRGB32& image);
+
+    //  Same as above, but using the cache of the current thread (if any).
+    //  See ImageStatsCacheScope.
+    static bool try_current(Kernels::PixelSums& sums, const ImageViewRGB32& image);
+
+
+private:
+    struct Tile;
+
+    void ensure_tile_pixels(size_t tx, size_t ty);
+    const Kernels::PixelSums& tile_totals(size_t tx, size_t ty);
+    const Tile& tile_integral(size_t tx, size_t ty);
+
+
+private:
+    std::shared_ptr<const ImageRGB32> m_frame;
+    std::shared_ptr<LazyVideoFrame> m_lazy;
+    ImageViewRGB32 m_image;
+
+    size_t m_width;
+    size_t m_height;
+    size_t m_tiles_x;
+    size_t m_tiles_y;
+
+    std::mutex m_lock;
+    std::vector<Tile> m_tiles;
+};
+
+
+
+//  While this is alive, all the calls to "image_stats()", "image_average()"
+//  and "image_stddev()" on this thread will use "cache" for any image that is
+//  a sub-image of its frame.
+class ImageStatsCacheScope{
+public:
+    ImageStatsCacheScope(const ImageStatsCacheScope&) = delete;
+    void operator=(const ImageStatsCacheScope&) = delete;
+
+    ImageStatsCacheScope(ImageStatsCache* cache);
+    ~ImageStatsCacheScope();
+
+private:
+    ImageStatsCache* m_previous;
+};
+
+
+
+}
+#endif
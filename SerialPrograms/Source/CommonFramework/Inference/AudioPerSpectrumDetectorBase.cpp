@@ -22,9 +22,11 @@ namespace PokemonAutomation{
 
 AudioPerSpectrumDetectorBase::AudioPerSpectrumDetectorBase(
     std::string label, std::string audio_name, Color detection_color,
-    ConsoleHandle& console, DetectedCallback detected_callback
+    ConsoleHandle& console, DetectedCallback detected_callback,
+    const FFTGeometry& geometry
 )
     : AudioInferenceCallback(std::move(label))
+    , m_geometry(geometry)
     , m_audio_name(std::move(audio_name))
     , m_detection_color(detection_color)
     , m_console(console)
@@ -116,7 +118,7 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     const float threshold = get_score_threshold();
     for (auto it = new_spectrums.rbegin(); it != new_spectrums.rend(); it++){
         std::vector<AudioSpectrum> single_spectrum = {*it};
-        const float matcher_score = m_matcher->match(single_spectrum);
+        const float matcher_score = m_matcher->match(single_spectrum, threshold);
         // std::cout << "error: " << matcherScore << std::endl;
 
         if (m_lowest_error < 1.0){
@@ -157,7 +159,10 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
             std::ostringstream os;
             os << m_audio_name << " found, score " << matcher_score << "/" << threshold << ", scale: " << m_matcher->lastMatchedScale();
             m_console.log(os.str(), COLOR_BLUE);
-            audio_feed.add_overlay(curStamp+1-m_matcher->numMatchedWindows(), curStamp+1, m_detection_color);
+            //  Overlays are drawn on the spectrograph of the default geometry.
+            if (m_geometry.is_default()){
+                audio_feed.add_overlay(curStamp+1-m_matcher->numMatchedWindows(), curStamp+1, m_detection_color);
+            }
 
             // Since the target audio is found, no need to check detection on the rest of the spectrums in `new_spectrums`.
 
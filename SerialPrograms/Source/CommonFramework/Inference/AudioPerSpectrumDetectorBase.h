@@ -55,9 +55,11 @@ public:
     // the inference session. The error coefficient of the found audio is passed to the callback
     // function. If it returns true, the inference session will stop (by returning true from 
     // AudioPerSpectrumDetectorBase::process_spectrums()).
+    // geometry: the FFT geometry of the spectrums to match. The template must be built with the same one.
     AudioPerSpectrumDetectorBase(
         std::string label, std::string audio_name, Color detection_color,
-        ConsoleHandle& console, DetectedCallback detected_callback
+        ConsoleHandle& console, DetectedCallback detected_callback,
+        const FFTGeometry& geometry = FFTGeometry()
     );
 
     virtual ~AudioPerSpectrumDetectorBase();
@@ -74,6 +76,8 @@ public:
         AudioFeed& audio_feed
     ) override;
 
+    virtual FFTGeometry fft_geometry() const override{ return m_geometry; }
+
     // Clear internal data to be used on another audio stream.
     void clear();
 
@@ -88,6 +92,8 @@ protected:
     // build the actual spectrogram matcher for the target audio.
     virtual std::unique_ptr<SpectrogramMatcher> build_spectrogram_matcher(size_t sample_rate) = 0;
 
+    FFTGeometry m_geometry;
+
     // Name of the target audio to be detected. Used for logging.
     std::string m_audio_name;
     // Color of the box to visualize the detection in the audio spectrogram UI.
@@ -25,9 +25,9 @@ AudioTemplateCache& AudioTemplateCache::instance(){
 }
 
 
-const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string& full_path_no_ext, size_t sample_rate){
+const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string& full_path_no_ext, size_t sample_rate, const FFTGeometry& geometry){
     SpinLockGuard lg(m_lock);
-    auto iter = m_cache.find(full_path_no_ext);
+    auto iter = m_cache.find(std::make_pair(full_path_no_ext, geometry));
     if (iter != m_cache.end()){
         return &iter->second;
     }
@@ -37,13 +37,13 @@ const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string&
         full_path = full_path_no_ext + ".mp3";
     }
 
-    AudioTemplate audio_template = loadAudioTemplate(full_path, (int)sample_rate);
+    AudioTemplate audio_template = loadAudioTemplate(full_path, (int)sample_rate, geometry);
     if (audio_template.numFrequencies() == 0){
         return nullptr;
     }
 
     iter = m_cache.emplace(
-        std::move(full_path_no_ext),
+        std::make_pair(full_path_no_ext, geometry),
         std::move(audio_template)
     ).first;
 
@@ -52,13 +52,13 @@ const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string&
 
 
 
-const AudioTemplate* AudioTemplateCache::get_nothrow(const std::string& path, size_t sample_rate){
+const AudioTemplate* AudioTemplateCache::get_nothrow(const std::string& path, size_t sample_rate, const FFTGeometry& geometry){
     std::string full_path_no_ext = RESOURCE_PATH() + path + "-" + std::to_string(sample_rate);
-    return get_nothrow_internal(full_path_no_ext, sample_rate);
+    return get_nothrow_internal(full_path_no_ext, sample_rate, geometry);
 }
-const AudioTemplate& AudioTemplateCache::get_throw(const std::string& path, size_t sample_rate){
+const AudioTemplate& AudioTemplateCache::get_throw(const std::string& path, size_t sample_rate, const FFTGeometry& geometry){
     std::string full_path_no_ext = RESOURCE_PATH() + path + "-" + std::to_string(sample_rate);
-    const AudioTemplate* audio_template = get_nothrow_internal(full_path_no_ext, sample_rate);
+    const AudioTemplate* audio_template = get_nothrow_internal(full_path_no_ext, sample_rate, geometry);
     if (audio_template == nullptr){
         throw FileException(
             nullptr, PA_CURRENT_FUNCTION,
@@ -10,6 +10,7 @@
 #include <string>
 #include <map>
 #include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/AudioPipeline/Spectrum/FFTGeometry.h"
 
 namespace PokemonAutomation{
 
@@ -27,10 +28,12 @@ public:
     // RESOURCE_PATH/PokemonLA/ShinySound-48000.wav if it exists. If not, it will load
     // RESOURCE_PATH/PokemonLA/ShinySound-48000.mp3 instead.
     // Won't throw if cannot read or parse the template file. Return nullptr in this case.
-    const AudioTemplate* get_nothrow(const std::string& path, size_t sample_rate);
+    // geometry: the FFT geometry to build the spectrogram with. Each geometry of the same file
+    // is cached separately.
+    const AudioTemplate* get_nothrow(const std::string& path, size_t sample_rate, const FFTGeometry& geometry = FFTGeometry());
     // See comment of AudioTemplateCache::get_nothrow().
     // Throw a FileException if cannot read or parse the template file.
-    const AudioTemplate& get_throw(const std::string& path, size_t sample_rate);
+    const AudioTemplate& get_throw(const std::string& path, size_t sample_rate, const FFTGeometry& geometry = FFTGeometry());
 
     static AudioTemplateCache& instance();
 
@@ -38,12 +41,12 @@ private:
     ~AudioTemplateCache();
     AudioTemplateCache();
 
-    const AudioTemplate* get_nothrow_internal(const std::string& full_path_no_ext, size_t sample_rate);
+    const AudioTemplate* get_nothrow_internal(const std::string& full_path_no_ext, size_t sample_rate, const FFTGeometry& geometry);
 
 
 private:
     SpinLock m_lock;
-    std::map<std::string, AudioTemplate> m_cache;
+    std::map<std::pair<std::string, FFTGeometry>, AudioTemplate> m_cache;
 };
 
 
@@ -19,6 +19,14 @@
 namespace PokemonAutomation{
 
 
+// How many frequency bands the fingerprint of a spectrum has. More bands give
+// a tighter lower bound of the match score but cost more to compare.
+const size_t SPECTRUM_FINGERPRINT_BANDS = 64;
+// The fingerprint bound holds exactly. This margin absorbs the rounding of the
+// full match so a spectrum that would be found is never skipped.
+const float SPECTRUM_FINGERPRINT_MARGIN = 0.001f;
+
+
 std::vector<float> buildSpikeKernel(size_t numFrequencies, size_t halfSampleRate){
     std::vector<float> kernel;
     // We find a good kernel when sample rate is 48K and numFrequencies is 2048:
@@ -145,6 +153,18 @@ SpectrogramMatcher::SpectrogramMatcher(
 //    cout << "m_numSpectrumsNeeded = " << m_numSpectrumsNeeded << endl;
 
     m_templateNorm = buildTemplateNorm();
+
+    // Split the matched frequencies into bands for the fingerprints.
+    const size_t numFreqs = m_freqEnd - m_freqStart;
+    m_numBands = std::min(SPECTRUM_FINGERPRINT_BANDS, numFreqs);
+    if (m_numBands > 0){
+        m_bandWidth = (numFreqs + m_numBands - 1) / m_numBands;
+        m_numBands = (numFreqs + m_bandWidth - 1) / m_bandWidth;
+    }
+    m_templateBandNorms.resize(numTemplateWindows * m_numBands);
+    for (size_t i = 0; i < numTemplateWindows; i++){
+        buildBandNorms(m_template.getWindow(i), m_templateBandNorms.data() + i * m_numBands);
+    }
 }
 
 uint64_t SpectrogramMatcher::latestTimestamp() const{
@@ -194,6 +214,21 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const {
     return ret;
 }
 
+float SpectrogramMatcher::buildBandNorms(const float* spectrum, float* bandNorms) const{
+    float normSqr = 0.0f;
+    for (size_t b = 0; b < m_numBands; b++){
+        const size_t start = m_freqStart + b * m_bandWidth;
+        const size_t end = std::min(start + m_bandWidth, m_freqEnd);
+        float sumSqr = 0.0f;
+        for (size_t j = start; j < end; j++){
+            sumSqr += spectrum[j] * spectrum[j];
+        }
+        bandNorms[b] = std::sqrt(sumSqr);
+        normSqr += sumSqr;
+    }
+    return normSqr;
+}
+
 bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
     if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
         std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
@@ -227,15 +262,14 @@ bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
         break;
     }
 
-    // Compute the norm square (= sum squares) of the spectrum, used for matching:
+    // Compute the band norms (the fingerprint) and the norm square (= sum squares) of
+    // the spectrum in one pass, used for matching:
     // TODO: if there will be multiple SpectrogramMatcher running on the same audio stream, can
     // move this per-spectrum computation to a shared struct for those matchers to save computation.
-    float spectrumNormSqr = 0.0f;
-    for (size_t i = m_freqStart; i < m_freqEnd; i++){
-        float mag = (*spectrum.magnitudes)[i];
-        spectrumNormSqr += mag * mag;
-    }
+    std::vector<float> bandNorms(m_numBands);
+    const float spectrumNormSqr = buildBandNorms(spectrum.magnitudes->data(), bandNorms.data());
     m_spectrumNormSqrs.push_front(spectrumNormSqr);
+    m_spectrumBandNorms.emplace_front(std::move(bandNorms));
 
     m_spectrums.emplace_front(std::move(spectrum));
 
@@ -253,6 +287,7 @@ bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum
     while (m_spectrums.size() > m_numSpectrumsNeeded){
         m_spectrums.pop_back();
         m_spectrumNormSqrs.pop_back();
+        m_spectrumBandNorms.pop_back();
     }
 
     return true;
@@ -332,7 +367,34 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
     return std::make_pair(score, scale);
 }
 
-float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums){
+float SpectrogramMatcher::lower_bound_sub_template(size_t sub_index) const{
+    const size_t windows = m_templateRange[sub_index].second - m_templateRange[sub_index].first;
+    double sumAA = 0.0;
+    double sumTT = 0.0;
+    double sumAT = 0.0;
+    auto iter = m_spectrumBandNorms.begin();
+    for (size_t i = 0; i < windows; i++, iter++){
+        // Pair the windows the same way as match_sub_template().
+        const float* bandsT = m_templateBandNorms.data() + (windows - 1 - i) * m_numBands;
+        const float* bandsA = iter->data();
+        for (size_t b = 0; b < m_numBands; b++){
+            sumAA += (double)bandsA[b] * bandsA[b];
+            sumTT += (double)bandsT[b] * bandsT[b];
+            sumAT += (double)bandsA[b] * bandsT[b];
+        }
+    }
+    if (sumAA < 1e-6){
+        // Silence. Leave it to the full match.
+        return 0.0f;
+    }
+
+    // By Cauchy-Schwarz on each band, <A, T> <= sum_b |A_b| |T_b| = sumAT.
+    // So the error at the best scale, |T|^2 - <A, T>^2 / |A|^2, is at least:
+    const double minSumSqr = std::max(sumTT - sumAT * sumAT / sumAA, 0.0);
+    return (float)(std::sqrt(minSumSqr) / m_templateNorm[0]);
+}
+
+float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums, float threshold){
     if (!update_to_new_spectrums(new_spectrums)){
         return FLT_MAX;
     }
@@ -363,20 +425,24 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums)
     m_lastStampTested = curStamp;
     
     // Do the match:
+    // If there is no subdivision, there is only one sub-template: the full template.
     float score = FLT_MAX; // the lower the score, the better the match
-    if (m_templateRange.size() == 1){
-        // Match the full template
-        std::tie(score, m_lastScale) = match_sub_template(0);
-    }else{
-        // Match each indivdual sub-template
-        for (size_t sub_template = 0; sub_template < m_templateRange.size(); sub_template++){
-            float sub_template_score = FLT_MAX;
-            float sub_template_scale = 1.0f;
+    for (size_t sub_template = 0; sub_template < m_templateRange.size(); sub_template++){
+        float sub_template_score = FLT_MAX;
+        float sub_template_scale = 0.0f;
+
+        // Use the fingerprints to skip sub-templates that can't reach the threshold.
+        // This is what rejects most of the spectrums during background noise.
+        const float lower_bound = threshold < 1.0f ? lower_bound_sub_template(sub_template) : 0.0f;
+        if (lower_bound > threshold + SPECTRUM_FINGERPRINT_MARGIN){
+            sub_template_score = std::min<float>(lower_bound, 1.0);
+        }else{
             std::tie(sub_template_score, sub_template_scale) = match_sub_template(sub_template);
-            if (sub_template_score < score){
-                score = sub_template_score;
-                m_lastScale = sub_template_scale;
-            }
+        }
+
+        if (sub_template_score < score){
+            score = sub_template_score;
+            m_lastScale = sub_template_scale;
         }
     }
 
@@ -395,6 +461,7 @@ bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& new_spectrums){
 void SpectrogramMatcher::clear(){
     m_spectrums.clear();
     m_spectrumNormSqrs.clear();
+    m_spectrumBandNorms.clear();
     m_lastStampTested = SIZE_MAX;
 }
 
@@ -53,7 +53,14 @@ public:
     // Newer (larger timestamp) spectrums at beginning of `new_spectrums` while older (smaller
     // timestamp) spectrums at the end.
     // In invalid cases (internal error or not enough windows), return FLT_MAX
-    float match(const std::vector<AudioSpectrum>& new_spectrums);
+    //
+    // threshold: the score the caller needs to consider it a match.
+    //  Before the full match, a cheap band-energy fingerprint of the spectrums
+    //  gives a lower bound of the score. If that bound is already above
+    //  `threshold`, the full match is skipped and the bound is returned instead
+    //  of the exact score. The result is still above `threshold`, so the caller
+    //  reaches the same decision. The default of 1.0 always gives the exact score.
+    float match(const std::vector<AudioSpectrum>& new_spectrums, float threshold = 1.0f);
 
     // Pass some spectrums in but don't run match on them.
     // Used for skipping some spectrums to avoid unnecessary matching.
@@ -83,9 +90,17 @@ private:
     // The function to build `m_templateNorm`
     std::vector<float> buildTemplateNorm() const;
 
+    // Write the norm of each frequency band of `spectrum` into `bandNorms`.
+    // Return the norm square of the whole spectrum.
+    float buildBandNorms(const float* spectrum, float* bandNorms) const;
+
     // For a given sub-template, return its match score and scaling factor
     std::pair<float, float> match_sub_template(size_t sub_index) const;
 
+    // For a given sub-template, return a lower bound of its match score using only
+    // the band norms.
+    float lower_bound_sub_template(size_t sub_index) const;
+
     // Update internal data for the next new spectrum. Called by `update_to_new_spectrums()`.
     // Return true if there is no error.
     bool update_to_new_spectrum(AudioSpectrum newSpectrum);
@@ -114,6 +129,14 @@ private:
     // For each subdivided template, store its sepctrogram matrix norm
     std::vector<float> m_templateNorm;
 
+    // The fingerprint of a spectrum is the norm of each frequency band in
+    // [m_freqStart, m_freqEnd). Each band is `m_bandWidth` frequencies wide,
+    // except for the last one.
+    size_t m_bandWidth = 1;
+    size_t m_numBands = 0;
+    // Band norms of each template window, `m_numBands` per window.
+    std::vector<float> m_templateBandNorms;
+
     Mode m_mode = Mode::RAW;
 
     std::vector<float> m_convKernel;
@@ -122,6 +145,8 @@ private:
     std::list<AudioSpectrum> m_spectrums;
     // Norm squares of each spectrum in `m_spectrums`.
     std::list<float> m_spectrumNormSqrs;
+    // Band norms of each spectrum in `m_spectrums`.
+    std::list<std::vector<float>> m_spectrumBandNorms;
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cmath>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "StatAccumulator.h"
 
@@ -64,13 +65,22 @@ PeriodicStatsReporterI32::PeriodicStatsReporterI32(
     , m_divider(divider)
     , m_period(period)
     , m_last_report(current_time())
+    , m_exported(MetricsRegistry::instance().histogram("periodic_stats", MetricsRegistry::label("stat", label)))
 {}
 void PeriodicStatsReporterI32::report_data(Logger& logger, uint32_t x){
     StatAccumulatorI32::operator+=(x);
+    m_window += x;
+    m_exported->record(x);
     WallClock now = current_time();
     if (m_last_report + m_period <= now){
-        log(logger, m_label, m_units, m_divider);
+        double divider = 1. / m_divider;
+        std::string str = m_label;
+        str += ": " + dump(m_units, m_divider);
+        str += ", p50 = " + tostr_default(m_window.percentile(0.50) * divider) + m_units;
+        str += ", p99 = " + tostr_default(m_window.percentile(0.99) * divider) + m_units;
+        logger.log(str, COLOR_MAGENTA);
         clear();
+        m_window.clear();
         m_last_report = now;
     }
 
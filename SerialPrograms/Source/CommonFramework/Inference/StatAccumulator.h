@@ -9,7 +9,9 @@
 
 #include <stdint.h>
 #include <string>
+#include <memory>
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Metrics/HdrHistogram.h"
 
 namespace PokemonAutomation{
 
@@ -41,6 +43,8 @@ private:
     uint32_t m_max = 0;
 };
 
+//  Logs the stats once every "period". The samples are also recorded into the
+//  "periodic_stats" histogram in MetricsRegistry under the same label.
 class PeriodicStatsReporterI32 : public StatAccumulatorI32{
 public:
     PeriodicStatsReporterI32(
@@ -56,6 +60,8 @@ private:
     double m_divider;
     std::chrono::milliseconds m_period;
     WallClock m_last_report;
+    HdrHistogram m_window;
+    std::shared_ptr<HdrHistogram> m_exported;
 };
 
 
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <vector>
+#include "CommonFramework/AudioPipeline/Spectrum/FFTGeometry.h"
 #include "InferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -33,6 +34,9 @@ public:
         AudioFeed& audio_feed
     ) = 0;
 
+    //  The FFT geometry of the spectrums that this callback wants.
+    virtual FFTGeometry fft_geometry() const{ return FFTGeometry(); }
+
 };
 
 
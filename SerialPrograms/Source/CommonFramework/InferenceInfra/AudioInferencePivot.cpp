@@ -5,6 +5,8 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "AudioInferencePivot.h"
 
@@ -25,6 +27,7 @@ struct AudioInferencePivot::PeriodicCallback{
     uint64_t last_seqnum = ~(uint64_t)0;
 
     StatAccumulatorI32 stats;
+    std::shared_ptr<HdrHistogram> latency;
 
     PeriodicCallback(
         Cancellable& p_scope,
@@ -36,6 +39,7 @@ struct AudioInferencePivot::PeriodicCallback{
         , set_when_triggered(p_set_when_triggered)
         , callback(p_callback)
         , period(p_period)
+        , latency(MetricsRegistry::instance().histogram("audio_inference_us", MetricsRegistry::label("callback", p_callback.label())))
     {}
 };
 
@@ -56,47 +60,61 @@ void AudioInferencePivot::add_callback(
     AudioInferenceCallback& callback,
     std::chrono::milliseconds period
 ){
-    SpinLockGuard lg(m_lock);
-    auto iter = m_map.find(&callback);
-    if (iter != m_map.end()){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to add the same callback twice.");
-    }
-    iter = m_map.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(&callback),
-        std::forward_as_tuple(scope, set_when_triggered, callback, period)
-    ).first;
+    //  Start the callback's geometry before the first run asks for it.
+    const FFTGeometry geometry = callback.fft_geometry();
+    m_feed.add_geometry_listener(geometry);
     try{
-        PeriodicRunner::add_event(&iter->second, period);
+        SpinLockGuard lg(m_lock);
+        auto iter = m_map.find(&callback);
+        if (iter != m_map.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to add the same callback twice.");
+        }
+        iter = m_map.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(&callback),
+            std::forward_as_tuple(scope, set_when_triggered, callback, period)
+        ).first;
+        try{
+            PeriodicRunner::add_event(&iter->second, period);
+        }catch (...){
+            m_map.erase(iter);
+            throw;
+        }
     }catch (...){
-        m_map.erase(iter);
+        m_feed.remove_geometry_listener(geometry);
         throw;
     }
 }
 StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback& callback){
-    SpinLockGuard lg(m_lock);
-    auto iter = m_map.find(&callback);
-    if (iter == m_map.end()){
-        return StatAccumulatorI32();
+    StatAccumulatorI32 stats;
+    {
+        SpinLockGuard lg(m_lock);
+        auto iter = m_map.find(&callback);
+        if (iter == m_map.end()){
+            return StatAccumulatorI32();
+        }
+        stats = iter->second.stats;
+        PeriodicRunner::remove_event(&iter->second);
+        m_map.erase(iter);
     }
-    StatAccumulatorI32 stats = iter->second.stats;
-    PeriodicRunner::remove_event(&iter->second);
-    m_map.erase(iter);
+    m_feed.remove_geometry_listener(callback.fft_geometry());
     return stats;
 }
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
+    TraceScope trace("inference", "AudioInferencePivot::run()");
     try{
         std::vector<AudioSpectrum> spectrums;
+        const FFTGeometry geometry = callback.callback.fft_geometry();
 
         if (callback.last_seqnum == ~(uint64_t)0){
 //            cout << "m_last_timestamp == SIZE_MAX" << endl;
-            spectrums = m_feed.spectrums_latest(1);
+            spectrums = m_feed.geometry_spectrums_latest(geometry, 1);
         }else{
 //            cout << "(m_last_timestamp != SIZE_MAX" << endl;
             //  Note: in this file we never consider the case that stamp may overflow.
             //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
-            spectrums = m_feed.spectrums_since(callback.last_seqnum + 1);
+            spectrums = m_feed.geometry_spectrums_since(geometry, callback.last_seqnum + 1);
         }
         if (spectrums.size() > 0){
             //  spectrums[0] has the newest spectrum with the largest stamp:
@@ -104,9 +122,15 @@ void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
         }
 
         WallClock time0 = current_time();
-        bool stop = callback.callback.process_spectrums(spectrums, m_feed);
+        bool stop;
+        {
+            TraceScope trace_callback("inference", "process_spectrums()", callback.callback.label());
+            stop = callback.callback.process_spectrums(spectrums, m_feed);
+        }
         WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        callback.stats += microseconds;
+        callback.latency->record(microseconds);
         if (stop){
             if (callback.set_when_triggered){
                 InferenceCallback* expected = nullptr;
@@ -5,6 +5,12 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedMalloc.h"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTools/ImageStatsCache.h"
+#include "CommonFramework/ImageTools/BinaryMatrixCache.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -22,6 +28,9 @@ struct VisualInferencePivot::PeriodicCallback{
     VisualInferenceCallback& callback;
     std::chrono::milliseconds period;
     StatAccumulatorI32 stats;
+    std::shared_ptr<HdrHistogram> latency;
+    std::shared_ptr<HdrHistogram> heap_allocs;      //  Per call.
+    std::shared_ptr<MetricsRegistry::Counter> recycled_allocs;
     uint64_t last_seqnum;
 
     PeriodicCallback(
@@ -34,6 +43,9 @@ struct VisualInferencePivot::PeriodicCallback{
         , set_when_triggered(p_set_when_triggered)
         , callback(p_callback)
         , period(p_period)
+        , latency(MetricsRegistry::instance().histogram("visual_inference_us", MetricsRegistry::label("callback", p_callback.label())))
+        , heap_allocs(MetricsRegistry::instance().histogram("visual_inference_heap_allocs", MetricsRegistry::label("callback", p_callback.label())))
+        , recycled_allocs(MetricsRegistry::instance().counter("visual_inference_recycled_allocs", MetricsRegistry::label("callback", p_callback.label())))
         , last_seqnum(0)
     {}
 };
@@ -86,18 +98,43 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
 }
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
+    TraceScope trace("inference", "VisualInferencePivot::run()");
+
+    //  Temporary images and matrices of this cycle reuse the buffers that were
+    //  freed by the previous cycles on this thread.
+    FrameArenaScope arena;
+
     try{
         //  Reuse the cached screenshot.
         if (!is_back_to_back || callback.last_seqnum == m_seqnum){
 //            cout << "back-to-back" << endl;
-            m_last = m_feed.snapshot();
+            std::shared_ptr<BinaryMatrixCache> previous = std::move(m_last.binary_cache);
+            m_last = m_feed.snapshot_lazy();
+            if (GlobalSettings::instance().ENABLE_INFERENCE_CACHES){
+                m_last.enable_stats_cache();
+                m_last.enable_binary_cache(previous.get());
+            }
             m_seqnum++;
         }
 
+        AlignedMallocCounters allocs0 = aligned_malloc_counters();
         WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
+        bool stop;
+        {
+            //  Let every callback on this frame share the same box stats and
+            //  binarized boxes.
+            ImageStatsCacheScope cache_scope(m_last.stats_cache.get());
+            BinaryMatrixCacheScope binary_scope(m_last.binary_cache.get());
+            TraceScope trace_callback("inference", "process_frame()", callback.callback.label());
+            stop = callback.callback.process_frame(m_last);
+        }
         WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        callback.stats += microseconds;
+        callback.latency->record(microseconds);
+        AlignedMallocCounters allocs1 = aligned_malloc_counters();
+        callback.heap_allocs->record(allocs1.heap_allocs - allocs0.heap_allocs);
+        callback.recycled_allocs->fetch_add(allocs1.recycled_allocs - allocs0.recycled_allocs, std::memory_order_relaxed);
         callback.last_seqnum = m_seqnum;
         if (stop){
             if (callback.set_when_triggered){
@@ -6,6 +6,7 @@
 
 #include <QCoreApplication>
 #include <QMenuBar>
+#include "ClientSource/Libraries/Logging.h"
 #include "CommonFramework/Windows/DpiScaler.h"
 #include "CommonFramework/Windows/WindowTracker.h"
 #include "FileWindowLogger.h"
@@ -23,47 +24,101 @@ Logger& global_logger_raw(){
 }
 
 
+struct FileWindowLogger::Record{
+    std::atomic<uint64_t> sequence;
+    WallClock timestamp;
+    Color color;
+    bool tagged;
+    std::string tag;
+    std::string msg;
+};
+
+
 FileWindowLogger::~FileWindowLogger(){
     {
-        std::lock_guard<std::mutex> lg(m_lock);
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
         m_stopping = true;
-        m_cv.notify_all();
     }
+    m_cv.notify_all();
     m_thread.join();
 }
 FileWindowLogger::FileWindowLogger(const std::string& path)
     : m_file(QString::fromStdString(path))
-    , m_max_queue_size(10000)
+    , m_records(new Record[QUEUE_SIZE])
+    , m_head(0)
+    , m_tail(0)
+    , m_dropped(0)
+    , m_dropped_reported(0)
+    , m_writer_sleeping(false)
     , m_stopping(false)
-    , m_thread(&FileWindowLogger::thread_loop, this)
 {
+    for (size_t c = 0; c < QUEUE_SIZE; c++){
+        m_records[c].sequence.store(c, std::memory_order_relaxed);
+    }
+
     bool exists = m_file.exists();
     m_file.open(QIODevice::WriteOnly | QIODevice::Append);
     if (!exists){
         std::string bom = "\xef\xbb\xbf";
         m_file.write(bom.c_str(), bom.size());
     }
+
+    m_thread = std::thread(&FileWindowLogger::thread_loop, this);
 }
 void FileWindowLogger::operator+=(FileWindowLoggerWindow& widget){
-    std::lock_guard<std::mutex> lg(m_lock);
+    std::lock_guard<std::mutex> lg(m_window_lock);
     m_windows.insert(&widget);
 }
 void FileWindowLogger::operator-=(FileWindowLoggerWindow& widget){
-    std::lock_guard<std::mutex> lg(m_lock);
+    std::lock_guard<std::mutex> lg(m_window_lock);
     m_windows.erase(&widget);
 }
 
+
+template <typename Fill>
+void FileWindowLogger::push(Fill&& fill){
+    uint64_t position = m_head.load(std::memory_order_relaxed);
+    while (true){
+        Record& record = m_records[position % QUEUE_SIZE];
+        uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+        if (sequence == position){
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                fill(record);
+                record.sequence.store(position + 1, std::memory_order_release);
+                break;
+            }
+        }else if (sequence < position){
+            //  Full. Drop it rather than stall the caller.
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }else{
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    //  The writer polls anyway. This just gets it going sooner.
+    if (m_writer_sleeping.load(std::memory_order_relaxed)){
+        m_cv.notify_all();
+    }
+}
 void FileWindowLogger::log(const std::string& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(msg, color);
-    m_cv.notify_all();
+    log(std::string(msg), color);
 }
 void FileWindowLogger::log(std::string&& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(std::move(msg), color);
-    m_cv.notify_all();
+    push([&](Record& record){
+        record.color = color;
+        record.tagged = false;
+        record.msg = std::move(msg);
+    });
+}
+void FileWindowLogger::log_tagged(WallClock timestamp, const std::string& tag, std::string&& msg, Color color){
+    push([&](Record& record){
+        record.timestamp = timestamp;
+        record.color = color;
+        record.tagged = true;
+        record.tag = tag;
+        record.msg = std::move(msg);
+    });
 }
 
 
@@ -89,12 +144,11 @@ std::string FileWindowLogger::normalize_newlines(const std::string& msg){
 
     return str;
 }
-std::string FileWindowLogger::to_file_str(const std::string& msg){
+void FileWindowLogger::append_file_str(std::string& str, const std::string& msg){
     //  Replace all newlines with:
     //      <br>    for the output window.
     //      \r\n    for the log file.
 
-    std::string str;
     for (char ch : msg){
         if (ch == '\n'){
             str += "\r\n";
@@ -103,10 +157,8 @@ std::string FileWindowLogger::to_file_str(const std::string& msg){
         str += ch;
     }
     str += "\r\n";
-
-    return str;
 }
-QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
+std::string FileWindowLogger::to_window_str(const std::string& msg, Color color){
     //  Replace all newlines with:
     //      <br>    for the output window.
     //      \r\n    for the log file.
@@ -132,45 +184,112 @@ QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
         str += "</font>";
 //    }
 
-    return QString::fromStdString(str);
+    return str;
 }
-void FileWindowLogger::internal_log(const std::string& msg, Color color){
-    std::string line = normalize_newlines(msg);
+
+
+size_t FileWindowLogger::drain(std::string& file_buffer, std::deque<std::string>& window_lines){
+    bool has_windows;
     {
-        if (!m_windows.empty()){
-            QString str = to_window_str(line, color);
-            for (FileWindowLoggerWindow* window : m_windows){
-                window->log(str);
-            }
+        std::lock_guard<std::mutex> lg(m_window_lock);
+        has_windows = !m_windows.empty();
+    }
+
+    size_t processed = 0;
+    while (processed < QUEUE_SIZE){
+        Record& record = m_records[m_tail % QUEUE_SIZE];
+        if (record.sequence.load(std::memory_order_acquire) != m_tail + 1){
+            break;
+        }
+
+        Color color = record.color;
+        std::string msg = std::move(record.msg);
+        if (record.tagged){
+            msg = time_to_str(record.timestamp) + " - [" + record.tag + "]: " + msg;
+        }
+
+        //  The slot keeps the capacity of "tag" so it can be reused.
+        record.msg = std::string();
+        record.sequence.store(m_tail + QUEUE_SIZE, std::memory_order_release);
+        m_tail++;
+        processed++;
+
+        append_file_str(file_buffer, msg);
+        if (has_windows){
+            window_lines.emplace_back(to_window_str(normalize_newlines(msg), color));
         }
     }
-    {
-        m_file.write(to_file_str(msg).c_str());
-        m_file.flush();
+
+    uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_dropped_reported){
+        std::string msg = time_to_str(current_time()) + " - [Logger]: Log queue overflowed. Dropped " +
+            std::to_string(dropped - m_dropped_reported) + " message(s).";
+        m_dropped_reported = dropped;
+        append_file_str(file_buffer, msg);
+        if (has_windows){
+            window_lines.emplace_back(to_window_str(msg, COLOR_RED));
+        }
+    }
+
+    while (window_lines.size() > MAX_PENDING_WINDOW_LINES){
+        window_lines.pop_front();
+    }
+
+    return processed;
+}
+void FileWindowLogger::update_windows(std::deque<std::string>& window_lines){
+    if (window_lines.empty()){
+        return;
+    }
+    QStringList lines;
+    for (const std::string& line : window_lines){
+        lines.append(QString::fromStdString(line));
+    }
+    window_lines.clear();
+
+    std::lock_guard<std::mutex> lg(m_window_lock);
+    for (FileWindowLoggerWindow* window : m_windows){
+        window->log(lines);
     }
 }
 void FileWindowLogger::thread_loop(){
-    std::unique_lock<std::mutex> lg(m_lock);
+    std::string file_buffer;
+    std::deque<std::string> window_lines;
+    WallClock last_window_update = current_time();
+
     while (true){
-        m_cv.wait(lg, [&]{
-            return m_stopping || !m_queue.empty();
-        });
-        if (m_stopping){
-            break;
+        size_t processed = drain(file_buffer, window_lines);
+
+        if (!file_buffer.empty()){
+            m_file.write(file_buffer.c_str(), file_buffer.size());
+            m_file.flush();
+            file_buffer.clear();
+        }
+
+        WallClock now = current_time();
+        if (last_window_update + WINDOW_UPDATE_PERIOD <= now){
+            update_windows(window_lines);
+            last_window_update = now;
         }
-        auto& item = m_queue.front();
-        std::string msg = std::move(item.first);
-        Color color = item.second;
-        m_queue.pop_front();
 
-        lg.unlock();
-        internal_log(msg, color);
-        lg.lock();
+        if (processed != 0){
+            continue;
+        }
 
-        if (m_queue.size() <= m_max_queue_size / 2){
-            m_cv.notify_all();
+        std::unique_lock<std::mutex> lg(m_sleep_lock);
+        if (m_stopping){
+            break;
         }
+        m_writer_sleeping.store(true, std::memory_order_relaxed);
+        m_cv.wait_for(lg, window_lines.empty() ? std::chrono::milliseconds(50) : WINDOW_UPDATE_PERIOD);
+        m_writer_sleeping.store(false, std::memory_order_relaxed);
     }
+
+    //  Anything that was logged right before shutdown.
+    drain(file_buffer, window_lines);
+    m_file.write(file_buffer.c_str(), file_buffer.size());
+    m_file.flush();
+    update_windows(window_lines);
 }
 
 
@@ -203,9 +322,11 @@ FileWindowLoggerWindow::FileWindowLoggerWindow(FileWindowLogger& logger, QWidget
 
     connect(
         this, &FileWindowLoggerWindow::signal_log,
-        m_text, [this](QString msg){
-//            cout << "signal_log(): " << msg.toStdString() << endl;
-            m_text->append(msg);
+        m_text, [this](QStringList lines){
+//            cout << "signal_log(): " << lines.size() << endl;
+            for (const QString& line : lines){
+                m_text->append(line);
+            }
         }
     );
 
@@ -221,7 +342,10 @@ FileWindowLoggerWindow::~FileWindowLoggerWindow(){
 
 void FileWindowLoggerWindow::log(QString msg){
 //    cout << "FileWindowLoggerWindow::log(): " << msg.toStdString() << endl;
-    emit signal_log(msg);
+    emit signal_log(QStringList(msg));
+}
+void FileWindowLoggerWindow::log(QStringList lines){
+    emit signal_log(std::move(lines));
 }
 
 
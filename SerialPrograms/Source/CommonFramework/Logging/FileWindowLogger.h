@@ -9,12 +9,16 @@
 
 #include <deque>
 #include <set>
+#include <memory>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <QFile>
+#include <QStringList>
 #include <QTextEdit>
 #include <QMainWindow>
+#include "Common/Cpp/Time.h"
 #include "Logger.h"
 
 namespace PokemonAutomation{
@@ -22,7 +26,25 @@ namespace PokemonAutomation{
 class FileWindowLoggerWindow;
 
 
+//
+//  Writes to the log file and the output windows.
+//
+//  "log()" never blocks. Messages go into a fixed-size lock-free queue and a
+//  writer thread does all the formatting and I/O. If the queue is full, the
+//  message is dropped and counted. The writer reports the count in the log.
+//
+//  File writes are batched. The output windows are updated at most once
+//  every WINDOW_UPDATE_PERIOD.
+//
 class FileWindowLogger : public Logger{
+public:
+    static constexpr size_t QUEUE_SIZE = 16384;
+    static constexpr std::chrono::milliseconds WINDOW_UPDATE_PERIOD = std::chrono::milliseconds(100);
+
+    //  Only the newest lines are kept for the window while waiting for the
+    //  next update. (the window only shows 1000 lines anyway)
+    static constexpr size_t MAX_PENDING_WINDOW_LINES = 1000;
+
 public:
     ~FileWindowLogger();
     FileWindowLogger(const std::string& path);
@@ -33,22 +55,43 @@ public:
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string&& msg, Color color = Color()) override;
 
+    //  Same as "log()", but the timestamp and tag are formatted on the writer
+    //  thread instead of the caller's. Used by TaggedLogger.
+    void log_tagged(WallClock timestamp, const std::string& tag, std::string&& msg, Color color);
+
+    uint64_t messages_dropped() const{ return m_dropped.load(std::memory_order_relaxed); }
+
 private:
+    struct Record;
+
+    template <typename Fill>
+    void push(Fill&& fill);
+
     static std::string normalize_newlines(const std::string& msg);
-    static std::string to_file_str(const std::string& msg);
-    static QString to_window_str(const std::string& msg, Color color);
+    static void append_file_str(std::string& str, const std::string& msg);
+    static std::string to_window_str(const std::string& msg, Color color);
 
-    void internal_log(const std::string& msg, Color color);
+    //  Returns the number of messages processed.
+    size_t drain(std::string& file_buffer, std::deque<std::string>& window_lines);
+    void update_windows(std::deque<std::string>& window_lines);
     void thread_loop();
 
 private:
     QFile m_file;
-    size_t m_max_queue_size;
-    std::mutex m_lock;
+
+    std::unique_ptr<Record[]> m_records;
+    std::atomic<uint64_t> m_head;
+    uint64_t m_tail;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_dropped_reported;
+
+    std::mutex m_window_lock;
+    std::set<FileWindowLoggerWindow*> m_windows;
+
+    std::atomic<bool> m_writer_sleeping;
+    std::mutex m_sleep_lock;
     std::condition_variable m_cv;
     bool m_stopping;
-    std::deque<std::pair<std::string, Color>> m_queue;
-    std::set<FileWindowLoggerWindow*> m_windows;
     std::thread m_thread;
 };
 
@@ -61,9 +104,11 @@ public:
     virtual ~FileWindowLoggerWindow();
 
     void log(QString msg);
+    //  Each line becomes its own block. (so the block limit counts lines)
+    void log(QStringList lines);
 
 signals:
-    void signal_log(QString msg);
+    void signal_log(QStringList lines);
 
 private:
     FileWindowLogger& m_logger;
@@ -6,6 +6,7 @@
 
 #include <QString>
 #include "ClientSource/Libraries/Logging.h"
+#include "FileWindowLogger.h"
 #include "Logger.h"
 
 #include <iostream>
@@ -21,10 +22,18 @@ Logger& global_logger_tagged(){
 
 TaggedLogger::TaggedLogger(Logger& logger, std::string tag)
     : m_logger(logger)
+    , m_file_logger(dynamic_cast<FileWindowLogger*>(&logger))
     , m_tag(std::move(tag))
 {}
 
 void TaggedLogger::log(const std::string& msg, Color color){
+    log(std::string(msg), color);
+}
+void TaggedLogger::log(std::string&& msg, Color color){
+    if (m_file_logger != nullptr){
+        m_file_logger->log_tagged(current_time(), m_tag, std::move(msg), color);
+        return;
+    }
     std::string str =
         current_time_to_str() +
         " - [" + m_tag + "]: " +
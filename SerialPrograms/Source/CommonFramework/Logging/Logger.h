@@ -13,6 +13,8 @@
 
 namespace PokemonAutomation{
 
+class FileWindowLogger;
+
 
 
 //  Print as is. Use this to build other loggers.
@@ -33,9 +35,15 @@ public:
     Logger& base_logger(){ return m_logger; }
 
     virtual void log(const std::string& msg, Color color = Color()) override;
+    virtual void log(std::string&& msg, Color color = Color()) override;
 
 private:
     Logger& m_logger;
+
+    //  Set if "m_logger" is the file logger. The timestamp and tag are then
+    //  formatted on its writer thread.
+    FileWindowLogger* m_file_logger;
+
     std::string m_tag;
 };
 
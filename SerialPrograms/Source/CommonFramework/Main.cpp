@@ -1,5 +1,7 @@
 
 #include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QApplication>
 //#include <QTextStream>
 #include <QMessageBox>
@@ -7,6 +9,7 @@
 #include <Integrations/DppIntegration/DppClient.h>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/ImageResolution.h"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
 #include "PersistentSettings.h"
 #include "Tests/CommandLineTests.h"
 #include "CrashDump.h"
@@ -33,6 +36,20 @@ using namespace PokemonAutomation;
 Q_DECLARE_METATYPE(std::string)
 
 
+//  Remove the metrics of instances that have exited. Running instances
+//  rewrite theirs every export period, so anything older than this is stale.
+static void prune_stale_metrics(const QString& application_name){
+    QDir dir(QString::fromStdString(METRICS_PATH));
+    QDateTime cutoff = QDateTime::currentDateTime().addSecs(-5 * 60);
+    const QFileInfoList files = dir.entryInfoList(QStringList{application_name + "-*"}, QDir::Files);
+    for (const QFileInfo& file : files){
+        if (file.lastModified() < cutoff){
+            QFile::remove(file.filePath());
+        }
+    }
+}
+
+
 int main(int argc, char *argv[]){
     setup_crash_handler();
 
@@ -54,6 +71,8 @@ int main(int argc, char *argv[]){
 
     QDir().mkpath(QString::fromStdString(SETTINGS_PATH));
     QDir().mkpath(QString::fromStdString(SCREENSHOTS_PATH));
+    QDir().mkpath(QString::fromStdString(METRICS_PATH));
+    QDir().mkpath(QString::fromStdString(WIRE_TRACES_PATH));
 
     //  Read program settings from json file: SerialPrograms-Settings.json.
     try{
@@ -99,6 +118,14 @@ int main(int argc, char *argv[]){
     }
 
 
+    //  Latency histograms for the serial link, inference and video.
+    //  One file per process so multiple instances don't clobber each other.
+    prune_stale_metrics(application.applicationName());
+    MetricsRegistry::instance().start_export(
+        METRICS_PATH + application.applicationName().toStdString() + "-" + std::to_string(QCoreApplication::applicationPid()),
+        std::chrono::seconds(10)
+    );
+
     int ret;
     {
         MainWindow w;
@@ -110,6 +137,8 @@ int main(int argc, char *argv[]){
     // Write program settings back to the json file.
     PERSISTENT_SETTINGS().write();
 
+    MetricsRegistry::instance().stop_export();
+
 #ifdef PA_SLEEPY
     Integration::SleepyDiscordRunner::sleepy_terminate();
 #endif
@@ -113,6 +113,7 @@ struct EventNotificationOption::Data{
         , m_label(LockWhileRunning::UNLOCKED, std::move(label))
         , m_ping(LockWhileRunning::UNLOCKED, ping)
         , m_null_screenshot(LockWhileRunning::UNLOCKED, "---")
+        , m_null_quality(LockWhileRunning::UNLOCKED, "---")
         , m_screenshot(ImageAttachmentMode::NO_SCREENSHOT)
         , m_tags(false, LockWhileRunning::UNLOCKED, "Notifs", "")
         , m_rate_limit_seconds(LockWhileRunning::UNLOCKED, rate_limit.count())
@@ -130,6 +131,7 @@ struct EventNotificationOption::Data{
         , m_label(LockWhileRunning::UNLOCKED, std::move(label))
         , m_ping(LockWhileRunning::UNLOCKED, ping)
         , m_null_screenshot(LockWhileRunning::UNLOCKED, "---")
+        , m_null_quality(LockWhileRunning::UNLOCKED, "---")
         , m_screenshot(ImageAttachmentMode::NO_SCREENSHOT)
         , m_tags(false, LockWhileRunning::UNLOCKED, tags_to_str(tags), "")
         , m_rate_limit_seconds(LockWhileRunning::UNLOCKED, rate_limit.count())
@@ -148,6 +150,7 @@ struct EventNotificationOption::Data{
         , m_label(LockWhileRunning::UNLOCKED, std::move(label))
         , m_ping(LockWhileRunning::UNLOCKED, ping)
         , m_null_screenshot(LockWhileRunning::UNLOCKED, "---")
+        , m_null_quality(LockWhileRunning::UNLOCKED, "---")
         , m_screenshot(screenshot)
         , m_tags(false, LockWhileRunning::UNLOCKED, tags_to_str(tags), "")
         , m_rate_limit_seconds(LockWhileRunning::UNLOCKED, rate_limit.count())
@@ -162,7 +165,9 @@ struct EventNotificationOption::Data{
     LabelCellOption m_label;
     BooleanCheckBoxCell m_ping;
     LabelCellOption m_null_screenshot;
+    LabelCellOption m_null_quality;
     ScreenshotCell m_screenshot;
+    ScreenshotQualityCell m_screenshot_quality;
     StringCell m_tags;
     SimpleIntegerCell<uint32_t> m_rate_limit_seconds;
 
@@ -186,6 +191,7 @@ EventNotificationOption::EventNotificationOption(
     add_option(m_data->m_label, "");
     add_option(m_data->m_ping, "Ping");
     add_option(m_data->m_null_screenshot, "");
+    add_option(m_data->m_null_quality, "");
     add_option(m_data->m_tags, "Tags");
     add_option(m_data->m_rate_limit_seconds, "RateLimitSeconds");
     add_option(m_test_button, "");
@@ -206,6 +212,7 @@ EventNotificationOption::EventNotificationOption(
     add_option(m_data->m_label, "");
     add_option(m_data->m_ping, "Ping");
     add_option(m_data->m_null_screenshot, "");
+    add_option(m_data->m_null_quality, "");
     add_option(m_data->m_tags, "Tags");
     add_option(m_data->m_rate_limit_seconds, "RateLimitSeconds");
     add_option(m_test_button, "");
@@ -227,6 +234,7 @@ EventNotificationOption::EventNotificationOption(
     add_option(m_data->m_label, "");
     add_option(m_data->m_ping, "Ping");
     add_option(m_data->m_screenshot, "Screenshot");
+    add_option(m_data->m_screenshot_quality, "ScreenshotQuality");
     add_option(m_data->m_tags, "Tags");
     add_option(m_data->m_rate_limit_seconds, "RateLimitSeconds");
     add_option(m_test_button, "");
@@ -243,6 +251,9 @@ bool EventNotificationOption::ping() const{
 ImageAttachmentMode EventNotificationOption::screenshot() const{
     return m_data->m_screenshot;
 }
+ImageAttachmentQuality EventNotificationOption::screenshot_quality() const{
+    return m_data->m_screenshot_quality;
+}
 std::vector<std::string> EventNotificationOption::tags() const{
     return parse_tags(m_data->m_tags);
 }
@@ -60,6 +60,7 @@ public:
     const std::string&  label       () const;
     bool                ping        () const;
     ImageAttachmentMode screenshot  () const;
+    ImageAttachmentQuality screenshot_quality() const;
     std::vector<std::string> tags   () const;
 
 //    void set_tags(std::vector<std::string> tags);
@@ -35,6 +35,7 @@ std::vector<std::string> EventNotificationsTable::make_header() const{
         "Event",
         "Should Ping",
         "Screenshot",
+        "Screenshot Quality",
         "Tags",
         "Rate Limit (seconds)",
         "",
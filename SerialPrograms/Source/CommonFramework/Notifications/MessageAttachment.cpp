@@ -4,10 +4,18 @@
  *
  */
 
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <vector>
 #include <QDir>
 #include <QFile>
+#include <QImage>
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageStats.h"
 #include "MessageAttachment.h"
 
 namespace PokemonAutomation{
@@ -17,15 +25,58 @@ namespace PokemonAutomation{
 ImageAttachment::ImageAttachment(
     const ImageViewRGB32& p_image,
     ImageAttachmentMode p_mode,
-    bool p_keep_file
+    bool p_keep_file,
+    ImageAttachmentQuality p_quality
 )
     : image(p_image)
     , mode(p_mode)
+    , quality(p_quality)
     , keep_file(p_keep_file)
 {}
 
 
 
+//  Downscale and encode "image" according to its quality.
+bool save_image_attachment(const ImageAttachment& image, const std::string& path){
+    size_t max_width = 0;
+    int jpg_quality = -1;
+    switch (image.quality){
+    case ImageAttachmentQuality::ORIGINAL:
+        return image.image.save(path);
+    case ImageAttachmentQuality::HIGH:
+        max_width = 1280;
+        jpg_quality = 90;
+        break;
+    case ImageAttachmentQuality::MEDIUM:
+        max_width = 960;
+        jpg_quality = 75;
+        break;
+    case ImageAttachmentQuality::LOW:
+        max_width = 640;
+        jpg_quality = 60;
+        break;
+    }
+
+    size_t width = image.image.width();
+    size_t height = image.image.height();
+    QImage qimage;
+    if (width > max_width){
+        height = height * max_width / width;
+        width = max_width;
+        qimage = image.image.scaled_to_QImage(width, height);
+    }else{
+        qimage = image.image.to_QImage_ref();
+    }
+
+    //  The quality of a PNG only changes how hard it's compressed.
+    return qimage.save(
+        QString::fromStdString(path), nullptr,
+        image.mode == ImageAttachmentMode::JPG ? jpg_quality : -1
+    );
+}
+
+
+
 PendingFileSend::~PendingFileSend(){
     if (m_filepath.empty()){
         return;
@@ -93,7 +144,7 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
         m_filepath = "TempFiles/" + m_filename;
     }
 
-    if (image.image.save(m_filepath)){
+    if (save_image_attachment(image, m_filepath)){
         logger.log("Saved image to: " + m_filepath, COLOR_BLUE);
     }else{
         logger.log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
@@ -107,6 +158,124 @@ void PendingFileSend::extend_lifetime(){
 
 
 
+//  A tiny thumbnail of a screenshot: the average color of each block of a
+//  32 x 18 grid. This is the perceptual hash used to find screenshots that
+//  look the same. Averaging over blocks hides capture noise. But anything
+//  that changes a block by more than the threshold (a different sprite, a
+//  new line of text) still gives a different thumbnail.
+//  Returns empty if the image is too small.
+std::vector<float> screenshot_thumbnail(const ImageViewRGB32& image){
+    const size_t GRID_WIDTH = 32;
+    const size_t GRID_HEIGHT = 18;
+
+    const size_t width = image.width();
+    const size_t height = image.height();
+    std::vector<float> thumbnail;
+    if (width < GRID_WIDTH || height < GRID_HEIGHT){
+        return thumbnail;
+    }
+
+    thumbnail.reserve(GRID_WIDTH * GRID_HEIGHT * 3);
+    for (size_t r = 0; r < GRID_HEIGHT; r++){
+        for (size_t c = 0; c < GRID_WIDTH; c++){
+            ImagePixelBox box(
+                c * width / GRID_WIDTH, r * height / GRID_HEIGHT,
+                (c + 1) * width / GRID_WIDTH, (r + 1) * height / GRID_HEIGHT
+            );
+            FloatPixel average = image_stats(extract_box_reference(image, box)).average;
+            thumbnail.emplace_back((float)average.r);
+            thumbnail.emplace_back((float)average.g);
+            thumbnail.emplace_back((float)average.b);
+        }
+    }
+    return thumbnail;
+}
+
+
+//  The last few screenshots that were saved to be sent.
+struct RecentScreenshots{
+    static constexpr size_t MAX_ENTRIES = 8;
+
+    struct Entry{
+        size_t width;
+        size_t height;
+        ImageAttachmentMode mode;
+        ImageAttachmentQuality quality;
+        bool keep_file;
+        std::vector<float> thumbnail;
+        std::shared_ptr<PendingFileSend> file;
+
+        bool matches(
+            const ImageAttachment& image, const std::vector<float>& p_thumbnail,
+            float threshold
+        ) const{
+            if (width != image.image.width() || height != image.image.height()){
+                return false;
+            }
+            if (mode != image.mode || quality != image.quality || keep_file != image.keep_file){
+                return false;
+            }
+            for (size_t c = 0; c < thumbnail.size(); c++){
+                if (std::abs(thumbnail[c] - p_thumbnail[c]) > threshold){
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    std::mutex lock;
+    std::deque<Entry> entries;
+
+    static RecentScreenshots& instance(){
+        static RecentScreenshots recent;
+        return recent;
+    }
+};
+
+
+std::shared_ptr<PendingFileSend> make_image_file_send(Logger& logger, const ImageAttachment& image){
+    uint8_t threshold = GlobalSettings::instance().SCREENSHOT_REUSE_THRESHOLD;
+    if (threshold == 0 || !image.allow_reuse || image.mode == ImageAttachmentMode::NO_SCREENSHOT || !image.image){
+        return std::make_shared<PendingFileSend>(logger, image);
+    }
+
+    std::vector<float> thumbnail = screenshot_thumbnail(image.image);
+    if (thumbnail.empty()){
+        return std::make_shared<PendingFileSend>(logger, image);
+    }
+
+    RecentScreenshots& recent = RecentScreenshots::instance();
+    {
+        std::lock_guard<std::mutex> lg(recent.lock);
+        for (const RecentScreenshots::Entry& entry : recent.entries){
+            if (entry.matches(image, thumbnail, threshold)){
+                logger.log("Screenshot is unchanged. Reusing: " + entry.file->filepath(), COLOR_BLUE);
+                return entry.file;
+            }
+        }
+    }
+
+    //  Don't hold the lock while encoding.
+    std::shared_ptr<PendingFileSend> file = std::make_shared<PendingFileSend>(logger, image);
+    if (file->filepath().empty()){
+        return file;
+    }
+
+    std::lock_guard<std::mutex> lg(recent.lock);
+    recent.entries.emplace_back(RecentScreenshots::Entry{
+        image.image.width(), image.image.height(),
+        image.mode, image.quality, image.keep_file,
+        std::move(thumbnail), file
+    });
+    while (recent.entries.size() > RecentScreenshots::MAX_ENTRIES){
+        recent.entries.pop_front();
+    }
+    return file;
+}
+
+
+
 
 
 }
@@ -19,13 +19,19 @@ namespace PokemonAutomation{
 struct ImageAttachment{
     ImageViewRGB32 image;
     ImageAttachmentMode mode = ImageAttachmentMode::NO_SCREENSHOT;
+    ImageAttachmentQuality quality = ImageAttachmentQuality::ORIGINAL;
     bool keep_file = false;
 
+    //  If the same screenshot was recently sent, send that file instead.
+    //  (see "SCREENSHOT_REUSE_THRESHOLD")
+    bool allow_reuse = false;
+
     ImageAttachment() = default;
     ImageAttachment(
         const ImageViewRGB32& p_image,
         ImageAttachmentMode p_mode,
-        bool p_keep_file = false
+        bool p_keep_file = false,
+        ImageAttachmentQuality p_quality = ImageAttachmentQuality::ORIGINAL
     );
 };
 
@@ -58,5 +64,13 @@ private:
 
 
 
+//  Save "image" to a file to send.
+//  If a screenshot that looks the same was recently saved with the same
+//  settings, return that file instead of encoding a new one. The file stays
+//  alive as long as it's in the recent list or still being sent.
+std::shared_ptr<PendingFileSend> make_image_file_send(Logger& logger, const ImageAttachment& image);
+
+
+
 }
 #endif
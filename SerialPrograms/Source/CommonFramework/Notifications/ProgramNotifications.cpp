@@ -93,7 +93,7 @@ void send_raw_notification(
     const std::vector<std::pair<std::string, std::string>>& messages,
     const ImageAttachment& image
 ){
-    std::shared_ptr<PendingFileSend> file(new PendingFileSend(logger, image));
+    std::shared_ptr<PendingFileSend> file = make_image_file_send(logger, image);
     bool hasFile = !file->filepath().empty();
 
     JsonObject embed;
@@ -236,7 +236,7 @@ void send_raw_program_notification(
         settings.ping(), settings.tags(),
         info, title,
         messages,
-        ImageAttachment(image, settings.screenshot(), keep_file)
+        ImageAttachment(image, settings.screenshot(), keep_file, settings.screenshot_quality())
     );
 }
 
@@ -292,7 +292,8 @@ void send_program_notification(
     const std::string& title,
     std::vector<std::pair<std::string, std::string>> messages,
     const std::string& current_stats_addendum,
-    const ImageViewRGB32& image, bool keep_file
+    const ImageViewRGB32& image, bool keep_file,
+    bool allow_screenshot_reuse
 ){
     if (!settings.ok_to_send_now(env.logger())){
         return;
@@ -320,6 +321,8 @@ void send_program_notification(
     if (GlobalSettings::instance().ALL_STATS && historical_stats){
         messages.emplace_back("Historical Stats:", env.historical_stats()->to_str());
     }
+    ImageAttachment attachment(image, settings.screenshot(), keep_file, settings.screenshot_quality());
+    attachment.allow_reuse = allow_screenshot_reuse;
     send_raw_notification(
         env.logger(),
         color,
@@ -327,7 +330,7 @@ void send_program_notification(
         env.program_info(),
         title,
         messages,
-        ImageAttachment(image, settings.screenshot(), keep_file)
+        attachment
     );
 }
 
@@ -345,7 +348,8 @@ void send_program_status_notification(
         Color(),
         "Program Status",
         {{"Message:", message}}, "",
-        image, keep_file
+        image, keep_file,
+        true
     );
 }
 void send_program_finished_notification(
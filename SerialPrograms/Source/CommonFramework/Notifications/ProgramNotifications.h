@@ -56,7 +56,8 @@ void send_program_notification(
     const std::string& title,
     std::vector<std::pair<std::string, std::string>> messages,
     const std::string& current_stats_addendum,
-    const ImageViewRGB32& image = ImageViewRGB32(), bool keep_file = false
+    const ImageViewRGB32& image = ImageViewRGB32(), bool keep_file = false,
+    bool allow_screenshot_reuse = false
 );
 
 
@@ -0,0 +1,262 @@
+/*  OCR Glyph Classifier
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Kernels/Kernels_BitScan.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "OCR_GlyphClassifier.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+static std::string to_hex(const uint64_t* words, size_t count){
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string str;
+    for (size_t c = 0; c < count; c++){
+        for (int s = 60; s >= 0; s -= 4){
+            str += DIGITS[(words[c] >> s) & 0xf];
+        }
+    }
+    return str;
+}
+static bool from_hex(uint64_t* words, size_t count, const std::string& str){
+    if (str.size() != count * 16){
+        return false;
+    }
+    for (size_t c = 0; c < count; c++){
+        uint64_t word = 0;
+        for (size_t i = 0; i < 16; i++){
+            char ch = str[c * 16 + i];
+            uint64_t digit;
+            if ('0' <= ch && ch <= '9'){
+                digit = ch - '0';
+            }else if ('a' <= ch && ch <= 'f'){
+                digit = ch - 'a' + 10;
+            }else{
+                return false;
+            }
+            word = (word << 4) | digit;
+        }
+        words[c] = word;
+    }
+    return true;
+}
+
+
+
+GlyphClassifier::GlyphClassifier(const std::string& json_path){
+    JsonValue json = load_json_file(json_path);
+    const JsonObject& root = json.get_object_throw(json_path);
+
+    if ((size_t)root.get_integer_throw("GridWidth", json_path) != GRID_WIDTH ||
+        (size_t)root.get_integer_throw("GridHeight", json_path) != GRID_HEIGHT
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Glyph grid size doesn't match.", json_path);
+    }
+
+    for (const JsonValue& item : root.get_array_throw("Glyphs", json_path)){
+        const JsonObject& obj = item.get_object_throw(json_path);
+        const std::string& ch = obj.get_string_throw("Char", json_path);
+        if (ch.size() != 1){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid glyph: " + ch, json_path);
+        }
+
+        Template glyph;
+        glyph.ch = ch[0];
+        glyph.aspect = obj.get_double_throw("Aspect", json_path);
+        if (!(glyph.aspect > 0) ||
+            !from_hex(glyph.bits, GRID_WORDS, obj.get_string_throw("Bits", json_path))
+        ){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid glyph: " + ch, json_path);
+        }
+        m_templates.emplace_back(glyph);
+    }
+}
+GlyphClassifier GlyphClassifier::load_optional(const std::string& json_path){
+    try{
+        return GlyphClassifier(json_path);
+    }catch (FileException&){
+        return GlyphClassifier();
+    }
+}
+
+JsonValue GlyphClassifier::to_json() const{
+    JsonArray glyphs;
+    for (const Template& glyph : m_templates){
+        JsonObject obj;
+        obj["Char"] = std::string(1, glyph.ch);
+        obj["Aspect"] = glyph.aspect;
+        obj["Bits"] = to_hex(glyph.bits, GRID_WORDS);
+        glyphs.push_back(std::move(obj));
+    }
+
+    JsonObject root;
+    root["GridWidth"] = GRID_WIDTH;
+    root["GridHeight"] = GRID_HEIGHT;
+    root["Glyphs"] = std::move(glyphs);
+    return root;
+}
+void GlyphClassifier::save(const std::string& json_path) const{
+    to_json().dump(json_path);
+}
+
+
+
+GlyphClassifier::Template GlyphClassifier::make_template(char ch, const PackedBinaryMatrix& glyph){
+    Template ret;
+    ret.ch = ch;
+    for (size_t c = 0; c < GRID_WORDS; c++){
+        ret.bits[c] = 0;
+    }
+
+    size_t width = glyph.width();
+    size_t height = glyph.height();
+    ret.aspect = height == 0 ? 1.0 : (double)width / height;
+    if (width == 0 || height == 0){
+        return ret;
+    }
+
+    //  Integral image of the set pixels so that each grid cell is O(1).
+    std::vector<uint32_t> integral((width + 1) * (height + 1), 0);
+    for (size_t r = 0; r < height; r++){
+        uint32_t run = 0;
+        const uint32_t* above = &integral[r * (width + 1)];
+        uint32_t* out = &integral[(r + 1) * (width + 1)];
+        for (size_t c = 0; c < width; c++){
+            run += glyph.get(c, r);
+            out[c + 1] = above[c + 1] + run;
+        }
+    }
+
+    //  A cell is set if at least half of the pixels it covers are set. Cells
+    //  always cover at least one pixel so thin glyphs don't disappear.
+    size_t bit = 0;
+    for (size_t gy = 0; gy < GRID_HEIGHT; gy++){
+        size_t y0 = gy * height / GRID_HEIGHT;
+        size_t y1 = std::max(y0 + 1, (gy + 1) * height / GRID_HEIGHT);
+        for (size_t gx = 0; gx < GRID_WIDTH; gx++, bit++){
+            size_t x0 = gx * width / GRID_WIDTH;
+            size_t x1 = std::max(x0 + 1, (gx + 1) * width / GRID_WIDTH);
+            size_t area = (x1 - x0) * (y1 - y0);
+            size_t set =
+                integral[y1 * (width + 1) + x1] - integral[y0 * (width + 1) + x1] -
+                integral[y1 * (width + 1) + x0] + integral[y0 * (width + 1) + x0];
+            if (2 * set >= area){
+                ret.bits[bit / 64] |= (uint64_t)1 << (bit % 64);
+            }
+        }
+    }
+
+    return ret;
+}
+double GlyphClassifier::distance(const Template& x, const Template& y){
+    size_t diff = 0;
+    for (size_t c = 0; c < GRID_WORDS; c++){
+        diff += Kernels::popcount(x.bits[c] ^ y.bits[c]);
+    }
+    return (double)diff / (GRID_WIDTH * GRID_HEIGHT) + ASPECT_WEIGHT * std::abs(std::log(x.aspect / y.aspect));
+}
+
+
+bool GlyphClassifier::add_template(char ch, const PackedBinaryMatrix& glyph){
+    Template entry = make_template(ch, glyph);
+    for (const Template& existing : m_templates){
+        if (existing.ch == ch && distance(existing, entry) == 0){
+            return false;
+        }
+    }
+    m_templates.emplace_back(entry);
+    return true;
+}
+
+
+GlyphMatch GlyphClassifier::classify(const PackedBinaryMatrix& glyph) const{
+    GlyphMatch ret;
+    if (m_templates.empty()){
+        return ret;
+    }
+
+    Template target = make_template(0, glyph);
+
+    //  Closest template of each character.
+    std::map<char, double> best;
+    for (const Template& item : m_templates){
+        double d = distance(target, item);
+        auto iter = best.find(item.ch);
+        if (iter == best.end()){
+            best.emplace(item.ch, d);
+        }else if (d < iter->second){
+            iter->second = d;
+        }
+    }
+
+    double second = std::numeric_limits<double>::infinity();
+    for (const auto& item : best){
+        if (ret.ch == 0 || item.second < ret.distance){
+            if (ret.ch != 0){
+                second = ret.distance;
+            }
+            ret.ch = item.first;
+            ret.distance = item.second;
+        }else if (item.second < second){
+            second = item.second;
+        }
+    }
+
+    //  If there's only one character, nothing else can be confused with it.
+    ret.margin = best.size() == 1 ? 1.0 : second - ret.distance;
+
+    return ret;
+}
+char GlyphClassifier::read(const PackedBinaryMatrix& glyph, double max_distance, double min_margin) const{
+    GlyphMatch match = classify(glyph);
+    if (match.ch == 0 || match.distance > max_distance || match.margin < min_margin){
+        return 0;
+    }
+    return match.ch;
+}
+
+
+
+std::vector<Kernels::Waterfill::WaterfillObject> waterfill_glyphs(
+    PackedBinaryMatrix& matrix,
+    size_t min_area, size_t max_glyphs
+){
+    using namespace Kernels::Waterfill;
+
+    std::map<size_t, WaterfillObject> map;
+    {
+        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+        auto iter = session->make_iterator(min_area);
+        WaterfillObject object;
+        while (map.size() < max_glyphs && iter->find_next(object, true)){
+            map.emplace(object.min_x, std::move(object));
+        }
+    }
+
+    std::vector<WaterfillObject> ret;
+    for (auto& item : map){
+        ret.emplace_back(std::move(item.second));
+    }
+    return ret;
+}
+
+
+
+}
+}
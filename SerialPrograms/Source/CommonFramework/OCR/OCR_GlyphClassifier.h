@@ -0,0 +1,116 @@
+/*  OCR Glyph Classifier
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Recognize single characters of a known font by comparing them against
+ *  templates of that font. This is meant for reading short strings (codes,
+ *  numbers) where the characters can be isolated with waterfill and the font
+ *  never changes. It is orders of magnitude faster than running Tesseract on
+ *  each character.
+ *
+ *  Each glyph is scaled to a small fixed grid of bits. Two glyphs are compared
+ *  by the fraction of bits that differ plus a penalty for different aspect
+ *  ratios. The aspect ratio is needed since scaling to the grid throws it
+ *  away. (otherwise "1" and "I" would look like a solid block)
+ *
+ *  The templates are trained from sample images using
+ *  "OCR::generate_glyph_templates()" in OCR_TrainingTools.h.
+ *
+ */
+
+#ifndef PokemonAutomation_OCR_GlyphClassifier_H
+#define PokemonAutomation_OCR_GlyphClassifier_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+
+namespace PokemonAutomation{
+    class JsonValue;
+namespace OCR{
+
+
+struct GlyphMatch{
+    //  The best matching character. Zero if there are no templates.
+    char ch = 0;
+
+    //  How different the glyph is from the best template.
+    //  0 is identical. 1 is every bit different.
+    double distance = 1.0;
+
+    //  How much further away the best template of any other character is.
+    //  Small margins mean the glyph is ambiguous.
+    double margin = 0;
+};
+
+
+class GlyphClassifier{
+public:
+    static constexpr size_t GRID_WIDTH = 12;
+    static constexpr size_t GRID_HEIGHT = 16;
+    static constexpr size_t GRID_WORDS = (GRID_WIDTH * GRID_HEIGHT + 63) / 64;
+
+    //  Weight of the aspect ratio difference. (in natural log)
+    static constexpr double ASPECT_WEIGHT = 0.25;
+
+public:
+    GlyphClassifier() = default;
+
+    //  Load the templates from a JSON file. Throws if the file can't be read.
+    GlyphClassifier(const std::string& json_path);
+
+    //  Same as above, but returns an empty classifier if the file can't be
+    //  read. Use this for optional template files. Callers should then fall
+    //  back to Tesseract.
+    static GlyphClassifier load_optional(const std::string& json_path);
+
+    bool empty() const{ return m_templates.empty(); }
+    size_t templates() const{ return m_templates.size(); }
+
+    //  Add a template for "ch". Duplicate templates are skipped.
+    //  Returns true if the template was added.
+    bool add_template(char ch, const PackedBinaryMatrix& glyph);
+
+    JsonValue to_json() const;
+    void save(const std::string& json_path) const;
+
+public:
+    //  "glyph" should be cropped to the bounding box of the character.
+    //  (such as from "WaterfillObject::packed_matrix()")
+    GlyphMatch classify(const PackedBinaryMatrix& glyph) const;
+
+    //  Same as "classify()", but returns zero unless the match is within
+    //  "max_distance" and the margin is at least "min_margin".
+    char read(const PackedBinaryMatrix& glyph, double max_distance, double min_margin) const;
+
+
+private:
+    struct Template{
+        char ch;
+        double aspect;  //  width / height
+        uint64_t bits[GRID_WORDS];
+    };
+
+    static Template make_template(char ch, const PackedBinaryMatrix& glyph);
+    static double distance(const Template& x, const Template& y);
+
+private:
+    std::vector<Template> m_templates;
+};
+
+
+
+//  Isolate the characters of a binary image with waterfill. Returns the
+//  objects sorted from left to right. At most "max_glyphs" are returned.
+std::vector<Kernels::Waterfill::WaterfillObject> waterfill_glyphs(
+    PackedBinaryMatrix& matrix,
+    size_t min_area, size_t max_glyphs
+);
+
+
+
+}
+}
+#endif
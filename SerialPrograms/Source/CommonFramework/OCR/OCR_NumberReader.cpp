@@ -5,8 +5,13 @@
  */
 
 #include <map>
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/Language.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageFilter.h"
+#include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "OCR_RawOCR.h"
+#include "OCR_GlyphClassifier.h"
 #include "OCR_NumberReader.h"
 
 // #include <iostream>
@@ -70,5 +75,44 @@ int read_number(Logger& logger, const ImageViewRGB32& image){
 
 
 
+int read_number(
+    Logger& logger, const ImageViewRGB32& image,
+    const GlyphClassifier& glyphs,
+    uint32_t text_min, uint32_t text_max,
+    size_t min_area,
+    double max_distance, double min_margin
+){
+    auto fallback = [&]{
+        return read_number(logger, to_blackwhite_rgb32_range(image, text_min, text_max, true));
+    };
+    if (glyphs.empty()){
+        return fallback();
+    }
+
+    TraceScope trace("ocr", "read_number() - glyphs");
+
+    PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, text_min, text_max);
+    std::vector<Kernels::Waterfill::WaterfillObject> objects = waterfill_glyphs(matrix, min_area, 16);
+
+    std::string normalized;
+    for (const Kernels::Waterfill::WaterfillObject& object : objects){
+        char ch = glyphs.read(object.packed_matrix(), max_distance, min_margin);
+        if (ch < '0' || ch > '9'){
+            return fallback();
+        }
+        normalized += ch;
+    }
+    if (normalized.empty()){
+        return fallback();
+    }
+
+    int number = std::atoi(normalized.c_str());
+    logger.log("Glyph Text: \"" + normalized + "\" -> " + std::to_string(number));
+
+    return number;
+}
+
+
+
 }
 }
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_OCR_NumberReader_H
 #define PokemonAutomation_OCR_NumberReader_H
 
+#include <stdint.h>
 #include "CommonFramework/Logging/Logger.h"
 
 namespace PokemonAutomation{
@@ -14,9 +15,24 @@ namespace PokemonAutomation{
 namespace OCR{
 
 
+class GlyphClassifier;
+
+
 //  Returns -1 if no number is found.
 int read_number(Logger& logger, const ImageViewRGB32& image);
 
+//  Same as above, but for a number in a known font. The digits are isolated
+//  by waterfilling the pixels in [text_min, text_max] and read with "glyphs".
+//  If any of them can't be read confidently, this falls back to Tesseract on
+//  the image filtered to black text in that range.
+int read_number(
+    Logger& logger, const ImageViewRGB32& image,
+    const GlyphClassifier& glyphs,
+    uint32_t text_min, uint32_t text_max,
+    size_t min_area = 10,
+    double max_distance = 0.15, double min_margin = 0.05
+);
+
 
 }
 }
@@ -11,6 +11,7 @@
 #include "3rdParty/TesseractPA/TesseractPA.h"
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
@@ -160,6 +161,8 @@ std::map<Language, TesseractPool> ocr_pool;
 
 
 std::string ocr_read(Language language, const ImageViewRGB32& image){
+    TraceScope trace("ocr", "ocr_read()");
+
 //    static size_t c = 0;
 //    image.save("test-" + QString::number(c++) + ".png");
 
@@ -9,11 +9,13 @@
 #include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "CommonFramework/OCR/OCR_RawOCR.h"
 #include "CommonFramework/OCR/OCR_StringNormalization.h"
 #include "OCR_SmallDictionaryMatcher.h"
 #include "OCR_LargeDictionaryMatcher.h"
+#include "OCR_GlyphClassifier.h"
 #include "OCR_TrainingTools.h"
 
 namespace PokemonAutomation{
@@ -267,6 +269,70 @@ void TrainingSession::generate_large_dictionary(
 
 
 
+void generate_glyph_templates(
+    Logger& logger, CancellableScope& scope,
+    const std::string& training_data_directory,
+    const std::string& output_json_file,
+    const std::vector<std::pair<uint32_t, uint32_t>>& text_filters,
+    size_t min_area
+){
+    std::string directory = TRAINING_PATH() + training_data_directory;
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\'){
+        directory += "/";
+    }
+
+    logger.log("Generating glyph templates from: " + directory);
+
+    GlyphClassifier classifier;
+    size_t samples = 0;
+    size_t matched = 0;
+    size_t glyphs = 0;
+
+    QDirIterator iter(QString::fromStdString(directory), QStringList() << "*.png", QDir::Files, QDirIterator::Subdirectories);
+    while (iter.hasNext()){
+        iter.next();
+        std::string filepath = iter.filePath().toStdString();
+        std::string text = iter.fileName().toStdString();
+        text = text.substr(0, text.find_first_of("-."));
+
+        ImageRGB32 image(filepath);
+        if (!image || text.empty()){
+            logger.log("Skipping: " + filepath);
+            continue;
+        }
+        samples++;
+
+        bool ok = false;
+        for (const auto& filter : text_filters){
+            PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, filter.first, filter.second);
+            std::vector<Kernels::Waterfill::WaterfillObject> objects = waterfill_glyphs(matrix, min_area, text.size() + 1);
+            if (objects.size() != text.size()){
+                continue;
+            }
+            ok = true;
+            for (size_t c = 0; c < text.size(); c++){
+                glyphs += classifier.add_template(text[c], objects[c].packed_matrix());
+            }
+        }
+        if (ok){
+            matched++;
+        }else{
+            logger.log("Unable to isolate characters: " + filepath, COLOR_RED);
+        }
+
+        scope.throw_if_cancelled();
+    }
+
+    logger.log("Samples: " + tostr_u_commas(samples));
+    logger.log("Matched: " + tostr_u_commas(matched));
+    logger.log("Templates: " + tostr_u_commas(glyphs));
+
+    classifier.save(output_json_file);
+}
+
+
+
+
 }
 }
 
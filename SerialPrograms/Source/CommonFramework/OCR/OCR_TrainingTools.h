@@ -68,6 +68,23 @@ private:
 std::string extract_name(const std::string& filename);
 
 
+
+//  Generate the templates for a GlyphClassifier from a directory of sample
+//  images. (recursive, relative to "TrainingData/")
+//
+//  Each file is named "<text>-<anything>.png" where <text> is the characters
+//  in the image from left to right. The characters are isolated with
+//  "waterfill_glyphs()" for each of the text filters. Results where the number
+//  of glyphs doesn't match the text are skipped.
+void generate_glyph_templates(
+    Logger& logger, CancellableScope& scope,
+    const std::string& training_data_directory,
+    const std::string& output_json_file,
+    const std::vector<std::pair<uint32_t, uint32_t>>& text_filters,
+    size_t min_area
+);
+
+
 }
 }
 #endif
@@ -28,6 +28,25 @@ inline const EnumDatabase<ImageAttachmentMode>& ImageAttachmentMode_Database(){
 
 
 
+//  How much to downscale and compress a screenshot before sending it.
+enum class ImageAttachmentQuality{
+    ORIGINAL,
+    HIGH,
+    MEDIUM,
+    LOW,
+};
+inline const EnumDatabase<ImageAttachmentQuality>& ImageAttachmentQuality_Database(){
+    static EnumDatabase<ImageAttachmentQuality> database({
+        {ImageAttachmentQuality::ORIGINAL,  "original", "Original"},
+        {ImageAttachmentQuality::HIGH,      "high",     "High (1280 wide)"},
+        {ImageAttachmentQuality::MEDIUM,    "medium",   "Medium (960 wide)"},
+        {ImageAttachmentQuality::LOW,       "low",      "Low (640 wide)"},
+    });
+    return database;
+}
+
+
+
 class ScreenshotCell : public EnumDropdownCell<ImageAttachmentMode>{
 public:
     ScreenshotCell(ImageAttachmentMode default_mode = ImageAttachmentMode::JPG)
@@ -38,6 +57,16 @@ public:
         )
     {}
 };
+class ScreenshotQualityCell : public EnumDropdownCell<ImageAttachmentQuality>{
+public:
+    ScreenshotQualityCell(ImageAttachmentQuality default_quality = ImageAttachmentQuality::ORIGINAL)
+        : EnumDropdownCell<ImageAttachmentQuality>(
+            ImageAttachmentQuality_Database(),
+            LockWhileRunning::UNLOCKED,
+            default_quality
+        )
+    {}
+};
 class ScreenshotOption : public EnumDropdownOption<ImageAttachmentMode>{
 public:
     ScreenshotOption(std::string label)
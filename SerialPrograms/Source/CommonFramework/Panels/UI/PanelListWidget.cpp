@@ -77,6 +77,7 @@ void PanelListWidget::handle_panel_clicked(const std::string& text){
     auto iter = m_panel_map.find(text);
     if (iter == m_panel_map.end()){
         PERSISTENT_SETTINGS().panels[JSON_PROGRAM_PANEL] = "";
+        PERSISTENT_SETTINGS().write_async(JSON_PROGRAM_PANEL);
         return;
     }
     std::shared_ptr<const PanelDescriptor>& descriptor = iter->second;
@@ -90,6 +91,7 @@ void PanelListWidget::handle_panel_clicked(const std::string& text){
         m_panel_holder.load_panel(descriptor, std::move(panel));
 
         PERSISTENT_SETTINGS().panels[JSON_PROGRAM_PANEL] = iter->first;
+        PERSISTENT_SETTINGS().write_async(JSON_PROGRAM_PANEL);
     }catch (const Exception& error){
         QMessageBox box;
         box.critical(
@@ -12,6 +12,7 @@
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "NintendoSwitch/Framework/NintendoSwitch_VirtualControllerMapping.h"
+#include "PersistentSettingsWriter.h"
 #include "PersistentSettings.h"
 
 //#include <iostream>
@@ -28,22 +29,54 @@ PersistentSettings& PERSISTENT_SETTINGS(){
 }
 
 
-PersistentSettings::PersistentSettings(){}
+PersistentSettings::PersistentSettings()
+    : m_send_all_panels(true)
+{}
+PersistentSettings::~PersistentSettings() = default;
 
 
-
-void PersistentSettings::write() const{
-    JsonObject root;
-
-    root["20-GlobalSettings"] = GlobalSettings::instance().to_json();
-    root["50-SwitchKeyboardMapping"] = NintendoSwitch::read_keyboard_mapping();
-
-    root["99-Panels"] = panels.clone();
-
-    try{
+PersistentSettingsWriter& PersistentSettings::writer(){
+    //  Created on first use since the application name isn't set until then.
+    if (!m_writer){
         std::string settings_path = SETTINGS_PATH + QCoreApplication::applicationName().toStdString() + "-Settings.json";
-        root.dump(settings_path);
-    }catch (FileException&){}
+        m_writer.reset(new PersistentSettingsWriter(std::move(settings_path)));
+    }
+    return *m_writer;
+}
+
+void PersistentSettings::write(){
+    std::map<std::string, JsonValue> all_panels;
+    for (const auto& item : panels){
+        all_panels[item.first] = item.second.clone();
+    }
+    PersistentSettingsWriter& settings_writer = writer();
+    settings_writer.post(
+        GlobalSettings::instance().to_json(),
+        NintendoSwitch::read_keyboard_mapping(),
+        std::move(all_panels),
+        true
+    );
+    m_send_all_panels = false;
+    settings_writer.flush();
+}
+void PersistentSettings::write_async(const std::string& changed_panel){
+    if (m_send_all_panels){
+        write();
+        return;
+    }
+    std::map<std::string, JsonValue> changed;
+    if (!changed_panel.empty()){
+        const JsonValue* value = panels.get_value(changed_panel);
+        if (value != nullptr){
+            changed[changed_panel] = value->clone();
+        }
+    }
+    writer().post(
+        GlobalSettings::instance().to_json(),
+        NintendoSwitch::read_keyboard_mapping(),
+        std::move(changed),
+        false
+    );
 }
 
 
@@ -79,6 +112,7 @@ void PersistentSettings::read(){
             panels = std::move(*value);
         }
     }
+    m_send_all_panels = true;
 }
 
 
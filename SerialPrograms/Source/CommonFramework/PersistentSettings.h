@@ -8,10 +8,13 @@
 #ifndef PokemonAutomation_PersistentSettings_H
 #define PokemonAutomation_PersistentSettings_H
 
+#include <memory>
 #include "Common/Cpp/Json/JsonObject.h"
 
 namespace PokemonAutomation{
 
+class PersistentSettingsWriter;
+
 // Global setting of the whole program.
 // The setting is stored in the local folder, named as SerialPrograms-Settings.json.
 // The settings json has three fields:
@@ -23,14 +26,27 @@ namespace PokemonAutomation{
 class PersistentSettings{
 public:
     PersistentSettings();
-
-    // Write settings to the json file.
-    void write() const;
+    ~PersistentSettings();
+
+    // Write settings to the json file. Blocks until it is written.
+    void write();
+    // Queue a write of the settings on a background thread. Rapid changes are
+    // batched into one write. "changed_panel" is the key in "panels" that
+    // changed, if any. Only that key gets serialized again, so anything that
+    // sets a key in "panels" must pass it here.
+    void write_async(const std::string& changed_panel = "");
     // Load settings from the json file.
     void read();
 
 public:
     JsonObject panels;
+
+private:
+    PersistentSettingsWriter& writer();
+
+    std::unique_ptr<PersistentSettingsWriter> m_writer;
+    //  The writer has not seen the panels yet. Send all of them.
+    bool m_send_all_panels;
 };
 
 // Return the singleton PersistentSettings.
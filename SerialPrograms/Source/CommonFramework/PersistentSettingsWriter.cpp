@@ -0,0 +1,210 @@
+/*  Persistent Settings Writer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Json/JsonTools.h"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "PersistentSettingsWriter.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+struct PersistentSettingsWriter::Pending{
+    JsonValue global_settings;
+    JsonValue keyboard_mapping;
+    std::map<std::string, JsonValue> panels;
+    bool all_panels = false;
+};
+
+
+
+PersistentSettingsWriter::PersistentSettingsWriter(
+    std::string path,
+    std::chrono::milliseconds quiet_period,
+    std::chrono::milliseconds max_delay
+)
+    : m_path(std::move(path))
+    , m_quiet_period(quiet_period)
+    , m_max_delay(max_delay)
+    , m_latency(MetricsRegistry::instance().histogram("settings_write_us"))
+    , m_first_change(WallClock::min())
+    , m_last_change(WallClock::min())
+    , m_posted(0)
+    , m_written(0)
+    , m_flushing(false)
+    , m_stopping(false)
+{
+    m_thread = std::thread(run_with_catch, "PersistentSettingsWriter::thread_loop()", [this]{ thread_loop(); });
+}
+PersistentSettingsWriter::~PersistentSettingsWriter(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+
+void PersistentSettingsWriter::post(
+    JsonValue global_settings,
+    JsonValue keyboard_mapping,
+    std::map<std::string, JsonValue> changed_panels,
+    bool all_panels
+){
+    WallClock now = current_time();
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (!m_pending){
+            m_pending.reset(new Pending());
+            m_first_change = now;
+        }
+        m_last_change = now;
+        m_posted++;
+
+        Pending& pending = *m_pending;
+        pending.global_settings = std::move(global_settings);
+        pending.keyboard_mapping = std::move(keyboard_mapping);
+        if (all_panels){
+            pending.panels = std::move(changed_panels);
+            pending.all_panels = true;
+        }else{
+            for (auto& item : changed_panels){
+                pending.panels[item.first] = std::move(item.second);
+            }
+        }
+    }
+    m_cv.notify_all();
+}
+void PersistentSettingsWriter::flush(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    uint64_t target = m_posted;
+    if (m_written >= target){
+        return;
+    }
+    m_flushing = true;
+    m_cv.notify_all();
+    m_cv.wait(lg, [&]{ return m_written >= target; });
+}
+
+
+void PersistentSettingsWriter::thread_loop(){
+    while (true){
+        std::unique_ptr<Pending> pending;
+        uint64_t seqnum;
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+            while (true){
+                if (!m_pending){
+                    if (m_stopping){
+                        return;
+                    }
+                    m_cv.wait(lg);
+                    continue;
+                }
+                if (m_stopping || m_flushing){
+                    break;
+                }
+
+                //  Wait for the changes to stop. But not forever.
+                WallClock deadline = std::min(m_last_change + m_quiet_period, m_first_change + m_max_delay);
+                if (current_time() >= deadline){
+                    break;
+                }
+                m_cv.wait_until(lg, deadline);
+            }
+            pending = std::move(m_pending);
+            seqnum = m_posted;
+            m_flushing = false;
+        }
+
+        write(*pending);
+
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_written = seqnum;
+        }
+        m_cv.notify_all();
+    }
+}
+
+
+//  Append '"key": value' at "depth" levels of indentation. "value" is the text
+//  of the value dumped by itself. It gets indented to match.
+static void append_json_member(std::string& out, const std::string& key, const std::string& value, size_t depth){
+    const std::string indent(4 * depth, ' ');
+    out += indent;
+    out += JsonValue(key).dump();
+    out += ": ";
+    for (char ch : value){
+        out += ch;
+        if (ch == '\n'){
+            out += indent;
+        }
+    }
+}
+
+void PersistentSettingsWriter::write(Pending& pending){
+    WallClock start = current_time();
+
+    //  Only serialize what changed.
+    m_global_settings = pending.global_settings.dump();
+    m_keyboard_mapping = pending.keyboard_mapping.dump();
+    if (pending.all_panels){
+        m_panels.clear();
+    }
+    for (const auto& item : pending.panels){
+        m_panels[item.first] = item.second.dump();
+    }
+
+    //  Same layout as dumping the whole tree.
+    std::string text = "{\n";
+    append_json_member(text, "20-GlobalSettings", m_global_settings, 1);
+    text += ",\n";
+    append_json_member(text, "50-SwitchKeyboardMapping", m_keyboard_mapping, 1);
+    text += ",\n";
+    if (m_panels.empty()){
+        append_json_member(text, "99-Panels", "{}", 1);
+    }else{
+        std::string panels = "{\n";
+        bool first = true;
+        for (const auto& item : m_panels){
+            if (!first){
+                panels += ",\n";
+            }
+            first = false;
+            append_json_member(panels, item.first, item.second, 1);
+        }
+        panels += "\n}";
+        append_json_member(text, "99-Panels", panels, 1);
+    }
+    text += "\n}";
+
+    try{
+        string_to_file(m_path, text);
+    }catch (FileException& e){
+        global_logger_tagged().log("Unable to save settings: " + e.message(), COLOR_RED);
+        return;
+    }
+
+    uint64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start).count();
+    m_latency->record(microseconds);
+    global_logger_tagged().log(
+        "Saved settings in " + std::to_string(microseconds / 1000) + " ms. (" +
+        std::to_string(pending.panels.size()) + " of " + std::to_string(m_panels.size()) + " panels serialized)"
+    );
+}
+
+
+
+}
@@ -0,0 +1,95 @@
+/*  Persistent Settings Writer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Write the settings file on a background thread.
+ *
+ *  Writes are debounced. A write happens once there have been no new changes
+ *  for "quiet_period", but never later than "max_delay" after the first
+ *  change. So a burst of changes becomes one write.
+ *
+ *  The file is serialized incrementally. Each panel's text is cached and only
+ *  the panels that changed are serialized again. The file is assembled from
+ *  the cached pieces and is identical to dumping the whole tree at once.
+ *
+ */
+
+#ifndef PokemonAutomation_PersistentSettingsWriter_H
+#define PokemonAutomation_PersistentSettingsWriter_H
+
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonValue.h"
+
+namespace PokemonAutomation{
+
+class HdrHistogram;
+
+
+class PersistentSettingsWriter{
+public:
+    PersistentSettingsWriter(
+        std::string path,
+        std::chrono::milliseconds quiet_period = std::chrono::milliseconds(500),
+        std::chrono::milliseconds max_delay = std::chrono::milliseconds(5000)
+    );
+
+    //  Writes anything that is still pending.
+    ~PersistentSettingsWriter();
+
+    //  Queue a write. "global_settings" and "keyboard_mapping" replace the
+    //  previous ones. "changed_panels" only needs the panels that changed
+    //  since the last post. If "all_panels" is true, it has every panel and
+    //  any panel not in it is dropped.
+    void post(
+        JsonValue global_settings,
+        JsonValue keyboard_mapping,
+        std::map<std::string, JsonValue> changed_panels,
+        bool all_panels
+    );
+
+    //  Write anything pending now and wait for it to finish.
+    void flush();
+
+
+private:
+    struct Pending;
+
+    void thread_loop();
+    void write(Pending& pending);
+
+
+private:
+    const std::string m_path;
+    const std::chrono::milliseconds m_quiet_period;
+    const std::chrono::milliseconds m_max_delay;
+    std::shared_ptr<HdrHistogram> m_latency;
+
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::unique_ptr<Pending> m_pending;
+    WallClock m_first_change;
+    WallClock m_last_change;
+    uint64_t m_posted;
+    uint64_t m_written;
+    bool m_flushing;
+    bool m_stopping;
+
+    //  Only used by the writer thread.
+    std::string m_global_settings;
+    std::string m_keyboard_mapping;
+    std::map<std::string, std::string> m_panels;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
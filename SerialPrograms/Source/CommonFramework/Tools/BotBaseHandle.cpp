@@ -11,11 +11,13 @@
 #include "Common/Cpp/PanicDump.h"
 #include "Common/Cpp/Concurrency/SpinPause.h"
 #include "Common/Cpp/Options/TimeExpressionOption.h"
+#include "Common/Cpp/Metrics/MetricsRegistry.h"
 #include "Common/Microcontroller/DeviceRoutines.h"
 #include "Common/NintendoSwitch/NintendoSwitch_ControllerDefs.h"
 #include "ClientSource/Libraries/MessageConverter.h"
 #include "ClientSource/Connection/SerialConnection.h"
 #include "ClientSource/Connection/PABotBase.h"
+#include "ClientSource/Connection/WireTrace.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Options/Environment/ThemeSelectorOption.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_Device.h"
@@ -46,6 +48,7 @@ BotBaseHandle::BotBaseHandle(
 BotBaseHandle::~BotBaseHandle(){
     stop();
     m_botbase.reset();
+    m_wire_trace.reset();
     m_state.store(State::NOT_CONNECTED, std::memory_order_release);
     emit on_not_connected("");
 }
@@ -203,7 +206,18 @@ void BotBaseHandle::reset_unprotected(const QSerialPortInfo* port){
 
     try{
         std::unique_ptr<SerialConnection> connection(new SerialConnection(name, PABB_BAUD_RATE));
-        m_botbase.reset(new PABotBase(m_logger, std::move(connection), nullptr));
+
+        //  Always record the traffic so there's something to look at if the
+        //  console desyncs. Decode with ClientSource/Programs/WireTraceDecoder.cpp.
+        //  The trace forwards everything to the serial logger.
+        m_botbase.reset();
+        m_wire_trace.reset(new WireTraceWriter(WIRE_TRACES_PATH + port->portName().toStdString() + ".pabbwire", &m_logger));
+
+        m_botbase.reset(new PABotBase(m_logger, std::move(connection), m_wire_trace.get()));
+
+        std::string labels = MetricsRegistry::label("port", port->portName().toStdString());
+        MetricsRegistry::instance().add_histogram("pabotbase_request_ack_us", labels, m_botbase->request_ack_latency());
+        MetricsRegistry::instance().add_histogram("pabotbase_command_ack_us", labels, m_botbase->command_ack_latency());
         m_current_pabotbase.store(PABotBaseLevel::NOT_PABOTBASE, std::memory_order_release);
     }catch (const ConnectionException& e){
         error = e.message();
@@ -265,8 +279,6 @@ uint8_t BotBaseHandle::verify_pabotbase(){
 void BotBaseHandle::thread_body(){
     using namespace PokemonAutomation;
 
-    m_botbase->set_sniffer(&m_logger);
-
     //  Connect
     {
         std::string error;
@@ -21,6 +21,7 @@ namespace PokemonAutomation{
 
 class MessageSniffer;
 class PABotBase;
+class WireTraceWriter;
 
 
 class BotBaseHandle : public QObject{
@@ -102,6 +103,9 @@ private:
     std::string m_label;
 
     std::thread m_status_thread;
+
+    //  Must outlive "m_botbase" since it is its sniffer.
+    std::unique_ptr<WireTraceWriter> m_wire_trace;
     std::unique_ptr<PABotBase> m_botbase;
     mutable std::mutex m_lock;
     std::mutex m_sleep_lock;
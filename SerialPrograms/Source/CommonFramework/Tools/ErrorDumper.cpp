@@ -7,6 +7,7 @@
 #include <mutex>
 #include <QDir>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Notifications/EventNotificationOption.h"
@@ -14,6 +15,7 @@
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
+#include "CommonFramework/VideoPipeline/VideoRecordingRing.h"
 #include "ConsoleHandle.h"
 #include "ErrorDumper.h"
 #include "ProgramEnvironment.h"
@@ -24,7 +26,8 @@ namespace PokemonAutomation{
 std::string dump_image_alone(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
-    const ImageViewRGB32& image
+    const ImageViewRGB32& image,
+    const Logger* console_logger
 ){
     static std::mutex lock;
     std::lock_guard<std::mutex> lg(lock);
@@ -34,6 +37,21 @@ std::string dump_image_alone(
     name += now_to_filestring();
     name += "-";
     name += label;
+
+    //  What the pipeline was doing leading up to the error. (if enabled)
+    if (TraceRecorder::instance().enabled()){
+        std::string trace = name + "-trace.json";
+        if (TraceRecorder::instance().dump(trace)){
+            logger.log("Saving pipeline trace to: " + trace, COLOR_RED);
+        }
+    }
+
+    //  The last few seconds of video of the console that failed. (if enabled)
+    std::string clip = VideoRecordingRing::export_console(console_logger ? *console_logger : logger, name);
+    if (!clip.empty()){
+        logger.log("Saving recent video to: " + clip, COLOR_RED);
+    }
+
     name += ".png";
     logger.log("Saving failed inference image to: " + name, COLOR_RED);
     image.save(name);
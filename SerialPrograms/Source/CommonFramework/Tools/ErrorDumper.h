@@ -19,10 +19,15 @@ class Logger;
 class ProgramEnvironment;
 struct ProgramInfo;
 
+// Dump error image to ./ErrorDumps/ folder. Return image path.
+// If recent video recording is enabled, the recent video of the console that
+// failed is saved next to it. That console is "console_logger" if given.
+// Otherwise it's "logger" if that is a console's logger.
 std::string dump_image_alone(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
-    const ImageViewRGB32& image
+    const ImageViewRGB32& image,
+    const Logger* console_logger = nullptr
 );
 // Dump error image to ./ErrorDumps/ folder. Also send image as telemetry if user allows.
 // Return image path.
@@ -11,6 +11,7 @@
 #include <QVBoxLayout>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/VideoPipeline/CameraOption.h"
 #include "VideoToolsQt5.h"
@@ -241,6 +242,8 @@ bool CameraSession::determine_frame_orientation(){
     return m_orientation_known;
 }
 VideoSnapshot CameraSession::snapshot(){
+    TraceScope trace("video", "CameraSession::snapshot()");
+
     std::unique_lock<std::mutex> lg(m_lock);
 
     //  Frame screenshots are disabled.
@@ -14,7 +14,10 @@
 #include <QMediaDevices>
 #include <QVideoSink>
 //#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/VideoPipeline/CameraOption.h"
+#include "VideoToolsQt6.h"
 #include "CameraWidgetQt6.h"
 
 //using std::cout;
@@ -84,6 +87,7 @@ CameraSession::CameraSession(Logger& logger, Resolution default_resolution)
     , m_last_frame_seqnum(0)
     , m_last_image_timestamp(WallClock::min())
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
+    , m_last_lazy_timestamp(WallClock::min())
 {}
 
 void CameraSession::get(CameraOption& option){
@@ -164,6 +168,8 @@ void CameraSession::report_rendered_frame(WallClock timestamp){
 }
 
 VideoSnapshot CameraSession::snapshot(){
+    TraceScope trace("video", "CameraSession::snapshot()");
+
     //  Prevent multiple concurrent screenshots from entering here.
     std::lock_guard<std::mutex> lg(m_lock);
 
@@ -185,6 +191,63 @@ VideoSnapshot CameraSession::snapshot(){
         frame_timestamp = m_last_frame_timestamp;
     }
 
+    return convert_full_frame(frame, frame_timestamp, frame_seqnum);
+}
+VideoSnapshot CameraSession::snapshot_lazy(){
+    TraceScope trace("video", "CameraSession::snapshot_lazy()");
+
+    if (!GlobalSettings::instance().ENABLE_LAZY_FRAME_CONVERSION){
+        return snapshot();
+    }
+
+    //  Prevent multiple concurrent screenshots from entering here.
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    if (m_camera == nullptr){
+        return VideoSnapshot();
+    }
+
+    //  Frame is already cached and is not stale.
+    QVideoFrame frame;
+    WallClock frame_timestamp;
+    uint64_t frame_seqnum;
+    {
+        SpinLockGuard lg0(m_frame_lock);
+        frame_seqnum = m_last_frame_seqnum;
+        if (!m_last_image.isNull() && m_last_image_seqnum == frame_seqnum){
+            return VideoSnapshot(m_last_image, m_last_image_timestamp);
+        }
+        frame = m_last_frame;
+        frame_timestamp = m_last_frame_timestamp;
+    }
+    if (m_last_lazy_seqnum == frame_seqnum){
+        std::shared_ptr<LazyVideoFrame> lazy = m_last_lazy.lock();
+        if (lazy){
+            return VideoSnapshot(std::move(lazy), m_last_lazy_timestamp);
+        }
+    }
+
+    if (!frame.isValid()){
+        global_logger_tagged().log("QVideoFrame is null.", COLOR_RED);
+        return VideoSnapshot();
+    }
+
+    std::unique_ptr<LazyVideoFrameConverter> converter = make_lazy_frame_converter(frame);
+    if (!converter){
+        //  Unsupported pixel format. Convert the whole thing.
+        return convert_full_frame(frame, frame_timestamp, frame_seqnum);
+    }
+
+    std::shared_ptr<LazyVideoFrame> lazy = std::make_shared<LazyVideoFrame>(frame.width(), frame.height(), std::move(converter));
+    m_last_lazy = lazy;
+    m_last_lazy_timestamp = frame_timestamp;
+    m_last_lazy_seqnum = frame_seqnum;
+
+    return VideoSnapshot(std::move(lazy), m_last_lazy_timestamp);
+}
+VideoSnapshot CameraSession::convert_full_frame(const QVideoFrame& frame, WallClock frame_timestamp, uint64_t frame_seqnum){
+    TraceScope trace("video", "CameraSession::convert_full_frame()");
+
     if (!frame.isValid()){
         global_logger_tagged().log("QVideoFrame is null.", COLOR_RED);
         return VideoSnapshot();
@@ -243,6 +306,10 @@ void CameraSession::shutdown(){
     m_last_image_timestamp = m_last_frame_timestamp;
     m_last_image_seqnum = m_last_frame_seqnum;
 
+    m_last_lazy.reset();
+    m_last_lazy_timestamp = m_last_frame_timestamp;
+    m_last_lazy_seqnum = m_last_frame_seqnum;
+
 }
 void CameraSession::startup(){
     if (!m_device){
@@ -70,6 +70,7 @@ public:
     virtual std::vector<Resolution> supported_resolutions() const override;
 
     virtual VideoSnapshot snapshot() override;
+    virtual VideoSnapshot snapshot_lazy() override;
     virtual double fps_source() override;
     virtual double fps_display() override;
 
@@ -84,6 +85,9 @@ private:
     void shutdown();
     void startup();
 
+    //  Must be called under "m_lock".
+    VideoSnapshot convert_full_frame(const QVideoFrame& frame, WallClock frame_timestamp, uint64_t frame_seqnum);
+
 
 private:
     Logger& m_logger;
@@ -119,6 +123,13 @@ private:
     uint64_t m_last_image_seqnum = 0;
     PeriodicStatsReporterI32 m_stats_conversion;
 
+    //  Last Lazy Frame
+    //  Not owned. It holds the native frame and should go away as soon as the
+    //  callbacks are done with it.
+    std::weak_ptr<LazyVideoFrame> m_last_lazy;
+    WallClock m_last_lazy_timestamp;
+    uint64_t m_last_lazy_seqnum = 0;
+
     std::set<Listener*> m_ui_listeners;
     std::set<FrameListener*> m_frame_listeners;
 
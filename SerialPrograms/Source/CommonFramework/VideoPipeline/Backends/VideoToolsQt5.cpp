@@ -10,6 +10,7 @@
 #include <QCameraInfo>
 #include <QCoreApplication>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageTools/ImageStats.h"
 #include "CommonFramework/ImageMatch/ImageDiff.h"
@@ -197,6 +198,8 @@ CameraScreenshotter::~CameraScreenshotter(){
     delete m_capture;
 }
 VideoSnapshot CameraScreenshotter::snapshot(){
+    TraceScope trace("video", "CameraScreenshotter::snapshot()");
+
     //  Only allow one snapshot at a time.
     WallClock timestamp = current_time();
 
@@ -0,0 +1,283 @@
+/*  Video Tools (QT6)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QtGlobal>
+#if QT_VERSION_MAJOR == 6
+
+#include <algorithm>
+#include <QVideoFrameFormat>
+#include "Common/Compiler.h"
+#include "VideoToolsQt6.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+//  Fixed-point (16.16) YCbCr -> RGB coefficients.
+struct YCbCrCoefficients{
+    int32_t y_offset;
+    int32_t y_scale;
+    int32_t r_v;
+    int32_t g_u;
+    int32_t g_v;
+    int32_t b_u;
+
+    YCbCrCoefficients(double kr, double kb, bool full_range){
+        double kg = 1 - kr - kb;
+        double y_scale_f = full_range ? 1.0 : 255. / 219;
+        double c_scale_f = full_range ? 1.0 : 255. / 224;
+        y_offset = full_range ? 0 : 16;
+        y_scale = (int32_t)(y_scale_f * 65536 + 0.5);
+        r_v = (int32_t)(c_scale_f * 2 * (1 - kr) * 65536 + 0.5);
+        g_u = (int32_t)(c_scale_f * 2 * kb * (1 - kb) / kg * 65536 + 0.5);
+        g_v = (int32_t)(c_scale_f * 2 * kr * (1 - kr) / kg * 65536 + 0.5);
+        b_u = (int32_t)(c_scale_f * 2 * (1 - kb) * 65536 + 0.5);
+    }
+
+    PA_FORCE_INLINE uint32_t to_rgb32(uint8_t y, uint8_t u, uint8_t v) const{
+        int32_t yy = (y - y_offset) * y_scale + 32768;
+        int32_t uu = u - 128;
+        int32_t vv = v - 128;
+        int32_t r = (yy + r_v * vv) >> 16;
+        int32_t g = (yy - g_u * uu - g_v * vv) >> 16;
+        int32_t b = (yy + b_u * uu) >> 16;
+        r = std::min<int32_t>(std::max<int32_t>(r, 0), 255);
+        g = std::min<int32_t>(std::max<int32_t>(g, 0), 255);
+        b = std::min<int32_t>(std::max<int32_t>(b, 0), 255);
+        return 0xff000000 | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+    }
+};
+YCbCrCoefficients get_ycbcr_coefficients(const QVideoFrameFormat& format){
+#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
+    bool full_range = format.colorRange() == QVideoFrameFormat::ColorRange_Full;
+    switch (format.colorSpace()){
+    case QVideoFrameFormat::ColorSpace_BT709:
+        return YCbCrCoefficients(0.2126, 0.0722, full_range);
+    case QVideoFrameFormat::ColorSpace_BT2020:
+        return YCbCrCoefficients(0.2627, 0.0593, full_range);
+    default:
+        return YCbCrCoefficients(0.299, 0.114, full_range);
+    }
+#else
+    switch (format.yCbCrColorSpace()){
+    case QVideoFrameFormat::YCbCr_BT709:
+    case QVideoFrameFormat::YCbCr_xvYCC709:
+        return YCbCrCoefficients(0.2126, 0.0722, false);
+    case QVideoFrameFormat::YCbCr_BT2020:
+        return YCbCrCoefficients(0.2627, 0.0593, false);
+    case QVideoFrameFormat::YCbCr_JPEG:
+        return YCbCrCoefficients(0.299, 0.114, true);
+    default:
+        return YCbCrCoefficients(0.299, 0.114, false);
+    }
+#endif
+}
+
+
+
+class QVideoFrameConverter : public LazyVideoFrameConverter{
+public:
+    enum class Layout{
+        BGRA,   //  Same as our RGB32 in memory.
+        ARGB,
+        RGBA,
+        ABGR,
+        NV12,
+        NV21,
+        YUV420P,
+        YV12,
+        YUYV,
+        UYVY,
+    };
+
+public:
+    QVideoFrameConverter(QVideoFrame frame, Layout layout)
+        : m_frame(std::move(frame))
+        , m_layout(layout)
+        , m_height(m_frame.height())
+        , m_bottom_to_top(m_frame.surfaceFormat().scanLineDirection() == QVideoFrameFormat::BottomToTop)
+        , m_coefficients(get_ycbcr_coefficients(m_frame.surfaceFormat()))
+    {
+        m_mapped = m_frame.map(QVideoFrame::ReadOnly);
+        for (int c = 0; c < 3; c++){
+            if (c < m_frame.planeCount()){
+                m_planes[c] = m_frame.bits(c);
+                m_bytes_per_line[c] = m_frame.bytesPerLine(c);
+            }else{
+                m_planes[c] = nullptr;
+                m_bytes_per_line[c] = 0;
+            }
+        }
+    }
+    virtual ~QVideoFrameConverter(){
+        if (m_mapped){
+            m_frame.unmap();
+        }
+    }
+
+    bool is_mapped() const{ return m_mapped; }
+
+    virtual void convert(
+        uint32_t* out, size_t bytes_per_row,
+        size_t min_x, size_t min_y,
+        size_t width, size_t height
+    ) override{
+        for (size_t r = 0; r < height; r++){
+            size_t y = min_y + r;
+            if (m_bottom_to_top){
+                y = m_height - 1 - y;
+            }
+            convert_row(out, min_x, y, width);
+            out = (uint32_t*)((char*)out + bytes_per_row);
+        }
+    }
+
+private:
+    const uint8_t* row(int plane, size_t y) const{
+        return m_planes[plane] + y * m_bytes_per_line[plane];
+    }
+    void convert_row(uint32_t* out, size_t min_x, size_t y, size_t width) const{
+        const YCbCrCoefficients& k = m_coefficients;
+        switch (m_layout){
+        case Layout::BGRA:{
+            const uint32_t* src = (const uint32_t*)row(0, y) + min_x;
+            for (size_t c = 0; c < width; c++){
+                out[c] = src[c] | 0xff000000;
+            }
+            return;
+        }
+        case Layout::ARGB:{
+            const uint8_t* src = row(0, y) + 4*min_x;
+            for (size_t c = 0; c < width; c++, src += 4){
+                out[c] = 0xff000000 | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | src[3];
+            }
+            return;
+        }
+        case Layout::RGBA:{
+            const uint8_t* src = row(0, y) + 4*min_x;
+            for (size_t c = 0; c < width; c++, src += 4){
+                out[c] = 0xff000000 | ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+            }
+            return;
+        }
+        case Layout::ABGR:{
+            const uint8_t* src = row(0, y) + 4*min_x;
+            for (size_t c = 0; c < width; c++, src += 4){
+                out[c] = 0xff000000 | ((uint32_t)src[3] << 16) | ((uint32_t)src[2] << 8) | src[1];
+            }
+            return;
+        }
+        case Layout::NV12:
+        case Layout::NV21:{
+            const uint8_t* src_y = row(0, y);
+            const uint8_t* src_uv = row(1, y / 2);
+            size_t u_index = m_layout == Layout::NV12 ? 0 : 1;
+            size_t v_index = 1 - u_index;
+            for (size_t c = 0; c < width; c++){
+                size_t x = min_x + c;
+                const uint8_t* uv = src_uv + (x & ~(size_t)1);
+                out[c] = k.to_rgb32(src_y[x], uv[u_index], uv[v_index]);
+            }
+            return;
+        }
+        case Layout::YUV420P:
+        case Layout::YV12:{
+            const uint8_t* src_y = row(0, y);
+            const uint8_t* src_u = row(m_layout == Layout::YUV420P ? 1 : 2, y / 2);
+            const uint8_t* src_v = row(m_layout == Layout::YUV420P ? 2 : 1, y / 2);
+            for (size_t c = 0; c < width; c++){
+                size_t x = min_x + c;
+                out[c] = k.to_rgb32(src_y[x], src_u[x / 2], src_v[x / 2]);
+            }
+            return;
+        }
+        case Layout::YUYV:
+        case Layout::UYVY:{
+            const uint8_t* src = row(0, y);
+            size_t y_index = m_layout == Layout::YUYV ? 0 : 1;
+            size_t u_index = m_layout == Layout::YUYV ? 1 : 0;
+            for (size_t c = 0; c < width; c++){
+                size_t x = min_x + c;
+                const uint8_t* pair = src + 2*(x & ~(size_t)1);
+                out[c] = k.to_rgb32(pair[2*(x & 1) + y_index], pair[u_index], pair[u_index + 2]);
+            }
+            return;
+        }
+        }
+    }
+
+private:
+    QVideoFrame m_frame;
+    Layout m_layout;
+    size_t m_height;
+    bool m_bottom_to_top;
+    bool m_mapped = false;
+    YCbCrCoefficients m_coefficients;
+    const uint8_t* m_planes[3];
+    size_t m_bytes_per_line[3];
+};
+
+
+
+std::unique_ptr<LazyVideoFrameConverter> make_lazy_frame_converter(const QVideoFrame& frame){
+    using Layout = QVideoFrameConverter::Layout;
+    Layout layout;
+    switch (frame.pixelFormat()){
+    case QVideoFrameFormat::Format_BGRA8888:
+    case QVideoFrameFormat::Format_BGRX8888:
+        layout = Layout::BGRA;
+        break;
+    case QVideoFrameFormat::Format_ARGB8888:
+    case QVideoFrameFormat::Format_XRGB8888:
+        layout = Layout::ARGB;
+        break;
+    case QVideoFrameFormat::Format_RGBA8888:
+    case QVideoFrameFormat::Format_RGBX8888:
+        layout = Layout::RGBA;
+        break;
+    case QVideoFrameFormat::Format_ABGR8888:
+    case QVideoFrameFormat::Format_XBGR8888:
+        layout = Layout::ABGR;
+        break;
+    case QVideoFrameFormat::Format_NV12:
+        layout = Layout::NV12;
+        break;
+    case QVideoFrameFormat::Format_NV21:
+        layout = Layout::NV21;
+        break;
+    case QVideoFrameFormat::Format_YUV420P:
+        layout = Layout::YUV420P;
+        break;
+    case QVideoFrameFormat::Format_YV12:
+        layout = Layout::YV12;
+        break;
+    case QVideoFrameFormat::Format_YUYV:
+        layout = Layout::YUYV;
+        break;
+    case QVideoFrameFormat::Format_UYVY:
+        layout = Layout::UYVY;
+        break;
+    default:
+        //  Premultiplied, high bit-depth, JPEG, etc...
+        return nullptr;
+    }
+
+    std::unique_ptr<QVideoFrameConverter> converter(new QVideoFrameConverter(frame, layout));
+    if (!converter->is_mapped()){
+        return nullptr;
+    }
+    return converter;
+}
+
+
+
+
+}
+#endif
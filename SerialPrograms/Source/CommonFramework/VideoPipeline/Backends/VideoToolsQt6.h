@@ -0,0 +1,29 @@
+/*  Video Tools (QT6)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoToolsQt6_H
+#define PokemonAutomation_VideoPipeline_VideoToolsQt6_H
+
+#include <QtGlobal>
+#if QT_VERSION_MAJOR == 6
+
+#include <memory>
+#include <QVideoFrame>
+#include "CommonFramework/VideoPipeline/LazyVideoFrame.h"
+
+namespace PokemonAutomation{
+
+
+//  Return a converter that reads directly out of the mapped native frame.
+//  Returns null if the pixel format of the frame isn't supported. In that
+//  case, the caller should fall back to "QVideoFrame::toImage()".
+std::unique_ptr<LazyVideoFrameConverter> make_lazy_frame_converter(const QVideoFrame& frame);
+
+
+
+}
+#endif
+#endif
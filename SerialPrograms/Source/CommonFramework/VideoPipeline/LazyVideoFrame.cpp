@@ -0,0 +1,126 @@
+/*  Lazy Video Frame
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "LazyVideoFrame.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+LazyVideoFrame::LazyVideoFrame(
+    size_t width, size_t height,
+    std::unique_ptr<LazyVideoFrameConverter> converter
+)
+    : m_width(width)
+    , m_height(height)
+    , m_tiles_x((width + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles_y((height + TILE_SIZE - 1) / TILE_SIZE)
+    , m_image(std::make_shared<ImageRGB32>(width, height))
+    , m_complete(m_tiles_x * m_tiles_y == 0)
+    , m_tiles_converted(0)
+    , m_tile_ready(m_tiles_x * m_tiles_y, false)
+    , m_converter(std::move(converter))
+{}
+
+
+ImageViewRGB32 LazyVideoFrame::extract_box_reference(const ImagePixelBox& box){
+    ImageViewRGB32 ret = PokemonAutomation::extract_box_reference((const ImageViewRGB32&)*m_image, box);
+    if (!ret || m_complete.load(std::memory_order_acquire)){
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_complete.load(std::memory_order_relaxed)){
+        return ret;
+    }
+
+    //  Recover the clipped region from the view.
+    size_t offset = (const char*)ret.data() - (const char*)m_image->data();
+    size_t min_y = offset / m_image->bytes_per_row();
+    size_t min_x = offset % m_image->bytes_per_row() / sizeof(uint32_t);
+
+    convert_tiles(
+        min_x / TILE_SIZE,
+        min_y / TILE_SIZE,
+        (min_x + ret.width() + TILE_SIZE - 1) / TILE_SIZE,
+        (min_y + ret.height() + TILE_SIZE - 1) / TILE_SIZE
+    );
+    return ret;
+}
+ImageViewRGB32 LazyVideoFrame::extract_box_reference(const ImageFloatBox& box){
+    size_t min_x = (size_t)(m_width * box.x + 0.5);
+    size_t min_y = (size_t)(m_height * box.y + 0.5);
+    size_t width = (size_t)(m_width * box.width + 0.5);
+    size_t height = (size_t)(m_height * box.height + 0.5);
+    return extract_box_reference(ImagePixelBox(min_x, min_y, min_x + width, min_y + height));
+}
+std::shared_ptr<const ImageRGB32> LazyVideoFrame::full_frame(){
+    if (m_complete.load(std::memory_order_acquire)){
+        return m_image;
+    }
+    std::lock_guard<std::mutex> lg(m_lock);
+    convert_tiles(0, 0, m_tiles_x, m_tiles_y);
+    return m_image;
+}
+
+
+void LazyVideoFrame::convert_tiles(
+    size_t tile_min_x, size_t tile_min_y,
+    size_t tile_max_x, size_t tile_max_y
+){
+    if (m_complete.load(std::memory_order_relaxed)){
+        return;
+    }
+
+    ImageRGB32& image = *m_image;
+    size_t bytes_per_row = image.bytes_per_row();
+    size_t converted = m_tiles_converted.load(std::memory_order_relaxed);
+
+    for (size_t ty = tile_min_y; ty < tile_max_y; ty++){
+        uint8_t* ready = &m_tile_ready[ty * m_tiles_x];
+        size_t y = ty * TILE_SIZE;
+        size_t rows = std::min(TILE_SIZE, m_height - y);
+
+        //  Convert each run of adjacent unconverted tiles in one call.
+        size_t tx = tile_min_x;
+        while (tx < tile_max_x){
+            if (ready[tx]){
+                tx++;
+                continue;
+            }
+            size_t run_end = tx + 1;
+            while (run_end < tile_max_x && !ready[run_end]){
+                run_end++;
+            }
+
+            size_t x = tx * TILE_SIZE;
+            size_t cols = std::min(run_end * TILE_SIZE, m_width) - x;
+            m_converter->convert(&image.pixel(x, y), bytes_per_row, x, y, cols, rows);
+
+            for (; tx < run_end; tx++){
+                ready[tx] = true;
+            }
+            converted += run_end - (x / TILE_SIZE);
+        }
+    }
+
+    m_tiles_converted.store(converted, std::memory_order_relaxed);
+    if (converted == total_tiles()){
+        //  Nothing left to read from the native frame.
+        m_converter.reset();
+        m_complete.store(true, std::memory_order_release);
+    }
+}
+
+
+
+
+}
@@ -0,0 +1,108 @@
+/*  Lazy Video Frame
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A video frame that is converted to RGB32 on demand. Most detectors only
+ *  read a few small boxes of the screen. So instead of converting the entire
+ *  native frame up front, convert only the tiles that are actually accessed
+ *  and cache them for the remaining callbacks that run on the same frame.
+ *
+ *  The whole frame goes through the same converter. So a box reads the same
+ *  pixels regardless of whether it was read before or after the full frame.
+ *
+ *  A lazy frame holds onto the native frame until it is destroyed. Don't keep
+ *  it beyond the callback. See "VideoSnapshot::detach()".
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_LazyVideoFrame_H
+#define PokemonAutomation_VideoPipeline_LazyVideoFrame_H
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+
+//  Converts regions of a native video frame into RGB32.
+//  Implementations are backend-specific and hold onto the native frame.
+class LazyVideoFrameConverter{
+public:
+    virtual ~LazyVideoFrameConverter() = default;
+
+    //  Convert the region (min_x, min_y, width, height) of the native frame.
+    //  "out" points to the destination pixel for (min_x, min_y).
+    virtual void convert(
+        uint32_t* out, size_t bytes_per_row,
+        size_t min_x, size_t min_y,
+        size_t width, size_t height
+    ) = 0;
+};
+
+
+
+class LazyVideoFrame{
+public:
+    static constexpr size_t TILE_SIZE = 64;
+
+public:
+    LazyVideoFrame(
+        size_t width, size_t height,
+        std::unique_ptr<LazyVideoFrameConverter> converter
+    );
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+    //  Return a reference to the requested box. Only the tiles that overlap
+    //  the box will be converted.
+    ImageViewRGB32 extract_box_reference(const ImagePixelBox& box);
+    ImageViewRGB32 extract_box_reference(const ImageFloatBox& box);
+
+    //  Convert the rest of the frame and return it. This is the same image
+    //  that the boxes above point into.
+    std::shared_ptr<const ImageRGB32> full_frame();
+
+    //  The image that the tiles are converted into. Only the parts that have
+    //  been returned by "extract_box_reference()" are valid.
+    ImageViewRGB32 backing_image() const{ return *m_image; }
+
+    size_t total_tiles() const{ return m_tiles_x * m_tiles_y; }
+    size_t tiles_converted() const{ return m_tiles_converted.load(std::memory_order_relaxed); }
+
+
+private:
+    //  Must be called under "m_lock".
+    void convert_tiles(
+        size_t tile_min_x, size_t tile_min_y,
+        size_t tile_max_x, size_t tile_max_y
+    );
+
+
+private:
+    const size_t m_width;
+    const size_t m_height;
+    const size_t m_tiles_x;
+    const size_t m_tiles_y;
+
+    std::shared_ptr<ImageRGB32> m_image;
+
+    std::mutex m_lock;
+    std::atomic<bool> m_complete;
+    std::atomic<size_t> m_tiles_converted;
+    std::vector<uint8_t> m_tile_ready;
+
+    //  Released once every tile has been converted.
+    std::unique_ptr<LazyVideoFrameConverter> m_converter;
+};
+
+
+
+
+}
+#endif
@@ -0,0 +1,47 @@
+/*  Video Feed Interface
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/ImageTools/ImageStatsCache.h"
+#include "CommonFramework/ImageTools/BinaryMatrixCache.h"
+#include "VideoFeed.h"
+
+namespace PokemonAutomation{
+
+
+void VideoSnapshot::enable_stats_cache(){
+    if (stats_cache){
+        return;
+    }
+    if (lazy){
+        stats_cache = std::make_shared<ImageStatsCache>(lazy);
+    }else if (frame && *frame){
+        stats_cache = std::make_shared<ImageStatsCache>(frame);
+    }
+}
+void VideoSnapshot::enable_binary_cache(const BinaryMatrixCache* previous){
+    if (binary_cache){
+        return;
+    }
+    BinaryMatrixCache::History history;
+    if (previous != nullptr){
+        history = previous->history();
+    }
+    if (lazy){
+        binary_cache = std::make_shared<BinaryMatrixCache>(lazy, std::move(history));
+    }else if (frame && *frame){
+        binary_cache = std::make_shared<BinaryMatrixCache>(frame, std::move(history));
+    }
+}
+
+ImageStats VideoSnapshot::image_stats(const ImageFloatBox& box) const{
+    return stats_cache
+        ? stats_cache->image_stats(box)
+        : PokemonAutomation::image_stats(extract_box_reference(box));
+}
+
+
+
+}
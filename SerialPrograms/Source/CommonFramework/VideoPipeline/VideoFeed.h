@@ -10,14 +10,33 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageStats.h"
+#include "LazyVideoFrame.h"
 
 namespace PokemonAutomation{
 
+class ImageStatsCache;
+class BinaryMatrixCache;
+
 
 struct VideoSnapshot{
     //  The frame itself. Null means no snapshot was available.
+    //  For lazy snapshots, this stays null. Use "full_frame()" or the
+    //  conversion operators below if the snapshot may be lazy.
     std::shared_ptr<const ImageRGB32> frame;
 
+    //  Set if the frame is converted on demand. See LazyVideoFrame.h.
+    std::shared_ptr<LazyVideoFrame> lazy;
+
+    //  Optional cache of box stats. Shared by all copies of this snapshot.
+    //  See "enable_stats_cache()".
+    std::shared_ptr<ImageStatsCache> stats_cache;
+
+    //  Optional cache of binarized boxes. Shared by all copies of this
+    //  snapshot. See "enable_binary_cache()".
+    std::shared_ptr<BinaryMatrixCache> binary_cache;
+
     //  The timestamp of when the frame was taken.
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
@@ -30,17 +49,69 @@ struct VideoSnapshot{
          : frame(std::make_shared<const ImageRGB32>(std::move(p_frame)))
          , timestamp(p_timestamp)
     {}
+    VideoSnapshot(std::shared_ptr<const ImageRGB32> p_frame, WallClock p_timestamp)
+         : frame(std::move(p_frame))
+         , timestamp(p_timestamp)
+    {}
+    VideoSnapshot(std::shared_ptr<LazyVideoFrame> p_lazy, WallClock p_timestamp)
+         : lazy(std::move(p_lazy))
+         , timestamp(p_timestamp)
+    {}
 
     //  Returns true if the snapshot is valid.
-    explicit operator bool() const{ return frame && *frame; }
+    explicit operator bool() const{ return (frame && *frame) || lazy; }
+
+    //  Return the entire frame. For lazy snapshots, this will convert
+    //  whatever hasn't been converted yet.
+    std::shared_ptr<const ImageRGB32> full_frame() const{
+        return lazy ? lazy->full_frame() : frame;
+    }
 
-    const ImageRGB32* operator->() const{ return frame.get(); }
+    //  Return a reference to the requested box. For lazy snapshots, this only
+    //  converts the part of the frame that overlaps the box.
+    ImageViewRGB32 extract_box_reference(const ImageFloatBox& box) const{
+        return lazy
+            ? lazy->extract_box_reference(box)
+            : PokemonAutomation::extract_box_reference((const ImageViewRGB32&)*frame, box);
+    }
+
+    //  Create the stats cache for this frame. Do this before handing out
+    //  copies of the snapshot so that they all share it.
+    void enable_stats_cache();
+
+    //  Create the binarization cache for this frame. "previous" is the cache
+    //  of the previous frame. (if any)
+    void enable_binary_cache(const BinaryMatrixCache* previous = nullptr);
+
+    //  Stats of the requested box. These use the stats cache if it's enabled.
+    ImageStats image_stats(const ImageFloatBox& box) const;
+    FloatPixel image_average(const ImageFloatBox& box) const{
+        return image_stats(box).average;
+    }
+    FloatPixel image_stddev(const ImageFloatBox& box) const{
+        return image_stats(box).stddev;
+    }
+
+    //  Return a copy that owns its pixels and has no caches. A lazy snapshot
+    //  holds onto the native frame and starves the capture backend if kept.
+    //  Call this before keeping a snapshot beyond the current callback.
+    VideoSnapshot detach() const{
+        if (!*this){
+            return VideoSnapshot();
+        }
+        return VideoSnapshot(full_frame(), timestamp);
+    }
 
-    operator std::shared_ptr<const ImageRGB32>() const{ return frame; }
-    operator ImageViewRGB32() const{ return *frame; }
+    const ImageRGB32* operator->() const{ return full_frame().get(); }
+
+    operator std::shared_ptr<const ImageRGB32>() const{ return full_frame(); }
+    operator ImageViewRGB32() const{ return *full_frame(); }
 
     void clear(){
         frame.reset();
+        lazy.reset();
+        stats_cache.reset();
+        binary_cache.reset();
         timestamp = WallClock::min();
     }
 };
@@ -58,6 +129,11 @@ public:
     //  Do not call this on the main thread or it may deadlock.
     virtual VideoSnapshot snapshot() = 0;
 
+    //  Same as "snapshot()", but the returned frame may be converted on demand
+    //  as regions of it are accessed. Backends that cannot do this will return
+    //  a regular snapshot.
+    virtual VideoSnapshot snapshot_lazy(){ return snapshot(); }
+
     //  Returns the currently measured frames/second for the video source + display.
     //  Use this for diagnostic purposes.
     virtual double fps_source() = 0;
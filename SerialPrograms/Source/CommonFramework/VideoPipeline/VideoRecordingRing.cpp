@@ -0,0 +1,221 @@
+/*  Video Recording Ring
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Concurrency/FireForgetDispatcher.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "VideoFeed.h"
+#include "VideoRecordingRing.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+//  All the live rings. Used by "export_console()".
+struct VideoRecordingRegistry{
+    std::mutex lock;
+    std::set<const VideoRecordingRing*> rings;
+
+    static VideoRecordingRegistry& instance(){
+        static VideoRecordingRegistry registry;
+        return registry;
+    }
+};
+
+
+
+VideoRecordingRing::VideoRecordingRing(Logger& logger, VideoFeed& feed, std::string name, Settings settings)
+    : m_logger(logger)
+    , m_feed(feed)
+    , m_name(std::move(name))
+    , m_settings(settings)
+    , m_bytes(0)
+    , m_last_timestamp(WallClock::min())
+    , m_stopping(false)
+{
+    m_logger.log(
+        "Recording the last " + std::to_string(m_settings.duration.count()) +
+        " seconds of video at " + std::to_string(m_settings.frames_per_second) + " fps."
+    );
+    m_thread = std::thread(run_with_catch, "VideoRecordingRing::thread_loop()", [this]{ thread_loop(); });
+
+    VideoRecordingRegistry& registry = VideoRecordingRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    registry.rings.insert(this);
+}
+VideoRecordingRing::~VideoRecordingRing(){
+    {
+        VideoRecordingRegistry& registry = VideoRecordingRegistry::instance();
+        std::lock_guard<std::mutex> lg(registry.lock);
+        registry.rings.erase(this);
+    }
+    {
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+size_t VideoRecordingRing::frames() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_frames.size();
+}
+size_t VideoRecordingRing::bytes() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_bytes;
+}
+
+
+void VideoRecordingRing::sample_frame(){
+    VideoSnapshot snapshot = m_feed.snapshot();
+    if (!snapshot || snapshot.timestamp == m_last_timestamp){
+        return;
+    }
+    m_last_timestamp = snapshot.timestamp;
+
+    std::shared_ptr<const ImageRGB32> frame = snapshot.full_frame();
+    size_t width = frame->width();
+    size_t height = frame->height();
+    QImage image;
+    if (width > m_settings.max_width){
+        height = height * m_settings.max_width / width;
+        width = m_settings.max_width;
+        image = frame->scaled_to_QImage(width, height);
+    }else{
+        image = frame->to_QImage_ref();
+    }
+
+    QByteArray jpeg;
+    QBuffer buffer(&jpeg);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "JPG", m_settings.jpeg_quality)){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_bytes += jpeg.size();
+    m_frames.emplace_back(Frame{snapshot.timestamp, std::move(jpeg)});
+
+    //  Drop frames that are too old or over the memory budget.
+    WallClock oldest = snapshot.timestamp - m_settings.duration;
+    while (!m_frames.empty()){
+        const Frame& front = m_frames.front();
+        if (front.timestamp >= oldest && m_bytes <= m_settings.max_bytes){
+            break;
+        }
+        m_bytes -= front.jpeg.size();
+        m_frames.pop_front();
+    }
+}
+void VideoRecordingRing::thread_loop(){
+    const std::chrono::microseconds period(1000000 / std::max<size_t>(m_settings.frames_per_second, 1));
+    WallClock next = current_time();
+    while (true){
+        {
+            std::unique_lock<std::mutex> lg(m_sleep_lock);
+            if (m_stopping){
+                return;
+            }
+            m_cv.wait_until(lg, next, [this]{ return m_stopping; });
+            if (m_stopping){
+                return;
+            }
+        }
+
+        sample_frame();
+
+        //  If we fell behind, don't try to catch up.
+        WallClock now = current_time();
+        next += period;
+        if (next < now){
+            next = now;
+        }
+    }
+}
+
+
+bool VideoRecordingRing::export_clip(
+    const std::string& path, VideoClipFormat format,
+    std::chrono::seconds duration
+) const{
+    std::vector<Frame> frames;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_frames.empty()){
+            return false;
+        }
+        WallClock oldest = duration == std::chrono::seconds::max()
+            ? WallClock::min()
+            : m_frames.back().timestamp - duration;
+        for (const Frame& frame : m_frames){
+            if (frame.timestamp >= oldest){
+                frames.emplace_back(frame);
+            }
+        }
+    }
+
+    m_logger.log("Saving last " + std::to_string(frames.size()) + " video frames to: " + path, COLOR_RED);
+
+    //  The logger may not outlive the ring. Log from the worker with the
+    //  global one.
+    global_dispatcher.dispatch([path, format, frames = std::move(frames)]{
+        bool ok = true;
+        switch (format){
+        case VideoClipFormat::IMAGE_SEQUENCE:{
+            QDir().mkpath(QString::fromStdString(path));
+            for (size_t c = 0; c < frames.size() && ok; c++){
+                std::string index = std::to_string(c);
+                index.insert(0, index.size() < 5 ? 5 - index.size() : 0, '0');
+                QFile file(QString::fromStdString(path + "/frame-" + index + ".jpg"));
+                ok = file.open(QIODevice::WriteOnly) && file.write(frames[c].jpeg) == frames[c].jpeg.size();
+            }
+            break;
+        }
+        case VideoClipFormat::MJPEG:{
+            QFile file(QString::fromStdString(path));
+            ok = file.open(QIODevice::WriteOnly);
+            for (size_t c = 0; c < frames.size() && ok; c++){
+                ok = file.write(frames[c].jpeg) == frames[c].jpeg.size();
+            }
+            break;
+        }
+        }
+        if (!ok){
+            global_logger_tagged().log("Unable to save video clip: " + path, COLOR_RED);
+        }
+    });
+    return true;
+}
+
+std::string VideoRecordingRing::export_console(const Logger& console_logger, const std::string& path_prefix){
+    VideoRecordingRegistry& registry = VideoRecordingRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    for (const VideoRecordingRing* ring : registry.rings){
+        if (&ring->m_logger != &console_logger){
+            continue;
+        }
+        std::string path = path_prefix + "-" + ring->name() + ".mjpeg";
+        return ring->export_clip(path, VideoClipFormat::MJPEG) ? path : "";
+    }
+    return "";
+}
+
+
+
+
+}
@@ -0,0 +1,111 @@
+/*  Video Recording Ring
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Keep the last few seconds of a video feed in memory so that there is
+ *  some context when something rare happens. (an error, a shiny, etc...)
+ *
+ *  A background thread samples the feed at a low frame rate, downscales each
+ *  frame and compresses it to JPEG. Only the compressed frames are kept. Old
+ *  frames are dropped once they fall out of the time window or the ring goes
+ *  over its memory budget.
+ *
+ *  Exporting never blocks the caller. The frames are copied out (cheap, the
+ *  JPEG buffers are shared) and written to disk on the global dispatcher.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoRecordingRing_H
+#define PokemonAutomation_VideoPipeline_VideoRecordingRing_H
+
+#include <stddef.h>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <QByteArray>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class VideoFeed;
+
+
+enum class VideoClipFormat{
+    //  A folder of numbered .jpg files.
+    IMAGE_SEQUENCE,
+    //  All the JPEGs back-to-back in one .mjpeg file. VLC and ffmpeg can play
+    //  these directly.
+    MJPEG,
+};
+
+
+class VideoRecordingRing{
+public:
+    struct Settings{
+        std::chrono::seconds duration = std::chrono::seconds(30);
+        size_t frames_per_second = 5;
+        //  Frames wider than this are downscaled.
+        size_t max_width = 640;
+        int jpeg_quality = 70;
+        size_t max_bytes = 64 * 1024 * 1024;
+    };
+
+public:
+    //  "logger" is the console's logger. It also identifies the console for
+    //  "export_console()". "name" identifies the feed in exported filenames.
+    VideoRecordingRing(Logger& logger, VideoFeed& feed, std::string name, Settings settings);
+    ~VideoRecordingRing();
+
+    const std::string& name() const{ return m_name; }
+
+    size_t frames() const;
+    size_t bytes() const;
+
+    //  Write the frames from the last "duration" to "path" in the background.
+    //  For IMAGE_SEQUENCE, "path" is the folder. Returns false if there is
+    //  nothing to export.
+    bool export_clip(
+        const std::string& path, VideoClipFormat format,
+        std::chrono::seconds duration = std::chrono::seconds::max()
+    ) const;
+
+    //  Export the ring of the console that logs to "console_logger" to
+    //  "<path_prefix>-<name>.mjpeg". Returns the path of the clip. Returns an
+    //  empty string if that console has no ring or it has nothing to export.
+    static std::string export_console(const Logger& console_logger, const std::string& path_prefix);
+
+
+private:
+    struct Frame{
+        WallClock timestamp;
+        QByteArray jpeg;
+    };
+
+    void sample_frame();
+    void thread_loop();
+
+
+private:
+    Logger& m_logger;
+    VideoFeed& m_feed;
+    const std::string m_name;
+    const Settings m_settings;
+
+    mutable std::mutex m_lock;
+    std::deque<Frame> m_frames;
+    size_t m_bytes;
+    WallClock m_last_timestamp;
+
+    std::mutex m_sleep_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
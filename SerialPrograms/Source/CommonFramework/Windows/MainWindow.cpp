@@ -12,6 +12,9 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QMessageBox>
+#include <QDir>
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Metrics/TraceRecorder.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Logging/FileWindowLogger.h"
@@ -161,6 +164,27 @@ MainWindow::MainWindow(QWidget* parent)
         }
     );
 
+    if (PreloadSettings::instance().DEVELOPER_MODE){
+        QPushButton* trace = new QPushButton("Save Pipeline Trace", support_box);
+        buttons->addWidget(trace);
+        connect(
+            trace, &QPushButton::clicked,
+            this, [](bool){
+                if (!TraceRecorder::instance().enabled()){
+                    global_logger_tagged().log("Pipeline trace is off. Turn on \"Record Pipeline Trace\" in the settings first.", COLOR_RED);
+                    return;
+                }
+                QDir().mkdir("ErrorDumps");
+                std::string path = "ErrorDumps/" + now_to_filestring() + "-trace.json";
+                if (TraceRecorder::instance().dump(path)){
+                    global_logger_tagged().log("Saved pipeline trace to: " + path);
+                }else{
+                    global_logger_tagged().log("Unable to save pipeline trace to: " + path, COLOR_RED);
+                }
+            }
+        );
+    }
+
     QPushButton* settings = new QPushButton("Settings", support_box);
     m_settings = settings;
     buttons->addWidget(settings);
@@ -13,31 +13,55 @@ namespace AudioStreamConversion{
 
 
 
-void convert_audio_uint8_to_float_Default(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_uint8_to_float_Default(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_uint8_Default(uint8_t* i, const float* f, size_t length);
-void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_sint16_Default(int16_t* i, const float* f, size_t length);
-void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t length);
+void convert_audio_float_to_float_Default(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs);
 
-void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_uint8_x86_SSE41(uint8_t* i, const float* f, size_t length);
-void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_sint16_x86_SSE41(int16_t* i, const float* f, size_t length);
-void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t length);
+void convert_audio_float_to_float_x86_SSE2(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs);
 
+void convert_audio_uint8_to_float_x86_AVX2(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs);
+void convert_audio_sint16_to_float_x86_AVX2(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs);
+void convert_audio_sint32_to_float_x86_AVX2(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs);
+void convert_audio_float_to_float_x86_AVX2(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs);
 
+void convert_audio_uint8_to_float_x86_AVX512(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs);
+void convert_audio_sint16_to_float_x86_AVX512(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs);
+void convert_audio_sint32_to_float_x86_AVX512(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs);
+void convert_audio_float_to_float_x86_AVX512(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs);
 
 
-void convert_audio_uint8_to_float(float* f, const uint8_t* i, size_t length, float output_multiplier){
+
+
+void convert_audio_uint8_to_float(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_audio_uint8_to_float_x86_AVX512(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_uint8_to_float_x86_AVX2(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
-        convert_audio_uint8_to_float_x86_SSE41(f, i, length, output_multiplier);
+        convert_audio_uint8_to_float_x86_SSE41(f, i, length, output_multiplier, swap_pairs);
         return;
     }
 #endif
-    convert_audio_uint8_to_float_Default(f, i, length, output_multiplier);
+    convert_audio_uint8_to_float_Default(f, i, length, output_multiplier, swap_pairs);
 }
 void convert_audio_float_to_uint8(uint8_t* i, const float* f, size_t length){
 #ifdef PA_AutoDispatch_x64_08_Nehalem
@@ -48,14 +72,26 @@ void convert_audio_float_to_uint8(uint8_t* i, const float* f, size_t length){
 #endif
     convert_audio_float_to_uint8_Default(i, f, length);
 }
-void convert_audio_sint16_to_float(float* f, const int16_t* i, size_t length, float output_multiplier){
+void convert_audio_sint16_to_float(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_audio_sint16_to_float_x86_AVX512(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_sint16_to_float_x86_AVX2(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
-        convert_audio_sint16_to_float_x86_SSE41(f, i, length, output_multiplier);
+        convert_audio_sint16_to_float_x86_SSE41(f, i, length, output_multiplier, swap_pairs);
         return;
     }
 #endif
-    convert_audio_sint16_to_float_Default(f, i, length, output_multiplier);
+    convert_audio_sint16_to_float_Default(f, i, length, output_multiplier, swap_pairs);
 }
 void convert_audio_float_to_sint16(int16_t* i, const float* f, size_t length){
 #ifdef PA_AutoDispatch_x64_08_Nehalem
@@ -66,14 +102,26 @@ void convert_audio_float_to_sint16(int16_t* i, const float* f, size_t length){
 #endif
     convert_audio_float_to_sint16_Default(i, f, length);
 }
-void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier){
+void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_audio_sint32_to_float_x86_AVX512(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_sint32_to_float_x86_AVX2(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
-        convert_audio_sint32_to_float_x86_SSE2(f, i, length, output_multiplier);
+        convert_audio_sint32_to_float_x86_SSE2(f, i, length, output_multiplier, swap_pairs);
         return;
     }
 #endif
-    convert_audio_sint32_to_float_Default(f, i, length, output_multiplier);
+    convert_audio_sint32_to_float_Default(f, i, length, output_multiplier, swap_pairs);
 }
 void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length){
 #ifdef PA_AutoDispatch_x64_08_Nehalem
@@ -84,6 +132,27 @@ void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length){
 #endif
     convert_audio_float_to_sint32_Default(i, f, length);
 }
+void convert_audio_float_to_float(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_audio_float_to_float_x86_AVX512(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_audio_float_to_float_x86_AVX2(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_audio_float_to_float_x86_SSE2(f, i, length, output_multiplier, swap_pairs);
+        return;
+    }
+#endif
+    convert_audio_float_to_float_Default(f, i, length, output_multiplier, swap_pairs);
+}
 
 
 
@@ -15,15 +15,23 @@ namespace Kernels{
 namespace AudioStreamConversion{
 
 
-void convert_audio_uint8_to_float(float* f, const uint8_t* i, size_t length, float output_multiplier);
+//  The "*_to_float" functions multiply every sample by "output_multiplier".
+//  The integer ones also clamp the result to [-1, 1].
+//  If "swap_pairs" is true, each pair of samples is swapped in the same pass.
+//  (i.e. the channels of an interleaved stereo stream are reversed) "length"
+//  must then be even.
+
+void convert_audio_uint8_to_float(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_uint8(uint8_t* i, const float* f, size_t length);
 
-void convert_audio_sint16_to_float(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_sint16_to_float(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_sint16(int16_t* i, const float* f, size_t length);
 
-void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier);
+void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs);
 void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length);
 
+void convert_audio_float_to_float(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs);
+
 
 
 
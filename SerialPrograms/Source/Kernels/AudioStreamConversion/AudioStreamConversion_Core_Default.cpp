@@ -13,13 +13,14 @@ namespace AudioStreamConversion{
 
 
 
-void convert_audio_uint8_to_float_Default(float* f, const uint8_t* i, size_t length, float output_multiplier){
+void convert_audio_uint8_to_float_Default(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs){
     const float SCALE = output_multiplier / 127.f;
+    const size_t swap = swap_pairs ? 1 : 0;
     for (size_t c = 0; c < length; c++){
         float x = (float)i[c] * SCALE - output_multiplier;
         x = std::max(x, -1.0f);
         x = std::min(x, 1.0f);
-        f[c] = x;
+        f[c ^ swap] = x;
     }
 }
 void convert_audio_float_to_uint8_Default(uint8_t* i, const float* f, size_t length){
@@ -32,13 +33,14 @@ void convert_audio_float_to_uint8_Default(uint8_t* i, const float* f, size_t len
     }
 }
 
-void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t length, float output_multiplier){
+void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs){
     const float SCALE = output_multiplier / 32767.f;
+    const size_t swap = swap_pairs ? 1 : 0;
     for (size_t c = 0; c < length; c++){
         float x = (float)i[c] * SCALE;
         x = std::max(x, -1.0f);
         x = std::min(x, 1.0f);
-        f[c] = x;
+        f[c ^ swap] = x;
     }
 }
 void convert_audio_float_to_sint16_Default(int16_t* i, const float* f, size_t length){
@@ -51,13 +53,14 @@ void convert_audio_float_to_sint16_Default(int16_t* i, const float* f, size_t le
     }
 }
 
-void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier){
+void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs){
     const float SCALE = output_multiplier / 2147483647.f;
+    const size_t swap = swap_pairs ? 1 : 0;
     for (size_t c = 0; c < length; c++){
         float x = (float)i[c] * SCALE;
         x = std::max(x, -1.0f);
         x = std::min(x, 1.0f);
-        f[c] = x;
+        f[c ^ swap] = x;
     }
 }
 void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t length){
@@ -70,6 +73,13 @@ void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t le
     }
 }
 
+void convert_audio_float_to_float_Default(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs){
+    const size_t swap = swap_pairs ? 1 : 0;
+    for (size_t c = 0; c < length; c++){
+        f[c ^ swap] = i[c] * output_multiplier;
+    }
+}
+
 
 
 
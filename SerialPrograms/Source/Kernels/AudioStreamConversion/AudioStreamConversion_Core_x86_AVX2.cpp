@@ -0,0 +1,138 @@
+/*  Audio Stream Conversion (x86 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "AudioStreamConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AudioStreamConversion{
+
+
+
+struct AudioSource_uint8_x86_AVX2{
+    using Type = uint8_t;
+    static PA_FORCE_INLINE __m256 load(const uint8_t* i){
+        return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)i)));
+    }
+    static PA_FORCE_INLINE __m128 load_ss(const uint8_t* i){
+        return _mm_cvtsi32_ss(_mm_setzero_ps(), i[0]);
+    }
+};
+struct AudioSource_sint16_x86_AVX2{
+    using Type = int16_t;
+    static PA_FORCE_INLINE __m256 load(const int16_t* i){
+        return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)i)));
+    }
+    static PA_FORCE_INLINE __m128 load_ss(const int16_t* i){
+        return _mm_cvtsi32_ss(_mm_setzero_ps(), i[0]);
+    }
+};
+struct AudioSource_sint32_x86_AVX2{
+    using Type = int32_t;
+    static PA_FORCE_INLINE __m256 load(const int32_t* i){
+        return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)i));
+    }
+    static PA_FORCE_INLINE __m128 load_ss(const int32_t* i){
+        return _mm_cvtsi32_ss(_mm_setzero_ps(), i[0]);
+    }
+};
+struct AudioSource_float_x86_AVX2{
+    using Type = float;
+    static PA_FORCE_INLINE __m256 load(const float* i){
+        return _mm256_loadu_ps(i);
+    }
+    static PA_FORCE_INLINE __m128 load_ss(const float* i){
+        return _mm_load_ss(i);
+    }
+};
+
+
+
+//  out = clamp(in * scale - offset, -1, 1)
+//  The clamp is skipped for float input.
+template <typename Source, bool clamp, bool swap_pairs>
+PA_FORCE_INLINE void convert_audio_to_float_x86_AVX2(
+    float* f, const typename Source::Type* i, size_t length,
+    float scale, float offset
+){
+    const __m256 SCALE = _mm256_set1_ps(scale);
+    const __m256 OFFSET = _mm256_set1_ps(offset);
+    size_t lc = length / 8;
+    while (lc--){
+        __m256 f0 = Source::load(i);
+        f0 = _mm256_mul_ps(f0, SCALE);
+        f0 = _mm256_sub_ps(f0, OFFSET);
+        if (clamp){
+            f0 = _mm256_max_ps(f0, _mm256_set1_ps(-1.0f));
+            f0 = _mm256_min_ps(f0, _mm256_set1_ps(1.0f));
+        }
+        if (swap_pairs){
+            f0 = _mm256_permute_ps(f0, 0xb1);
+        }
+        _mm256_storeu_ps(f, f0);
+        f += 8;
+        i += 8;
+    }
+
+    length %= 8;
+    for (size_t c = 0; c < length; c++){
+        __m128 f0 = Source::load_ss(i + c);
+        f0 = _mm_mul_ss(f0, _mm256_castps256_ps128(SCALE));
+        f0 = _mm_sub_ss(f0, _mm256_castps256_ps128(OFFSET));
+        if (clamp){
+            f0 = _mm_max_ss(f0, _mm_set1_ps(-1.0f));
+            f0 = _mm_min_ss(f0, _mm_set1_ps(1.0f));
+        }
+        _mm_store_ss(f + (swap_pairs ? c ^ 1 : c), f0);
+    }
+}
+template <typename Source, bool clamp>
+PA_FORCE_INLINE void convert_audio_to_float_x86_AVX2(
+    float* f, const typename Source::Type* i, size_t length,
+    float scale, float offset, bool swap_pairs
+){
+    if (swap_pairs){
+        convert_audio_to_float_x86_AVX2<Source, clamp, true>(f, i, length, scale, offset);
+    }else{
+        convert_audio_to_float_x86_AVX2<Source, clamp, false>(f, i, length, scale, offset);
+    }
+}
+
+
+
+void convert_audio_uint8_to_float_x86_AVX2(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX2<AudioSource_uint8_x86_AVX2, true>(
+        f, i, length, output_multiplier / 127.f, output_multiplier, swap_pairs
+    );
+}
+void convert_audio_sint16_to_float_x86_AVX2(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX2<AudioSource_sint16_x86_AVX2, true>(
+        f, i, length, output_multiplier / 32767.f, 0, swap_pairs
+    );
+}
+void convert_audio_sint32_to_float_x86_AVX2(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX2<AudioSource_sint32_x86_AVX2, true>(
+        f, i, length, output_multiplier / 2147483647.f, 0, swap_pairs
+    );
+}
+void convert_audio_float_to_float_x86_AVX2(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX2<AudioSource_float_x86_AVX2, false>(
+        f, i, length, output_multiplier, 0, swap_pairs
+    );
+}
+
+
+
+
+}
+}
+}
+#endif
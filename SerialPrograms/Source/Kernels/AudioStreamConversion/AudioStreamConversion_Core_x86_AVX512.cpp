@@ -0,0 +1,141 @@
+/*  Audio Stream Conversion (x86 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "AudioStreamConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AudioStreamConversion{
+
+
+
+struct AudioSource_uint8_x86_AVX512{
+    using Type = uint8_t;
+    static PA_FORCE_INLINE __m512 load(const uint8_t* i){
+        return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)i)));
+    }
+    static PA_FORCE_INLINE __m512 load(const uint8_t* i, __mmask16 mask){
+        return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(mask, i)));
+    }
+};
+struct AudioSource_sint16_x86_AVX512{
+    using Type = int16_t;
+    static PA_FORCE_INLINE __m512 load(const int16_t* i){
+        return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)i)));
+    }
+    static PA_FORCE_INLINE __m512 load(const int16_t* i, __mmask16 mask){
+        return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_maskz_loadu_epi16(mask, i)));
+    }
+};
+struct AudioSource_sint32_x86_AVX512{
+    using Type = int32_t;
+    static PA_FORCE_INLINE __m512 load(const int32_t* i){
+        return _mm512_cvtepi32_ps(_mm512_loadu_si512(i));
+    }
+    static PA_FORCE_INLINE __m512 load(const int32_t* i, __mmask16 mask){
+        return _mm512_cvtepi32_ps(_mm512_maskz_loadu_epi32(mask, i));
+    }
+};
+struct AudioSource_float_x86_AVX512{
+    using Type = float;
+    static PA_FORCE_INLINE __m512 load(const float* i){
+        return _mm512_loadu_ps(i);
+    }
+    static PA_FORCE_INLINE __m512 load(const float* i, __mmask16 mask){
+        return _mm512_maskz_loadu_ps(mask, i);
+    }
+};
+
+
+
+//  out = clamp(in * scale - offset, -1, 1)
+//  The clamp is skipped for float input.
+template <bool clamp, bool swap_pairs>
+PA_FORCE_INLINE __m512 convert_audio_to_float_x86_AVX512(__m512 f0, __m512 scale, __m512 offset){
+    f0 = _mm512_mul_ps(f0, scale);
+    f0 = _mm512_sub_ps(f0, offset);
+    if (clamp){
+        f0 = _mm512_max_ps(f0, _mm512_set1_ps(-1.0f));
+        f0 = _mm512_min_ps(f0, _mm512_set1_ps(1.0f));
+    }
+    if (swap_pairs){
+        f0 = _mm512_permute_ps(f0, 0xb1);
+    }
+    return f0;
+}
+template <typename Source, bool clamp, bool swap_pairs>
+PA_FORCE_INLINE void convert_audio_to_float_x86_AVX512(
+    float* f, const typename Source::Type* i, size_t length,
+    float scale, float offset
+){
+    const __m512 SCALE = _mm512_set1_ps(scale);
+    const __m512 OFFSET = _mm512_set1_ps(offset);
+    size_t lc = length / 16;
+    while (lc--){
+        __m512 f0 = Source::load(i);
+        f0 = convert_audio_to_float_x86_AVX512<clamp, swap_pairs>(f0, SCALE, OFFSET);
+        _mm512_storeu_ps(f, f0);
+        f += 16;
+        i += 16;
+    }
+
+    length %= 16;
+    if (length){
+        //  Swapping stays within each pair. Since "length" is even when
+        //  swapping, the swapped lanes are inside the mask.
+        __mmask16 mask = ((uint32_t)1 << length) - 1;
+        __m512 f0 = Source::load(i, mask);
+        f0 = convert_audio_to_float_x86_AVX512<clamp, swap_pairs>(f0, SCALE, OFFSET);
+        _mm512_mask_storeu_ps(f, mask, f0);
+    }
+}
+template <typename Source, bool clamp>
+PA_FORCE_INLINE void convert_audio_to_float_x86_AVX512(
+    float* f, const typename Source::Type* i, size_t length,
+    float scale, float offset, bool swap_pairs
+){
+    if (swap_pairs){
+        convert_audio_to_float_x86_AVX512<Source, clamp, true>(f, i, length, scale, offset);
+    }else{
+        convert_audio_to_float_x86_AVX512<Source, clamp, false>(f, i, length, scale, offset);
+    }
+}
+
+
+
+void convert_audio_uint8_to_float_x86_AVX512(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX512<AudioSource_uint8_x86_AVX512, true>(
+        f, i, length, output_multiplier / 127.f, output_multiplier, swap_pairs
+    );
+}
+void convert_audio_sint16_to_float_x86_AVX512(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX512<AudioSource_sint16_x86_AVX512, true>(
+        f, i, length, output_multiplier / 32767.f, 0, swap_pairs
+    );
+}
+void convert_audio_sint32_to_float_x86_AVX512(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX512<AudioSource_sint32_x86_AVX512, true>(
+        f, i, length, output_multiplier / 2147483647.f, 0, swap_pairs
+    );
+}
+void convert_audio_float_to_float_x86_AVX512(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs){
+    convert_audio_to_float_x86_AVX512<AudioSource_float_x86_AVX512, false>(
+        f, i, length, output_multiplier, 0, swap_pairs
+    );
+}
+
+
+
+
+}
+}
+}
+#endif
@@ -8,6 +8,7 @@
 
 #include <immintrin.h>
 #include <smmintrin.h>
+#include "Common/Compiler.h"
 #include "AudioStreamConversion.h"
 
 namespace PokemonAutomation{
@@ -16,7 +17,8 @@ namespace AudioStreamConversion{
 
 
 
-void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier){
+template <bool swap_pairs>
+PA_FORCE_INLINE void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier){
     const __m128 SCALE = _mm_set1_ps(output_multiplier / 127.f);
     const __m128 SUB = _mm_set1_ps(output_multiplier);
     size_t lc = length / 4;
@@ -31,21 +33,29 @@ void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t l
         f0 = _mm_sub_ps(f0, SUB);
         f0 = _mm_max_ps(f0, _mm_set1_ps(-1.0f));
         f0 = _mm_min_ps(f0, _mm_set1_ps(1.0f));
+        if (swap_pairs){
+            f0 = _mm_shuffle_ps(f0, f0, 0xb1);
+        }
         _mm_storeu_ps(f, f0);
         f += 4;
         i += 4;
     }
 
     length %= 4;
-    while (length--){
-        __m128 f0 = _mm_cvtsi32_ss(_mm_setzero_ps(), i[0]);
+    for (size_t c = 0; c < length; c++){
+        __m128 f0 = _mm_cvtsi32_ss(_mm_setzero_ps(), i[c]);
         f0 = _mm_mul_ss(f0, SCALE);
         f0 = _mm_sub_ss(f0, SUB);
         f0 = _mm_max_ss(f0, _mm_set1_ps(-1.0f));
         f0 = _mm_min_ss(f0, _mm_set1_ps(1.0f));
-        _mm_store_ss(f, f0);
-        f += 1;
-        i += 1;
+        _mm_store_ss(f + (swap_pairs ? c ^ 1 : c), f0);
+    }
+}
+void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    if (swap_pairs){
+        convert_audio_uint8_to_float_x86_SSE41<true>(f, i, length, output_multiplier);
+    }else{
+        convert_audio_uint8_to_float_x86_SSE41<false>(f, i, length, output_multiplier);
     }
 }
 void convert_audio_float_to_uint8_x86_SSE41(uint8_t* i, const float* f, size_t length){
@@ -80,7 +90,8 @@ void convert_audio_float_to_uint8_x86_SSE41(uint8_t* i, const float* f, size_t l
     }
 }
 
-void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t length, float output_multiplier){
+template <bool swap_pairs>
+PA_FORCE_INLINE void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t length, float output_multiplier){
     const __m128 SCALE = _mm_set1_ps(output_multiplier / 32767.f);
     size_t lc = length / 4;
     while (lc--){
@@ -89,20 +100,28 @@ void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t
         f0 = _mm_mul_ps(f0, SCALE);
         f0 = _mm_max_ps(f0, _mm_set1_ps(-1.0f));
         f0 = _mm_min_ps(f0, _mm_set1_ps(1.0f));
+        if (swap_pairs){
+            f0 = _mm_shuffle_ps(f0, f0, 0xb1);
+        }
         _mm_storeu_ps(f, f0);
         f += 4;
         i += 4;
     }
 
     length %= 4;
-    while (length--){
-        __m128 f0 = _mm_cvtsi32_ss(_mm_setzero_ps(), i[0]);
+    for (size_t c = 0; c < length; c++){
+        __m128 f0 = _mm_cvtsi32_ss(_mm_setzero_ps(), i[c]);
         f0 = _mm_mul_ss(f0, SCALE);
         f0 = _mm_max_ss(f0, _mm_set1_ps(-1.0f));
         f0 = _mm_min_ss(f0, _mm_set1_ps(1.0f));
-        _mm_store_ss(f, f0);
-        f += 1;
-        i += 1;
+        _mm_store_ss(f + (swap_pairs ? c ^ 1 : c), f0);
+    }
+}
+void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    if (swap_pairs){
+        convert_audio_sint16_to_float_x86_SSE41<true>(f, i, length, output_multiplier);
+    }else{
+        convert_audio_sint16_to_float_x86_SSE41<false>(f, i, length, output_multiplier);
     }
 }
 void convert_audio_float_to_sint16_x86_SSE41(int16_t* i, const float* f, size_t length){
@@ -131,7 +150,8 @@ void convert_audio_float_to_sint16_x86_SSE41(int16_t* i, const float* f, size_t
     }
 }
 
-void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier){
+template <bool swap_pairs>
+PA_FORCE_INLINE void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier){
     const __m128 SCALE = _mm_set1_ps(output_multiplier / 2147483647.f);
     size_t lc = length / 4;
     while (lc--){
@@ -140,20 +160,28 @@ void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t l
         f0 = _mm_mul_ps(f0, SCALE);
         f0 = _mm_max_ps(f0, _mm_set1_ps(-1.0f));
         f0 = _mm_min_ps(f0, _mm_set1_ps(1.0f));
+        if (swap_pairs){
+            f0 = _mm_shuffle_ps(f0, f0, 0xb1);
+        }
         _mm_storeu_ps(f, f0);
         f += 4;
         i += 4;
     }
 
     length %= 4;
-    while (length--){
-        __m128 f0 = _mm_cvtsi32_ss(_mm_setzero_ps(), i[0]);
+    for (size_t c = 0; c < length; c++){
+        __m128 f0 = _mm_cvtsi32_ss(_mm_setzero_ps(), i[c]);
         f0 = _mm_mul_ss(f0, SCALE);
-        f0 = _mm_min_ss(f0, _mm_set1_ps(32767.f));
-        f0 = _mm_max_ss(f0, _mm_set1_ps(-32768.f));
-        _mm_store_ss(f, f0);
-        f += 1;
-        i += 1;
+        f0 = _mm_max_ss(f0, _mm_set1_ps(-1.0f));
+        f0 = _mm_min_ss(f0, _mm_set1_ps(1.0f));
+        _mm_store_ss(f + (swap_pairs ? c ^ 1 : c), f0);
+    }
+}
+void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier, bool swap_pairs){
+    if (swap_pairs){
+        convert_audio_sint32_to_float_x86_SSE2<true>(f, i, length, output_multiplier);
+    }else{
+        convert_audio_sint32_to_float_x86_SSE2<false>(f, i, length, output_multiplier);
     }
 }
 void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t length){
@@ -181,6 +209,36 @@ void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t l
     }
 }
 
+template <bool swap_pairs>
+PA_FORCE_INLINE void convert_audio_float_to_float_x86_SSE2(float* f, const float* i, size_t length, float output_multiplier){
+    const __m128 SCALE = _mm_set1_ps(output_multiplier);
+    size_t lc = length / 4;
+    while (lc--){
+        __m128 f0 = _mm_loadu_ps(i);
+        f0 = _mm_mul_ps(f0, SCALE);
+        if (swap_pairs){
+            f0 = _mm_shuffle_ps(f0, f0, 0xb1);
+        }
+        _mm_storeu_ps(f, f0);
+        f += 4;
+        i += 4;
+    }
+
+    length %= 4;
+    for (size_t c = 0; c < length; c++){
+        __m128 f0 = _mm_load_ss(i + c);
+        f0 = _mm_mul_ss(f0, SCALE);
+        _mm_store_ss(f + (swap_pairs ? c ^ 1 : c), f0);
+    }
+}
+void convert_audio_float_to_float_x86_SSE2(float* f, const float* i, size_t length, float output_multiplier, bool swap_pairs){
+    if (swap_pairs){
+        convert_audio_float_to_float_x86_SSE2<true>(f, i, length, output_multiplier);
+    }else{
+        convert_audio_float_to_float_x86_SSE2<false>(f, i, length, output_multiplier);
+    }
+}
+
 
 
 
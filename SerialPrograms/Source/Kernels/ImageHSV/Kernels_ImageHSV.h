@@ -0,0 +1,29 @@
+/*  RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_H
+#define PokemonAutomation_Kernels_ImageHSV_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert every pixel of an RGB32 image to HSV32. Alpha is preserved.
+//  Output pixel layout: alpha (highest bits), H, S, V (lowest bits).
+//  H is the standard [0, 360) hue mapped to [0, 256). Reddish hues that are
+//  slightly below 0 degrees are clamped to 0.
+void rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,32 @@
+/*  RGB32 to HSV32 (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_ImageHSV_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct RGB32_to_HSV32_Default{
+    static const size_t VECTOR_SIZE = 1;
+
+    static PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        out[0] = rgb32_to_hsv32_Default(in[0]);
+    }
+};
+
+
+void rgb32_to_hsv32_Default(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    rgb32_to_hsv32<RGB32_to_HSV32_Default>(in, in_bytes_per_row, width, height, out, out_bytes_per_row);
+}
+
+
+
+}
+}
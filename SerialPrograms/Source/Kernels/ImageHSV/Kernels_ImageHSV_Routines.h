@@ -0,0 +1,96 @@
+/*  RGB32 to HSV32 Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_Routines_H
+#define PokemonAutomation_Kernels_ImageHSV_Routines_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Reference implementation for a single pixel.
+//
+//  All the vector versions must match this exactly. The divisions are written
+//  so that truncating a correctly rounded float quotient gives the same result
+//  as integer division over the whole input range.
+//
+//      S = 255 - (min * 255 + max / 2) / max
+//      H = (512 * n + 6 * delta) / (12 * delta)
+//
+//  where "n" is the hue numerator for the sector selected by the max channel,
+//  offset by 2 * delta or 4 * delta for the green and blue sectors.
+PA_FORCE_INLINE uint32_t rgb32_to_hsv32_Default(uint32_t pixel){
+    int32_t r = (pixel >> 16) & 0xff;
+    int32_t g = (pixel >>  8) & 0xff;
+    int32_t b = (pixel >>  0) & 0xff;
+
+    int32_t M = r > g ? r : g;
+    M = M > b ? M : b;
+    int32_t m = r < g ? r : g;
+    m = m < b ? m : b;
+    int32_t delta = M - m;
+
+    int32_t S = 0;
+    if (M > 0){
+        S = 255 - (m * 255 + M / 2) / M;
+    }
+
+    int32_t H = 0;
+    if (delta > 0){
+        int32_t n;
+        if (M == r){
+            n = g - b;
+        }else if (M == g){
+            n = b - r + 2 * delta;
+        }else{
+            n = r - g + 4 * delta;
+        }
+        if (n > 0){
+            H = (512 * n + 6 * delta) / (12 * delta);
+        }
+    }
+
+    return (pixel & 0xff000000) | ((uint32_t)H << 16) | ((uint32_t)S << 8) | (uint32_t)M;
+}
+
+
+
+template <typename Runner>
+PA_FORCE_INLINE void rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    const size_t VECTOR_SIZE = Runner::VECTOR_SIZE;
+    do{
+        const uint32_t* i0 = in;
+        uint32_t* o0 = out;
+        size_t lc = width / VECTOR_SIZE;
+        while (lc--){
+            Runner::process_full(o0, i0);
+            i0 += VECTOR_SIZE;
+            o0 += VECTOR_SIZE;
+        }
+        size_t left = width % VECTOR_SIZE;
+        while (left--){
+            *o0++ = rgb32_to_hsv32_Default(*i0++);
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }while (--height);
+}
+
+
+
+}
+}
+#endif
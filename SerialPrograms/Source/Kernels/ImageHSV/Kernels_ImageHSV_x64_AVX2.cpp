@@ -0,0 +1,79 @@
+/*  RGB32 to HSV32 (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels_ImageHSV_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct RGB32_to_HSV32_x64_AVX2{
+    static const size_t VECTOR_SIZE = 8;
+
+    static PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m256i pixel = _mm256_loadu_si256((const __m256i*)in);
+        _mm256_storeu_si256((__m256i*)out, process_word(pixel));
+    }
+
+    static PA_FORCE_INLINE __m256i process_word(__m256i pixel){
+        const __m256i mask = _mm256_set1_epi32(0xff);
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask);
+        __m256i b = _mm256_and_si256(pixel, mask);
+
+        __m256i M = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+        __m256i m = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+        __m256i delta = _mm256_sub_epi32(M, m);
+
+        //  S = 255 - (m * 255 + M / 2) / M
+        __m256i s_num = _mm256_sub_epi32(_mm256_slli_epi32(m, 8), m);
+        s_num = _mm256_add_epi32(s_num, _mm256_srli_epi32(M, 1));
+        __m256i S = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(s_num), _mm256_cvtepi32_ps(M)));
+        S = _mm256_sub_epi32(_mm256_set1_epi32(255), S);
+        S = _mm256_andnot_si256(_mm256_cmpeq_epi32(M, _mm256_setzero_si256()), S);
+
+        //  Pick the hue sector. Red takes priority, then green.
+        __m256i is_r = _mm256_cmpeq_epi32(M, r);
+        __m256i is_g = _mm256_cmpeq_epi32(M, g);
+        __m256i n_r = _mm256_sub_epi32(g, b);
+        __m256i n_g = _mm256_add_epi32(_mm256_sub_epi32(b, r), _mm256_slli_epi32(delta, 1));
+        __m256i n_b = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_slli_epi32(delta, 2));
+        __m256i n = _mm256_blendv_epi8(n_b, n_g, is_g);
+        n = _mm256_blendv_epi8(n, n_r, is_r);
+
+        //  H = (512 * n + 6 * delta) / (12 * delta)
+        __m256i delta2 = _mm256_slli_epi32(delta, 1);
+        __m256i delta6 = _mm256_add_epi32(delta2, _mm256_slli_epi32(delta, 2));
+        __m256i h_num = _mm256_add_epi32(_mm256_slli_epi32(n, 9), delta6);
+        __m256i h_den = _mm256_slli_epi32(delta6, 1);
+        __m256i H = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(h_num), _mm256_cvtepi32_ps(h_den)));
+        H = _mm256_max_epi32(H, _mm256_setzero_si256());
+        H = _mm256_andnot_si256(_mm256_cmpeq_epi32(delta, _mm256_setzero_si256()), H);
+
+        __m256i ret = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+        ret = _mm256_or_si256(ret, _mm256_slli_epi32(H, 16));
+        ret = _mm256_or_si256(ret, _mm256_slli_epi32(S, 8));
+        ret = _mm256_or_si256(ret, M);
+        return ret;
+    }
+};
+
+
+void rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    rgb32_to_hsv32<RGB32_to_HSV32_x64_AVX2>(in, in_bytes_per_row, width, height, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
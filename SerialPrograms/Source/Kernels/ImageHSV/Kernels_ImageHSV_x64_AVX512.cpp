@@ -0,0 +1,76 @@
+/*  RGB32 to HSV32 (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Kernels_ImageHSV_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct RGB32_to_HSV32_x64_AVX512{
+    static const size_t VECTOR_SIZE = 16;
+
+    static PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m512i pixel = _mm512_loadu_si512((const __m512i*)in);
+        _mm512_storeu_si512((__m512i*)out, process_word(pixel));
+    }
+
+    static PA_FORCE_INLINE __m512i process_word(__m512i pixel){
+        const __m512i mask = _mm512_set1_epi32(0xff);
+        __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), mask);
+        __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), mask);
+        __m512i b = _mm512_and_si512(pixel, mask);
+
+        __m512i M = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+        __m512i m = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+        __m512i delta = _mm512_sub_epi32(M, m);
+
+        //  S = 255 - (m * 255 + M / 2) / M
+        __mmask16 M_nonzero = _mm512_test_epi32_mask(M, M);
+        __m512i s_num = _mm512_sub_epi32(_mm512_slli_epi32(m, 8), m);
+        s_num = _mm512_add_epi32(s_num, _mm512_srli_epi32(M, 1));
+        __m512i S = _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(s_num), _mm512_cvtepi32_ps(M)));
+        S = _mm512_maskz_sub_epi32(M_nonzero, _mm512_set1_epi32(255), S);
+
+        //  Pick the hue sector. Red takes priority, then green.
+        __mmask16 is_r = _mm512_cmpeq_epi32_mask(M, r);
+        __mmask16 is_g = _mm512_cmpeq_epi32_mask(M, g);
+        __m512i n = _mm512_add_epi32(_mm512_sub_epi32(r, g), _mm512_slli_epi32(delta, 2));
+        n = _mm512_mask_add_epi32(n, is_g, _mm512_sub_epi32(b, r), _mm512_slli_epi32(delta, 1));
+        n = _mm512_mask_sub_epi32(n, is_r, g, b);
+
+        //  H = (512 * n + 6 * delta) / (12 * delta)
+        __mmask16 delta_nonzero = _mm512_test_epi32_mask(delta, delta);
+        __m512i delta6 = _mm512_add_epi32(_mm512_slli_epi32(delta, 1), _mm512_slli_epi32(delta, 2));
+        __m512i h_num = _mm512_add_epi32(_mm512_slli_epi32(n, 9), delta6);
+        __m512i h_den = _mm512_slli_epi32(delta6, 1);
+        __m512i H = _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(h_num), _mm512_cvtepi32_ps(h_den)));
+        H = _mm512_maskz_max_epi32(delta_nonzero, H, _mm512_setzero_si512());
+
+        __m512i ret = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+        ret = _mm512_or_si512(ret, _mm512_slli_epi32(H, 16));
+        ret = _mm512_or_si512(ret, _mm512_slli_epi32(S, 8));
+        ret = _mm512_or_si512(ret, M);
+        return ret;
+    }
+};
+
+
+void rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    rgb32_to_hsv32<RGB32_to_HSV32_x64_AVX512>(in, in_bytes_per_row, width, height, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,79 @@
+/*  RGB32 to HSV32 (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels_ImageHSV_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct RGB32_to_HSV32_x64_SSE41{
+    static const size_t VECTOR_SIZE = 4;
+
+    static PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m128i pixel = _mm_loadu_si128((const __m128i*)in);
+        _mm_storeu_si128((__m128i*)out, process_word(pixel));
+    }
+
+    static PA_FORCE_INLINE __m128i process_word(__m128i pixel){
+        const __m128i mask = _mm_set1_epi32(0xff);
+        __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask);
+        __m128i b = _mm_and_si128(pixel, mask);
+
+        __m128i M = _mm_max_epi32(_mm_max_epi32(r, g), b);
+        __m128i m = _mm_min_epi32(_mm_min_epi32(r, g), b);
+        __m128i delta = _mm_sub_epi32(M, m);
+
+        //  S = 255 - (m * 255 + M / 2) / M
+        __m128i s_num = _mm_sub_epi32(_mm_slli_epi32(m, 8), m);
+        s_num = _mm_add_epi32(s_num, _mm_srli_epi32(M, 1));
+        __m128i S = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(s_num), _mm_cvtepi32_ps(M)));
+        S = _mm_sub_epi32(_mm_set1_epi32(255), S);
+        S = _mm_andnot_si128(_mm_cmpeq_epi32(M, _mm_setzero_si128()), S);
+
+        //  Pick the hue sector. Red takes priority, then green.
+        __m128i is_r = _mm_cmpeq_epi32(M, r);
+        __m128i is_g = _mm_cmpeq_epi32(M, g);
+        __m128i n_r = _mm_sub_epi32(g, b);
+        __m128i n_g = _mm_add_epi32(_mm_sub_epi32(b, r), _mm_slli_epi32(delta, 1));
+        __m128i n_b = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_slli_epi32(delta, 2));
+        __m128i n = _mm_blendv_epi8(n_b, n_g, is_g);
+        n = _mm_blendv_epi8(n, n_r, is_r);
+
+        //  H = (512 * n + 6 * delta) / (12 * delta)
+        __m128i delta2 = _mm_slli_epi32(delta, 1);
+        __m128i delta6 = _mm_add_epi32(delta2, _mm_slli_epi32(delta, 2));
+        __m128i h_num = _mm_add_epi32(_mm_slli_epi32(n, 9), delta6);
+        __m128i h_den = _mm_slli_epi32(delta6, 1);
+        __m128i H = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(h_num), _mm_cvtepi32_ps(h_den)));
+        H = _mm_max_epi32(H, _mm_setzero_si128());
+        H = _mm_andnot_si128(_mm_cmpeq_epi32(delta, _mm_setzero_si128()), H);
+
+        __m128i ret = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+        ret = _mm_or_si128(ret, _mm_slli_epi32(H, 16));
+        ret = _mm_or_si128(ret, _mm_slli_epi32(S, 8));
+        ret = _mm_or_si128(ret, M);
+        return ret;
+    }
+};
+
+
+void rgb32_to_hsv32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    rgb32_to_hsv32<RGB32_to_HSV32_x64_SSE41>(in, in_bytes_per_row, width, height, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
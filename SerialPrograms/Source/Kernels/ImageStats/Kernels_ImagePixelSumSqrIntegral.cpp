@@ -0,0 +1,52 @@
+/*  Pixel Sum + Sum of Squares (Integral Image)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelSumSqrIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_sum_sqr_integral_Default(
+    uint32_t* integral, size_t integral_stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+void pixel_sum_sqr_integral_x64_SSE41(
+    uint32_t* integral, size_t integral_stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+
+
+
+void pixel_sum_sqr_integral(
+    uint32_t* integral, size_t integral_stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        pixel_sum_sqr_integral_x64_SSE41(
+            integral, integral_stride,
+            width, height,
+            image, image_bytes_per_row
+        );
+        return;
+    }
+#endif
+    pixel_sum_sqr_integral_Default(
+        integral, integral_stride,
+        width, height,
+        image, image_bytes_per_row
+    );
+}
+
+
+
+}
+}
@@ -0,0 +1,48 @@
+/*  Pixel Sum + Sum of Squares (Integral Image)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelSumSqrIntegral_H
+#define PokemonAutomation_Kernels_ImagePixelSumSqrIntegral_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Each entry of the integral image is 8 lanes in this order.
+enum{
+    PIXEL_INTEGRAL_SUM_B,
+    PIXEL_INTEGRAL_SUM_G,
+    PIXEL_INTEGRAL_SUM_R,
+    PIXEL_INTEGRAL_COUNT,
+    PIXEL_INTEGRAL_SQR_B,
+    PIXEL_INTEGRAL_SQR_G,
+    PIXEL_INTEGRAL_SQR_R,
+    PIXEL_INTEGRAL_UNUSED,      //  Value is unspecified.
+    PIXEL_INTEGRAL_LANES,
+};
+
+
+//  Build the integral image of the pixel sums and sums of squares.
+//
+//  "integral" has (height + 1) rows of (width + 1) entries with a row
+//  length of "integral_stride" uint32_t's. Entry (x, y) is the sum over all
+//  the pixels in [0, x) x [0, y). Row 0 and column 0 are set to zero.
+//
+//  Pixels are considered active if the alpha is >= 128. The sums of squares
+//  will overflow 32 bits past 65536 pixels. So keep width * height below that.
+void pixel_sum_sqr_integral(
+    uint32_t* integral, size_t integral_stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,61 @@
+/*  Pixel Sum + Sum of Squares (Integral Image) (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include "Kernels_ImagePixelSumSqrIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_sum_sqr_integral_Default(
+    uint32_t* integral, size_t integral_stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    const size_t LANES = PIXEL_INTEGRAL_LANES;
+
+    memset(integral, 0, (width + 1) * LANES * sizeof(uint32_t));
+
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* above = integral;
+        integral += integral_stride;
+        memset(integral, 0, LANES * sizeof(uint32_t));
+
+        uint32_t run[LANES] = {};
+        for (size_t c = 0; c < width; c++){
+            uint32_t p = image[c];
+            int32_t m = p;
+
+            m = m >> 31;
+            p &= (uint32_t)m;
+
+            uint32_t r0 = p & 0x000000ff;
+            uint32_t r1 = (p >>  8) & 0x000000ff;
+            uint32_t r2 = (p >> 16) & 0x000000ff;
+
+            run[PIXEL_INTEGRAL_SUM_B] += r0;
+            run[PIXEL_INTEGRAL_SUM_G] += r1;
+            run[PIXEL_INTEGRAL_SUM_R] += r2;
+            run[PIXEL_INTEGRAL_COUNT] -= m;
+            run[PIXEL_INTEGRAL_SQR_B] += r0 * r0;
+            run[PIXEL_INTEGRAL_SQR_G] += r1 * r1;
+            run[PIXEL_INTEGRAL_SQR_R] += r2 * r2;
+
+            const uint32_t* in = above + (c + 1) * LANES;
+            uint32_t* out = integral + (c + 1) * LANES;
+            for (size_t l = 0; l < LANES; l++){
+                out[l] = in[l] + run[l];
+            }
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+}
+}
@@ -0,0 +1,69 @@
+/*  Pixel Sum + Sum of Squares (Integral Image) (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelSumSqrIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  An entry is two vectors: (B, G, R, count) and (B^2, G^2, R^2, count).
+//  The pixel layout already puts B, G, R in the right lanes. So a pixel only
+//  needs to be widened and have its alpha turned into 0 or 1.
+void pixel_sum_sqr_integral_x64_SSE41(
+    uint32_t* integral, size_t integral_stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i limit = _mm_setr_epi32(255, 255, 255, 1);
+
+    __m128i* out = (__m128i*)integral;
+    for (size_t c = 0; c <= width; c++){
+        _mm_storeu_si128(out + 0, zero);
+        _mm_storeu_si128(out + 1, zero);
+        out += 2;
+    }
+
+    for (size_t r = 0; r < height; r++){
+        const __m128i* above = (const __m128i*)integral;
+        integral += integral_stride;
+        out = (__m128i*)integral;
+        _mm_storeu_si128(out + 0, zero);
+        _mm_storeu_si128(out + 1, zero);
+
+        __m128i sum = zero;
+        __m128i sqr = zero;
+        for (size_t c = 0; c < width; c++){
+            above += 2;
+            out += 2;
+
+            uint32_t p = image[c];
+            p &= (uint32_t)((int32_t)p >> 31);
+
+            __m128i x = _mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)p));
+            x = _mm_min_epi32(x, limit);
+
+            sum = _mm_add_epi32(sum, x);
+            sqr = _mm_add_epi32(sqr, _mm_mullo_epi16(x, x));
+
+            _mm_storeu_si128(out + 0, _mm_add_epi32(sum, _mm_loadu_si128(above + 0)));
+            _mm_storeu_si128(out + 1, _mm_add_epi32(sqr, _mm_loadu_si128(above + 1)));
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
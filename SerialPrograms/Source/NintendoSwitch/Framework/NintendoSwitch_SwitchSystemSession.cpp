@@ -4,6 +4,8 @@
  *
  */
 
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/VideoPipeline/VideoRecordingRing.h"
 #include "CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
@@ -26,6 +28,7 @@ SwitchSystemSession::~SwitchSystemSession(){
         m_logger.log("Shutting down session...");
     }catch (...){}
     ProgramTracker::instance().remove_console(m_console_id);
+    m_recording.reset();
     m_overlay.remove_stat(*m_main_thread_utilization);
     m_overlay.remove_stat(*m_cpu_utilization);
     m_option.m_camera.info = m_camera->current_device();
@@ -51,6 +54,18 @@ SwitchSystemSession::SwitchSystemSession(
     m_console_id = ProgramTracker::instance().add_console(program_id, *this);
     m_overlay.add_stat(*m_cpu_utilization);
     m_overlay.add_stat(*m_main_thread_utilization);
+
+    const VideoRecordingOption& recording = GlobalSettings::instance().VIDEO_RECORDING;
+    if (recording.enabled()){
+        VideoRecordingRing::Settings settings;
+        settings.duration = std::chrono::seconds(recording.SECONDS);
+        settings.frames_per_second = recording.FRAMES_PER_SECOND;
+        settings.max_width = recording.MAX_WIDTH;
+        settings.max_bytes = (size_t)recording.MAX_MEMORY_MB * 1024 * 1024;
+        m_recording.reset(new VideoRecordingRing(
+            m_logger, *m_camera, "Console" + std::to_string(console_number), settings
+        ));
+    }
 }
 
 void SwitchSystemSession::get(SwitchSystemOption& option){
@@ -31,6 +31,7 @@
 namespace PokemonAutomation{
     class CpuUtilizationStat;
     class ThreadUtilizationStat;
+    class VideoRecordingRing;
 namespace NintendoSwitch{
 
 class SwitchSystemOption;
@@ -87,6 +88,9 @@ private:
 
     std::unique_ptr<CpuUtilizationStat> m_cpu_utilization;
     std::unique_ptr<ThreadUtilizationStat> m_main_thread_utilization;
+
+    //  Recent video. Only set if enabled in the global settings.
+    std::unique_ptr<VideoRecordingRing> m_recording;
 };
 
 
@@ -110,7 +110,11 @@ void ProgramSelect::change_list(int index){
     }
     m_dropdown->setCurrentIndex(index);
     m_active_index = index;
-    PERSISTENT_SETTINGS().panels["ProgramCategory"] = m_lists[index]->name();
+    JsonValue& category = PERSISTENT_SETTINGS().panels["ProgramCategory"];
+    if (category.get_string_default() != m_lists[index]->name()){
+        category = m_lists[index]->name();
+        PERSISTENT_SETTINGS().write_async("ProgramCategory");
+    }
     delete m_active_list;
     m_active_list = m_lists[index]->make_QWidget(*this, m_holder);
     layout()->addWidget(m_active_list);
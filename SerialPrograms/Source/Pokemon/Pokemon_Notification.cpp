@@ -6,8 +6,10 @@
 
 #include <cmath>
 #include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
+#include "CommonFramework/VideoPipeline/VideoRecordingRing.h"
 #include "Pokemon/Pokemon_Strings.h"
 #include "Pokemon/Resources/Pokemon_PokeballNames.h"
 #include "Pokemon/Resources/Pokemon_PokemonNames.h"
@@ -78,7 +80,8 @@ void send_encounter_notification(
     const std::vector<EncounterResult>& results,
     double alpha,
     const ImageViewRGB32& screenshot,
-    const EncounterFrequencies* frequencies
+    const EncounterFrequencies* frequencies,
+    const Logger* console_logger
 ){
     ShinyType max_shiny_type = ShinyType::UNKNOWN;
     size_t shiny_count = 0;
@@ -159,6 +162,15 @@ void send_encounter_notification(
         stats_addendum = frequencies->dump_sorted_map("");
     }
 
+    if (has_shiny && console_logger != nullptr){
+        std::string clip = VideoRecordingRing::export_console(
+            *console_logger, SCREENSHOTS_PATH + now_to_filestring() + "-Shiny"
+        );
+        if (!clip.empty()){
+            env.log("Saving recent video to: " + clip, COLOR_BLUE);
+        }
+    }
+
     if (has_shiny){
         send_program_notification(
             env, settings_shiny,
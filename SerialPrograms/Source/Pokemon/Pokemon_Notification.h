@@ -41,7 +41,10 @@ void send_encounter_notification(
     const std::vector<EncounterResult>& results,
     double alpha,   //  Set to std::nan("") to hide the field.
     const ImageViewRGB32& screenshot = ImageViewRGB32(),
-    const EncounterFrequencies* frequencies = nullptr
+    const EncounterFrequencies* frequencies = nullptr,
+    //  The logger of the console the encounter is on. On a shiny, the recent
+    //  video of that console is saved to the screenshots folder. (if enabled)
+    const Logger* console_logger = nullptr
 );
 
 
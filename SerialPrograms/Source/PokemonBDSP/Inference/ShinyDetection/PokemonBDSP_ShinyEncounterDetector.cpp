@@ -101,7 +101,7 @@ bool ShinyEncounterTracker::process_frame(const VideoSnapshot& frame){
 
         m_sparkle_tracker_wild.process_frame(frame);
         m_sparkle_tracker_own.clear_boxes();
-        m_best_wild_overall.add_frame(frame.frame, m_sparkles_wild);
+        m_best_wild_overall.add_frame(frame.full_frame(), m_sparkles_wild);
 
         ImagePixelBox box_overall = floatbox_to_pixelbox(width, height, {0.4, 0.02, 0.60, 0.93});
         ImagePixelBox box_left = floatbox_to_pixelbox(width, height, m_box_wild_left);
@@ -127,7 +127,7 @@ bool ShinyEncounterTracker::process_frame(const VideoSnapshot& frame){
 
         m_sparkle_tracker_wild.clear_boxes();
         m_sparkle_tracker_own.process_frame(frame);
-        m_best_own.add_frame(frame.frame, m_sparkles_own);
+        m_best_own.add_frame(frame.full_frame(), m_sparkles_own);
         break;
     case EncounterState::POST_ENTRY:
         break;
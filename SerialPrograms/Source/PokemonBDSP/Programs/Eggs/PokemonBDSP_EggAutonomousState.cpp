@@ -155,7 +155,7 @@ void EggAutonomousState::process_shiny(const ImageViewRGB32& screen){
         m_notification_noop,
         m_notification_shiny,
         false, true, {{{}, ShinyType::UNKNOWN_SHINY}}, std::nan(""),
-        screen
+        screen, nullptr, &m_console.logger()
     );
 }
 
@@ -150,7 +150,8 @@ bool StandardEncounterHandler::handle_standard_encounter(const DoublesShinyDetec
         m_language != Language::None, is_likely_shiny(result.shiny_type),
         encounter_results, result.alpha,
         result.get_best_screenshot(),
-        enable_names ? &m_frequencies : nullptr
+        enable_names ? &m_frequencies : nullptr,
+        &m_console.logger()
     );
 
     if (m_settings.VIDEO_ON_SHINY && encounter.has_shiny()){
@@ -238,7 +239,8 @@ bool StandardEncounterHandler::handle_standard_encounter_end_battle(
         enable_names, is_likely_shiny(result.shiny_type),
         encounter_results, result.alpha,
         result.get_best_screenshot(),
-        enable_names ? &m_frequencies : nullptr
+        enable_names ? &m_frequencies : nullptr,
+        &m_console.logger()
     );
 
     EncounterActionFull action = encounter.get_action();
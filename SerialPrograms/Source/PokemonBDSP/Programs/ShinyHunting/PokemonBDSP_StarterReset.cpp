@@ -225,7 +225,7 @@ void StarterReset::program(SingleSwitchProgramEnvironment& env, BotBaseContext&
                 NOTIFICATION_NONSHINY,
                 NOTIFICATION_SHINY,
                 true, true, {{{"starly"}, ShinyType::UNKNOWN_SHINY}}, result_wild.alpha,
-                result_wild.get_best_screenshot()
+                result_wild.get_best_screenshot(), nullptr, &env.console.logger()
             );
         }else{
 #if 0
@@ -249,7 +249,7 @@ void StarterReset::program(SingleSwitchProgramEnvironment& env, BotBaseContext&
                 NOTIFICATION_NONSHINY,
                 NOTIFICATION_SHINY,
                 true, true, {{{starter}, ShinyType::UNKNOWN_SHINY}}, result_own.alpha,
-                result_own.get_best_screenshot()
+                result_own.get_best_screenshot(), nullptr, &env.console.logger()
             );
             break;
         }else{
@@ -7,7 +7,6 @@
 /* TODO ideas
 break into smaller functions
 read pokemon name and store the slug (easier to detect missread than reading a number)
-Optimise the swapping algo
 Add enum for ball ? Also, BDSP is reading from swsh data. Worth refactoring ?
 
 ideas for more checks :
@@ -24,10 +23,13 @@ language
 "stamps"
 */
 
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <sstream>
+#include <tuple>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
@@ -47,6 +49,7 @@ language
 #include "PokemonHome/Inference/PokemonHome_BallReader.h"
 #include "PokemonSwSh/Commands/PokemonSwSh_Commands_GameEntry.h"
 #include "PokemonSwSh/Programs/ReleaseHelpers.h"
+#include "PokemonHome_BoxSortingPlanner.h"
 #include "PokemonHome_BoxSorting.h"
 
 namespace PokemonAutomation{
@@ -56,8 +59,6 @@ using namespace Pokemon;
 
 
 const size_t MAX_BOXES = 200;
-const size_t MAX_COLUMNS = 6;
-const size_t MAX_ROWS = 5;
 
 BoxSorting_Descriptor::BoxSorting_Descriptor()
     : SingleSwitchProgramDescriptor(
@@ -74,17 +75,14 @@ struct BoxSorting_Descriptor::Stats : public StatsTracker{
     Stats()
         : pkmn(m_stats["Pokemon"])
         , empty(m_stats["Empty Slots"])
-        , compare(m_stats["Compares"])
         , swaps(m_stats["Swaps"])
     {
         m_display_order.emplace_back(Stat("Pokemon"));
         m_display_order.emplace_back(Stat("Empty Slots"));
-        m_display_order.emplace_back(Stat("Compares"));
         m_display_order.emplace_back(Stat("Swaps"));
     }
     std::atomic<uint64_t>& pkmn;
     std::atomic<uint64_t>& empty;
-    std::atomic<uint64_t>& compare;
     std::atomic<uint64_t>& swaps;
 };
 std::unique_ptr<StatsTracker> BoxSorting_Descriptor::make_stats() const{
@@ -118,7 +116,7 @@ BoxSorting::BoxSorting()
           "box_order"
       )
     , DRY_RUN(
-          "<b>Dry Run:</b><br>Catalogue and make sort plan without executing. (Will output to OUTPUT_FILE and OUTPUT_FILE.sortplan)",
+          "<b>Dry Run:</b><br>Catalogue and make sort plan without executing. The estimated run time of the plan is logged. (Will output to OUTPUT_FILE and OUTPUT_FILE-sortplan)",
           LockWhileRunning::LOCKED,
           false
       )
@@ -137,34 +135,11 @@ BoxSorting::BoxSorting()
 
 
 
-struct Cursor{
-  size_t box;
-  size_t row;
-  size_t column;
-};
-
 std::ostream& operator<<(std::ostream& os, const Cursor& cursor){
     os << "(" << cursor.box << "/" << cursor.row << "/" << cursor.column << ")";
     return os;
 }
 
-Cursor get_cursor(size_t index){
-    Cursor ret;
-
-    ret.column = index % MAX_COLUMNS;
-    index = index / MAX_COLUMNS;
-
-    ret.row = index % MAX_ROWS;
-    index = index / MAX_ROWS;
-
-    ret.box = index;
-    return ret;
-}
-
-size_t get_index(size_t box, size_t row, size_t column){
-    return box * MAX_ROWS * MAX_COLUMNS + row * MAX_COLUMNS + column;
-}
-
 
 
 struct Pokemon{
@@ -312,54 +287,24 @@ bool go_to_first_slot(SingleSwitchProgramEnvironment& env, BotBaseContext& conte
     ss << "Moving cursor from " << cur_cursor << " to " << dest_cursor;
     env.console.log(ss.str());
 
-    // TODO: shortest path movement though pages, boxes
-    for (size_t i = cur_cursor.box; i < dest_cursor.box; ++i){
+    CursorMoves moves = get_cursor_moves(cur_cursor, dest_cursor);
+    for (size_t i = 0; i < moves.box_right; ++i){
         pbf_press_button(context, BUTTON_R, 10, GAME_DELAY+30);
     }
-    for (size_t i = dest_cursor.box; i < cur_cursor.box; ++i){
+    for (size_t i = 0; i < moves.box_left; ++i){
         pbf_press_button(context, BUTTON_L, 10, GAME_DELAY+30);
     }
-
-
-    // direct nav up or down through rows
-    if (!(cur_cursor.row == 0 && dest_cursor.row == 4) && !(dest_cursor.row == 0 && cur_cursor.row == 4)) {
-        for (size_t i = cur_cursor.row; i < dest_cursor.row; ++i){
-            pbf_press_dpad(context, DPAD_DOWN, 1, GAME_DELAY);
-        }
-        for (size_t i = dest_cursor.row; i < cur_cursor.row; ++i){
-            pbf_press_dpad(context, DPAD_UP, 1, GAME_DELAY);
-        }
-    } else { // wrap around is faster to move between first or last row
-        if (cur_cursor.row == 0 && dest_cursor.row == 4) {
-            for (size_t i = 0; i <= 2; ++i){
-                pbf_press_dpad(context, DPAD_UP, 1, GAME_DELAY);
-            }
-        } else {
-            for (size_t i = 0; i <= 2; ++i){
-                pbf_press_dpad(context, DPAD_DOWN, 1, GAME_DELAY);
-            }
-        }
+    for (size_t i = 0; i < moves.down; ++i){
+        pbf_press_dpad(context, DPAD_DOWN, 1, GAME_DELAY);
     }
-
-    // direct nav forward or backward through columns
-    if ((dest_cursor.column > cur_cursor.column && dest_cursor.column - cur_cursor.column <= 3) || (cur_cursor.column > dest_cursor.column && cur_cursor.column - dest_cursor.column <= 3)) {
-        for (size_t i = cur_cursor.column; i < dest_cursor.column; ++i){
-            pbf_press_dpad(context, DPAD_RIGHT, 1, GAME_DELAY);
-        }
-        for (size_t i = dest_cursor.column; i < cur_cursor.column; ++i){
-            pbf_press_dpad(context, DPAD_LEFT, 1, GAME_DELAY);
-        }
-    } else { // wrap around is faster if direct movement is more than 3 away
-        if (dest_cursor.column > cur_cursor.column) {
-            for (size_t i = 0; i < MAX_COLUMNS - (dest_cursor.column - cur_cursor.column); ++i){
-                pbf_press_dpad(context, DPAD_LEFT, 1, GAME_DELAY);
-            }
-        }
-        if (cur_cursor.column > dest_cursor.column) {
-            for (size_t i = 0; i < MAX_COLUMNS - (cur_cursor.column - dest_cursor.column); ++i){
-                pbf_press_dpad(context, DPAD_RIGHT, 1, GAME_DELAY);
-            }
-        }
+    for (size_t i = 0; i < moves.up; ++i){
+        pbf_press_dpad(context, DPAD_UP, 1, GAME_DELAY);
+    }
+    for (size_t i = 0; i < moves.right; ++i){
+        pbf_press_dpad(context, DPAD_RIGHT, 1, GAME_DELAY);
+    }
+    for (size_t i = 0; i < moves.left; ++i){
+        pbf_press_dpad(context, DPAD_LEFT, 1, GAME_DELAY);
     }
 
     context.wait_for_all_requests();
@@ -397,59 +342,79 @@ void output_boxes_data_json(const std::vector<std::optional<Pokemon>>& boxes_dat
     pokemon_data.dump(json_path + ".json");
 }
 
+// Map each slot to an id so that two slots have the same id iff the Pokemon
+// in them are interchangeable for sorting. Empty slots are id 0.
+std::vector<size_t> get_slot_classes(
+    const std::vector<std::optional<Pokemon>>& slots,
+    std::map<std::tuple<uint16_t, bool, bool, std::string, EggHatchGenderFilter>, size_t>& ids
+){
+    std::vector<size_t> ret;
+    for (const std::optional<Pokemon>& pokemon : slots){
+        if (!pokemon.has_value()){
+            ret.emplace_back(0);
+            continue;
+        }
+        // NOTE edit when adding new struct members that are part of operator==
+        auto key = std::make_tuple(
+            pokemon->national_dex_number,
+            pokemon->shiny,
+            pokemon->gmax,
+            pokemon->ball_slug,
+            pokemon->gender
+        );
+        ret.emplace_back(ids.emplace(key, ids.size() + 1).first->second);
+    }
+    return ret;
+}
+
+void output_sort_plan_json(const std::vector<BoxSwap>& swaps, const std::string& json_path){
+    JsonArray plan;
+    for (const BoxSwap& swap : swaps){
+        JsonObject step;
+        Cursor pick = get_cursor(swap.pick);
+        Cursor place = get_cursor(swap.place);
+        step["pick_box"] = pick.box;
+        step["pick_row"] = pick.row;
+        step["pick_column"] = pick.column;
+        step["place_box"] = place.box;
+        step["place_row"] = place.row;
+        step["place_column"] = place.column;
+        plan.push_back(std::move(step));
+    }
+    plan.dump(json_path + ".json");
+}
+
 void do_sort(
         SingleSwitchProgramEnvironment& env,
         BotBaseContext& context,
         std::vector<std::optional<Pokemon>> boxes_data,
-        std::vector<std::optional<Pokemon>> boxes_sorted,
+        const std::vector<BoxSwap>& swaps,
         BoxSorting_Descriptor::Stats& stats,
         Cursor& cur_cursor,
         uint16_t GAME_DELAY
         ) {
     std::ostringstream ss;
-    // this need to be separated into functions when I will redo the whole thing but I just wanted it to work
+    for (const BoxSwap& swap : swaps){
+        Cursor cursor = get_cursor(swap.pick);
+        Cursor cursor_s = get_cursor(swap.place);
 
-    // going thru the sorted list one by one and for each one go through the current pokemon layout to find the closest possible match to fill the slot
-    for (size_t poke_nb_s = 0; poke_nb_s < boxes_sorted.size(); poke_nb_s++){
-        if (boxes_sorted[poke_nb_s] == std::nullopt){ // we've hit the end of the sorted list.
-            break;
-        }
-        for (size_t poke_nb = poke_nb_s; poke_nb < boxes_data.size(); poke_nb++){
-            Cursor cursor_s = get_cursor(poke_nb_s);
-            Cursor cursor = get_cursor(poke_nb);
-
-            // ss << "Comparing " << boxes_data[poke_nb] << " at " << cursor << " to " << boxes_sorted[poke_nb_s] << " at " << cursor_s;
-            // env.console.log(ss.str());
-            // ss.str("");
-
-            //check for a match and also check if the pokemon is not already in the slot
-            stats.compare++;
-            env.update_stats();
-            if(boxes_sorted[poke_nb_s] == boxes_data[poke_nb] && poke_nb_s == poke_nb){ // Same spot no need to move.
-                break;
-            }
-            if(boxes_sorted[poke_nb_s] == boxes_data[poke_nb]){
-                ss << "Swapping " << boxes_data[poke_nb] << " at " << cursor << " and " << boxes_sorted[poke_nb_s] << " at " << cursor_s;
-                env.console.log(ss.str());
-                ss.str("");
-
-                //moving cursor to the pokemon to pick it up
-                cur_cursor = move_cursor_to(env, context, cur_cursor, cursor, GAME_DELAY);
-                pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
+        ss << "Swapping " << boxes_data[swap.pick] << " at " << cursor << " and " << boxes_data[swap.place] << " at " << cursor_s;
+        env.console.log(ss.str());
+        ss.str("");
 
-                //moving to destination to place it or swap it
-                cur_cursor = move_cursor_to(env, context, cur_cursor, cursor_s, GAME_DELAY);
-                pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
+        //moving cursor to the pokemon to pick it up
+        cur_cursor = move_cursor_to(env, context, cur_cursor, cursor, GAME_DELAY);
+        pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
 
-                context.wait_for_all_requests();
+        //moving to destination to place it or swap it
+        cur_cursor = move_cursor_to(env, context, cur_cursor, cursor_s, GAME_DELAY);
+        pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
 
-                std::swap(boxes_data[poke_nb_s], boxes_data[poke_nb]);
-                stats.swaps++;
-                env.update_stats();
+        context.wait_for_all_requests();
 
-                break;
-            }
-        }
+        std::swap(boxes_data[swap.place], boxes_data[swap.pick]);
+        stats.swaps++;
+        env.update_stats();
     }
 }
 
@@ -711,8 +676,22 @@ void BoxSorting::program(SingleSwitchProgramEnvironment& env, BotBaseContext& co
     const std::string sorted_path = json_path + "-sorted";
     output_boxes_data_json(boxes_sorted, sorted_path);
 
+    std::map<std::tuple<uint16_t, bool, bool, std::string, EggHatchGenderFilter>, size_t> class_ids;
+    std::vector<size_t> have = get_slot_classes(boxes_data, class_ids);
+    std::vector<size_t> want = get_slot_classes(boxes_sorted, class_ids);
+
+    BoxSortingCosts costs(GAME_DELAY);
+    size_t start = get_index(cur_cursor.box, cur_cursor.row, cur_cursor.column);
+    std::vector<BoxSwap> sort_plan = plan_sort(have, want, start, costs);
+    uint64_t plan_ticks = costs.plan(start, sort_plan);
+    env.console.log(
+        "Sort plan: " + std::to_string(sort_plan.size()) + " swaps, estimated " +
+        duration_to_string(std::chrono::milliseconds(plan_ticks * 1000 / TICKS_PER_SECOND))
+    );
+    output_sort_plan_json(sort_plan, json_path + "-sortplan");
+
     if (!DRY_RUN) {
-        do_sort(env, context, boxes_data, boxes_sorted, stats, cur_cursor, GAME_DELAY);
+        do_sort(env, context, boxes_data, sort_plan, stats, cur_cursor, GAME_DELAY);
     }
 
     send_program_finished_notification(env, NOTIFICATION_PROGRAM_FINISH);
@@ -0,0 +1,320 @@
+/*  Home Box Sorting Planner
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include <map>
+#include "PokemonHome_BoxSortingPlanner.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonHome{
+
+
+
+Cursor get_cursor(size_t index){
+    Cursor ret;
+
+    ret.column = index % MAX_COLUMNS;
+    index = index / MAX_COLUMNS;
+
+    ret.row = index % MAX_ROWS;
+    index = index / MAX_ROWS;
+
+    ret.box = index;
+    return ret;
+}
+
+size_t get_index(size_t box, size_t row, size_t column){
+    return box * MAX_ROWS * MAX_COLUMNS + row * MAX_COLUMNS + column;
+}
+
+
+
+CursorMoves get_cursor_moves(const Cursor& cur_cursor, const Cursor& dest_cursor){
+    CursorMoves moves;
+
+    if (dest_cursor.box > cur_cursor.box){
+        moves.box_right = dest_cursor.box - cur_cursor.box;
+    }else{
+        moves.box_left = cur_cursor.box - dest_cursor.box;
+    }
+
+    // direct nav up or down through rows
+    if (!(cur_cursor.row == 0 && dest_cursor.row == 4) && !(dest_cursor.row == 0 && cur_cursor.row == 4)) {
+        if (dest_cursor.row > cur_cursor.row){
+            moves.down = dest_cursor.row - cur_cursor.row;
+        }else{
+            moves.up = cur_cursor.row - dest_cursor.row;
+        }
+    } else { // wrap around is faster to move between first or last row
+        if (cur_cursor.row == 0 && dest_cursor.row == 4) {
+            moves.up = 3;
+        } else {
+            moves.down = 3;
+        }
+    }
+
+    // direct nav forward or backward through columns
+    if ((dest_cursor.column > cur_cursor.column && dest_cursor.column - cur_cursor.column <= 3) || (cur_cursor.column > dest_cursor.column && cur_cursor.column - dest_cursor.column <= 3)) {
+        if (dest_cursor.column > cur_cursor.column){
+            moves.right = dest_cursor.column - cur_cursor.column;
+        }else{
+            moves.left = cur_cursor.column - dest_cursor.column;
+        }
+    } else { // wrap around is faster if direct movement is more than 3 away
+        if (dest_cursor.column > cur_cursor.column) {
+            moves.left = MAX_COLUMNS - (dest_cursor.column - cur_cursor.column);
+        }
+        if (cur_cursor.column > dest_cursor.column) {
+            moves.right = MAX_COLUMNS - (cur_cursor.column - dest_cursor.column);
+        }
+    }
+
+    return moves;
+}
+
+
+
+uint64_t BoxSortingCosts::move(size_t from, size_t to) const{
+    CursorMoves moves = get_cursor_moves(get_cursor(from), get_cursor(to));
+    return (moves.box_right + moves.box_left) * box_change +
+        (moves.down + moves.up + moves.right + moves.left) * dpad;
+}
+uint64_t BoxSortingCosts::plan(size_t cursor, const std::vector<BoxSwap>& swaps) const{
+    uint64_t ticks = 0;
+    for (const BoxSwap& swap : swaps){
+        ticks += move(cursor, swap.pick) + pick_or_place;
+        ticks += move(swap.pick, swap.place) + pick_or_place;
+        cursor = swap.place;
+    }
+    return ticks;
+}
+
+
+
+std::vector<BoxSwap> plan_sort_greedy(std::vector<size_t> have, const std::vector<size_t>& want){
+    std::vector<BoxSwap> swaps;
+    for (size_t poke_nb_s = 0; poke_nb_s < want.size(); poke_nb_s++){
+        if (want[poke_nb_s] == 0){ // we've hit the end of the sorted list.
+            break;
+        }
+        for (size_t poke_nb = poke_nb_s; poke_nb < have.size(); poke_nb++){
+            if (want[poke_nb_s] != have[poke_nb]){
+                continue;
+            }
+            if (poke_nb_s != poke_nb){
+                swaps.emplace_back(BoxSwap{poke_nb, poke_nb_s});
+                std::swap(have[poke_nb_s], have[poke_nb]);
+            }
+            break;
+        }
+    }
+    return swaps;
+}
+
+// Plan the swaps from the cycle decomposition of the permutation.
+//
+// A cycle of k misplaced slots takes k - 1 swaps and can be walked without
+// moving the cursor between them: pick up what is under the cursor and swap it
+// into the slot where the held Pokemon's predecessor belongs. So we want as
+// many short cycles as possible and then visit them in an order that keeps
+// the cursor travel low.
+//
+// Since identical Pokemon are interchangeable, there are many valid
+// permutations. Cycles are built greedily, closing them as early as possible.
+// That doesn't always find the most cycles. So the greedy plan is kept as a
+// fallback in case it happens to be cheaper. (see "plan_sort()")
+std::vector<BoxSwap> plan_sort_cycles(
+    const std::vector<size_t>& have, const std::vector<size_t>& want,
+    size_t cursor, const BoxSortingCosts& costs
+){
+    const size_t slots = have.size();
+
+    // cycles[i][j]'s contents belong in cycles[i][j + 1].
+    std::vector<std::vector<size_t>> cycles;
+    std::vector<bool> used(slots, false);
+
+    // Two misplaced slots that want each other's contents are a single swap.
+    // Take all of these first.
+    std::map<std::pair<size_t, size_t>, std::vector<size_t>> by_move;
+    for (size_t slot = 0; slot < slots; slot++){
+        if (have[slot] != want[slot]){
+            by_move[{have[slot], want[slot]}].emplace_back(slot);
+        }
+    }
+    for (auto& item : by_move){
+        if (item.first.first > item.first.second){
+            continue;
+        }
+        auto iter = by_move.find({item.first.second, item.first.first});
+        if (iter == by_move.end()){
+            continue;
+        }
+        std::vector<size_t>& forward = item.second;
+        std::vector<size_t>& reverse = iter->second;
+        while (!forward.empty() && !reverse.empty()){
+            used[forward.back()] = true;
+            used[reverse.back()] = true;
+            cycles.emplace_back(std::vector<size_t>{forward.back(), reverse.back()});
+            forward.pop_back();
+            reverse.pop_back();
+        }
+    }
+
+    // For each class, the remaining misplaced slots that want it.
+    std::map<size_t, std::vector<size_t>> wanted_by;
+    for (size_t slot = 0; slot < slots; slot++){
+        if (have[slot] != want[slot] && !used[slot]){
+            wanted_by[want[slot]].emplace_back(slot);
+        }
+    }
+
+    // Returns true if there is an unused slot that has "item" and wants "wanted".
+    auto has_unused = [&](size_t item, size_t wanted){
+        auto iter = by_move.find({item, wanted});
+        if (iter == by_move.end()){
+            return false;
+        }
+        std::vector<size_t>& list = iter->second;
+        while (!list.empty() && used[list.back()]){
+            list.pop_back();
+        }
+        return !list.empty();
+    };
+
+    // Take an unused slot that wants "item". Prefer one whose own contents
+    // close the cycle, then one that lets the next step close it. Otherwise
+    // take the one closest to "from".
+    auto take_slot = [&](size_t item, size_t close_with, size_t from){
+        std::vector<size_t>& candidates = wanted_by[item];
+        size_t best = 0;
+        uint64_t best_cost = UINT64_MAX;
+        for (size_t c = 0; c < candidates.size();){
+            size_t slot = candidates[c];
+            if (used[slot]){
+                candidates[c] = candidates.back();
+                candidates.pop_back();
+                continue;
+            }
+            if (have[slot] == close_with){
+                best = c;
+                break;
+            }
+            uint64_t cost = costs.move(from, slot);
+            if (!has_unused(close_with, have[slot])){
+                //  Rank everything that can't close on the next step after
+                //  everything that can.
+                cost += UINT64_MAX / 2;
+            }
+            if (cost < best_cost){
+                best = c;
+                best_cost = cost;
+            }
+            c++;
+        }
+        size_t slot = candidates[best];
+        used[slot] = true;
+        return slot;
+    };
+
+    // Whatever is left forms longer cycles. Follow each one from an unused
+    // slot until something belongs back in it.
+    //
+    // A walk closes as soon as it reaches something that belongs in the
+    // start slot. So start from the slots that want the most common items
+    // (usually empty slots in the tail).
+    std::map<size_t, size_t> misplaced_count;
+    std::vector<size_t> starts;
+    for (size_t slot = 0; slot < slots; slot++){
+        if (have[slot] != want[slot] && !used[slot]){
+            misplaced_count[want[slot]]++;
+            starts.emplace_back(slot);
+        }
+    }
+    std::stable_sort(
+        starts.begin(), starts.end(),
+        [&](size_t x, size_t y){
+            return misplaced_count[want[x]] > misplaced_count[want[y]];
+        }
+    );
+    for (size_t start : starts){
+        if (used[start]){
+            continue;
+        }
+        used[start] = true;
+
+        std::vector<size_t> cycle{start};
+        size_t current = start;
+        while (have[current] != want[start]){
+            current = take_slot(have[current], want[start], current);
+            cycle.emplace_back(current);
+        }
+        cycles.emplace_back(std::move(cycle));
+    }
+
+    // Visit the cycles nearest first. Walk each cycle backwards from the
+    // entry point that is cheapest to reach and to walk.
+    std::vector<BoxSwap> swaps;
+    std::vector<bool> done(cycles.size(), false);
+    for (size_t remaining = cycles.size(); remaining > 0; remaining--){
+        size_t best_cycle = 0;
+        size_t best_entry = 0;
+        uint64_t best_cost = UINT64_MAX;
+        for (size_t c = 0; c < cycles.size(); c++){
+            if (done[c]){
+                continue;
+            }
+            const std::vector<size_t>& cycle = cycles[c];
+            size_t k = cycle.size();
+            uint64_t walk = 0;
+            for (size_t i = 0; i < k; i++){
+                walk += costs.move(cycle[i], cycle[(i + 1) % k]);
+            }
+            for (size_t i = 0; i < k; i++){
+                if (have[cycle[i]] == 0){
+                    continue;   //  Can't pick up an empty slot.
+                }
+                uint64_t cost = costs.move(cursor, cycle[i]) + walk - costs.move(cycle[i], cycle[(i + 1) % k]);
+                if (cost < best_cost){
+                    best_cycle = c;
+                    best_entry = i;
+                    best_cost = cost;
+                }
+            }
+        }
+
+        const std::vector<size_t>& cycle = cycles[best_cycle];
+        size_t k = cycle.size();
+        for (size_t step = 0; step + 1 < k; step++){
+            size_t pick = cycle[(best_entry + k - step) % k];
+            size_t place = cycle[(best_entry + k - step - 1) % k];
+            swaps.emplace_back(BoxSwap{pick, place});
+        }
+        cursor = cycle[(best_entry + 1) % k];
+        done[best_cycle] = true;
+    }
+
+    return swaps;
+}
+
+std::vector<BoxSwap> plan_sort(
+    const std::vector<size_t>& have, const std::vector<size_t>& want,
+    size_t cursor, const BoxSortingCosts& costs
+){
+    std::vector<BoxSwap> greedy_plan = plan_sort_greedy(have, want);
+    std::vector<BoxSwap> cycle_plan = plan_sort_cycles(have, want, cursor, costs);
+    if (costs.plan(cursor, greedy_plan) < costs.plan(cursor, cycle_plan)){
+        return greedy_plan;
+    }
+    return cycle_plan;
+}
+
+
+
+}
+}
+}
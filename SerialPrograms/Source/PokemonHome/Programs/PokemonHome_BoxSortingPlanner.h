@@ -0,0 +1,99 @@
+/*  Home Box Sorting Planner
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Plan the swaps that sort the boxes. Slots are numbered across boxes in
+ *  reading order and each slot holds a class id. Two slots have the same id iff
+ *  the Pokemon in them are interchangeable for sorting. Empty slots are id 0.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonHome_BoxSortingPlanner_H
+#define PokemonAutomation_PokemonHome_BoxSortingPlanner_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonHome{
+
+
+const size_t MAX_COLUMNS = 6;
+const size_t MAX_ROWS = 5;
+
+
+struct Cursor{
+  size_t box;
+  size_t row;
+  size_t column;
+};
+
+Cursor get_cursor(size_t index);
+size_t get_index(size_t box, size_t row, size_t column);
+
+
+// Number of presses in each direction needed to move the cursor between two slots.
+struct CursorMoves{
+    size_t box_right = 0;
+    size_t box_left = 0;
+    size_t down = 0;
+    size_t up = 0;
+    size_t right = 0;
+    size_t left = 0;
+};
+
+CursorMoves get_cursor_moves(const Cursor& cur_cursor, const Cursor& dest_cursor);
+
+
+// A single pick up (Y) at "pick" followed by a place or swap (Y) at "place".
+struct BoxSwap{
+    size_t pick;
+    size_t place;
+};
+
+// Tick cost of each kind of input. These match the delays used by
+// move_cursor_to() and do_sort().
+struct BoxSortingCosts{
+    uint64_t box_change;
+    uint64_t dpad;
+    uint64_t pick_or_place;
+
+    BoxSortingCosts(uint16_t GAME_DELAY)
+        : box_change(10 + GAME_DELAY + 30)
+        , dpad(1 + GAME_DELAY)
+        , pick_or_place(10 + GAME_DELAY + 30)
+    {}
+
+    //  Ticks to move the cursor between two slots.
+    uint64_t move(size_t from, size_t to) const;
+    //  Ticks to run "swaps" starting with the cursor at "cursor".
+    uint64_t plan(size_t cursor, const std::vector<BoxSwap>& swaps) const;
+};
+
+
+// The original greedy plan: fill each sorted slot in order with the first
+// matching Pokemon found after it.
+std::vector<BoxSwap> plan_sort_greedy(std::vector<size_t> have, const std::vector<size_t>& want);
+
+// Plan the swaps from the cycle decomposition of the permutation. Visits the
+// cycles in an order that keeps the cursor travel low. See the .cpp file.
+std::vector<BoxSwap> plan_sort_cycles(
+    const std::vector<size_t>& have, const std::vector<size_t>& want,
+    size_t cursor, const BoxSortingCosts& costs
+);
+
+// Return whichever of the two plans above takes fewer ticks. Neither one is
+// always better. The cycle plan can take more swaps to save cursor travel.
+std::vector<BoxSwap> plan_sort(
+    const std::vector<size_t>& have, const std::vector<size_t>& want,
+    size_t cursor, const BoxSortingCosts& costs
+);
+
+
+
+}
+}
+}
+#endif
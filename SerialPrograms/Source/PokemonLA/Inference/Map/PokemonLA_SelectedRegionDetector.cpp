@@ -39,14 +39,14 @@ public:
             return false;
         }
         if (m_regions.empty()){
-            reload_reference(frame.frame);
+            reload_reference(frame.full_frame());
         }
 
         for (RegionState& region : m_regions){
-            ImageViewRGB32 current = extract_box_reference(frame, region.box);
+            ImageViewRGB32 current = frame.extract_box_reference(region.box);
 
             if (current.width() != (size_t)region.start.width() || current.height() != (size_t)region.start.height()){
-                reload_reference(frame.frame);
+                reload_reference(frame.full_frame());
                 return false;
             }
 
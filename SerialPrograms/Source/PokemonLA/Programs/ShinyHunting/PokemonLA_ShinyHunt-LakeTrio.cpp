@@ -223,7 +223,7 @@ void ShinyHuntLakeTrio::program(SingleSwitchProgramEnvironment& env, BotBaseCont
                     NOTIFICATION_NONSHINY,
                     NOTIFICATION_SHINY,
                     true, true, {{std::move(slugs), ShinyType::UNKNOWN_SHINY}}, std::nan(""),
-                    screen
+                    screen, nullptr, &env.console.logger()
                 );
                 if (VIDEO_ON_SHINY){
 //                    pbf_wait(context, 5 * TICKS_PER_SECOND);
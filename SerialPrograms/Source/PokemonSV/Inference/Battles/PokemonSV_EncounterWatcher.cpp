@@ -34,8 +34,9 @@ bool EncounterWatcher::process_frame(const VideoSnapshot& frame){
         }
 
         //  Add current frame if it has been long enough since the previous.
+        //  Keep our own copy. Don't hold onto the native frame.
         if (m_history.empty() || m_history.back().timestamp + std::chrono::milliseconds(250) < frame.timestamp){
-            m_history.push_back(frame);
+            m_history.push_back(frame.detach());
         }
     }
 
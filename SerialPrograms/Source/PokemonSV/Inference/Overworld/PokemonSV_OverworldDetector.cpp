@@ -157,7 +157,7 @@ bool OverworldWatcher::process_frame(const VideoSnapshot& frame){
         m_last_ball = frame.timestamp;
     }
     if (!m_start_of_detection){
-        m_start_of_detection = frame;
+        m_start_of_detection = frame.detach();
         return false;
     }
 
@@ -170,7 +170,7 @@ bool OverworldWatcher::process_frame(const VideoSnapshot& frame){
     ImageViewRGB32 start = extract_box_reference(m_start_of_detection, m_radar_inside);
     ImageViewRGB32 current = extract_box_reference(frame, m_radar_inside);
     if (start.width() != current.width() || start.height() != current.height()){
-        m_start_of_detection = frame;
+        m_start_of_detection = frame.detach();
         return false;
     }
 
@@ -178,7 +178,7 @@ bool OverworldWatcher::process_frame(const VideoSnapshot& frame){
     double rmsd = ImageMatch::pixel_RMSD(start, current);
 //    cout << "rmsd = " << rmsd << endl;
     if (rmsd > 2.0){
-        m_start_of_detection = frame;
+        m_start_of_detection = frame.detach();
         return false;
     }
 
@@ -4,6 +4,8 @@
  *
  */
 
+#include <cmath>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
@@ -80,29 +82,43 @@ void SandwichHandLocator::make_overlays(VideoOverlaySet& items) const{
 }
 
 std::pair<double, double> SandwichHandLocator::detect(const ImageViewRGB32& frame) const {
+    return detect_in_region(frame.width(), frame.height(), extract_box_reference(frame, m_box));
+}
+
+std::pair<double, double> SandwichHandLocator::detect(const VideoSnapshot& frame) const {
+    if (frame.lazy){
+        return detect_in_region(frame.lazy->width(), frame.lazy->height(), frame.extract_box_reference(m_box));
+    }
+    return detect(*frame.frame);
+}
+
+std::pair<double, double> SandwichHandLocator::detect_in_region(
+    size_t screen_width, size_t screen_height,
+    const ImageViewRGB32& region
+) const {
 
     const std::vector<std::pair<uint32_t, uint32_t>> filters = {
         {combine_rgb(150, 150, 150), combine_rgb(255, 255, 255)}
     };
 
-    const double screen_rel_size = (frame.height() / 1080.0);
+    const double screen_rel_size = (screen_height / 1080.0);
 
     double min_hand_size = ((m_type == HandType::FREE) ? 5000.0 : 4500.0);
     const size_t min_size = size_t(screen_rel_size * screen_rel_size * min_hand_size);
 
     std::pair<double, double> hand_location(-1.0, -1.0);
 
-    ImagePixelBox pixel_box = floatbox_to_pixelbox(frame.width(), frame.height(), m_box);
+    ImagePixelBox pixel_box = floatbox_to_pixelbox(screen_width, screen_height, m_box);
     match_template_by_waterfill(
-        extract_box_reference(frame, m_box), 
+        region,
         ((m_type == HandType::FREE) ? SandwichFreeHandMatcher::instance() : SandwichGrabbingHandMatcher::instance()),
         filters,
         {min_size, SIZE_MAX},
         60,
         [&](Kernels::Waterfill::WaterfillObject& object) -> bool {
             hand_location = std::make_pair(
-                (object.center_of_gravity_x() + pixel_box.min_x) / (double)frame.width(),
-                (object.center_of_gravity_y() + pixel_box.min_y) / (double)frame.height()
+                (object.center_of_gravity_x() + pixel_box.min_x) / (double)screen_width,
+                (object.center_of_gravity_y() + pixel_box.min_y) / (double)screen_height
             );
             return true;
         }
@@ -123,12 +139,126 @@ void SandwichHandWatcher::make_overlays(VideoOverlaySet& items) const{
 }
 
 bool SandwichHandWatcher::process_frame(const VideoSnapshot& frame){
-    m_last_snapshot = frame;
+    //  Keep our own copy. Don't hold onto the native frame.
+    m_last_snapshot = frame.detach();
     m_location = m_locator.detect(frame);
     return m_location.first >= 0.0;
 }
 
 
+
+SandwichHandTracker::SandwichHandTracker(
+    HandType hand_type,
+    const ImageFloatBox& box,
+    Color color
+)
+    : VisualInferenceCallback("SandwichHandTracker")
+    , m_initial_box(box)
+    , m_color(color)
+    , m_locator(hand_type, box, color)
+    , m_last_found(WallClock::min())
+    , m_misses(0)
+{
+    m_sample.search_box = box;
+}
+
+VideoSnapshot SandwichHandTracker::last_snapshot() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_last_snapshot;
+}
+SandwichHandTracker::Sample SandwichHandTracker::sample() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_sample;
+}
+SandwichHandTracker::Sample SandwichHandTracker::wait_for_sample(uint64_t seqnum, WallClock deadline) const{
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_cv.wait_until(lg, deadline, [&]{ return m_sample.seqnum > seqnum; });
+    return m_sample;
+}
+
+void SandwichHandTracker::make_overlays(VideoOverlaySet& items) const{
+    items.add(m_color, m_initial_box);
+}
+
+ImageFloatBox SandwichHandTracker::search_box(const Sample& last, WallClock timestamp) const{
+    if (last.location.first < 0 || m_misses > MAX_MISSES){
+        return m_initial_box;
+    }
+
+    // Don't trust the velocity too far into the future.
+    double time_s = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - m_last_found).count() / 1000000.0;
+    time_s = std::max(std::min(time_s, 0.5), 0.0);
+
+    const double x = last.location.first + last.velocity.first * time_s;
+    const double y = last.location.second + last.velocity.second * time_s;
+
+    // A still hand gets a window of 4x the hand size. Add however far the
+    // prediction can be off and widen it on every miss.
+    const double half_width = (HAND_WIDTH * 2 + std::fabs(last.velocity.first) * time_s) * (1 + m_misses);
+    const double half_height = (HAND_HEIGHT * 2 + std::fabs(last.velocity.second) * time_s) * (1 + m_misses);
+
+    // Never search outside of the initial box. Other white things on screen
+    // could be mistaken for the hand there.
+    const double min_x = std::max(m_initial_box.x, x - half_width);
+    const double min_y = std::max(m_initial_box.y, y - half_height);
+    const double max_x = std::min(m_initial_box.x + m_initial_box.width, x + half_width);
+    const double max_y = std::min(m_initial_box.y + m_initial_box.height, y + half_height);
+    if (max_x <= min_x || max_y <= min_y){
+        return m_initial_box;
+    }
+    return ImageFloatBox(min_x, min_y, max_x - min_x, max_y - min_y);
+}
+
+bool SandwichHandTracker::process_frame(const VideoSnapshot& frame){
+    Sample last = sample();
+
+    // Inference may run faster than the video. Don't process the same frame twice.
+    if (last.seqnum != 0 && frame.timestamp == last.timestamp){
+        return false;
+    }
+
+    Sample current = last;
+    current.seqnum++;
+    current.timestamp = frame.timestamp;
+    current.search_box = search_box(last, frame.timestamp);
+
+    m_locator.change_box(current.search_box);
+    std::pair<double, double> location = m_locator.detect(frame);
+    current.found = location.first >= 0.0;
+
+    if (current.found){
+        double time_s = last.location.first < 0
+            ? 0
+            : std::chrono::duration_cast<std::chrono::microseconds>(frame.timestamp - m_last_found).count() / 1000000.0;
+        if (time_s <= 0 || time_s > 0.5){
+            // No recent location to estimate velocity from.
+            current.velocity = std::make_pair(0.0, 0.0);
+        }else{
+            // Smooth it out as the hand location jitters by a few pixels.
+            current.velocity = std::make_pair(
+                0.5 * last.velocity.first + 0.5 * (location.first - last.location.first) / time_s,
+                0.5 * last.velocity.second + 0.5 * (location.second - last.location.second) / time_s
+            );
+        }
+        current.location = location;
+        m_last_found = frame.timestamp;
+        m_misses = 0;
+    }else{
+        m_misses++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_sample = current;
+        //  Keep our own copy. Don't hold onto the native frame.
+        m_last_snapshot = frame.detach();
+    }
+    m_cv.notify_all();
+
+    return false;
+}
+
+
 }
 }
 }
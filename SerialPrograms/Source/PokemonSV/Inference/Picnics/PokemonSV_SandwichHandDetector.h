@@ -7,7 +7,10 @@
 #ifndef PokemonAutomation_PokemonSV_SandwichHandLocator_H
 #define PokemonAutomation_PokemonSV_SandwichHandLocator_H
 
+#include <mutex>
+#include <condition_variable>
 #include "Common/Cpp/Color.h"
+#include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/InferenceInfra/VisualInferenceCallback.h"
@@ -40,9 +43,19 @@ public:
     // If hand not detected, return (-1, -1).
     std::pair<double, double> detect(const ImageViewRGB32& screen) const;
 
+    // Same as above. If the snapshot is lazy, only the pixels inside the box
+    // are converted.
+    std::pair<double, double> detect(const VideoSnapshot& screen) const;
+
+    const ImageFloatBox& box() const { return m_box; }
     void change_box(const ImageFloatBox& new_box) { m_box = new_box; }
 
 private:
+    std::pair<double, double> detect_in_region(
+        size_t screen_width, size_t screen_height,
+        const ImageViewRGB32& region
+    ) const;
+
     HandType m_type;
     ImageFloatBox m_box;
     Color m_color;
@@ -70,6 +83,68 @@ private:
 };
 
 
+// Track the hand on every frame while it is being moved.
+// Instead of scanning the whole box on every frame, it searches a small window
+// around where the hand should be given its last location and velocity. If the
+// hand isn't found there, the window grows on each frame until it falls back
+// to the initial box.
+// This never returns true. The latest location is published after every frame.
+// Use "wait_for_sample()" to get it.
+class SandwichHandTracker : public VisualInferenceCallback{
+public:
+    using HandType = SandwichHandType;
+
+    // Size of the hand in screen fraction.
+    static constexpr double HAND_WIDTH = 0.071;
+    static constexpr double HAND_HEIGHT = 0.106;
+
+    // After this many frames without the hand, search the initial box again.
+    static constexpr size_t MAX_MISSES = 3;
+
+    struct Sample{
+        // Incremented on every processed frame. 0 means no frame yet.
+        uint64_t seqnum = 0;
+        // Timestamp of the frame.
+        WallClock timestamp = WallClock::min();
+        // Whether the hand is found on this frame.
+        bool found = false;
+        // Last found hand location, (-1, -1) if never found.
+        std::pair<double, double> location{-1.0, -1.0};
+        // Estimated hand velocity in screen fraction per second.
+        std::pair<double, double> velocity{0.0, 0.0};
+        // The box that was searched on this frame.
+        ImageFloatBox search_box;
+    };
+
+    SandwichHandTracker(HandType hand_type, const ImageFloatBox& box, Color color = COLOR_RED);
+
+    VideoSnapshot last_snapshot() const;
+    Sample sample() const;
+
+    // Wait until there is a sample newer than "seqnum" or until "deadline".
+    // Returns the latest sample either way.
+    Sample wait_for_sample(uint64_t seqnum, WallClock deadline) const;
+
+    virtual void make_overlays(VideoOverlaySet& items) const override;
+    virtual bool process_frame(const VideoSnapshot& frame) override;
+
+private:
+    ImageFloatBox search_box(const Sample& last, WallClock timestamp) const;
+
+private:
+    const ImageFloatBox m_initial_box;
+    const Color m_color;
+    SandwichHandLocator m_locator;
+    WallClock m_last_found;
+    size_t m_misses;
+
+    mutable std::mutex m_lock;
+    mutable std::condition_variable m_cv;
+    Sample m_sample;
+    VideoSnapshot m_last_snapshot;
+};
+
+
 
 }
 }
@@ -16,6 +16,8 @@
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "CommonFramework/ImageMatch/ExactImageMatcher.h"
 #include "CommonFramework/OCR/OCR_RawOCR.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
+#include "CommonFramework/OCR/OCR_TrainingTools.h"
 #include "PokemonSV_TeraCodeReader.h"
 
 //#define PA_ENABLE_CODE_DEBUG
@@ -51,8 +53,54 @@ public:
     ImageMatch::ExactImageMatcher CHI_S;
 };
 
+
+//  Templates for the code font. These are only for the code. The timer is in
+//  a different font. If these are missing, every character goes to Tesseract
+//  instead.
+class GlyphTemplates{
+    GlyphTemplates()
+        : CLASSIFIER(OCR::GlyphClassifier::load_optional(RESOURCE_PATH() + "PokemonSV/TeraCode/TeraCodeGlyphs.json"))
+    {}
+
+public:
+    static constexpr double MAX_DISTANCE = 0.15;
+    static constexpr double MIN_MARGIN = 0.05;
+
+    static const GlyphTemplates& instance(){
+        static GlyphTemplates templates;
+        return templates;
+    }
+
+    OCR::GlyphClassifier CLASSIFIER;
+};
+
 void preload_code_templates(){
     CharacterTemplates::instance();
+    GlyphTemplates::instance();
+}
+
+
+
+//  Upper bounds of the dark pixels that make up the characters.
+const std::vector<uint32_t>& CODE_FILTERS(){
+    static const std::vector<uint32_t> filters{
+        0xff5f5f5f,
+        0xff7f7f7f,
+    };
+    return filters;
+}
+const size_t CODE_MIN_AREA = 20;
+
+void generate_code_glyph_templates(Logger& logger, CancellableScope& scope, const std::string& directory){
+    std::vector<std::pair<uint32_t, uint32_t>> filters;
+    for (uint32_t filter : CODE_FILTERS()){
+        filters.emplace_back(0xff000000, filter);
+    }
+    OCR::generate_glyph_templates(
+        logger, scope, directory,
+        "TeraCodeGlyphs.json",
+        filters, CODE_MIN_AREA
+    );
 }
 
 
@@ -145,10 +193,12 @@ struct WaterfillOCRResult{
 };
 
 
+//  "glyphs" are the templates of the font. (if any)
 std::vector<WaterfillOCRResult> waterfill_OCR(
     AsyncDispatcher& dispatcher,
     const ImageViewRGB32& image,
-    uint32_t threshold
+    uint32_t threshold,
+    const OCR::GlyphClassifier* glyphs = nullptr
 ){
     using namespace Kernels::Waterfill;
 
@@ -158,30 +208,37 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
     ImageRGB32 filtered = to_blackwhite_rgb32_range(image, 0xff000000, threshold, true);
     PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, 0xff000000, threshold);
 
-    std::map<size_t, WaterfillObject> map;
-    {
-        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
-        auto iter = session->make_iterator(20);
-        WaterfillObject object;
-        while (map.size() < 16 && iter->find_next(object, true)){
-            map.emplace(object.min_x, std::move(object));
-        }
+    std::vector<WaterfillOCRResult> ret;
+    for (WaterfillObject& object : OCR::waterfill_glyphs(matrix, CODE_MIN_AREA, 16)){
+        ret.emplace_back(WaterfillOCRResult{std::move(object), ""});
     }
 
-    std::vector<WaterfillOCRResult> ret;
-    for (auto& item : map){
-        ret.emplace_back(WaterfillOCRResult{std::move(item.second), ""});
+    //  Try the templates first. Only the characters that don't match one
+    //  confidently are sent to Tesseract.
+    std::vector<size_t> unknown;
+    for (size_t c = 0; c < ret.size(); c++){
+        char ch = glyphs == nullptr ? 0 : glyphs->read(
+            ret[c].object.packed_matrix(),
+            GlyphTemplates::MAX_DISTANCE,
+            GlyphTemplates::MIN_MARGIN
+        );
+        if (ch != 0){
+            ret[c].ocr = std::string(1, ch);
+        }else{
+            unknown.emplace_back(c);
+        }
     }
 
     dispatcher.run_in_parallel(
-        0, ret.size(),
+        0, unknown.size(),
         [&](size_t index){
-            WaterfillObject& object = ret[index].object;
+            WaterfillOCRResult& result = ret[unknown[index]];
+            WaterfillObject& object = result.object;
             ImageRGB32 cropped = extract_box_reference(filtered, object).copy();
             PackedBinaryMatrix tmp(object.packed_matrix());
             filter_by_mask(tmp, cropped, Color(0xffffffff), true);
             ImageRGB32 padded = pad_image(cropped, cropped.width(), 0xffffffff);
-            ret[index].ocr = OCR::ocr_read(Language::English, padded);
+            result.ocr = OCR::ocr_read(Language::English, padded);
         }
     );
 
@@ -263,13 +320,11 @@ int16_t read_raid_timer(Logger& logger, AsyncDispatcher& dispatcher, const Image
 
 
 std::string read_raid_code(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image){
-    std::vector<uint32_t> filters{
-        0xff5f5f5f,
-        0xff7f7f7f,
-    };
-
-    for (uint32_t filter : filters){
-        std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, filter);
+    for (uint32_t filter : CODE_FILTERS()){
+        std::vector<WaterfillOCRResult> characters = waterfill_OCR(
+            dispatcher, image, filter,
+            &GlyphTemplates::instance().CLASSIFIER
+        );
 
         static const std::map<char, char> SUBSTITUTIONS{
             {'I', '1'},
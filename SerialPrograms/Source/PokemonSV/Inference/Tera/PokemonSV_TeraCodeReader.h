@@ -7,17 +7,24 @@
 #ifndef PokemonAutomation_PokemonSV_TeraCodeReader_H
 #define PokemonAutomation_PokemonSV_TeraCodeReader_H
 
+#include <string>
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 
 namespace PokemonAutomation{
     class Logger;
     class AsyncDispatcher;
+    class CancellableScope;
 namespace NintendoSwitch{
 namespace PokemonSV{
 
 
 void preload_code_templates();
 
+//  Generate the character templates for the code font from the sample images
+//  in "directory". (relative to "TrainingData/")
+//  See "OCR::generate_glyph_templates()" for how to name the samples.
+void generate_code_glyph_templates(Logger& logger, CancellableScope& scope, const std::string& directory);
+
 
 //  Returns # of seconds left. Returns -1 if unable to read.
 int16_t read_raid_timer(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image);
@@ -43,6 +43,7 @@
 #include "Programs/Glitches/PokemonSV_CloneItems-1.0.1.h"
 
 #include "Programs/TestPrograms/PokemonSV_SoundListener.h"
+#include "Programs/TestPrograms/PokemonSV_TrainTeraCodeOCR.h"
 
 #ifdef PA_OFFICIAL
 #include "../../Internal/SerialPrograms/NintendoSwitch_TestPrograms.h"
@@ -112,6 +113,7 @@ std::vector<PanelEntry> PanelListFactory::make_panels() const{
     if (PreloadSettings::instance().DEVELOPER_MODE){
         ret.emplace_back("---- Developer Tools ----");
         ret.emplace_back(make_single_switch_program<SoundListener_Descriptor, SoundListener>());
+        ret.emplace_back(make_computer_program<TrainTeraCodeOCR_Descriptor, TrainTeraCodeOCR>());
     }
 
 #ifdef PA_OFFICIAL
@@ -515,7 +515,7 @@ void EggAutonomous::process_one_baby(SingleSwitchProgramEnvironment& env, BotBas
             m_notification_noop,
             NOTIFICATION_SHINY,
             false, true, {{{}, ShinyType::UNKNOWN_SHINY}}, std::nan(""),
-            env.console.video().snapshot()
+            env.console.video().snapshot(), nullptr, &env.console.logger()
         );
     }else{
         env.console.overlay().add_log("Not shiny " + std::to_string(egg_index+1) + "/" + std::to_string(num_eggs_in_party), COLOR_WHITE);
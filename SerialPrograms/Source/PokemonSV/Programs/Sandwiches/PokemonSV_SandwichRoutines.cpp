@@ -8,6 +8,7 @@
 #include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/InferenceInfra/InferenceRoutines.h"
+#include "CommonFramework/InferenceInfra/InferenceSession.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
@@ -275,7 +276,7 @@ ImageFloatBox move_sandwich_hand(
     uint8_t joystick_x = 128;
     uint8_t joystick_y = 128;
 
-    SandwichHandWatcher hand_watcher(hand_type, start_box);
+    SandwichHandTracker hand_tracker(hand_type, start_box);
 
     // A session that creates a new thread to send button commands to controller
     AsyncCommandSession move_session(context, console.logger(), dispatcher, console.botbase());
@@ -286,39 +287,57 @@ ImageFloatBox move_sandwich_hand(
         });
     }
 
+    // Track the hand on every frame for as long as it is moving. The loop
+    // below reacts to each new location as soon as it is published.
+    double fps = console.video().fps_source();
+    std::chrono::milliseconds frame_period(fps > 0 ? std::max(std::min(int(1000 / fps), 50), 8) : 16);
+    CancellableHolder<CancellableScope> tracker_scope(static_cast<CancellableScope&>(context));
+    InferenceSession tracker_session(tracker_scope, console, {{hand_tracker, frame_period}});
+
     const std::pair<double, double> target_loc(end_box.x + end_box.width/2, end_box.y + end_box.height/2);
 
-    std::pair<double, double> last_loc(-1, -1);
-    std::pair<double, double> speed(-1, -1);
-    WallClock cur_time, last_time;
+    // Re-dispatch when the push changes, but not faster than the controller can
+    // take it. Also re-dispatch before the last push runs out.
+    const std::chrono::milliseconds min_dispatch_period(32);
+    const std::chrono::milliseconds max_dispatch_period(80);
+
+    uint64_t seqnum = 0;
+    WallClock last_found = current_time();
+    WallClock last_dispatch = WallClock::min();
     VideoOverlaySet overlay_set(console.overlay());
 
     while(true){
-        int ret = wait_until(console, context, std::chrono::seconds(5), {hand_watcher});
-        if (ret < 0){
-            dump_image_and_throw_recoverable_exception(
-                info, console,
-                SANDWICH_HAND_TYPE_NAMES(hand_type) + "SandwichHandNotDetected",
-                "move_sandwich_hand(): Cannot detect " + SANDWICH_HAND_TYPE_NAMES(hand_type) + " hand.",
-                hand_watcher.last_snapshot()
-            );
+        SandwichHandTracker::Sample sample = hand_tracker.wait_for_sample(seqnum, current_time() + std::chrono::milliseconds(50));
+        tracker_scope.throw_if_cancelled_with_exception();
+        context.throw_if_cancelled();
+
+        if (sample.seqnum == seqnum || !sample.found){
+            seqnum = sample.seqnum;
+            if (current_time() - last_found > std::chrono::seconds(5)){
+                dump_image_and_throw_recoverable_exception(
+                    info, console,
+                    SANDWICH_HAND_TYPE_NAMES(hand_type) + "SandwichHandNotDetected",
+                    "move_sandwich_hand(): Cannot detect " + SANDWICH_HAND_TYPE_NAMES(hand_type) + " hand.",
+                    hand_tracker.last_snapshot()
+                );
+            }
+            continue;
         }
+        seqnum = sample.seqnum;
+        last_found = current_time();
 
-        auto cur_loc = hand_watcher.location();
-        console.log("Hand location: " + std::to_string(cur_loc.first) + ", " + std::to_string(cur_loc.second));
-        cur_time = current_time();
+        auto cur_loc = sample.location;
 
         const ImageFloatBox hand_bb = hand_location_to_box(cur_loc); 
-        const ImageFloatBox expanded_hand_bb = expand_box(hand_bb);
-        hand_watcher.change_box(expanded_hand_bb);
 
         overlay_set.clear();
         overlay_set.add(COLOR_RED, hand_bb);
-        overlay_set.add(COLOR_BLUE, expanded_hand_bb);
+        overlay_set.add(COLOR_BLUE, sample.search_box);
 
         std::pair<double, double> dif(target_loc.first - cur_loc.first, target_loc.second - cur_loc.second);
         // console.log("float diff to target: " + std::to_string(dif.first) + ", " + std::to_string(dif.second));
         if (std::fabs(dif.first) < end_box.width/2 && std::fabs(dif.second) < end_box.height/2){
+            console.log("Hand location: " + std::to_string(cur_loc.first) + ", " + std::to_string(cur_loc.second));
             console.log(SANDWICH_HAND_TYPE_NAMES(hand_type) + " hand reached target.");
             move_session.stop_session_and_rethrow(); // Stop the commands
             if (hand_type == SandwichHandType::GRABBING){
@@ -343,41 +362,42 @@ ImageFloatBox move_sandwich_hand(
         std::pair<double, double> push(real_dif.first * target_joystick_push / distance, real_dif.second * target_joystick_push / distance);
         // console.log("push force " + std::to_string(push.first) + ", " + std::to_string(push.second));
 
-        if (last_loc.first < 0){
-            speed = std::make_pair(0.0, 0.0);
-        } else {
-            std::chrono::microseconds time = std::chrono::duration_cast<std::chrono::microseconds>(cur_time - last_time);
-            double time_s = time.count() / 1000000.0;
-            std::pair<double, double> moved((cur_loc.first - last_loc.first) * 16, (cur_loc.second - last_loc.second) * 9);
+        // The tracker gives the velocity in screen fraction per second.
+        std::pair<double, double> moved(sample.velocity.first * 16, sample.velocity.second * 9);
 
-            // Currently set to zero damping as it seems we don't need them for now
-            double damping_factor = 0.0;
-            double damping_multiplier = (-1.0) * damping_factor / time_s;
-            std::pair<double, double> damped_push_offset(moved.first * damping_multiplier, moved.second * damping_multiplier);
+        // Currently set to zero damping as it seems we don't need them for now
+        double damping_factor = 0.0;
+        std::pair<double, double> damped_push_offset(moved.first * -damping_factor, moved.second * -damping_factor);
 
-            push.first += damped_push_offset.first;
-            push.second += damped_push_offset.second;
-        }
+        push.first += damped_push_offset.first;
+        push.second += damped_push_offset.second;
 
-        joystick_x = (uint8_t) std::max(std::min(int(push.first + 0.5) + 128, 255), 0);
-        joystick_y = (uint8_t) std::max(std::min(int(push.second + 0.5) + 128, 255), 0);
+        uint8_t new_joystick_x = (uint8_t) std::max(std::min(int(push.first + 0.5) + 128, 255), 0);
+        uint8_t new_joystick_y = (uint8_t) std::max(std::min(int(push.second + 0.5) + 128, 255), 0);
         // console.log("joystick push " + std::to_string(joystick_x) + ", " + std::to_string(joystick_y));
 
+        WallClock now = current_time();
+        bool changed = new_joystick_x != joystick_x || new_joystick_y != joystick_y;
+        if (now - last_dispatch < (changed ? min_dispatch_period : max_dispatch_period)){
+            continue;
+        }
+        joystick_x = new_joystick_x;
+        joystick_y = new_joystick_y;
+        last_dispatch = now;
+
         // Dispatch a new series of commands that overwrites the last ones
-        move_session.dispatch([&](BotBaseContext& context){
+        move_session.dispatch([pressing_A, joystick_x, joystick_y](BotBaseContext& context){
             if (pressing_A){
-                // Note: joystick_x and joystick_y must be defined to outlive `move_session`.
 //                pbf_controller_state(context, BUTTON_A, DPAD_NONE, joystick_x, joystick_y, 128, 128, 20);
                 ssf_press_button(context, BUTTON_A, 0, 1000, 0);
             }
             pbf_move_left_joystick(context, joystick_x, joystick_y, 20, 0);
         });
         
-        console.log("Moved joystick");
-
-        last_loc = cur_loc;
-        last_time = cur_time;
-        context.wait_for(std::chrono::milliseconds(80));
+        console.log(
+            "Hand location: " + std::to_string(cur_loc.first) + ", " + std::to_string(cur_loc.second)
+            + ". Moved joystick"
+        );
     }
 }
 
@@ -865,25 +885,24 @@ void run_sandwich_maker(SingleSwitchProgramEnvironment& env, BotBaseContext& con
     std::vector<std::string> bowl_order;
 
     //Get 3 default labels
-    ImageRGB32 image_center_label = to_blackwhite_rgb32_range(
-        extract_box_reference(screen, center_bowl_label),
-        combine_rgb(215, 215, 215), combine_rgb(255, 255, 255), true
-    );
-    ImageRGB32 image_left_label = to_blackwhite_rgb32_range(
-        extract_box_reference(screen, left_bowl_label),
-        combine_rgb(215, 215, 215), combine_rgb(255, 255, 255), true
-    );
-    ImageRGB32 image_right_label = to_blackwhite_rgb32_range(
-        extract_box_reference(screen, right_bowl_label),
-        combine_rgb(215, 215, 215), combine_rgb(255, 255, 255), true
-    );
+    //The labels are independent of each other. Read them all at once.
+    const ImageFloatBox* default_labels[] = {&center_bowl_label, &left_bowl_label, &right_bowl_label};
+    OCR::StringMatchResult default_results[3];
+    env.inference_dispatcher().run_in_parallel(0, 3, [&](size_t index){
+        ImageRGB32 image_label = to_blackwhite_rgb32_range(
+            extract_box_reference(screen, *default_labels[index]),
+            combine_rgb(215, 215, 215), combine_rgb(255, 255, 255), true
+        );
+        OCR::StringMatchResult& label_result = default_results[index];
+        label_result = PokemonSV::SandwichFillingOCR::instance().read_substring(
+            env.console, SANDWICH_OPTIONS.LANGUAGE, image_label,
+            OCR::BLACK_TEXT_FILTERS()
+        );
+        label_result.clear_beyond_log10p(SandwichFillingOCR::MAX_LOG10P);
+        label_result.clear_beyond_spread(SandwichFillingOCR::MAX_LOG10P_SPREAD);
+    });
 
-    OCR::StringMatchResult result = PokemonSV::SandwichFillingOCR::instance().read_substring(
-        env.console, SANDWICH_OPTIONS.LANGUAGE, image_center_label,
-        OCR::BLACK_TEXT_FILTERS()
-    );
-    result.clear_beyond_log10p(SandwichFillingOCR::MAX_LOG10P);
-    result.clear_beyond_spread(SandwichFillingOCR::MAX_LOG10P_SPREAD);
+    OCR::StringMatchResult result = std::move(default_results[0]);
     if (result.results.empty()) {
         throw OperationFailedException(
             ErrorReport::SEND_ERROR_REPORT, env.console,
@@ -897,12 +916,7 @@ void run_sandwich_maker(SingleSwitchProgramEnvironment& env, BotBaseContext& con
         bowl_order.push_back(r.second.token);
     }
     //Get left (2nd) ingredient
-    result = PokemonSV::SandwichFillingOCR::instance().read_substring(
-        env.console, SANDWICH_OPTIONS.LANGUAGE, image_left_label,
-        OCR::BLACK_TEXT_FILTERS()
-    );
-    result.clear_beyond_log10p(SandwichFillingOCR::MAX_LOG10P);
-    result.clear_beyond_spread(SandwichFillingOCR::MAX_LOG10P_SPREAD);
+    result = std::move(default_results[1]);
     if (result.results.empty()) {
         env.log("No ingredient found on left label.", COLOR_BLACK);
         env.console.overlay().add_log("No ingredient found on left label.", COLOR_WHITE);
@@ -913,12 +927,7 @@ void run_sandwich_maker(SingleSwitchProgramEnvironment& env, BotBaseContext& con
         bowl_order.push_back(r.second.token);
     }
     //Get right (3rd) ingredient
-    result = PokemonSV::SandwichFillingOCR::instance().read_substring(
-        env.console, SANDWICH_OPTIONS.LANGUAGE, image_right_label,
-        OCR::BLACK_TEXT_FILTERS()
-    );
-    result.clear_beyond_log10p(SandwichFillingOCR::MAX_LOG10P);
-    result.clear_beyond_spread(SandwichFillingOCR::MAX_LOG10P_SPREAD);
+    result = std::move(default_results[2]);
     if (result.results.empty()) {
         env.log("No ingredient found on right label.", COLOR_BLACK);
         env.console.overlay().add_log("No ingredient found on right label.", COLOR_WHITE);
@@ -932,24 +941,33 @@ void run_sandwich_maker(SingleSwitchProgramEnvironment& env, BotBaseContext& con
     //center 1, left 2, right 3, far left 4, far far left/right 5, right 6
     //this differs from the game layout: far right is 5 and far far left/right is 6 in game
     //however as long as we stay internally consistent with this numbering it will work
+    //Scrolling has to happen one bowl at a time, but the reads don't depend on
+    //each other. Grab every side label first, then read them all at once.
+    std::vector<ImageRGB32> side_labels;
     for (int i = 0; i < (bowls - 3); i++) {
         pbf_press_button(context, BUTTON_R, 20, 80);
         pbf_wait(context, 100);
         context.wait_for_all_requests();
 
         VideoSnapshot screen2 = env.console.video().snapshot();
-        ImageRGB32 image_side_label = to_blackwhite_rgb32_range(
+        side_labels.emplace_back(to_blackwhite_rgb32_range(
             extract_box_reference(screen2, left_bowl_label),
             combine_rgb(215, 215, 215), combine_rgb(255, 255, 255), true
-        );
-        //image_side_label.save("./image_side_label.png");
-
-        result = PokemonSV::SandwichFillingOCR::instance().read_substring(
-            env.console, SANDWICH_OPTIONS.LANGUAGE, image_side_label,
+        ));
+        //side_labels.back().save("./image_side_label.png");
+    }
+    std::vector<OCR::StringMatchResult> side_results(side_labels.size());
+    env.inference_dispatcher().run_in_parallel(0, side_labels.size(), [&](size_t index){
+        OCR::StringMatchResult& label_result = side_results[index];
+        label_result = PokemonSV::SandwichFillingOCR::instance().read_substring(
+            env.console, SANDWICH_OPTIONS.LANGUAGE, side_labels[index],
             OCR::BLACK_TEXT_FILTERS()
         );
-        result.clear_beyond_log10p(SandwichFillingOCR::MAX_LOG10P);
-        result.clear_beyond_spread(SandwichFillingOCR::MAX_LOG10P_SPREAD);
+        label_result.clear_beyond_log10p(SandwichFillingOCR::MAX_LOG10P);
+        label_result.clear_beyond_spread(SandwichFillingOCR::MAX_LOG10P_SPREAD);
+    });
+    for (OCR::StringMatchResult& side_result : side_results) {
+        result = std::move(side_result);
         if (result.results.empty()) {
             env.log("No ingredient found on side label.", COLOR_BLACK);
             env.console.overlay().add_log("No ingredient found on side label.", COLOR_WHITE);
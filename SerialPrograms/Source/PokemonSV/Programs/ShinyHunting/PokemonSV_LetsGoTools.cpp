@@ -200,7 +200,8 @@ bool LetsGoEncounterBotTracker::process_battle(EncounterWatcher& watcher, Encoun
         {{slugs, is_shiny ? ShinyType::UNKNOWN_SHINY : ShinyType::NOT_SHINY}},
         watcher.lowest_error_coefficient(),
         watcher.shiny_screenshot(),
-        &m_encounter_frequencies
+        &m_encounter_frequencies,
+        &m_console.logger()
     );
 
     //  Set default action: stop program if shiny, otherwise run away.
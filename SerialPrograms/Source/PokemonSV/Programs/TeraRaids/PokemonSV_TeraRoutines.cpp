@@ -631,7 +631,7 @@ TeraResult run_tera_summary(
             false, true,
             {{{}, ShinyType::UNKNOWN_SHINY}},
             std::nan(""),
-            battle_screenshot
+            battle_screenshot, nullptr, &console.logger()
         );
         if (stop_on_shiny){
             throw ProgramFinishedException();
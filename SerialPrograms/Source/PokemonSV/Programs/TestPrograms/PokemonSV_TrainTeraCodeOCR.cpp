@@ -0,0 +1,53 @@
+/*  Train Tera Code OCR
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/Tools/ProgramEnvironment.h"
+#include "Pokemon/Pokemon_Strings.h"
+#include "PokemonSV/Inference/Tera/PokemonSV_TeraCodeReader.h"
+#include "PokemonSV_TrainTeraCodeOCR.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+
+using namespace Pokemon;
+
+
+TrainTeraCodeOCR_Descriptor::TrainTeraCodeOCR_Descriptor()
+    : ComputerProgramDescriptor(
+        "PokemonSV:TrainTeraCodeOCR",
+        STRING_POKEMON + " SV", "Train Tera Code OCR",
+        "",
+        "Generate the character templates for reading Tera raid codes."
+    )
+{}
+
+
+
+TrainTeraCodeOCR::TrainTeraCodeOCR()
+    : DIRECTORY(
+        false,
+        "<b>Training Data Directory:</b> (Relative to \"TrainingData/\")<br>"
+        "Each image is named after the code in it. (e.g. \"5ABC8J-001.png\")",
+        LockWhileRunning::LOCKED,
+        "TeraCodeOCR/",
+        "TeraCodeOCR/"
+    )
+{
+    PA_ADD_OPTION(DIRECTORY);
+}
+
+
+
+void TrainTeraCodeOCR::program(ProgramEnvironment& env, CancellableScope& scope){
+    generate_code_glyph_templates(env.logger(), scope, DIRECTORY);
+}
+
+
+
+}
+}
+}
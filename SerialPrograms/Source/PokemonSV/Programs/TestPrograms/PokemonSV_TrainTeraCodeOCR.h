@@ -0,0 +1,40 @@
+/*  Train Tera Code OCR
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_TrainTeraCodeOCR_H
+#define PokemonAutomation_PokemonSV_TrainTeraCodeOCR_H
+
+#include "Common/Cpp/Options/StringOption.h"
+#include "ComputerPrograms/ComputerProgram.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+
+
+class TrainTeraCodeOCR_Descriptor : public ComputerProgramDescriptor{
+public:
+    TrainTeraCodeOCR_Descriptor();
+};
+
+
+
+class TrainTeraCodeOCR : public ComputerProgramInstance{
+public:
+    TrainTeraCodeOCR();
+
+    virtual void program(ProgramEnvironment& env, CancellableScope& scope) override;
+
+private:
+    StringOption DIRECTORY;
+};
+
+
+
+}
+}
+}
+#endif
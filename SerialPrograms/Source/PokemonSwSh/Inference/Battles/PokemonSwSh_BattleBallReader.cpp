@@ -5,9 +5,10 @@
  */
 
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
-#include "CommonFramework/ImageTools/ImageFilter.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/OCR/OCR_NumberReader.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 //#include "CommonFramework/OCR/OCR_StringNormalization.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
 #include "PokemonSwSh/Resources/PokemonSwSh_PokeballSprites.h"
@@ -107,12 +108,21 @@ std::string BattleBallReader::read_ball(const ImageViewRGB32& screen) const{
     }
     return overlap[0];
 }
+//  Templates for the digits of the ball quantity. If these are missing, the
+//  quantity goes to Tesseract instead.
+const OCR::GlyphClassifier& BALL_QUANTITY_GLYPHS(){
+    static OCR::GlyphClassifier glyphs = OCR::GlyphClassifier::load_optional(
+        RESOURCE_PATH() + "PokemonSwSh/BallQuantityGlyphs.json"
+    );
+    return glyphs;
+}
+
 uint16_t BattleBallReader::read_quantity(const ImageViewRGB32& screen) const{
-    ImageRGB32 image = to_blackwhite_rgb32_range(
-        extract_box_reference(screen, m_box_quantity),
-        0xff808080, 0xffffffff, true
+    int qty = OCR::read_number(
+        m_console, extract_box_reference(screen, m_box_quantity),
+        BALL_QUANTITY_GLYPHS(),
+        0xff808080, 0xffffffff
     );
-    int qty = OCR::read_number(m_console, image);
     return (uint16_t)std::max(qty, 0);
 }
 
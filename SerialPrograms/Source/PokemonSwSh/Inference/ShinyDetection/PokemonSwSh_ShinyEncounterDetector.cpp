@@ -73,7 +73,7 @@ bool ShinyEncounterTracker::process_frame(const VideoSnapshot& frame){
     case EncounterState::BEFORE_ANYTHING:
         break;
     case EncounterState::WILD_ANIMATION:
-        m_best_wild.add_frame(frame.frame, m_sparkles);
+        m_best_wild.add_frame(frame.full_frame(), m_sparkles);
         break;
     case EncounterState::YOUR_ANIMATION:
         break;
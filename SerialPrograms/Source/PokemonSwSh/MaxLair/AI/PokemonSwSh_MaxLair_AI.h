@@ -11,6 +11,7 @@
 #include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
 
 namespace PokemonAutomation{
+    class AsyncDispatcher;
 namespace NintendoSwitch{
 namespace PokemonSwSh{
 namespace MaxLairInternal{
@@ -34,7 +35,7 @@ int8_t select_starter(
 //  1 for 2nd from left.
 //  2 ...
 std::vector<PathNode> select_path(
-    Logger& logger,
+    Logger& logger, AsyncDispatcher& dispatcher,
     const GlobalState& state,
     size_t player_index
 );
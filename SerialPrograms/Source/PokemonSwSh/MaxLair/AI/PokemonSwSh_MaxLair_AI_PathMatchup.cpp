@@ -4,6 +4,8 @@
  *
  */
 
+#include <array>
+#include <algorithm>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -20,17 +22,49 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+static constexpr size_t TYPE_COUNT = (size_t)PokemonType::FAIRY + 1;
+using TypeScores = std::array<double, TYPE_COUNT>;
+
+
 struct PathMatchDatabase{
     std::map<PokemonType, std::set<std::string>> rentals_by_type;
-    std::map<std::string, std::map<PokemonType, double>> type_vs_boss;
+
+    //  Indexed by the PkmnLib id of the boss minus the number of rentals.
+    size_t rentals;
+    std::vector<TypeScores> type_vs_boss;
+    std::vector<bool> has_boss;
+
+    //  Average over all the bosses that have the type. Indexed by the type.
+    //  NONE is the average over all bosses.
+    TypeScores type_vs_boss_type[TYPE_COUNT];
+    bool has_boss_type[TYPE_COUNT];
 
     static const PathMatchDatabase& instance(){
         static PathMatchDatabase database;
         return database;
     }
 
+    const TypeScores& boss_scores(const std::string& boss_slug) const{
+        const std::map<std::string, papkmnlib::Pokemon>& all_bosses = papkmnlib::all_boss_pokemon();
+        auto iter = all_bosses.find(boss_slug);
+        if (iter == all_bosses.end() || !has_boss[iter->second.id() - rentals]){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
+        }
+        return type_vs_boss[iter->second.id() - rentals];
+    }
+    const TypeScores& boss_scores(PokemonType boss_type) const{
+        if ((size_t)boss_type >= TYPE_COUNT || !has_boss_type[(size_t)boss_type]){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss Type: " + std::to_string((int)boss_type));
+        }
+        return type_vs_boss_type[(size_t)boss_type];
+    }
+
 private:
-    PathMatchDatabase(){
+    PathMatchDatabase()
+        : rentals(papkmnlib::all_rental_pokemon().size())
+        , type_vs_boss(papkmnlib::all_boss_pokemon().size())
+        , has_boss(papkmnlib::all_boss_pokemon().size(), false)
+    {
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/path_tree.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.get_object_throw(path);
@@ -50,9 +84,17 @@ private:
             }
         }
 
+        const std::map<std::string, papkmnlib::Pokemon>& all_bosses = papkmnlib::all_boss_pokemon();
         JsonObject& node = root.get_object_throw("base_node", path).get_object_throw("hash_table");
         for (auto& item : node){
-            std::map<PokemonType, double>& boss = type_vs_boss[item.first];
+            auto boss_iter = all_bosses.find(item.first);
+            if (boss_iter == all_bosses.end()){
+                continue;
+            }
+            size_t index = boss_iter->second.id() - rentals;
+            TypeScores& boss = type_vs_boss[index];
+            boss.fill(0);
+            has_boss[index] = true;
 
             JsonObject& obj = item.second.get_object_throw(path).get_object_throw("hash_table", path);
 
@@ -60,12 +102,37 @@ private:
                 if (type.first == PokemonType::NONE){
                     continue;
                 }
-                boss[type.first] = obj.get_double_throw(type.second, path);
+                boss[(size_t)type.first] = obj.get_double_throw(type.second, path);
             }
         }
-    }
-
 
+        //  Average over the bosses of each type.
+        for (size_t boss_type = 0; boss_type < TYPE_COUNT; boss_type++){
+            papkmnlib::Type pkmnlib_type = papkmnlib::serial_type_to_pkmnlib((PokemonType)boss_type);
+            TypeScores& weight = type_vs_boss_type[boss_type];
+            weight.fill(0);
+            has_boss_type[boss_type] = true;
+            size_t count = 0;
+            for (const auto& item : all_bosses_by_dex()){
+                const papkmnlib::Pokemon& boss = papkmnlib::get_pokemon(item.second);
+                if ((PokemonType)boss_type != PokemonType::NONE && !boss.has_type(pkmnlib_type)){
+                    continue;
+                }
+                size_t index = boss.id() - rentals;
+                if (boss.id() < rentals || !has_boss[index]){
+                    has_boss_type[boss_type] = false;
+                    break;
+                }
+                for (size_t type = 0; type < TYPE_COUNT; type++){
+                    weight[type] += type_vs_boss[index][type];
+                }
+                count++;
+            }
+            for (double& item : weight){
+                item /= (double)count;
+            }
+        }
+    }
 };
 
 
@@ -78,37 +145,17 @@ const std::set<std::string>& rentals_by_type(PokemonType type){
     return iter->second;
 }
 
-double type_vs_boss(PokemonType type, const std::string& boss_slug){
-    const PathMatchDatabase& database = PathMatchDatabase::instance();
-
-    auto iter0 = database.type_vs_boss.find(boss_slug);
-    if (iter0 == database.type_vs_boss.end()){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
-    }
-
-    auto iter1 = iter0->second.find(type);
-    if (iter1 == iter0->second.end()){
+double type_score(const TypeScores& scores, PokemonType type){
+    if (type == PokemonType::NONE || (size_t)type >= TYPE_COUNT){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-
-    return iter1->second;
+    return scores[(size_t)type];
+}
+double type_vs_boss(PokemonType type, const std::string& boss_slug){
+    return type_score(PathMatchDatabase::instance().boss_scores(boss_slug), type);
 }
 double type_vs_boss(PokemonType type, PokemonType boss_type){
-    using namespace papkmnlib;
-
-    Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
-
-    double weight = 0;
-    size_t count = 0;
-    for (const auto& item : all_bosses_by_dex()){
-        const Pokemon& boss = get_pokemon(item.second);
-        if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
-            weight += type_vs_boss(type, boss.name());
-            count++;
-        }
-    }
-
-    return weight / (double)count;
+    return type_score(PathMatchDatabase::instance().boss_scores(boss_type), type);
 }
 
 
@@ -123,22 +170,29 @@ double type_vs_boss(PokemonType type, PokemonType boss_type){
 
 
 
-void append_subpath(
-    std::vector<std::vector<PathNode>>& paths,
+static void append_subpath(
+    std::vector<CompactPath>& paths,
     const PathNode& node,
-    const std::vector<std::vector<PathNode>>& subpaths
+    const std::vector<CompactPath>& subpaths
 ){
-    for (const auto& item : subpaths){
-        paths.emplace_back();
-        std::vector<PathNode>& path = paths.back();
-        path.emplace_back(node);
-        path.insert(path.end(), item.begin(), item.end());
+    for (const CompactPath& item : subpaths){
+        CompactPath path;
+        path.length = item.length + 1;
+        path.nodes[0] = node;
+        std::copy(item.begin(), item.end(), path.nodes + 1);
+        paths.emplace_back(path);
     }
 }
-std::vector<std::vector<PathNode>> generate_paths(
+static void append_node(std::vector<CompactPath>& paths, const PathNode& node){
+    CompactPath path;
+    path.length = 1;
+    path.nodes[0] = node;
+    paths.emplace_back(path);
+}
+std::vector<CompactPath> generate_paths(
     const PathMap& map, uint8_t wins, int8_t side
 ){
-    std::vector<std::vector<PathNode>> ret;
+    std::vector<CompactPath> ret;
 
     if (wins == 0){
         append_subpath(ret, {0, map.mon1[0]}, generate_paths(map, 1, 0));
@@ -151,8 +205,8 @@ std::vector<std::vector<PathNode>> generate_paths(
     }
 
     if (wins == 1){
-        std::vector<std::vector<PathNode>> left = generate_paths(map, 2, 0);
-        std::vector<std::vector<PathNode>> right = generate_paths(map, 2, 1);
+        std::vector<CompactPath> left = generate_paths(map, 2, 0);
+        std::vector<CompactPath> right = generate_paths(map, 2, 1);
         switch (map.path_type){
         case 0:
             if (side == 0){
@@ -191,32 +245,32 @@ std::vector<std::vector<PathNode>> generate_paths(
         switch (map.path_type){
         case 0:
             if (side == 0){
-                ret.emplace_back(std::vector<PathNode>{PathNode{0, map.mon3[0]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{1, map.mon3[1]}});
+                append_node(ret, {0, map.mon3[0]});
+                append_node(ret, {1, map.mon3[1]});
             }else{
-                ret.emplace_back(std::vector<PathNode>{PathNode{0, map.mon3[1]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{1, map.mon3[2]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{2, map.mon3[3]}});
+                append_node(ret, {0, map.mon3[1]});
+                append_node(ret, {1, map.mon3[2]});
+                append_node(ret, {2, map.mon3[3]});
             }
             break;
         case 1:
             if (side == 0){
-                ret.emplace_back(std::vector<PathNode>{PathNode{0, map.mon3[0]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{1, map.mon3[1]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{2, map.mon3[2]}});
+                append_node(ret, {0, map.mon3[0]});
+                append_node(ret, {1, map.mon3[1]});
+                append_node(ret, {2, map.mon3[2]});
             }else{
-                ret.emplace_back(std::vector<PathNode>{PathNode{0, map.mon3[2]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{1, map.mon3[3]}});
+                append_node(ret, {0, map.mon3[2]});
+                append_node(ret, {1, map.mon3[3]});
             }
             break;
         case 2:
             if (side == 0){
-                ret.emplace_back(std::vector<PathNode>{PathNode{0, map.mon3[0]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{1, map.mon3[1]}});
+                append_node(ret, {0, map.mon3[0]});
+                append_node(ret, {1, map.mon3[1]});
             }else{
-                ret.emplace_back(std::vector<PathNode>{PathNode{0, map.mon3[1]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{1, map.mon3[2]}});
-                ret.emplace_back(std::vector<PathNode>{PathNode{2, map.mon3[3]}});
+                append_node(ret, {0, map.mon3[1]});
+                append_node(ret, {1, map.mon3[2]});
+                append_node(ret, {2, map.mon3[3]});
             }
             break;
         }
@@ -227,18 +281,17 @@ std::vector<std::vector<PathNode>> generate_paths(
 }
 
 
-template <typename Boss>
-double evaluate_path(const Boss& boss, const std::vector<PathNode>& path){
-    if (path.size() > 3){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Path is longer than 3: " + std::to_string(path.size()));
+double evaluate_path(const TypeScores& boss, const CompactPath& path){
+    if (path.length > 3){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Path is longer than 3: " + std::to_string(path.length));
     }
     const double weights[] = {1, 2, 3};
     double weight = 0;
 
-    size_t battle_index = 3 - path.size();
+    size_t battle_index = 3 - path.length;
     size_t node_index = 0;
     for (; battle_index < 3; node_index++, battle_index++){
-        weight += type_vs_boss(path[node_index].type, boss) * weights[battle_index];
+        weight += type_score(boss, path.nodes[node_index].type) * weights[battle_index];
     }
     return weight;
 }
@@ -254,7 +307,7 @@ std::vector<PathNode> select_path(
 //        return {};
 //    }
 
-    std::vector<std::vector<PathNode>> paths = generate_paths(pathmap, wins, path_side);
+    std::vector<CompactPath> paths = generate_paths(pathmap, wins, path_side);
     if (paths.empty()){
         if (logger){
             logger->log("No available paths due to read errors.", COLOR_RED);
@@ -262,28 +315,27 @@ std::vector<PathNode> select_path(
         return {};
     }
 
-    std::multimap<double, std::vector<PathNode>, std::greater<double>> rank;
-    if (boss.empty()){
-        for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(pathmap.boss, path), path);
-        }
-    }else{
-        for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(boss, path), path);
-        }
+    const PathMatchDatabase& database = PathMatchDatabase::instance();
+    const TypeScores& boss_scores = boss.empty()
+        ? database.boss_scores(pathmap.boss)
+        : database.boss_scores(boss);
+
+    std::multimap<double, CompactPath, std::greater<double>> rank;
+    for (const CompactPath& path : paths){
+        rank.emplace(evaluate_path(boss_scores, path), path);
     }
     std::string str = "Available Paths:\n";
     for (const auto& path : rank){
         str += std::to_string(path.first);
         str += " : ";
-        str += dump_path(path.second);
+        str += dump_path(path.second.to_vector());
         str += "\n";
     }
     if (logger){
         logger->log(str);
     }
 
-    return std::move(rank.begin()->second);
+    return rank.begin()->second.to_vector();
 }
 
 
@@ -26,7 +26,18 @@ double type_vs_boss(PokemonType type, PokemonType boss_type);
 
 
 
-std::vector<std::vector<PathNode>> generate_paths(
+//  A path from the current position to the boss. At most 3 nodes so it is
+//  stored inline. Copying one is just a few bytes.
+struct CompactPath{
+    uint8_t length = 0;
+    PathNode nodes[3];
+
+    const PathNode* begin() const{ return nodes; }
+    const PathNode* end() const{ return nodes + length; }
+    std::vector<PathNode> to_vector() const{ return std::vector<PathNode>(begin(), end()); }
+};
+
+std::vector<CompactPath> generate_paths(
     const PathMap& map, uint8_t wins, int8_t side
 );
 
@@ -0,0 +1,185 @@
+/*  Max Lair AI Path Search
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <set>
+#include <map>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "PokemonSwSh_MaxLair_AI_Tools.h"
+#include "PokemonSwSh_MaxLair_AI_PathSearch.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace MaxLairInternal{
+
+
+namespace{
+
+struct TeamSlot{
+    double score;       //  Matchup against the boss candidates.
+    double hp_factor;
+    double npc_factor;
+};
+
+double team_value(const TeamSlot team[4]){
+    double total = 0;
+    for (size_t c = 0; c < 4; c++){
+        total += team[c].score * team[c].hp_factor * team[c].npc_factor;
+    }
+    return total;
+}
+
+
+struct Candidate{
+    uint16_t id;    //  Same rental, same id. Across all nodes.
+    double score;
+};
+
+struct PathSearchContext{
+    //  Everything that can be caught at each node.
+    std::vector<Candidate> candidates[3];
+    size_t player_index = 0;
+    uint8_t length = 0;
+    WallClock deadline;
+    bool timed_out = false;
+};
+
+//  "caught" holds the ids of what was caught at the nodes before "node".
+double expectimax(PathSearchContext& context, size_t node, const TeamSlot team[4], const uint16_t caught[3]){
+    if (node >= context.length){
+        return team_value(team);
+    }
+    if (context.timed_out || current_time() > context.deadline){
+        context.timed_out = true;
+        return 0;
+    }
+
+    double sum = 0;
+    size_t count = 0;
+    for (const Candidate& candidate : context.candidates[node]){
+        //  The same rental doesn't show up twice in one adventure.
+        if (std::find(caught, caught + node, candidate.id) != caught + node){
+            continue;
+        }
+        uint16_t next_caught[3] = {caught[0], caught[1], caught[2]};
+        next_caught[node] = candidate.id;
+
+        //  Only our own player decides whether to take what was caught.
+        double keep = expectimax(context, node + 1, team, next_caught);
+        TeamSlot hypothetical[4] = {team[0], team[1], team[2], team[3]};
+        hypothetical[context.player_index].score = candidate.score;
+        hypothetical[context.player_index].hp_factor = 1;
+        double swap = expectimax(context, node + 1, hypothetical, next_caught);
+
+        sum += std::max(keep, swap);
+        count++;
+    }
+    if (count == 0){
+        return expectimax(context, node + 1, team, caught);
+    }
+    return sum / (double)count;
+}
+
+}
+
+
+
+std::vector<PathSearchResult> search_paths(
+    AsyncDispatcher& dispatcher,
+    const GlobalState& state,
+    const std::vector<CompactPath>& paths,
+    size_t player_index,
+    std::chrono::milliseconds time_limit
+){
+    using namespace papkmnlib;
+
+    WallClock deadline = current_time() + time_limit;
+
+    if (player_index >= 4){
+        return {};
+    }
+
+    std::vector<const Pokemon*> bosses = get_boss_candidates(state);
+    if (bosses.empty()){
+        return {};
+    }
+
+    double lives = state.lives_left < 0 ? 4 : std::max<double>(state.lives_left, 1);
+    double average = rental_vs_boss_matchup(nullptr, bosses);
+
+    TeamSlot team[4];
+    double baseline = 0;
+    std::set<std::string> exclusions = state.seen;
+    for (size_t c = 0; c < 4; c++){
+        const PlayerState& player = state.players[c];
+        TeamSlot& slot = team[c];
+        slot.npc_factor = player.console_id < 0 ? 0.5 : 1.0;
+        baseline += average * slot.npc_factor;
+        if (player.pokemon.empty()){
+            slot.score = average;
+            slot.hp_factor = 1;
+            continue;
+        }
+        exclusions.insert(player.pokemon);
+        slot.score = rental_vs_boss_matchup(&get_pokemon(player.pokemon), bosses);
+        double hp = player.health.value.dead ? 0 : player.health.value.hp;
+        slot.hp_factor = hp >= 0 ? (hp + lives - 1) / lives : 1;
+    }
+
+    //  Score every rental once up front. The search only needs the numbers.
+    std::map<std::string, uint16_t> ids;
+    std::map<PokemonType, std::vector<Candidate>> candidates_by_type;
+    std::vector<PathSearchContext> contexts(paths.size());
+    for (size_t c = 0; c < paths.size(); c++){
+        PathSearchContext& context = contexts[c];
+        context.player_index = player_index;
+        context.length = paths[c].length;
+        context.deadline = deadline;
+        for (size_t i = 0; i < paths[c].length; i++){
+            PokemonType type = paths[c].nodes[i].type;
+            auto iter = candidates_by_type.find(type);
+            if (iter == candidates_by_type.end()){
+                std::vector<Candidate>& candidates = candidates_by_type[type];
+                for (const std::string& rental : rentals_by_type(type)){
+                    if (exclusions.find(rental) != exclusions.end()){
+                        continue;
+                    }
+                    uint16_t id = ids.emplace(rental, (uint16_t)ids.size()).first->second;
+                    candidates.emplace_back(Candidate{id, rental_vs_boss_matchup(&get_pokemon(rental), bosses)});
+                }
+                iter = candidates_by_type.find(type);
+            }
+            context.candidates[i] = iter->second;
+        }
+    }
+
+    std::vector<PathSearchResult> results(paths.size());
+    dispatcher.run_in_parallel(
+        0, paths.size(),
+        [&](size_t index){
+            PathSearchContext& context = contexts[index];
+            PathSearchResult& result = results[index];
+            result.path = paths[index];
+            const uint16_t caught[3] = {0, 0, 0};
+            result.score = expectimax(context, 0, team, caught);
+            result.complete = !context.timed_out;
+            if (result.score > 0){
+                result.win_probability = result.score / (result.score + baseline);
+            }
+        }
+    );
+    return results;
+}
+
+
+
+}
+}
+}
+}
@@ -0,0 +1,72 @@
+/*  Max Lair AI Path Search
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Lookahead over the remaining paths. After each battle on a path, the
+ *  team may swap one of its members for the Pokemon that was just caught.
+ *  What gets caught is random. (any rental of the node's type that hasn't
+ *  been seen yet)
+ *
+ *  For each path, this computes the expected strength of the team against
+ *  the boss when it gets there. Chance nodes average over the rentals that
+ *  can be caught, without replacement along the path. Decision nodes take the
+ *  best of keeping the team or replacing our own player's Pokemon. The other
+ *  players make their own choices, so their Pokemon are left alone.
+ *
+ *  Team strength is the same rental vs. boss matchup that the swap logic
+ *  uses. It is adjusted for HP and for NPCs.
+ *
+ *  The paths are searched in parallel. If the time limit runs out, the
+ *  unfinished paths are marked as such. The caller should then fall back to
+ *  the cheaper heuristic.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSwSh_MaxLair_AI_PathSearch_H
+#define PokemonAutomation_PokemonSwSh_MaxLair_AI_PathSearch_H
+
+#include <chrono>
+#include <vector>
+#include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
+#include "PokemonSwSh_MaxLair_AI_PathMatchup.h"
+
+namespace PokemonAutomation{
+    class AsyncDispatcher;
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace MaxLairInternal{
+
+
+struct PathSearchResult{
+    CompactPath path;
+
+    //  Expected team strength against the boss at the end of the path.
+    double score = 0;
+
+    //  Rough chance of beating the boss. The team is compared to a team of
+    //  average rentals. (Bradley-Terry) So 50% means "as good as a random
+    //  team".
+    double win_probability = 0;
+
+    //  False if the time limit ran out before this path was finished.
+    bool complete = false;
+};
+
+
+//  Returns one result for each path in the same order.
+//  Returns an empty list if nothing is known about the boss.
+std::vector<PathSearchResult> search_paths(
+    AsyncDispatcher& dispatcher,
+    const GlobalState& state,
+    const std::vector<CompactPath>& paths,
+    size_t player_index,
+    std::chrono::milliseconds time_limit
+);
+
+
+
+}
+}
+}
+}
+#endif
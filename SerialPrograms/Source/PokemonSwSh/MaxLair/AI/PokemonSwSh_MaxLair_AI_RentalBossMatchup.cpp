@@ -4,6 +4,8 @@
  *
  */
 
+#include <cmath>
+#include <limits>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -19,63 +21,113 @@ namespace MaxLairInternal{
 
 
 
+//  Flat rental x boss matrix indexed by the PkmnLib ids.
 struct MatchupDatabase{
-    std::map<std::string, std::map<std::string, double>> map;
+    size_t rentals;
+    size_t bosses;
+    std::vector<double> matrix;
+    std::vector<double> average_by_boss;    //  Over all the rentals.
 
     static const MatchupDatabase& instance(){
         static MatchupDatabase database;
         return database;
     }
 
-    double get(const std::string& rental, const std::string& boss) const{
-        auto iter0 = map.find(rental);
-        if (iter0 == map.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental);
+    double get(const papkmnlib::Pokemon& rental, const papkmnlib::Pokemon& boss) const{
+        if (rental.id() >= rentals){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental.name());
         }
-        auto iter1 = iter0->second.find(boss);
-        if (iter1 == iter0->second.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + rental);
+        size_t boss_index = boss_id(boss);
+        double score = matrix[rental.id() * bosses + boss_index];
+        if (std::isnan(score)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + boss.name());
         }
-        return iter1->second;
+        return score;
+    }
+    double average(const papkmnlib::Pokemon& boss) const{
+        double score = average_by_boss[boss_id(boss)];
+        if (std::isnan(score)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + boss.name());
+        }
+        return score;
     }
 
 private:
-    MatchupDatabase(){
+    size_t boss_id(const papkmnlib::Pokemon& boss) const{
+        if (boss.id() < rentals || boss.id() >= rentals + bosses){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + boss.name());
+        }
+        return boss.id() - rentals;
+    }
+
+    MatchupDatabase()
+        : rentals(papkmnlib::all_rental_pokemon().size())
+        , bosses(papkmnlib::all_boss_pokemon().size())
+        , matrix(rentals * bosses, std::numeric_limits<double>::quiet_NaN())
+    {
+        const std::map<std::string, papkmnlib::Pokemon>& all_rentals = papkmnlib::all_rental_pokemon();
+        const std::map<std::string, papkmnlib::Pokemon>& all_bosses = papkmnlib::all_boss_pokemon();
+
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.get_object_throw(path);
         for (auto& item0 : root){
-            std::map<std::string, double>& sub = map[item0.first];
+            auto rental = all_rentals.find(item0.first);
+            if (rental == all_rentals.end()){
+                continue;
+            }
+            double* row = &matrix[rental->second.id() * bosses];
             JsonObject& obj = item0.second.get_object_throw(path);
             for (auto& item1 : obj){
-                sub[item1.first] = item1.second.get_double_throw(path);
+                auto boss = all_bosses.find(item1.first);
+                if (boss == all_bosses.end()){
+                    continue;
+                }
+                row[boss_id(boss->second)] = item1.second.get_double_throw(path);
+            }
+        }
+
+        for (size_t boss = 0; boss < bosses; boss++){
+            double score = 0;
+            for (size_t rental = 0; rental < rentals; rental++){
+                score += matrix[rental * bosses + boss];
             }
+            average_by_boss.emplace_back(score / rentals);
         }
     }
 };
 
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
-    return MatchupDatabase::instance().get(rental, boss);
+    using namespace papkmnlib;
+    return MatchupDatabase::instance().get(get_pokemon(rental), get_pokemon(boss));
 }
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
     using namespace papkmnlib;
 
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    const Pokemon& attacker = get_pokemon(rental);
+
     double score = 0;
     if (bosses.empty()){
         const auto& all_bosses = all_boss_pokemon();
         for (const auto& boss : all_bosses){
-            score += rental_vs_boss_matchup(rental, boss.second.name());
+            score += database.get(attacker, boss.second);
         }
-        score /= bosses.size();
+        score /= all_bosses.size();
     }else{
         for (const std::string& boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss);
+            score += database.get(attacker, get_pokemon(boss));
         }
         score /= bosses.size();
     }
     return score;
 }
-
+double rental_vs_boss_matchup(const papkmnlib::Pokemon& rental, const papkmnlib::Pokemon& boss){
+    return MatchupDatabase::instance().get(rental, boss);
+}
+double average_rental_vs_boss_matchup(const papkmnlib::Pokemon& boss){
+    return MatchupDatabase::instance().average(boss);
+}
 
 
 
@@ -13,12 +13,22 @@
 namespace PokemonAutomation{
 namespace NintendoSwitch{
 namespace PokemonSwSh{
+namespace papkmnlib{
+    class Pokemon;
+}
 namespace MaxLairInternal{
 
 
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss);
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses);
 
+//  Same as above without any string lookups. "rental" and "boss" must come
+//  from the PkmnLib databases. (see papkmnlib::Pokemon::id())
+double rental_vs_boss_matchup(const papkmnlib::Pokemon& rental, const papkmnlib::Pokemon& boss);
+
+//  Average over all rentals.
+double average_rental_vs_boss_matchup(const papkmnlib::Pokemon& boss);
+
 
 
 }
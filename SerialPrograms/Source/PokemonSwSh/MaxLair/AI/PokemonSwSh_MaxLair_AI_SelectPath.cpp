@@ -5,10 +5,13 @@
  */
 
 #include <cstddef>
+#include <algorithm>
 #include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.h"
 #include "PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh_MaxLair_AI_PathSearch.h"
 
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "PokemonSwSh/PokemonSwSh_Settings.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -22,6 +25,8 @@ namespace MaxLairInternal{
 
 
 
+//  The path is chosen while the game is waiting on us.
+const std::chrono::milliseconds PATH_SEARCH_TIME_LIMIT(250);
 
 
 
@@ -29,7 +34,7 @@ namespace MaxLairInternal{
 //  1 for 2nd from left.
 //  2 ...
 std::vector<PathNode> select_path(
-    Logger& logger,
+    Logger& logger, AsyncDispatcher& dispatcher,
     const GlobalState& state,
     size_t player_index
 ){
@@ -39,11 +44,43 @@ std::vector<PathNode> select_path(
         COLOR_PURPLE
     );
 
-    std::vector<std::vector<PathNode>> paths = generate_paths(state.path, state.wins, state.path_side);
+    std::vector<CompactPath> paths = generate_paths(state.path, state.wins, state.path_side);
     if (paths.empty()){
         return {};
     }
 
+    std::vector<PathSearchResult> results;
+    if (GameSettings::instance().MAX_LAIR_PATH_SEARCH){
+        results = search_paths(dispatcher, state, paths, player_index, PATH_SEARCH_TIME_LIMIT);
+    }
+    bool complete = !results.empty();
+    for (const PathSearchResult& result : results){
+        complete &= result.complete;
+    }
+    if (complete){
+        //  Stable so that ties go to the left-most path like before.
+        std::stable_sort(
+            results.begin(), results.end(),
+            [](const PathSearchResult& x, const PathSearchResult& y){
+                return x.score > y.score;
+            }
+        );
+        std::string str = "Path Search (score : win chance : path):\n";
+        for (const PathSearchResult& result : results){
+            str += std::to_string(result.score);
+            str += " : ";
+            str += std::to_string((int)(result.win_probability * 100 + 0.5));
+            str += "% : ";
+            str += dump_path(result.path.to_vector());
+            str += "\n";
+        }
+        logger.log(str);
+        return results[0].path.to_vector();
+    }
+    if (!results.empty()){
+        logger.log("Path search ran out of time. Falling back to type matchups.", COLOR_ORANGE);
+    }
+
 //    cout << "Paths = " << paths.size() << endl;
 #if 0
     std::string str = "Available Paths:\n";
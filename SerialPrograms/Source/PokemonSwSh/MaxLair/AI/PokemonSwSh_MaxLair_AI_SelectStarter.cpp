@@ -43,11 +43,11 @@ int8_t select_starter(
         if (options[c].empty()){
             continue;
         }
-//        const Pokemon& rental = get_pokemon(options[c]);
+        const Pokemon& rental = get_pokemon(options[c]);
         double score = 0;
         for (const Pokemon* boss : bosses){
 //            score += evaluate_matchup(rental, *boss, {}, 4);
-            score += rental_vs_boss_matchup(options[c], boss->name());
+            score += rental_vs_boss_matchup(rental, *boss);
         }
         score /= bosses.size();
         rank.emplace(score, c);
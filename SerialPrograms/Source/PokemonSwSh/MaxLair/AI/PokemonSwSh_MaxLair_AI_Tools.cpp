@@ -91,30 +91,23 @@ std::vector<const papkmnlib::Pokemon*> get_boss_candidates(const GlobalState& st
 
 
 
-double rental_vs_boss_matchup(const std::string& rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
+double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
     using namespace papkmnlib;
 
     if (bosses.empty()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss list cannot be empty.");
     }
     double score = 0;
-    if (rental.empty()){
+    if (rental == nullptr){
         for (const Pokemon* boss : bosses){
-            for (const auto& candidate : all_rental_pokemon()){
-                score += rental_vs_boss_matchup(candidate.first, boss->name());
-            }
+            score += average_rental_vs_boss_matchup(*boss);
         }
-        score /= bosses.size() * all_rental_pokemon().size();
     }else{
         for (const Pokemon* boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss->name());
+            score += rental_vs_boss_matchup(*rental, *boss);
         }
-        score /= bosses.size();
     }
-    return score;
-}
-double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
-    return rental_vs_boss_matchup(rental == nullptr ? "" : rental->name(), bosses);
+    return score / bosses.size();
 }
 
 
@@ -26,6 +26,10 @@ std::vector<const papkmnlib::Pokemon*> get_rental_candidates_on_path_pkmnlib(con
 std::vector<const papkmnlib::Pokemon*> get_boss_candidates(const GlobalState& state);
 
 
+//  Average matchup against "bosses". A null rental is an average rental.
+double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<const papkmnlib::Pokemon*>& bosses);
+
+
 double evaluate_hypothetical_team(
     const GlobalState& state,
     const papkmnlib::Pokemon* team[4],
@@ -51,7 +51,7 @@ void run_path_select(
 
 
     //  Select the path.
-    std::vector<PathNode> path = select_path(console, inferred, player_index);
+    std::vector<PathNode> path = select_path(console, env.inference_dispatcher(), inferred, player_index);
     uint8_t slot;
     if (path.empty()){
         console.log("No available paths due to read errors. Picking left-most path.", COLOR_RED);
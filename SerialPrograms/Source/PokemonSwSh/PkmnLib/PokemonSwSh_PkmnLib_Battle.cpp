@@ -5,6 +5,8 @@
  */
 
 #include <set>
+#include <memory>
+#include <atomic>
 #include "PokemonSwSh_PkmnLib_Battle.h"
 
 namespace PokemonAutomation{
@@ -319,7 +321,7 @@ double terrain_damage_multiplier(const Pokemon& attacker, const Pokemon& defende
     return modifier;
 }
 
-double damage_score(
+double compute_damage_score(
     const Pokemon& attacker, const Pokemon& defender,
     size_t moveIdx, const Field& field, bool multipleTargets
 ){
@@ -436,6 +438,95 @@ double damage_score(
 }
 
 
+// the damage only depends on the database entries of the two pokemon, the attacker's dynamax
+// state and burn, the move, the field and whether there are multiple targets
+// so for pokemon straight out of the database we remember every damage that was calculated
+// the table is dense: one row of [dynamax][move][defender][multiple targets] for each
+// (field, attacker), allocated on first use
+class DamageTable{
+public:
+    static constexpr size_t FIELDS = 5 * 5;
+    static constexpr size_t MOVES = 5;
+
+    static DamageTable& instance(){
+        static DamageTable table;
+        return table;
+    }
+
+    ~DamageTable(){
+        for (size_t c = 0; c < FIELDS * m_pokemon; c++){
+            delete[] m_rows[c].load(std::memory_order_relaxed);
+        }
+    }
+
+    double get(
+        const Pokemon& attacker, const Pokemon& defender,
+        size_t moveIdx, const Field& field, bool multipleTargets
+    ){
+        size_t field_index = (size_t)field.weather() * 5 + (size_t)field.terrain();
+        std::atomic<double>* row = get_row(field_index * m_pokemon + attacker.id());
+        std::atomic<double>& entry = row[
+            ((attacker.is_dynamax() * MOVES + moveIdx) * m_pokemon + defender.id()) * 2 + multipleTargets
+        ];
+
+        // it's fine if two threads calculate the same entry at once, they get the same result
+        double damage = entry.load(std::memory_order_relaxed);
+        if (damage < 0){
+            damage = compute_damage_score(attacker, defender, moveIdx, field, multipleTargets);
+            entry.store(damage, std::memory_order_relaxed);
+        }
+        return damage;
+    }
+
+private:
+    DamageTable()
+        : m_pokemon(all_pokemon_by_id().size())
+        , m_rows(new std::atomic<std::atomic<double>*>[FIELDS * m_pokemon])
+    {
+        for (size_t c = 0; c < FIELDS * m_pokemon; c++){
+            m_rows[c].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<double>* get_row(size_t index){
+        std::atomic<double>* row = m_rows[index].load(std::memory_order_acquire);
+        if (row != nullptr){
+            return row;
+        }
+
+        size_t size = 2 * MOVES * m_pokemon * 2;
+        std::atomic<double>* new_row = new std::atomic<double>[size];
+        for (size_t c = 0; c < size; c++){
+            new_row[c].store(-1, std::memory_order_relaxed);
+        }
+        if (m_rows[index].compare_exchange_strong(row, new_row, std::memory_order_acq_rel)){
+            return new_row;
+        }
+        delete[] new_row;
+        return row;
+    }
+
+private:
+    const size_t m_pokemon;
+    std::unique_ptr<std::atomic<std::atomic<double>*>[]> m_rows;
+};
+
+
+double damage_score(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field, bool multipleTargets
+){
+    if (attacker.id() == Pokemon::NO_ID ||
+        defender.id() == Pokemon::NO_ID ||
+        moveIdx >= DamageTable::MOVES ||
+        attacker.non_volatile_status_effect() == NonVolatileStatusEffects::BURN
+    ){
+        return compute_damage_score(attacker, defender, moveIdx, field, multipleTargets);
+    }
+    return DamageTable::instance().get(attacker, defender, moveIdx, field, multipleTargets);
+}
+
+
 
 
 
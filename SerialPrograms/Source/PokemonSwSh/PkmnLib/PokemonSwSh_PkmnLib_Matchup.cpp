@@ -61,10 +61,86 @@ double calc_average_damage(
     return totalDamage / count;
 }
 
-double calc_move_score(
-    const Pokemon& attacker, Pokemon defender,
+namespace{
+
+// everything in the move score that doesn't depend on which move the attacker picks
+struct MoveScoreContext{
+    double teammateDamage;
+    double receivedRegularDamage;
+    // same as above, but the spread moves are blocked by wide guard
+    double receivedGuardedDamage;
+    double receivedMaxMoveDamage;
+
+    MoveScoreContext(
+        const Pokemon& attacker, const Pokemon& defender,
+        const std::vector<const Pokemon*>& teammates,
+        const Field& field
+    );
+};
+
+MoveScoreContext::MoveScoreContext(
+    const Pokemon& attacker, const Pokemon& defender,
     const std::vector<const Pokemon*>& teammates,
-    size_t moveIdx, const Field& field
+    const Field& field
+)
+    : receivedRegularDamage(0.0)
+    , receivedGuardedDamage(0.0)
+    , receivedMaxMoveDamage(0.0)
+{
+    // calculate the damage the teammates do against the boss
+    std::vector<const Pokemon*> tempDefenderList{&defender};
+    teammateDamage = calc_average_damage(teammates, tempDefenderList, field, false);
+
+    size_t defenderNumMoves = defender.num_moves();
+
+    //  Disable the dmax HP bonus for this calculation. This actively hurts
+    //  multiplayer mode where other players can dmax.
+//    double dmax_hp_ratio = attacker.is_dynamax() ? 2.0 : 1.0;
+    double dmax_hp_ratio = 1.0;
+
+    // first calculate damage from regular moves
+    Pokemon regularDefender = defender;
+    regularDefender.set_is_dynamax(false);
+    tempDefenderList[0] = &regularDefender;
+
+    // the damage to the teammates is the same for every move of the defender
+    double teammateSpreadDamage = calc_average_damage(tempDefenderList, teammates, field, true);
+    double teammateSingleDamage = calc_average_damage(tempDefenderList, teammates, field, false);
+
+    // iterate through defender moves for non-dynamax
+    for (size_t ii = 0; ii < defenderNumMoves; ii++){
+        const Move& defenderMove = regularDefender.move(ii);
+        // NOTE: original function in python also checked to make sure we aren't dynamax, we already did that
+        if (defenderMove.is_spread()){
+            receivedRegularDamage += damage_score(regularDefender, attacker, ii, field, true) / defenderNumMoves;
+            receivedRegularDamage += 3 * teammateSpreadDamage / defenderNumMoves;
+        }else{
+            double damage = 0.25 * damage_score(regularDefender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
+            double teammate = 0.75 * teammateSingleDamage / defenderNumMoves;
+            receivedRegularDamage += damage;
+            receivedRegularDamage += teammate;
+            receivedGuardedDamage += damage;
+            receivedGuardedDamage += teammate;
+        }
+    }
+//    cout << "receivedRegularDamage = " << receivedRegularDamage << endl;
+
+    // then set up for max moves
+    Pokemon maxDefender = defender;
+    maxDefender.set_is_dynamax(true);
+    tempDefenderList[0] = &maxDefender;
+    teammateSingleDamage = calc_average_damage(tempDefenderList, teammates, field, false);
+    for (size_t ii = 0; ii < defenderNumMoves; ii++){
+        receivedMaxMoveDamage += 0.25 * damage_score(maxDefender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
+        receivedMaxMoveDamage += 0.75 * teammateSingleDamage / defenderNumMoves;
+    }
+//    cout << "receivedMaxMoveDamage = " << receivedMaxMoveDamage << endl;
+}
+
+double calc_move_score(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field,
+    const MoveScoreContext& context
 ){
     // this function is different than the one above
     // it will give a score for a single move based on several different factors
@@ -80,62 +156,23 @@ double calc_move_score(
 
     // fudge factor is available based on AI decisions
     double fudgeFactor = 1.5;
-    std::vector<const Pokemon*> tempDefenderList{&defender};
     // calculate the damage the teammates do against the boss
-    damageScore += (1.5 * fudgeFactor) * calc_average_damage(teammates, tempDefenderList, field, false);
+    damageScore += (1.5 * fudgeFactor) * context.teammateDamage;
 
     // TODO: implement status moves contributions, since all NonVolatile ones are pretty good
 
     // estimate potential received damage
-    double receivedDamage = 0.0;
-    double receivedRegularDamage = 0.0;
-    double receivedMaxMoveDamage = 0.0;
     double maxMoveProbability = 0.3; // TODO: we need hard data for this guy eventually
-    size_t defenderNumMoves = defender.num_moves();
 
     // get the attacker move
     const Move& attackerMove = attacker.move(moveIdx);
 
-    bool originalDefenderDynamax = defender.is_dynamax();
-    // first calculate damage from regular moves
-    defender.set_is_dynamax(false);
-    // replace it
-    tempDefenderList[0] = &defender;
-
-    //  Disable the dmax HP bonus for this calculation. This actively hurts
-    //  multiplayer mode where other players can dmax.
-//    double dmax_hp_ratio = attacker.is_dynamax() ? 2.0 : 1.0;
-    double dmax_hp_ratio = 1.0;
-
-    // iterate through defender moves for non-dynamax
-    for (size_t ii = 0; ii < defenderNumMoves; ii++){
-        const Move& defenderMove = defender.move(ii);
-        // NOTE: original function in python also checked to make sure we aren't dynamax, we already did that
-        if (defenderMove.is_spread()){
-            if (attackerMove != "wide-guard" || attacker.is_dynamax()){
-                receivedRegularDamage += damage_score(defender, attacker, ii, field, true) / defenderNumMoves;
-                receivedRegularDamage += 3 * calc_average_damage(tempDefenderList, teammates, field, true) / defenderNumMoves;
-            }
-        }else{
-            receivedRegularDamage += 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
-            receivedRegularDamage += 0.75 * calc_average_damage(tempDefenderList, teammates, field, false) / defenderNumMoves;
-        }
-    }
-//    cout << "receivedRegularDamage = " << receivedRegularDamage << endl;
-
-    // then set up for max moves
-    defender.set_is_dynamax(true);
-    tempDefenderList[0] = &defender;
-    for (size_t ii = 0; ii < defenderNumMoves; ii++){
-        receivedMaxMoveDamage += 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
-        receivedMaxMoveDamage += 0.75 * calc_average_damage(tempDefenderList, teammates, field, false) / defenderNumMoves;
-    }
-//    cout << "receivedMaxMoveDamage = " << receivedMaxMoveDamage << endl;
-
-    // at the end restore defender dynamax state
-    defender.set_is_dynamax(originalDefenderDynamax);
+    // wide guard blocks the spread moves unless we're dynamaxed
+    double receivedRegularDamage = attackerMove != "wide-guard" || attacker.is_dynamax()
+        ? context.receivedRegularDamage
+        : context.receivedGuardedDamage;
 
-    receivedDamage = receivedRegularDamage * (1 - maxMoveProbability) + receivedMaxMoveDamage * maxMoveProbability;
+    double receivedDamage = receivedRegularDamage * (1 - maxMoveProbability) + context.receivedMaxMoveDamage * maxMoveProbability;
 
     // failsafe in case received damage is very small (or zero!), don't want to blow it up to infinity
     if (receivedDamage < 0.0001){
@@ -149,7 +186,7 @@ double calc_move_score(
 
 void select_best_move(
     const Pokemon& attacker, const Pokemon& defender, const Field& field,
-    const std::vector<const Pokemon*>& teammates,
+    const MoveScoreContext& context,
     size_t& bestIndex, std::string& bestMoveName, double& bestMoveScore
 ){
     // by default best score should be small, so we can only grow
@@ -162,7 +199,7 @@ void select_best_move(
     // now iterate through the moves
     for (size_t ii = 0; ii < attacker.num_moves(); ii++){
         if (attacker.pp(ii) > 0){
-            score = calc_move_score(attacker, defender, teammates, ii, field);
+            score = calc_move_score(attacker, defender, ii, field, context);
             if (score > bestMoveScore){
                 bestIndex = ii;
                 bestMoveScore = score;
@@ -172,9 +209,30 @@ void select_best_move(
     }
 }
 
+}
+
+
+double calc_move_score(
+    const Pokemon& attacker, const Pokemon& defender,
+    const std::vector<const Pokemon*>& teammates,
+    size_t moveIdx, const Field& field
+){
+    MoveScoreContext context(attacker, defender, teammates, field);
+    return calc_move_score(attacker, defender, moveIdx, field, context);
+}
+
+void select_best_move(
+    const Pokemon& attacker, const Pokemon& defender, const Field& field,
+    const std::vector<const Pokemon*>& teammates,
+    size_t& bestIndex, std::string& bestMoveName, double& bestMoveScore
+){
+    MoveScoreContext context(attacker, defender, teammates, field);
+    select_best_move(attacker, defender, field, context, bestIndex, bestMoveName, bestMoveScore);
+}
+
 
 double evaluate_matchup(
-    Pokemon attacker, const Pokemon& boss,
+    const Pokemon& rental, const Pokemon& boss,
     const std::vector<const Pokemon*>& teammates,
     uint8_t numLives
 ){
@@ -184,9 +242,10 @@ double evaluate_matchup(
     Field baseField;
     baseField.set_default_field(boss.name());
 
-    if (attacker.name() == "ditto"){
-        attacker = boss;
-    }
+    Pokemon attacker = rental.name() == "ditto" ? boss : rental;
+
+    // the damage received doesn't depend on the attacker's dynamax state, so it's shared by both
+    MoveScoreContext context(attacker, boss, teammates, baseField);
 
     // calculate scores for base and DA versions of the attacker
     // start by yoinking out the DMax variable
@@ -199,12 +258,12 @@ double evaluate_matchup(
     double bestMoveScore;
     size_t bestIndex;
     // get the best moves and score, we're going to only use move score
-    select_best_move(attacker, boss, baseField, teammates, bestIndex, bestMoveName, bestMoveScore);
+    select_best_move(attacker, boss, baseField, context, bestIndex, bestMoveName, bestMoveScore);
 
     // then do the dynamax version
     attacker.set_is_dynamax(true);
     double bestDMaxMoveScore;
-    select_best_move(attacker, boss, baseField, teammates, bestIndex, bestMoveName, bestDMaxMoveScore);
+    select_best_move(attacker, boss, baseField, context, bestIndex, bestMoveName, bestDMaxMoveScore);
 
     // return the attacker back to original dmax state
     attacker.set_is_dynamax(originalDMaxState);
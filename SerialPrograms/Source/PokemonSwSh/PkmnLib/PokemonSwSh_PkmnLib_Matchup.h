@@ -24,7 +24,7 @@ double calc_average_damage(
     const Field& field, bool multipleTargets
 );
 double calc_move_score(
-    const Pokemon& attacker, Pokemon defender,
+    const Pokemon& attacker, const Pokemon& defender,
     const std::vector<const Pokemon*>& teammates,
     size_t moveIdx, const Field& field
 );
@@ -34,7 +34,7 @@ void select_best_move(
     size_t& bestIndex, std::string& bestMoveName, double& bestMoveScore
 );
 double evaluate_matchup(
-    Pokemon attacker, const Pokemon& boss,
+    const Pokemon& rental, const Pokemon& boss,
     const std::vector<const Pokemon*>& teammates,
     uint8_t numLives
 );
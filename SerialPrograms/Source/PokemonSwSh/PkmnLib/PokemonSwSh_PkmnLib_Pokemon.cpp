@@ -198,6 +198,7 @@ void Pokemon::update_stats(bool is_iv, uint8_t HP, uint8_t Atk, uint8_t Def, uin
 
     // then recalculate stats
     calculate_stats();
+    m_id = NO_ID;
 }
 void Pokemon::update_stats(
     uint8_t iv_hp, uint8_t iv_atk, uint8_t iv_def, uint8_t iv_spatk, uint8_t iv_spdef, uint8_t iv_speed,
@@ -223,6 +224,7 @@ void Pokemon::update_stats(
 
     // then recalculate stats
     calculate_stats();
+    m_id = NO_ID;
 }
 
 
@@ -271,10 +273,12 @@ const Move& Pokemon::max_move(size_t index) const{
 void Pokemon::set_move(const Move& move, size_t index){
     assert_move_index(index);
     m_move[index] = &move;
+    m_id = NO_ID;
 }
 void Pokemon::set_max_move(const Move& move, size_t index){
     assert_move_index(index);
     m_max_move[index] = &move;
+    m_id = NO_ID;
 }
 
 uint32_t Pokemon::move_id(size_t index) const{
@@ -336,7 +340,7 @@ std::string Pokemon::dump() const{
 }
 
 
-std::map<std::string, Pokemon> load_pokemon(const std::string& filepath, bool is_legendary){
+std::map<std::string, Pokemon> load_pokemon(const std::string& filepath, bool is_legendary, size_t first_id){
     std::string path = RESOURCE_PATH() + filepath;
     JsonValue json = load_json_file(path);
     JsonObject& root = json.get_object_throw(path);
@@ -425,16 +429,33 @@ std::map<std::string, Pokemon> load_pokemon(const std::string& filepath, bool is
         );
     }
 
+    for (auto& item : map){
+        item.second.set_id(first_id++);
+    }
+
     return map;
 }
 
 
 const std::map<std::string, Pokemon>& all_rental_pokemon(){
-    static std::map<std::string, Pokemon> pokemon = load_pokemon("PokemonSwSh/MaxLair/rental_pokemon.json", false);
+    static std::map<std::string, Pokemon> pokemon = load_pokemon("PokemonSwSh/MaxLair/rental_pokemon.json", false, 0);
     return pokemon;
 }
 const std::map<std::string, Pokemon>& all_boss_pokemon(){
-    static std::map<std::string, Pokemon> pokemon = load_pokemon("PokemonSwSh/MaxLair/boss_pokemon.json", true);
+    static std::map<std::string, Pokemon> pokemon = load_pokemon("PokemonSwSh/MaxLair/boss_pokemon.json", true, all_rental_pokemon().size());
+    return pokemon;
+}
+const std::vector<const Pokemon*>& all_pokemon_by_id(){
+    static const std::vector<const Pokemon*> pokemon = []{
+        std::vector<const Pokemon*> ret;
+        for (const auto& item : all_rental_pokemon()){
+            ret.emplace_back(&item.second);
+        }
+        for (const auto& item : all_boss_pokemon()){
+            ret.emplace_back(&item.second);
+        }
+        return ret;
+    }();
     return pokemon;
 }
 
@@ -8,6 +8,7 @@
 #define _PokemonAutomation_PokemonSwSh_PkmnLib_Pokemon_H
 
 #include <string>
+#include <vector>
 #include <map>
 #include "PokemonSwSh_PkmnLib_Types.h"
 #include "PokemonSwSh_PkmnLib_Stats.h"
@@ -49,6 +50,10 @@ enum class VolatileStatusEffects{
 };
 
 class Pokemon{
+public:
+    // id of anything that isn't an unmodified entry of the databases
+    static constexpr size_t NO_ID = (size_t)-1;
+
 public:
     // declare public functions now
 
@@ -95,6 +100,9 @@ public:
     );
 
     // declare basic getters for some of the values we have
+    // dense index into all_pokemon_by_id(), NO_ID once the stats or moves are changed
+    size_t              id() const{ return m_id; }
+    void                set_id(size_t id) { m_id = id; }
     uint16_t            dex_id() const{ return m_dex_id; }
     const std::string&  name() const{ return m_name; }
     const std::string&  ability() const{ return m_ability; }
@@ -167,6 +175,7 @@ private:
     // private members, shouldn't need to be accessed unless with accessors
 
     // basic information regarding the pokemon itself
+    size_t m_id = NO_ID;
     uint16_t m_dex_id;
     std::string m_name;
     std::string m_ability;
@@ -214,6 +223,10 @@ private:
 const std::map<std::string, Pokemon>& all_rental_pokemon();
 const std::map<std::string, Pokemon>& all_boss_pokemon();
 
+// every pokemon of both databases indexed by Pokemon::id()
+// the rentals come first in slug order, followed by the bosses
+const std::vector<const Pokemon*>& all_pokemon_by_id();
+
 const Pokemon& get_pokemon(const std::string& slug);
 
 
@@ -252,7 +252,12 @@ GameSettings::GameSettings()
         LockWhileRunning::LOCKED,
         1.2, 0
     )
-//    , m_experimental("<font size=4><b>Experimental/Beta Features:</b></font>")
+    , m_experimental("<font size=4><b>Experimental/Beta Features:</b></font>")
+    , MAX_LAIR_PATH_SEARCH(
+        "<b>Max Lair Path Search:</b><br>Choose the Max Lair path by searching over what can be caught along each path instead of by type matchups alone.",
+        LockWhileRunning::LOCKED,
+        false
+    )
 {
     PA_ADD_STATIC(m_egg_options);
     PA_ADD_OPTION(AUTO_DEPOSIT);
@@ -310,7 +315,8 @@ GameSettings::GameSettings()
     PA_ADD_OPTION(LINE_SPARKLE_ALPHA);
     PA_ADD_OPTION(SHINY_DIALOG_ALPHA);
 
-//    PA_ADD_STATIC(m_experimental);
+    PA_ADD_STATIC(m_experimental);
+    PA_ADD_OPTION(MAX_LAIR_PATH_SEARCH);
 }
 
 
@@ -80,6 +80,9 @@ public:
     FloatingPointOption LINE_SPARKLE_ALPHA;
 
     FloatingPointOption SHINY_DIALOG_ALPHA;
+
+    SectionDividerOption m_experimental;
+    BooleanCheckBoxOption MAX_LAIR_PATH_SEARCH;
 };
 
 
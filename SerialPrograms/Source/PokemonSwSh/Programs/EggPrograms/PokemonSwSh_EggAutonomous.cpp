@@ -606,7 +606,7 @@ bool EggAutonomous::process_hatched_pokemon(SingleSwitchProgramEnvironment& env,
                     m_notification_noop,
                     NOTIFICATION_SHINY,
                     false, true, {{{}, ShinyType::UNKNOWN_SHINY}}, std::nan(""),
-                    screen
+                    screen, nullptr, &env.console.logger()
                 );
             }else{
                 env.log("Pokemon " + std::to_string(i_hatched) + " is not shiny.", COLOR_PURPLE);
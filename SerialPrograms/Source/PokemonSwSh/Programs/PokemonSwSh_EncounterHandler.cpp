@@ -96,7 +96,8 @@ void StandardEncounterHandler::run_away_and_update_stats(
         candidates_ptr, is_likely_shiny(result.shiny_type),
         {{candidates, result.shiny_type}}, result.alpha,
         result.get_best_screenshot(),
-        &m_frequencies
+        &m_frequencies,
+        &m_console.logger()
     );
 
     BlackScreenOverWatcher black_screen_detector;
@@ -160,7 +161,8 @@ bool StandardEncounterHandler::handle_standard_encounter(const ShinyDetectionRes
         candidates_ptr, is_likely_shiny(result.shiny_type),
         {{candidates, result.shiny_type}}, result.alpha,
         result.get_best_screenshot(),
-        &m_frequencies
+        &m_frequencies,
+        &m_console.logger()
     );
 
     if (m_settings.VIDEO_ON_SHINY && encounter.is_shiny()){
@@ -224,7 +226,8 @@ bool StandardEncounterHandler::handle_standard_encounter_end_battle(
         candidates_ptr, is_likely_shiny(result.shiny_type),
         {{candidates, result.shiny_type}}, result.alpha,
         result.get_best_screenshot(),
-        &m_frequencies
+        &m_frequencies,
+        &m_console.logger()
     );
 
     switch (action.first){
@@ -4,7 +4,6 @@
  *
  */
 
-#include <algorithm>
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h"
@@ -78,14 +77,10 @@ Xoroshiro128PlusState refind_rng_state(
     bool log_image_values)
 {
     Xoroshiro128Plus rng(last_known_state.s0, last_known_state.s1);
-    for (size_t i = 0; i < min_advances; i++) {
-        rng.next();
-    }
+    rng.advance(min_advances);
     OrbeetleAttackAnimationDetector detector(console, context);
     size_t possible_indices = SIZE_MAX;
-    std::vector<bool> sequence = {};
-    std::vector<bool> last_bit_sequence = rng.generate_last_bit_sequence(max_advances - min_advances);
-    size_t distance = 0;
+    Xoroshiro128PlusLastBitSearch search(rng.get_state(), max_advances - min_advances);
 
     size_t i = 0;
     while (possible_indices > 1) {
@@ -102,26 +97,17 @@ Xoroshiro128PlusState refind_rng_state(
             );
         case OrbeetleAttackAnimationDetector::SPECIAL:
             text += " : Special";
-            sequence.emplace_back(true);
+            search.push(true);
             break;
         case OrbeetleAttackAnimationDetector::PHYSICAL:
             text += " : Physical";
-            sequence.emplace_back(false);
+            search.push(false);
             break;
         }
         console.overlay().add_log(text, COLOR_BLUE);
         pbf_wait(context, 180);
 
-        std::vector<bool>::iterator last_bit_start = std::search(last_bit_sequence.begin(), last_bit_sequence.end(), sequence.begin(), sequence.end());
-        possible_indices = 0;
-        distance = 0;
-        while (last_bit_start != last_bit_sequence.end()) {
-            possible_indices++;
-            distance = std::distance(last_bit_sequence.begin(), last_bit_start);
-
-            last_bit_start++;
-            last_bit_start = std::search(last_bit_start, last_bit_sequence.end(), sequence.begin(), sequence.end());
-        }
+        possible_indices = search.count_matches(2);
     }
     if (possible_indices == 0) {
         throw OperationFailedException(
@@ -130,12 +116,10 @@ Xoroshiro128PlusState refind_rng_state(
         );
     }
 
-    distance += sequence.size();
-    console.log("RNG: needed " + std::to_string(sequence.size()) + " animations.");
+    size_t distance = search.first_match() + search.observed();
+    console.log("RNG: needed " + std::to_string(search.observed()) + " animations.");
     console.log("RNG: new state is " + std::to_string(distance + min_advances) + " advances from last known state.");
-    for (size_t advance = 0; advance < distance; advance++) {
-        rng.next();
-    }
+    rng.advance(distance);
     console.log("RNG: state[0] = " + tostr_hex(rng.get_state().s0));
     console.log("RNG: state[1] = " + tostr_hex(rng.get_state().s1));
 
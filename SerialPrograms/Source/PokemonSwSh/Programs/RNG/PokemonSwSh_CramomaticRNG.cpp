@@ -30,6 +30,7 @@
 #include "PokemonSwSh/Programs/PokemonSwSh_GameEntry.h"
 #include "PokemonSwSh/Programs/RNG/PokemonSwSh_BasicRNG.h"
 #include "PokemonSwSh/Programs/RNG/PokemonSwSh_CramomaticRNG.h"
+#include "PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128PlusLanes.h"
 
 //#include <iostream>
 //using std::cout;
@@ -185,89 +186,102 @@ CramomaticTarget CramomaticRNG::calculate_target(SingleSwitchProgramEnvironment&
     std::vector<CramomaticTarget> possible_targets;
 
     std::sort(selected_balls.begin(), selected_balls.end(), [](CramomaticSelection sel1, CramomaticSelection sel2) { return sel1.priority > sel2.priority; });
+
+    // Evaluate LANES consecutive advances at a time.
+    constexpr size_t LANES = 16;
+    uint64_t scratch[LANES];
+    uint64_t ball_rolls[LANES];
+    uint64_t safari_sport_rolls[LANES];
+    uint64_t bonus_bounds[LANES];
+    uint64_t bonus_rolls[LANES];
+
     // priority_advances only starts counting up after the first good result is found
-    while (priority_advances <= MAX_PRIORITY_ADVANCES) {
-        // calculate the result for the current temp_rng state
-        Xoroshiro128Plus temp_rng(rng.get_state());
+    bool done = false;
+    while (!done && priority_advances <= MAX_PRIORITY_ADVANCES) {
+        // calculate the results for the next LANES rng states
+        Xoroshiro128PlusLanes<LANES> lanes(rng);
 
         for (size_t i = 0; i < NUM_NPCS; i++) {
-            temp_rng.nextInt(91);
+            lanes.next_int(91, scratch);
         }
-        temp_rng.next();
-        temp_rng.nextInt(60);
+        lanes.next(scratch);
+        lanes.next_int(60, scratch);
+
+        /*item_roll*/ lanes.next_int(4, scratch);
+        lanes.next_int(100, ball_rolls);
+        lanes.next_int(1000, safari_sport_rolls);
+        for (size_t lane = 0; lane < LANES; lane++) {
+            bool is_safari_sport = safari_sport_rolls[lane] == 0;
+            bonus_bounds[lane] = is_safari_sport || ball_rolls[lane] == 99 ? 1000 : 100;
+        }
+        lanes.next_int(bonus_bounds, bonus_rolls);
 
-        /*uint64_t item_roll =*/ temp_rng.nextInt(4);
-        uint64_t ball_roll = temp_rng.nextInt(100);
-        bool is_safari_sport = temp_rng.nextInt(1000) == 0;
-        bool is_bonus = false;
+        for (size_t lane = 0; lane < LANES && priority_advances <= MAX_PRIORITY_ADVANCES; lane++) {
+            uint64_t ball_roll = ball_rolls[lane];
+            bool is_safari_sport = safari_sport_rolls[lane] == 0;
+            bool is_bonus = bonus_rolls[lane] == 0;
 
-        if (is_safari_sport || ball_roll == 99) {
-            is_bonus = temp_rng.nextInt(1000) == 0;
-        }
-        else {
-            is_bonus = temp_rng.nextInt(100) == 0;
-        }
+            CramomaticBallType type;
+            if (is_safari_sport) {
+                type = CramomaticBallType::Safari;
+            }
+            else if (ball_roll < 25) {
+                type = CramomaticBallType::Poke;
+            }
+            else if (ball_roll < 50) {
+                type = CramomaticBallType::Great;
+            }
+            else if (ball_roll < 75) {
+                type = CramomaticBallType::Shop1;
+            }
+            else if (ball_roll < 99) {
+                type = CramomaticBallType::Shop2;
+            }
+            else {
+                type = CramomaticBallType::Apricorn;
+            }
 
-        CramomaticBallType type;
-        if (is_safari_sport) {
-            type = CramomaticBallType::Safari;
-        }
-        else if (ball_roll < 25) {
-            type = CramomaticBallType::Poke;
-        }
-        else if (ball_roll < 50) {
-            type = CramomaticBallType::Great;
-        }
-        else if (ball_roll < 75) {
-            type = CramomaticBallType::Shop1;
-        }
-        else if (ball_roll < 99) {
-            type = CramomaticBallType::Shop2;
-        }
-        else {
-            type = CramomaticBallType::Apricorn;
-        }
-        
-
-        // check whether the result is a good result
-        for (size_t i = 0; i < selected_balls.size(); i++) {
-            CramomaticSelection selection = selected_balls[i];
-            if (!selection.is_bonus || is_bonus) {
-                if (is_safari_sport) {
-                    if (selection.ball_type == CramomaticBallType::Safari || selection.ball_type == CramomaticBallType::Sport) {
-                        type = selection.ball_type;
+
+            // check whether the result is a good result
+            for (size_t i = 0; i < selected_balls.size(); i++) {
+                CramomaticSelection selection = selected_balls[i];
+                if (!selection.is_bonus || is_bonus) {
+                    if (is_safari_sport) {
+                        if (selection.ball_type == CramomaticBallType::Safari || selection.ball_type == CramomaticBallType::Sport) {
+                            type = selection.ball_type;
+                        }
+                    }
+
+                    if (selection.ball_type == type) {
+                        CramomaticTarget target;
+                        target.ball_type = type;
+                        target.is_bonus = is_bonus;
+                        target.needed_advances = advances;
+                        possible_targets.emplace_back(target);
+
+                        priority_advances = 0;
+
+                        uint16_t priority = selection.priority;
+                        selected_balls.erase(
+                            std::remove_if(selected_balls.begin(), selected_balls.end()
+                                , [priority](CramomaticSelection sel) { return sel.priority <= priority; })
+                            , selected_balls.end());
+                        break;
                     }
+
                 }
-                
-                if (selection.ball_type == type) {
-                    CramomaticTarget target;
-                    target.ball_type = type;
-                    target.is_bonus = is_bonus;
-                    target.needed_advances = advances;
-                    possible_targets.emplace_back(target);
-
-                    priority_advances = 0;
-
-                    uint16_t priority = selection.priority;
-                    selected_balls.erase(
-                        std::remove_if(selected_balls.begin(), selected_balls.end()
-                            , [priority](CramomaticSelection sel) { return sel.priority <= priority; })
-                        , selected_balls.end());
+            }
+            if (possible_targets.size() > 0) {
+                if (selected_balls.empty()) {
+                    //priority_advances = MAX_PRIORITY_ADVANCES + 1;
+                    done = true;
                     break;
                 }
-
+                priority_advances++;
             }
-        }
-        if (possible_targets.size() > 0) {
-            if (selected_balls.empty()) {
-                //priority_advances = MAX_PRIORITY_ADVANCES + 1;
-                break;
-            }
-            priority_advances++;
-        }
 
-        rng.next();
-        advances++;
+            advances++;
+        }
     }
 
     // Choose the first result which doesn't overshadow a higher priority choice.
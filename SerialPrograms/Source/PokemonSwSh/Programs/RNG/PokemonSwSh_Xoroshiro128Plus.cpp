@@ -5,6 +5,8 @@
  */
 
 #include <cstddef>
+#include <array>
+#include "Kernels/Kernels_BitScan.h"
 #include "PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128Plus.h"
 
 namespace PokemonAutomation {
@@ -45,6 +47,84 @@ Xoroshiro128PlusState Xoroshiro128Plus::get_state() {
     return state;
 }
 
+// The generator is linear over GF(2). So advancing by 2^k is a fixed 128x128
+// bit matrix which is applied by XORing together the columns selected by the
+// bits of the state.
+namespace{
+
+using JumpMatrix = std::array<std::array<uint64_t, 2>, 128>;
+
+void apply_jump_matrix(const JumpMatrix& matrix, uint64_t& s0, uint64_t& s1){
+    uint64_t r0 = 0;
+    uint64_t r1 = 0;
+    for (size_t c = 0; c < 64; c++){
+        uint64_t mask = 0 - ((s0 >> c) & 1);
+        r0 ^= matrix[c][0] & mask;
+        r1 ^= matrix[c][1] & mask;
+    }
+    for (size_t c = 0; c < 64; c++){
+        uint64_t mask = 0 - ((s1 >> c) & 1);
+        r0 ^= matrix[c + 64][0] & mask;
+        r1 ^= matrix[c + 64][1] & mask;
+    }
+    s0 = r0;
+    s1 = r1;
+}
+
+// JUMP_MATRICES()[k] advances the state by 2^k.
+const std::vector<JumpMatrix>& JUMP_MATRICES(){
+    static const std::vector<JumpMatrix> matrices = []{
+        std::vector<JumpMatrix> ret(64);
+
+        // Column c of a single step is the result of stepping the unit vector c.
+        for (size_t c = 0; c < 128; c++){
+            Xoroshiro128Plus rng(
+                c < 64 ? (uint64_t)1 << c : 0,
+                c < 64 ? 0 : (uint64_t)1 << (c - 64)
+            );
+            rng.next();
+            ret[0][c] = {rng.state.s0, rng.state.s1};
+        }
+
+        // Square the previous matrix.
+        for (size_t k = 1; k < 64; k++){
+            for (size_t c = 0; c < 128; c++){
+                uint64_t s0 = ret[k - 1][c][0];
+                uint64_t s1 = ret[k - 1][c][1];
+                apply_jump_matrix(ret[k - 1], s0, s1);
+                ret[k][c] = {s0, s1};
+            }
+        }
+        return ret;
+    }();
+    return matrices;
+}
+
+}
+
+void Xoroshiro128Plus::advance(uint64_t advances) {
+    // A matrix application costs about as much as a couple hundred steps.
+    const uint64_t DIRECT_STEPS = 256;
+    for (uint64_t i = 0; i < (advances % DIRECT_STEPS); i++) {
+        next();
+    }
+    advances /= DIRECT_STEPS;
+    if (advances == 0) {
+        return;
+    }
+
+    const std::vector<JumpMatrix>& matrices = JUMP_MATRICES();
+    size_t k = 8;
+    while (advances != 0) {
+        if (advances & 1) {
+            apply_jump_matrix(matrices[k], state.s0, state.s1);
+        }
+        advances >>= 1;
+        k++;
+    }
+}
+
+
 uint64_t nextPowerOfTwo(uint64_t number) {
     uint64_t x = number;
     x--;
@@ -78,6 +158,77 @@ std::vector<bool> Xoroshiro128Plus::generate_last_bit_sequence(size_t max_advanc
     return sequence;
 }
 
+Xoroshiro128PlusLastBitSearch::Xoroshiro128PlusLastBitSearch(Xoroshiro128PlusState state, size_t length)
+    : m_length(length)
+    , m_observed(0)
+    , m_last_bits((length + 63) / 64, 0)
+    , m_candidates((length + 63) / 64, ~(uint64_t)0)
+{
+    Xoroshiro128Plus rng(state);
+    for (size_t i = 0; i < length; i++) {
+        m_last_bits[i / 64] |= (rng.next() & 1) << (i % 64);
+    }
+    if (length % 64 != 0) {
+        m_candidates.back() = ((uint64_t)1 << (length % 64)) - 1;
+    }
+}
+
+uint64_t Xoroshiro128PlusLastBitSearch::window(size_t index) const {
+    size_t word = index / 64;
+    size_t shift = index % 64;
+    if (word >= m_last_bits.size()) {
+        return 0;
+    }
+    uint64_t ret = m_last_bits[word] >> shift;
+    if (shift != 0 && word + 1 < m_last_bits.size()) {
+        ret |= m_last_bits[word + 1] << (64 - shift);
+    }
+    return ret;
+}
+
+void Xoroshiro128PlusLastBitSearch::push(bool bit) {
+    // Start position "i" survives if result "i + m_observed" has the same bit.
+    uint64_t flip = bit ? 0 : ~(uint64_t)0;
+    for (size_t c = 0; c < m_candidates.size(); c++) {
+        if (m_candidates[c] != 0) {
+            m_candidates[c] &= window(c * 64 + m_observed) ^ flip;
+        }
+    }
+
+    // The observed sequence must fit entirely within the range. So the start
+    // position that would now run past the end is no longer possible.
+    if (m_observed != 0 && m_observed <= m_length) {
+        size_t last = m_length - m_observed;
+        m_candidates[last / 64] &= ~((uint64_t)1 << (last % 64));
+    }
+    m_observed++;
+}
+
+size_t Xoroshiro128PlusLastBitSearch::count_matches(size_t limit) const {
+    size_t count = 0;
+    for (uint64_t word : m_candidates) {
+        while (word != 0 && count < limit) {
+            word &= word - 1;
+            count++;
+        }
+        if (count >= limit) {
+            break;
+        }
+    }
+    return count;
+}
+
+size_t Xoroshiro128PlusLastBitSearch::first_match() const {
+    for (size_t c = 0; c < m_candidates.size(); c++) {
+        size_t zeros;
+        if (Kernels::trailing_zeros(zeros, m_candidates[c])) {
+            return c * 64 + zeros;
+        }
+    }
+    return SIZE_MAX;
+}
+
+
 // The generic solution to the system of equations to calculate the initial state from the last bits of 128 consecutive Xoroshiro128+ results.
 uint64_t Xoroshiro128Plus::last_bits_reverse_matrix[128][2] = {
     /*s0 bit 0*/ {0b0101001100100001111011111110111001010011111110101011100011001101, 0b0111010111110111000101010100001111101001111001011111001011010111} ,
@@ -8,6 +8,7 @@
 #define PokemonAutomation_PokemonSwSh_Xoroshiro128Plus_H
 
 #include <stdint.h>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -28,6 +29,10 @@ public:
     uint64_t next();
     uint64_t nextInt(uint64_t);
     Xoroshiro128PlusState get_state();
+
+    // Same as calling next() "advances" times, but takes O(log(advances)).
+    void advance(uint64_t advances);
+
     std::vector<bool> generate_last_bit_sequence(size_t max_advances);
 
     static Xoroshiro128Plus xoroshiro128plus_from_last_bits(std::pair<uint64_t, uint64_t> last_bits);
@@ -39,5 +44,37 @@ private:
     uint64_t rotl(const uint64_t x, int k);
 };
 
+
+// Finds where an observed sequence of last bits starts within the next
+// "length" results of a generator.
+// The results and the possible start positions are both kept as packed
+// bitsets. So each observed bit narrows down all the candidates 64 at a time.
+class Xoroshiro128PlusLastBitSearch {
+public:
+    Xoroshiro128PlusLastBitSearch(Xoroshiro128PlusState state, size_t length);
+
+    size_t length() const { return m_length; }
+    size_t observed() const { return m_observed; }
+
+    // Add the next observed bit.
+    void push(bool bit);
+
+    // Number of start positions that still match. Stops counting at "limit".
+    size_t count_matches(size_t limit = SIZE_MAX) const;
+
+    // Returns the first start position that still matches. SIZE_MAX if none.
+    size_t first_match() const;
+
+private:
+    // The 64 last bits starting from "index". Bits past the end are zero.
+    uint64_t window(size_t index) const;
+
+private:
+    size_t m_length;
+    size_t m_observed;
+    std::vector<uint64_t> m_last_bits;
+    std::vector<uint64_t> m_candidates;
+};
+
 }
 #endif
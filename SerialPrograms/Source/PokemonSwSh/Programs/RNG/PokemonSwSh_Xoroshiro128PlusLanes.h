@@ -0,0 +1,109 @@
+/*  Xoroshiro128+ (Multi-Lane)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Runs many independent Xoroshiro128+ generators side by side. This is
+ *  used to evaluate many candidate advances at once when searching for a
+ *  target. Each operation is a plain loop over the lanes without any
+ *  branches so that the compiler can vectorize it.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSwSh_Xoroshiro128PlusLanes_H
+#define PokemonAutomation_PokemonSwSh_Xoroshiro128PlusLanes_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128Plus.h"
+
+namespace PokemonAutomation {
+
+
+template <size_t LANES>
+class Xoroshiro128PlusLanes {
+public:
+    // Lane i starts from the state of "rng" after i advances.
+    // "rng" is advanced by LANES.
+    Xoroshiro128PlusLanes(Xoroshiro128Plus& rng) {
+        for (size_t i = 0; i < LANES; i++) {
+            Xoroshiro128PlusState state = rng.get_state();
+            m_s0[i] = state.s0;
+            m_s1[i] = state.s1;
+            rng.next();
+        }
+    }
+
+    // Same as Xoroshiro128Plus::next() for every lane.
+    void next(uint64_t out[LANES]) {
+        for (size_t i = 0; i < LANES; i++) {
+            out[i] = step(m_s0[i], m_s1[i], ~(uint64_t)0);
+        }
+    }
+
+    // Same as Xoroshiro128Plus::nextInt() for every lane.
+    void next_int(uint64_t bound, uint64_t out[LANES]) {
+        uint64_t bounds[LANES];
+        for (size_t i = 0; i < LANES; i++) {
+            bounds[i] = bound;
+        }
+        next_int(bounds, out);
+    }
+    void next_int(const uint64_t bound[LANES], uint64_t out[LANES]) {
+        uint64_t mask[LANES];
+        uint64_t active[LANES];
+        for (size_t i = 0; i < LANES; i++) {
+            mask[i] = next_power_of_two(bound[i]) - 1;
+            active[i] = ~(uint64_t)0;
+        }
+
+        // Rejection sampling. Lanes that already have a value stop advancing.
+        while (true) {
+            uint64_t remaining = 0;
+            for (size_t i = 0; i < LANES; i++) {
+                uint64_t result = step(m_s0[i], m_s1[i], active[i]) & mask[i];
+                out[i] = (result & active[i]) | (out[i] & ~active[i]);
+                active[i] &= 0 - (uint64_t)(result >= bound[i]);
+                remaining |= active[i];
+            }
+            if (remaining == 0) {
+                return;
+            }
+        }
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+    static uint64_t next_power_of_two(uint64_t x) {
+        x--;
+        x |= x >> 1;
+        x |= x >> 2;
+        x |= x >> 4;
+        x |= x >> 8;
+        x |= x >> 16;
+        x |= x >> 32;
+        return x + 1;
+    }
+
+    // Advance the lane only where "enable" is all ones.
+    static uint64_t step(uint64_t& s0, uint64_t& s1, uint64_t enable) {
+        uint64_t x0 = s0;
+        uint64_t x1 = s1;
+        uint64_t result = x0 + x1;
+        x1 ^= x0;
+        uint64_t n0 = rotl(x0, 24) ^ x1 ^ (x1 << 16);
+        uint64_t n1 = rotl(x1, 37);
+        s0 = (n0 & enable) | (s0 & ~enable);
+        s1 = (n1 & enable) | (s1 & ~enable);
+        return result;
+    }
+
+private:
+    uint64_t m_s0[LANES];
+    uint64_t m_s1[LANES];
+};
+
+
+}
+#endif
@@ -7,13 +7,25 @@
 
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Metrics/HdrHistogram.h"
+#include "CommonFramework/Logging/FileWindowLogger.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Inference/BlackBorderDetector.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
+#include "CommonFramework/AudioPipeline/IO/AudioFileDecoder.h"
+#include "CommonFramework/AudioPipeline/IO/AudioFileAnalyzer.h"
+#include "CommonFramework/VideoPipeline/LazyVideoFrame.h"
+#include "CommonFramework/VideoPipeline/Backends/VideoToolsQt6.h"
 #include "CommonFramework_Tests.h"
 #include "TestUtils.h"
 
 
+#include <stdio.h>
+#include <fstream>
+#include <random>
+#include <thread>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -31,5 +43,449 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
     return 0;
 }
 
+int test_CommonFramework_FileWindowLogger(const std::string& test_path){
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(test_path);
+        std::string line;
+        while (std::getline(file, line)){
+            if (!line.empty() && line.back() == '\r'){
+                line.pop_back();
+            }
+            if (!line.empty()){
+                lines.emplace_back(std::move(line));
+            }
+        }
+    }
+    if (lines.empty()){
+        cout << "Skip " << test_path << " as it has no lines to log." << endl;
+        return -1;
+    }
+
+    const size_t THREADS = 8;
+    const size_t MESSAGES_PER_THREAD = 20000;
+    const std::string log_path = "FileWindowLogger-Benchmark.log";
+    remove(log_path.c_str());
+
+    HdrHistogram latency;
+    uint64_t dropped;
+    {
+        FileWindowLogger logger(log_path);
+        TaggedLogger tagged(logger, "Benchmark");
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; t++){
+            threads.emplace_back([&, t]{
+                for (size_t c = 0; c < MESSAGES_PER_THREAD; c++){
+                    const std::string& line = lines[(t * MESSAGES_PER_THREAD + c) % lines.size()];
+                    auto time0 = std::chrono::steady_clock::now();
+                    tagged.log(line);
+                    auto time1 = std::chrono::steady_clock::now();
+                    latency += std::chrono::duration_cast<std::chrono::nanoseconds>(time1 - time0).count();
+                }
+            });
+        }
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+        dropped = logger.messages_dropped();
+    }
+
+    //  Everything that wasn't dropped must be in the file.
+    uint64_t written = 0;
+    {
+        std::ifstream file(log_path);
+        std::string line;
+        while (std::getline(file, line)){
+            written += line.find("- [Benchmark]: ") != std::string::npos;
+        }
+    }
+    remove(log_path.c_str());
+
+    cout << "Threads: " << THREADS << ", Messages: " << THREADS * MESSAGES_PER_THREAD << endl;
+    cout << "Written: " << written << ", Dropped: " << dropped << endl;
+    cout << "log() cost: " << latency.dump(" ns", 1) << endl;
+
+    TEST_RESULT_EQUAL(written + dropped, THREADS * MESSAGES_PER_THREAD);
+
+    return 0;
+}
+
+
+
+namespace{
+
+struct WavLayout{
+    const char* name;
+    uint16_t tag;           //  1 = PCM, 3 = IEEE float
+    uint16_t channels;
+    uint16_t bits;
+    bool extensible;        //  Use WAVE_FORMAT_EXTENSIBLE with "tag" as the sub-format.
+    bool odd_chunk;         //  Put an odd-sized chunk before "fmt ".
+    bool truncated;         //  "data" claims more than the file has.
+    AudioSampleFormat format;
+};
+
+void append_u16(std::string& str, uint16_t x){
+    str += (char)(x & 0xff);
+    str += (char)(x >> 8);
+}
+void append_u32(std::string& str, uint32_t x){
+    append_u16(str, (uint16_t)(x & 0xffff));
+    append_u16(str, (uint16_t)(x >> 16));
+}
+
+std::string make_wav(const WavLayout& layout, uint32_t sample_rate, const std::string& samples){
+    uint16_t block_align = layout.channels * layout.bits / 8;
+
+    std::string fmt;
+    append_u16(fmt, layout.extensible ? 0xfffe : layout.tag);
+    append_u16(fmt, layout.channels);
+    append_u32(fmt, sample_rate);
+    append_u32(fmt, sample_rate * block_align);
+    append_u16(fmt, block_align);
+    append_u16(fmt, layout.bits);
+    if (layout.extensible){
+        append_u16(fmt, 22);            //  Extension size
+        append_u16(fmt, layout.bits);   //  Valid bits
+        append_u32(fmt, 0);             //  Channel mask
+        append_u16(fmt, layout.tag);    //  Sub-format GUID
+        fmt += std::string("\x00\x00\x00\x00\x10\x00\x80\x00\x00\xaa\x00\x38\x9b\x71", 14);
+    }
+
+    std::string body = "WAVE";
+    if (layout.odd_chunk){
+        body += "LIST";
+        append_u32(body, 3);
+        body += std::string("abc\0", 4);
+    }
+    body += "fmt ";
+    append_u32(body, (uint32_t)fmt.size());
+    body += fmt;
+    body += "data";
+    if (layout.truncated){
+        //  Claim twice as much and end in the middle of a frame.
+        append_u32(body, (uint32_t)(2 * samples.size()));
+        body += samples;
+        body += '\0';
+    }else{
+        append_u32(body, (uint32_t)samples.size());
+        body += samples;
+        if (samples.size() & 1){
+            body += '\0';
+        }
+    }
+
+    std::string file = "RIFF";
+    append_u32(file, (uint32_t)body.size());
+    return file + body;
+}
+
+//  Deletes the file however the test returns.
+struct RemoveFileOnExit{
+    std::string path;
+    ~RemoveFileOnExit(){
+        remove(path.c_str());
+    }
+};
+
+int test_wav_setup(const std::string& wav_path, uint32_t sample_rate, size_t frames){
+    cout << "Sample rate " << sample_rate << ", " << frames << " frames:" << endl;
+
+    const WavLayout LAYOUTS[] = {
+        {"PCM 8-bit",               1, 1,  8, false, false, false, AudioSampleFormat::UINT8},
+        {"PCM 16-bit",              1, 2, 16, false, false, false, AudioSampleFormat::SINT16},
+        {"PCM 24-bit",              1, 2, 24, false, false, false, AudioSampleFormat::SINT32},
+        {"PCM 32-bit",              1, 1, 32, false, false, false, AudioSampleFormat::SINT32},
+        {"Float",                   3, 2, 32, false, false, false, AudioSampleFormat::FLOAT32},
+        {"Extensible PCM 16-bit",   1, 2, 16, true,  false, false, AudioSampleFormat::SINT16},
+        {"Extensible PCM 24-bit",   1, 1, 24, true,  false, false, AudioSampleFormat::SINT32},
+        {"Extensible float",        3, 1, 32, true,  false, false, AudioSampleFormat::FLOAT32},
+        {"Odd-sized chunks",        1, 1,  8, false, true,  false, AudioSampleFormat::UINT8},
+        {"Truncated data",          1, 2, 24, false, false, true,  AudioSampleFormat::SINT32},
+    };
+
+    std::mt19937 rng(sample_rate ^ (uint32_t)frames);
+    for (const WavLayout& layout : LAYOUTS){
+        //  Odd # of 8-bit mono frames so the data chunk needs a pad byte.
+        size_t layout_frames = layout.odd_chunk ? (frames | 1) : frames;
+        size_t bytes_per_sample = layout.bits / 8;
+
+        std::string samples;
+        for (size_t c = 0; c < layout_frames * layout.channels * bytes_per_sample; c++){
+            samples += (char)(rng() & 0xff);
+        }
+        {
+            std::ofstream file(wav_path, std::ios::binary);
+            file << make_wav(layout, sample_rate, samples);
+        }
+
+        //  24-bit samples are widened to 32-bit.
+        std::string expected;
+        if (bytes_per_sample == 3){
+            for (size_t c = 0; c < samples.size(); c += 3){
+                expected += '\0';
+                expected += samples.substr(c, 3);
+            }
+        }else{
+            expected = samples;
+        }
+
+        std::string decoded;
+        try{
+            std::unique_ptr<AudioFileDecoder> decoder = open_audio_file(wav_path);
+            TEST_RESULT_COMPONENT_EQUAL(decoder->sample_rate(), sample_rate, layout.name);
+            TEST_RESULT_COMPONENT_EQUAL(decoder->channels(), layout.channels, layout.name);
+            TEST_RESULT_COMPONENT_EQUAL((int)decoder->format(), (int)layout.format, layout.name);
+
+            //  An odd chunk size so reads don't line up with anything.
+            const size_t CHUNK_FRAMES = 7;
+            std::string buffer(CHUNK_FRAMES * decoder->frame_size(), '\0');
+            while (size_t read = decoder->read(&buffer[0], CHUNK_FRAMES)){
+                decoded += buffer.substr(0, read * decoder->frame_size());
+            }
+        }catch (FileException& e){
+            cerr << "Error: " << layout.name << ": " << e.message() << endl;
+            return 1;
+        }
+        TEST_RESULT_COMPONENT_EQUAL(decoded.size(), expected.size(), layout.name);
+        TEST_RESULT_COMPONENT_EQUAL(decoded == expected, true, layout.name);
+        cout << layout.name << ": OK" << endl;
+    }
+
+    //  The analyzer decodes the whole file.
+    {
+        std::string samples(frames * 2 * sizeof(float), '\0');
+        {
+            std::ofstream file(wav_path, std::ios::binary);
+            file << make_wav(LAYOUTS[4], sample_rate, samples);
+        }
+        AudioFileAnalyzer analyzer(wav_path);
+        TEST_RESULT_COMPONENT_EQUAL(analyzer.run(), frames, "analyzer");
+    }
+
+    return 0;
+}
+
+}
+
+int test_CommonFramework_WavFileDecoder(const std::string&){
+    const struct{
+        uint32_t sample_rate;
+        size_t frames;
+    } SETUPS[] = {
+        {48000, 4800},
+        {44100, 1001},
+        {96000, 1},
+        {8000, 64},
+    };
+
+    RemoveFileOnExit wav{"WavFileDecoder-Test.wav"};
+    for (const auto& setup : SETUPS){
+        int ret = test_wav_setup(wav.path, setup.sample_rate, setup.frames);
+        if (ret != 0){
+            return ret;
+        }
+    }
+    return 0;
+}
+
+
+
+#if QT_VERSION_MAJOR == 6
+namespace{
+
+bool same_pixels(const ImageViewRGB32& x, const ImageViewRGB32& y){
+    if (x.width() != y.width() || x.height() != y.height()){
+        return false;
+    }
+    for (size_t r = 0; r < x.height(); r++){
+        for (size_t c = 0; c < x.width(); c++){
+            if (x.pixel(c, r) != y.pixel(c, r)){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+ImagePixelBox random_box(std::mt19937& rng, size_t width, size_t height){
+    size_t min_x = rng() % width;
+    size_t min_y = rng() % height;
+    size_t max_x = min_x + 1 + rng() % (width - min_x);
+    size_t max_y = min_y + 1 + rng() % (height - min_y);
+    return ImagePixelBox(min_x, min_y, max_x, max_y);
+}
+
+}
+#endif
+
+int test_CommonFramework_LazyVideoFrame(const std::string&){
+#if QT_VERSION_MAJOR == 6
+    //  Not multiples of the tile size.
+    const size_t WIDTH = 200;
+    const size_t HEIGHT = 150;
+    const size_t BOXES = 16;
+
+    struct Format{
+        const char* name;
+        QVideoFrameFormat::PixelFormat format;
+    };
+    const Format FORMATS[] = {
+        {"BGRA8888",    QVideoFrameFormat::Format_BGRA8888},
+        {"ARGB8888",    QVideoFrameFormat::Format_ARGB8888},
+        {"RGBA8888",    QVideoFrameFormat::Format_RGBA8888},
+        {"ABGR8888",    QVideoFrameFormat::Format_ABGR8888},
+        {"NV12",        QVideoFrameFormat::Format_NV12},
+        {"NV21",        QVideoFrameFormat::Format_NV21},
+        {"YUV420P",     QVideoFrameFormat::Format_YUV420P},
+        {"YV12",        QVideoFrameFormat::Format_YV12},
+        {"YUYV",        QVideoFrameFormat::Format_YUYV},
+        {"UYVY",        QVideoFrameFormat::Format_UYVY},
+    };
+
+    std::mt19937 rng(0);
+    for (const Format& format : FORMATS){
+        QVideoFrame frame(QVideoFrameFormat(QSize((int)WIDTH, (int)HEIGHT), format.format));
+        if (!frame.map(QVideoFrame::WriteOnly)){
+            cerr << "Error: " << format.name << ": Unable to map frame." << endl;
+            return 1;
+        }
+        for (int plane = 0; plane < frame.planeCount(); plane++){
+            uchar* bits = frame.bits(plane);
+            for (qsizetype c = 0; c < frame.mappedBytes(plane); c++){
+                bits[c] = (uchar)(rng() & 0xff);
+            }
+        }
+        frame.unmap();
+
+        std::unique_ptr<LazyVideoFrameConverter> converter = make_lazy_frame_converter(frame);
+        TEST_RESULT_COMPONENT_EQUAL(converter != nullptr, true, format.name);
+        LazyVideoFrame lazy(WIDTH, HEIGHT, std::move(converter));
+
+        //  Read some boxes before the full frame...
+        std::vector<std::pair<ImagePixelBox, ImageRGB32>> before;
+        for (size_t c = 0; c < BOXES; c++){
+            ImagePixelBox box = random_box(rng, WIDTH, HEIGHT);
+            before.emplace_back(box, lazy.extract_box_reference(box).copy());
+        }
+
+        std::shared_ptr<const ImageRGB32> full = lazy.full_frame();
+        TEST_RESULT_COMPONENT_EQUAL(full->width(), WIDTH, format.name);
+        TEST_RESULT_COMPONENT_EQUAL(full->height(), HEIGHT, format.name);
+
+        for (const auto& item : before){
+            bool same = same_pixels(item.second, extract_box_reference(*full, item.first));
+            TEST_RESULT_COMPONENT_EQUAL(same, true, format.name);
+        }
+
+        //  ...and some after.
+        for (size_t c = 0; c < BOXES; c++){
+            ImagePixelBox box = random_box(rng, WIDTH, HEIGHT);
+            bool same = same_pixels(lazy.extract_box_reference(box), extract_box_reference(*full, box));
+            TEST_RESULT_COMPONENT_EQUAL(same, true, format.name);
+        }
+        cout << format.name << ": OK" << endl;
+    }
+    return 0;
+#else
+    cout << "Skip as lazy frames need Qt6." << endl;
+    return -1;
+#endif
+}
+
+
+
+namespace{
+
+//  3x5 digits. Every one of them fills its bounding box.
+const char* const DIGIT_FONT[10][5] = {
+    {"###", "#.#", "#.#", "#.#", "###"},
+    {".#.", "##.", ".#.", ".#.", "###"},
+    {"###", "..#", "###", "#..", "###"},
+    {"###", "..#", "###", "..#", "###"},
+    {"#.#", "#.#", "###", "..#", "..#"},
+    {"###", "#..", "###", "..#", "###"},
+    {"###", "#..", "###", "#.#", "###"},
+    {"###", "..#", "..#", "..#", "..#"},
+    {"###", "#.#", "###", "#.#", "###"},
+    {"###", "#.#", "###", "..#", "###"},
+};
+
+//  Draw "digit" with each font pixel as a "scale_x" by "scale_y" block.
+PackedBinaryMatrix draw_digit(size_t digit, size_t scale_x, size_t scale_y){
+    PackedBinaryMatrix matrix(3 * scale_x, 5 * scale_y);
+    for (size_t r = 0; r < matrix.height(); r++){
+        for (size_t c = 0; c < matrix.width(); c++){
+            matrix.set(c, r, DIGIT_FONT[digit][r / scale_y][c / scale_x] == '#');
+        }
+    }
+    return matrix;
+}
+
+}
+
+int test_CommonFramework_GlyphClassifier(const std::string&){
+    const double MAX_DISTANCE = 0.15;
+    const double MIN_MARGIN = 0.05;
+
+    OCR::GlyphClassifier classifier;
+    for (size_t digit = 0; digit < 10; digit++){
+        TEST_RESULT_COMPONENT_EQUAL(classifier.add_template((char)('0' + digit), draw_digit(digit, 4, 4)), true, "add");
+    }
+    //  The same glyph again is a duplicate.
+    TEST_RESULT_COMPONENT_EQUAL(classifier.add_template('0', draw_digit(0, 4, 4)), false, "add duplicate");
+    TEST_RESULT_COMPONENT_EQUAL(classifier.templates(), (size_t)10, "templates");
+
+    //  Other sizes and slightly different aspect ratios match the same digit.
+    //  But digits that differ by one font pixel (such as 3 and 9) can lose
+    //  their margin at other sizes. So only the trained size is read.
+    const std::pair<size_t, size_t> SCALES[] = {{4, 4}, {3, 3}, {5, 5}, {7, 7}, {8, 8}, {4, 5}, {5, 4}};
+    for (const auto& scale : SCALES){
+        bool trained = scale.first == 4 && scale.second == 4;
+        for (size_t digit = 0; digit < 10; digit++){
+            std::string name = std::to_string(digit) + " at " + std::to_string(scale.first) + "x" + std::to_string(scale.second);
+            PackedBinaryMatrix glyph = draw_digit(digit, scale.first, scale.second);
+            TEST_RESULT_COMPONENT_EQUAL(classifier.classify(glyph).ch, (char)('0' + digit), name);
+            if (trained){
+                TEST_RESULT_COMPONENT_EQUAL(classifier.read(glyph, MAX_DISTANCE, MIN_MARGIN), (char)('0' + digit), name);
+            }
+        }
+    }
+
+    //  A stray pixel in a corner still reads.
+    for (size_t digit = 0; digit < 10; digit++){
+        PackedBinaryMatrix glyph = draw_digit(digit, 6, 6);
+        glyph.set(0, glyph.height() - 1, !glyph.get(0, glyph.height() - 1));
+        TEST_RESULT_COMPONENT_EQUAL(classifier.classify(glyph).ch, (char)('0' + digit), std::to_string(digit) + " with noise");
+    }
+
+    //  Something that isn't a digit is rejected. (a dash)
+    {
+        PackedBinaryMatrix dash(15, 3);
+        dash.set_ones();
+        TEST_RESULT_COMPONENT_EQUAL((int)classifier.read(dash, MAX_DISTANCE, MIN_MARGIN), 0, "dash");
+    }
+
+    //  The templates survive a round trip through JSON.
+    const std::string json_path = "GlyphClassifier-Test.json";
+    classifier.save(json_path);
+    OCR::GlyphClassifier loaded(json_path);
+    remove(json_path.c_str());
+    TEST_RESULT_COMPONENT_EQUAL(loaded.templates(), classifier.templates(), "loaded templates");
+    for (size_t digit = 0; digit < 10; digit++){
+        PackedBinaryMatrix glyph = draw_digit(digit, 5, 6);
+        OCR::GlyphMatch x = classifier.classify(glyph);
+        OCR::GlyphMatch y = loaded.classify(glyph);
+        TEST_RESULT_COMPONENT_EQUAL(y.ch, x.ch, "loaded " + std::to_string(digit));
+        TEST_RESULT_COMPONENT_EQUAL(y.distance, x.distance, "loaded " + std::to_string(digit));
+    }
+
+    //  No templates means nothing is read.
+    TEST_RESULT_COMPONENT_EQUAL((int)OCR::GlyphClassifier().classify(draw_digit(0, 4, 4)).ch, 0, "empty");
+
+    return 0;
+}
+
 
 }
@@ -9,12 +9,33 @@
 #ifndef PokemonAutomation_Tests_CommonFramework_Tests_H
 #define PokemonAutomation_Tests_CommonFramework_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+//  Replays the lines of a text file (e.g. an old log) from several threads
+//  and reports the cost of each log() call.
+int test_CommonFramework_FileWindowLogger(const std::string& test_path);
+
+//  Self-contained. Any file in the test folder runs it. Writes .wav files of
+//  every supported layout at several sample rates and lengths with random
+//  frames and checks that they decode back to the same samples.
+int test_CommonFramework_WavFileDecoder(const std::string& test_path);
+
+//  Self-contained. Any file in the test folder runs it. Fills native video
+//  frames of each supported pixel format with random data and checks that
+//  boxes read from the lazy frame match the same boxes of the full frame.
+int test_CommonFramework_LazyVideoFrame(const std::string& test_path);
+
+//  Self-contained. Any file in the test folder runs it. Trains a glyph
+//  classifier on a small synthetic font and reads it back at other sizes,
+//  with noise and after a JSON round trip.
+int test_CommonFramework_GlyphClassifier(const std::string& test_path);
+
 }
 
 #endif
@@ -5,11 +5,19 @@
  */
 
 
+#include <cmath>
+#include <vector>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageHSV32.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageHSV/Kernels_ImageHSV_Routines.h"
+#include "Kernels/AudioStreamConversion/AudioStreamConversion.h"
+#include "CommonFramework/AudioPipeline/IO/AudioFileDecoder.h"
 #include "Kernels_Tests.h"
 
 #include <iostream>
@@ -40,4 +48,152 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
     return 0;
 }
 
+int test_kernels_ImageHSV32(const ImageViewRGB32& image){
+    //  Every pixel must match the scalar reference.
+    ImageHSV32 hsv(image);
+    for (size_t y = 0; y < image.height(); y++){
+        for (size_t x = 0; x < image.width(); x++){
+            uint32_t expected = rgb32_to_hsv32_Default(image.pixel(x, y));
+            if (hsv.pixel(x, y) != expected){
+                cerr << "Mismatch at (" << x << ", " << y << "): " << hsv.pixel(x, y) << " != " << expected << endl;
+                return 1;
+            }
+        }
+    }
+
+    int num_iterations = 1000;
+    auto time_start = current_time();
+    for(int i = 0; i < num_iterations; i++){
+        ImageHSV32 tmp(image);
+    }
+    auto time_end = current_time();
+    const auto ms = std::chrono::duration_cast<Milliseconds>(time_end - time_start).count();
+    cout << "Time: " << ms << " ms, " << ms / 1000. << " s" << endl;
+
+    return 0;
+}
+
+
+namespace{
+
+//  Scalar reference for "convert_audio_*_to_float()".
+template <typename Type>
+void reference_audio_to_float(
+    std::vector<float>& out, const std::vector<Type>& in,
+    float scale, float offset, bool clamp, bool swap_pairs
+){
+    out.resize(in.size());
+    size_t swap = swap_pairs ? 1 : 0;
+    for (size_t c = 0; c < in.size(); c++){
+        float x = (float)in[c] * scale - offset;
+        if (clamp){
+            x = std::max(x, -1.0f);
+            x = std::min(x, 1.0f);
+        }
+        out[c ^ swap] = x;
+    }
+}
+
+template <typename Type, typename Kernel>
+int check_audio_to_float(
+    const char* name, const std::vector<Type>& in,
+    float full_scale, bool offset, bool clamp,
+    Kernel kernel
+){
+    const float VOLUME = 0.8f;
+    const size_t ITERATIONS = 200;
+
+    AlignedVector<float> out(in.size());
+    std::vector<float> expected;
+    for (bool swap_pairs : {false, true}){
+        reference_audio_to_float(expected, in, VOLUME / full_scale, offset ? VOLUME : 0, clamp, swap_pairs);
+        kernel(out.data(), in.data(), in.size(), VOLUME, swap_pairs);
+        for (size_t c = 0; c < in.size(); c++){
+            //  Vector paths may fuse the multiply-subtract.
+            if (std::abs(out[c] - expected[c]) > 1e-6f){
+                cerr << name << (swap_pairs ? " (swapped)" : "") << ": Mismatch at " << c << ": "
+                     << out[c] << " != " << expected[c] << endl;
+                return 1;
+            }
+        }
+
+        auto time_start = current_time();
+        for (size_t i = 0; i < ITERATIONS; i++){
+            kernel(out.data(), in.data(), in.size(), VOLUME, swap_pairs);
+        }
+        auto time_end = current_time();
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+        cout << name << (swap_pairs ? " (swapped)" : "") << ": " << us / 1000. << " ms, "
+             << (double)(in.size() * ITERATIONS) / std::max<double>((double)us, 1) << " samples/us" << endl;
+    }
+    return 0;
+}
+
+}
+
+int test_kernels_AudioStreamConversion(const std::string& test_path){
+    using namespace Kernels::AudioStreamConversion;
+
+    //  Use the samples of the file as float. Then re-quantize them to every
+    //  input format.
+    std::vector<float> signal;
+    try{
+        std::unique_ptr<AudioFileDecoder> decoder = open_audio_file(test_path);
+        AlignedVector<char> buffer(4096 * decoder->frame_size());
+        AlignedVector<float> converted(4096 * decoder->channels());
+        while (size_t frames = decoder->read(buffer.data(), 4096)){
+            size_t samples = frames * decoder->channels();
+            switch (decoder->format()){
+            case AudioSampleFormat::UINT8:
+                convert_audio_uint8_to_float(converted.data(), (const uint8_t*)buffer.data(), samples, 1.0f, false);
+                break;
+            case AudioSampleFormat::SINT16:
+                convert_audio_sint16_to_float(converted.data(), (const int16_t*)buffer.data(), samples, 1.0f, false);
+                break;
+            case AudioSampleFormat::SINT32:
+                convert_audio_sint32_to_float(converted.data(), (const int32_t*)buffer.data(), samples, 1.0f, false);
+                break;
+            case AudioSampleFormat::FLOAT32:
+                convert_audio_float_to_float(converted.data(), (const float*)buffer.data(), samples, 1.0f, false);
+                break;
+            default:
+                return -1;
+            }
+            signal.insert(signal.end(), converted.data(), converted.data() + samples);
+        }
+    }catch (FileException&){
+        cout << "Skip " << test_path << " as it isn't a readable audio file." << endl;
+        return -1;
+    }
+
+    //  Swapping needs whole pairs.
+    signal.resize(signal.size() & ~(size_t)1);
+    if (signal.empty()){
+        cout << "Skip " << test_path << " as it has no samples." << endl;
+        return -1;
+    }
+
+    std::vector<uint8_t> u8(signal.size());
+    std::vector<int16_t> s16(signal.size());
+    std::vector<int32_t> s32(signal.size());
+    convert_audio_float_to_uint8(u8.data(), signal.data(), signal.size());
+    convert_audio_float_to_sint16(s16.data(), signal.data(), signal.size());
+    convert_audio_float_to_sint32(s32.data(), signal.data(), signal.size());
+
+    cout << signal.size() << " samples" << endl;
+    if (check_audio_to_float("uint8", u8, 127.f, true, true, convert_audio_uint8_to_float)){
+        return 1;
+    }
+    if (check_audio_to_float("sint16", s16, 32767.f, false, true, convert_audio_sint16_to_float)){
+        return 1;
+    }
+    if (check_audio_to_float("sint32", s32, 2147483647.f, false, true, convert_audio_sint32_to_float)){
+        return 1;
+    }
+    if (check_audio_to_float("float", signal, 1, false, false, convert_audio_float_to_float)){
+        return 1;
+    }
+    return 0;
+}
+
 }
@@ -9,12 +9,18 @@
 #ifndef PokemonAutomation_Tests_Kernels_Tests_H
 #define PokemonAutomation_Tests_Kernels_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_ImageHSV32(const ImageViewRGB32& image);
+
+int test_kernels_AudioStreamConversion(const std::string& test_path);
+
 }
 
 #endif
@@ -7,13 +7,30 @@
 
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
+#include "ClientSource/Connection/CommandCoalescing.h"
+#include "ClientSource/Connection/LoopbackDevice.h"
+#include "ClientSource/Connection/PABotBase.h"
+#ifndef _WIN32
+#include "ClientSource/Connection/SerialConnectionPOSIX.h"
+#endif
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "NintendoSwitch/Commands/NintendoSwitch_Messages_PushButtons.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_DetectHome.h"
 #include "NintendoSwitch_Tests.h"
 #include "TestUtils.h"
 
+#include <memory>
+#include <random>
+#include <thread>
+#include <ctime>
+#include <fstream>
+#include <sstream>
 #include <iostream>
+#ifndef _WIN32
+#include <stdlib.h>
+#endif
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -31,5 +48,269 @@ int test_NintendoSwitch_UpdateMenuDetector(const ImageViewRGB32& image, bool tar
 }
 
 
+int test_NintendoSwitch_CommandCoalescing(const std::string& test_path){
+    std::vector<std::unique_ptr<BotBaseRequest>> script;
+    {
+        std::ifstream file(test_path);
+        std::string line;
+        while (std::getline(file, line)){
+            std::istringstream ss(line);
+            std::string command;
+            uint16_t a = 0, b = 0;
+            if (!(ss >> command) || command[0] == '#'){
+                continue;
+            }
+            ss >> a >> b;
+            if (command == "press"){
+                script.emplace_back(new DeviceRequest_pbf_press_button(BUTTON_A, a, b));
+            }else if (command == "dpad"){
+                script.emplace_back(new DeviceRequest_pbf_press_dpad(DPAD_UP, a, b));
+            }else if (command == "wait"){
+                script.emplace_back(new DeviceRequest_pbf_wait(a));
+            }else if (command == "state"){
+                script.emplace_back(new DeviceRequest_controller_state(BUTTON_B, DPAD_NONE, 128, 128, 128, 128, (uint8_t)a));
+            }else{
+                cout << "Skip " << test_path << " as it isn't a command script." << endl;
+                return -1;
+            }
+        }
+    }
+    if (script.empty()){
+        cout << "Skip " << test_path << " as it has no commands." << endl;
+        return -1;
+    }
+
+    //  Fewest device commands possible: everything is held and merged.
+    uint64_t script_ticks = 0;
+    uint64_t ideal_commands = 1;
+    {
+        BotBaseMessage held = script[0]->message();
+        for (const auto& request : script){
+            script_ticks += LoopbackDevice::command_ticks(request->message());
+        }
+        for (size_t c = 1; c < script.size(); c++){
+            BotBaseMessage next = script[c]->message();
+            if (!try_coalesce_commands(held, next)){
+                held = std::move(next);
+                ideal_commands++;
+            }
+        }
+    }
+
+    //  The device runs a lot slower than the host issues commands. So
+    //  everything after the first few commands (which go straight into the
+    //  empty device queue) gets held and merged.
+    uint64_t received, finished, ticks_executed, ticks_starved, coalesced;
+    {
+        LoopbackDevice* device = new LoopbackDevice(std::chrono::microseconds(1000));
+        PABotBase botbase(global_logger_command_line(), std::unique_ptr<StreamConnection>(device));
+        botbase.connect();
+        for (const auto& request : script){
+            static_cast<BotBase&>(botbase).issue_request(*request, nullptr);
+        }
+        botbase.wait_for_all_requests();
+        received = device->commands_received();
+        finished = device->commands_finished();
+        ticks_executed = device->ticks_executed();
+        ticks_starved = device->ticks_starved();
+        coalesced = botbase.commands_coalesced();
+    }
+
+    cout << "Script: " << script.size() << " commands, " << script_ticks << " ticks" << endl;
+    cout << "Device: " << received << " commands (ideal " << ideal_commands << "), "
+         << ticks_executed << " ticks, " << ticks_starved << " starved" << endl;
+
+    TEST_RESULT_COMPONENT_EQUAL(received + coalesced, script.size(), "commands received + coalesced");
+    TEST_RESULT_COMPONENT_EQUAL(finished, received, "commands finished");
+    TEST_RESULT_COMPONENT_EQUAL(ticks_executed, script_ticks, "ticks executed");
+    TEST_RESULT_COMPONENT_EQUAL(received <= ideal_commands + PABB_DEVICE_QUEUE_SIZE, true, "commands received <= ideal + queue size");
+
+    return 0;
+}
+
+
+
+
+
+#ifdef _WIN32
+int test_NintendoSwitch_SerialReactor(const std::string& test_path){
+    cout << "Skip " << test_path << " as it needs pseudo-terminals." << endl;
+    return -1;
+}
+#else
+namespace{
+
+class SerialCollector : public StreamListener{
+public:
+    virtual void on_recv(const void* data, size_t bytes) override{
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_data.append((const char*)data, bytes);
+        }
+        m_cv.notify_all();
+    }
+    std::string wait_for(size_t bytes, std::chrono::milliseconds timeout){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait_for(lg, timeout, [&]{ return m_data.size() >= bytes; });
+        return m_data;
+    }
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::string m_data;
+};
+
+struct PseudoTerminal{
+    int master = -1;
+    std::unique_ptr<SerialConnection> connection;
+    SerialCollector received;
+
+    ~PseudoTerminal(){
+        if (connection){
+            connection->remove_listener(received);
+            connection->stop();
+        }
+        if (master != -1){
+            close(master);
+        }
+    }
+};
+
+//  Write all of "data" into "fd" in random sized pieces.
+void write_in_pieces(int fd, const std::string& data, size_t max_write, uint32_t seed){
+    std::minstd_rand rng(seed);
+    size_t sent = 0;
+    while (sent < data.size()){
+        size_t bytes = std::min<size_t>(rng() % max_write + 1, data.size() - sent);
+        ssize_t actual = write(fd, data.data() + sent, bytes);
+        if (actual <= 0){
+            return;
+        }
+        sent += actual;
+        if (rng() % 8 == 0){
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+//  Read exactly "bytes" from "fd" or until it times out.
+std::string read_exactly(int fd, size_t bytes, std::chrono::milliseconds timeout){
+    std::string ret;
+    WallClock deadline = current_time() + timeout;
+    char buffer[256];
+    while (ret.size() < bytes && current_time() < deadline){
+        ssize_t actual = read(fd, buffer, std::min(sizeof(buffer), bytes - ret.size()));
+        if (actual > 0){
+            ret.append(buffer, actual);
+        }else{
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return ret;
+}
+
+std::string random_bytes(size_t bytes, uint32_t seed){
+    std::minstd_rand rng(seed);
+    std::string ret(bytes, 0);
+    for (char& ch : ret){
+        ch = (char)(rng() & 0xff);
+    }
+    return ret;
+}
+
+}
+
+
+int test_NintendoSwitch_SerialReactor(const std::string& test_path){
+    size_t ports = 0, bytes = 0, max_write = 0;
+    {
+        std::ifstream file(test_path);
+        if (!(file >> ports >> bytes >> max_write) || ports < 2 || max_write == 0){
+            cout << "Skip " << test_path << " as it isn't a serial reactor test." << endl;
+            return -1;
+        }
+    }
+
+    std::vector<std::unique_ptr<PseudoTerminal>> terminals;
+    for (size_t c = 0; c < ports; c++){
+        std::unique_ptr<PseudoTerminal> terminal(new PseudoTerminal());
+        terminal->master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (terminal->master == -1 || grantpt(terminal->master) != 0 || unlockpt(terminal->master) != 0){
+            cout << "Skip " << test_path << " as pseudo-terminals are unavailable." << endl;
+            return -1;
+        }
+        terminal->connection.reset(new SerialConnection(ptsname(terminal->master), 115200));
+        terminal->connection->add_listener(terminal->received);
+        fcntl(terminal->master, F_SETFL, fcntl(terminal->master, F_GETFL) | O_NONBLOCK);
+        terminals.emplace_back(std::move(terminal));
+    }
+
+    //  Device -> program: all ports at once, in random pieces.
+    {
+        std::vector<std::string> expected;
+        std::vector<std::thread> writers;
+        for (size_t c = 0; c < ports; c++){
+            expected.emplace_back(random_bytes(bytes, (uint32_t)c + 1));
+        }
+        for (size_t c = 0; c < ports; c++){
+            writers.emplace_back(write_in_pieces, terminals[c]->master, std::cref(expected[c]), max_write, (uint32_t)c + 100);
+        }
+        for (std::thread& writer : writers){
+            writer.join();
+        }
+        for (size_t c = 0; c < ports; c++){
+            std::string actual = terminals[c]->received.wait_for(bytes, std::chrono::seconds(5));
+            TEST_RESULT_COMPONENT_EQUAL(actual.size(), bytes, "bytes received on port " + std::to_string(c));
+            TEST_RESULT_COMPONENT_EQUAL(actual == expected[c], true, "data received on port " + std::to_string(c));
+        }
+    }
+
+    //  Program -> device. Anything beyond the send buffer may be dropped if
+    //  it's sent faster than the device reads it.
+    const size_t send_bytes = std::min(bytes, SerialConnection::MAX_SEND_BUFFER);
+    for (size_t c = 0; c < ports; c++){
+        const std::string expected = random_bytes(send_bytes, (uint32_t)c + 200);
+        std::string actual;
+        std::thread reader([&]{
+            actual = read_exactly(terminals[c]->master, send_bytes, std::chrono::seconds(5));
+        });
+        StreamConnection& connection = *terminals[c]->connection;
+        for (size_t sent = 0; sent < send_bytes; sent += max_write){
+            connection.send(expected.data() + sent, std::min(max_write, send_bytes - sent));
+        }
+        reader.join();
+        TEST_RESULT_COMPONENT_EQUAL(actual.size(), send_bytes, "bytes sent on port " + std::to_string(c));
+        TEST_RESULT_COMPONENT_EQUAL(actual == expected, true, "data sent on port " + std::to_string(c));
+        TEST_RESULT_COMPONENT_EQUAL(terminals[c]->connection->bytes_dropped(), 0u, "bytes dropped on port " + std::to_string(c));
+    }
+
+    //  Unplug the first port. The reactor must stop listening to it instead
+    //  of spinning on the hangup.
+    close(terminals[0]->master);
+    terminals[0]->master = -1;
+    {
+        std::clock_t cpu0 = std::clock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        double cpu_seconds = (double)(std::clock() - cpu0) / CLOCKS_PER_SEC;
+        cout << "CPU time after unplug: " << cpu_seconds << " s" << endl;
+        TEST_RESULT_COMPONENT_EQUAL(cpu_seconds < 0.25, true, "reactor idle after unplug");
+    }
+
+    //  The other ports are unaffected.
+    for (size_t c = 1; c < ports; c++){
+        std::string before = terminals[c]->received.wait_for(0, std::chrono::milliseconds(0));
+        std::string expected = random_bytes(max_write, (uint32_t)c + 300);
+        write_in_pieces(terminals[c]->master, expected, max_write, (uint32_t)c + 400);
+        std::string actual = terminals[c]->received.wait_for(before.size() + max_write, std::chrono::seconds(5));
+        TEST_RESULT_COMPONENT_EQUAL(actual == before + expected, true, "data received after unplug on port " + std::to_string(c));
+    }
+
+    //  Stopping the unplugged port must not hang.
+    terminals.clear();
+
+    return 0;
+}
+#endif
 
 }
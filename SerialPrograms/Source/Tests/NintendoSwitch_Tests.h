@@ -9,12 +9,30 @@
 #ifndef PokemonAutomation_Tests_NintendoSwitch_Tests_H
 #define PokemonAutomation_Tests_NintendoSwitch_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_NintendoSwitch_UpdateMenuDetector(const ImageViewRGB32& image, bool target);
 
+//  Runs a script of controller commands through PABotBase into a
+//  LoopbackDevice. Each line of the script is one of:
+//      press <hold ticks> <release ticks>
+//      dpad <hold ticks> <release ticks>
+//      wait <ticks>
+//      state <ticks>
+//  Checks that coalescing doesn't change the controller time and that the
+//  device gets no more commands than expected.
+int test_NintendoSwitch_CommandCoalescing(const std::string& test_path);
+
+//  Connects to pseudo-terminals through the serial reactor. The test file is
+//  one line: <ports> <bytes per port> <max write size>
+//  Streams random data both ways in random sized writes, then unplugs one
+//  port and checks that the rest keep working. Skipped on Windows.
+int test_NintendoSwitch_SerialReactor(const std::string& test_path);
+
 }
 
 #endif
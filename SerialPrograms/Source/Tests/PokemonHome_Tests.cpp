@@ -0,0 +1,113 @@
+/*  Pokemon Home Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+
+#include <stdint.h>
+#include <algorithm>
+#include <map>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "PokemonHome/Programs/PokemonHome_BoxSortingPlanner.h"
+#include "PokemonHome_Tests.h"
+#include "TestUtils.h"
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace NintendoSwitch::PokemonHome;
+
+
+//  Run the plan on "have". Returns false if it picks up from an empty slot.
+bool apply_box_sort_plan(std::vector<size_t>& have, const std::vector<BoxSwap>& swaps){
+    for (const BoxSwap& swap : swaps){
+        if (have[swap.pick] == 0){
+            return false;
+        }
+        std::swap(have[swap.pick], have[swap.place]);
+    }
+    return true;
+}
+
+int test_pokemonHome_BoxSortingPlanner(const std::string& test_path){
+    std::vector<size_t> have;
+    try{
+        JsonValue json = load_json_file(test_path);
+        const JsonArray* slots = json.get_array();
+        if (slots == nullptr){
+            cout << "Skip " << test_path << " as it isn't a box layout." << endl;
+            return -1;
+        }
+
+        //  Slots with the same fields (other than the position) are the same
+        //  class. Empty slots only have the position.
+        std::map<std::string, size_t> ids;
+        for (const JsonValue& item : *slots){
+            const JsonObject* slot = item.get_object();
+            if (slot == nullptr){
+                cout << "Skip " << test_path << " as it isn't a box layout." << endl;
+                return -1;
+            }
+            JsonObject pokemon;
+            for (const auto& field : *slot){
+                const std::string& key = field.first;
+                if (key != "index" && key != "box" && key != "row" && key != "column"){
+                    pokemon[key] = field.second.clone();
+                }
+            }
+            if (pokemon.empty()){
+                have.emplace_back(0);
+            }else{
+                have.emplace_back(ids.emplace(pokemon.dump(), ids.size() + 1).first->second);
+            }
+        }
+    }catch (FileException&){
+        cout << "Skip " << test_path << " as it cannot be read as JSON." << endl;
+        return -1;
+    }
+
+    //  Any order works for the planner. Sort by class with empty slots last.
+    std::vector<size_t> want = have;
+    std::sort(
+        want.begin(), want.end(),
+        [](size_t x, size_t y){
+            return (x == 0 ? SIZE_MAX : x) < (y == 0 ? SIZE_MAX : y);
+        }
+    );
+
+    BoxSortingCosts costs(0);
+    std::vector<BoxSwap> greedy_plan = plan_sort_greedy(have, want);
+    std::vector<BoxSwap> cycle_plan = plan_sort_cycles(have, want, 0, costs);
+    uint64_t greedy_ticks = costs.plan(0, greedy_plan);
+    uint64_t cycle_ticks = costs.plan(0, cycle_plan);
+    cout << "Slots: " << have.size() << endl;
+    cout << "Greedy plan: " << greedy_plan.size() << " swaps, " << greedy_ticks << " ticks" << endl;
+    cout << "Cycle plan: " << cycle_plan.size() << " swaps, " << cycle_ticks << " ticks" << endl;
+
+    std::vector<size_t> result = have;
+    TEST_RESULT_COMPONENT_EQUAL(apply_box_sort_plan(result, greedy_plan), true, "greedy plan picks up a Pokemon");
+    TEST_RESULT_COMPONENT_EQUAL(result == want, true, "greedy plan sorts");
+
+    result = have;
+    TEST_RESULT_COMPONENT_EQUAL(apply_box_sort_plan(result, cycle_plan), true, "cycle plan picks up a Pokemon");
+    TEST_RESULT_COMPONENT_EQUAL(result == want, true, "cycle plan sorts");
+
+    //  Neither plan always wins on swaps or on ticks. The program runs
+    //  whichever one takes fewer ticks.
+    uint64_t sort_ticks = costs.plan(0, plan_sort(have, want, 0, costs));
+    TEST_RESULT_COMPONENT_EQUAL(sort_ticks, std::min(greedy_ticks, cycle_ticks), "sort plan ticks");
+
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,23 @@
+/*  Pokemon Home Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *  
+ *  
+ */
+
+
+#ifndef PokemonAutomation_Tests_PokemonHome_Tests_H
+#define PokemonAutomation_Tests_PokemonHome_Tests_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+//  "test_path" is a box layout as written to OUTPUT_FILE.json by the box
+//  sorter. Plans the sort and checks that the plan is valid and no worse than
+//  the old greedy one.
+int test_pokemonHome_BoxSortingPlanner(const std::string& test_path);
+
+}
+
+#endif
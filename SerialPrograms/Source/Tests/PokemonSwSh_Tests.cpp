@@ -16,6 +16,11 @@
 #include "PokemonSwSh/MaxLair/Inference/PokemonSwSh_MaxLair_Detect_BattleMenu.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_DialogBoxDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxShinySymbolDetector.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Tools.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathSearch.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 
 #include <QFileInfo>
 #include <QDir>
@@ -23,6 +28,8 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <fstream>
+#include <random>
 #include <map>
 using std::cout;
 using std::cerr;
@@ -125,4 +132,158 @@ int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target){
     return 0;
 }
 
+
+//  Strength of the team against the boss at the end of "path". Averaged over
+//  random catches. Our player takes what was caught if it's better than what
+//  it has. The NPCs keep what they have.
+static double simulate_max_lair_path(
+    std::mt19937& rng, size_t rollouts,
+    const MaxLairInternal::GlobalState& state, size_t player_index,
+    const std::vector<MaxLairInternal::PathNode>& path
+){
+    using namespace MaxLairInternal;
+    using namespace papkmnlib;
+
+    const std::vector<const papkmnlib::Pokemon*> bosses{&get_pokemon(state.boss)};
+    std::map<std::string, double> scores;
+    auto score = [&](const std::string& slug){
+        auto iter = scores.find(slug);
+        if (iter == scores.end()){
+            iter = scores.emplace(slug, rental_vs_boss_matchup(&get_pokemon(slug), bosses)).first;
+        }
+        return iter->second;
+    };
+
+    std::set<std::string> exclusions = state.seen;
+    for (const PlayerState& player : state.players){
+        exclusions.insert(player.pokemon);
+    }
+
+    double total = 0;
+    for (size_t r = 0; r < rollouts; r++){
+        double ours = score(state.players[player_index].pokemon);
+        std::set<std::string> caught = exclusions;
+        for (const PathNode& node : path){
+            std::vector<const std::string*> available;
+            for (const std::string& rental : rentals_by_type(node.type)){
+                if (caught.find(rental) == caught.end()){
+                    available.emplace_back(&rental);
+                }
+            }
+            if (available.empty()){
+                continue;
+            }
+            const std::string& rental = *available[rng() % available.size()];
+            caught.insert(rental);
+            ours = std::max(ours, score(rental));
+        }
+        for (size_t c = 0; c < 4; c++){
+            const PlayerState& player = state.players[c];
+            double value = c == player_index ? ours : score(player.pokemon);
+            total += player.console_id < 0 ? 0.5 * value : value;
+        }
+    }
+    return total / (double)rollouts;
+}
+
+int test_pokemonSwSh_MaxLair_PathSearch(const std::string& test_path){
+    using namespace MaxLairInternal;
+    using namespace papkmnlib;
+
+    //  The file has the number of random scenarios and the seed.
+    size_t scenarios = 0;
+    uint32_t seed = 0;
+    {
+        std::ifstream file(test_path);
+        if (!(file >> scenarios >> seed) || scenarios == 0){
+            cout << "Skip " << test_path << " as it isn't a simulation setup." << endl;
+            return -1;
+        }
+    }
+
+    std::vector<const std::string*> bosses;
+    for (const auto& item : all_boss_pokemon()){
+        bosses.emplace_back(&item.first);
+    }
+    std::vector<const std::string*> rentals;
+    for (const auto& item : all_rental_pokemon()){
+        rentals.emplace_back(&item.first);
+    }
+    std::vector<PokemonType> types;
+    for (const auto& item : TYPE_ENUM_TO_SLUG){
+        if (item.first != PokemonType::NONE && !rentals_by_type(item.first).empty()){
+            types.emplace_back(item.first);
+        }
+    }
+    if (bosses.empty() || rentals.empty() || types.empty()){
+        cout << "Skip " << test_path << " as the rental data isn't loaded." << endl;
+        return -1;
+    }
+
+    const size_t PLAYER_INDEX = 0;
+    const size_t ROLLOUTS = 200;
+
+    AsyncDispatcher dispatcher(nullptr, 4);
+    std::mt19937 rng(seed);
+    double search_total = 0;
+    double heuristic_total = 0;
+    size_t different = 0;
+    for (size_t s = 0; s < scenarios; s++){
+        GlobalState state;
+        state.boss = *bosses[rng() % bosses.size()];
+        state.lives_left = 4;
+        state.path.path_type = (int8_t)(rng() % 3);
+        for (PokemonType& type : state.path.mon1){
+            type = types[rng() % types.size()];
+        }
+        for (PokemonType& type : state.path.mon2){
+            type = types[rng() % types.size()];
+        }
+        for (PokemonType& type : state.path.mon3){
+            type = types[rng() % types.size()];
+        }
+        for (size_t c = 0; c < 4; c++){
+            state.players[c].console_id = c == PLAYER_INDEX ? 0 : -1;
+            state.players[c].pokemon = *rentals[rng() % rentals.size()];
+        }
+
+        std::vector<CompactPath> paths = generate_paths(state.path, state.wins, state.path_side);
+        std::vector<PathNode> heuristic = select_path(nullptr, state.boss, state.path, state.wins, state.path_side);
+        std::vector<PathSearchResult> results = search_paths(
+            dispatcher, state, paths, PLAYER_INDEX, std::chrono::seconds(10)
+        );
+        TEST_RESULT_COMPONENT_EQUAL(results.size(), paths.size(), "path search results");
+
+        const PathSearchResult* best = nullptr;
+        for (const PathSearchResult& result : results){
+            TEST_RESULT_COMPONENT_EQUAL(result.complete, true, "path search finished");
+            if (best == nullptr || result.score > best->score){
+                best = &result;
+            }
+        }
+        std::vector<PathNode> searched = best->path.to_vector();
+        if (searched.empty() || heuristic.empty() || searched[0].path_slot != heuristic[0].path_slot){
+            different++;
+        }
+
+        //  Same catches for both so only the path makes a difference.
+        uint32_t rollout_seed = rng();
+        std::mt19937 search_rng(rollout_seed);
+        std::mt19937 heuristic_rng(rollout_seed);
+        search_total += simulate_max_lair_path(search_rng, ROLLOUTS, state, PLAYER_INDEX, searched);
+        heuristic_total += simulate_max_lair_path(heuristic_rng, ROLLOUTS, state, PLAYER_INDEX, heuristic);
+    }
+
+    cout << "Scenarios: " << scenarios << " (" << different << " with a different first step)" << endl;
+    cout << "Search: " << search_total / scenarios << endl;
+    cout << "Heuristic: " << heuristic_total / scenarios << endl;
+
+    //  Leave some room for the noise of the rollouts.
+    if (search_total < heuristic_total * 0.99){
+        cerr << "Error: " << __func__ << ":" << __LINE__ << " path search is worse than the type heuristic." << endl;
+        return 1;
+    }
+    return 0;
+}
+
 }
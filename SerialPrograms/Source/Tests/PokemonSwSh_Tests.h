@@ -38,6 +38,11 @@ int test_pokemonSwSh_BoxShinySymbolDetector(const ImageViewRGB32& image, bool ta
 
 int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target);
 
+//  The test file has "<scenarios> <seed>". Runs that many random Max Lair
+//  path maps and checks that the path search does no worse than the type
+//  heuristic when the chosen paths are played out.
+int test_pokemonSwSh_MaxLair_PathSearch(const std::string& test_path);
+
 }
 
 #endif
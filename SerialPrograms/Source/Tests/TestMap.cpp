@@ -9,6 +9,7 @@
 #include "CommonFramework_Tests.h"
 #include "Kernels_Tests.h"
 #include "NintendoSwitch_Tests.h"
+#include "PokemonHome_Tests.h"
 #include "PokemonLA_Tests.h"
 #include "PokemonSwSh_Tests.h"
 #include "PokemonSV_Tests.h"
@@ -221,8 +222,17 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_ImageHSV32", std::bind(image_void_detector_helper, test_kernels_ImageHSV32, _1)},
+    {"Kernels_AudioStreamConversion", test_kernels_AudioStreamConversion},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_FileWindowLogger", test_CommonFramework_FileWindowLogger},
+    {"CommonFramework_WavFileDecoder", test_CommonFramework_WavFileDecoder},
+    {"CommonFramework_LazyVideoFrame", test_CommonFramework_LazyVideoFrame},
+    {"CommonFramework_GlyphClassifier", test_CommonFramework_GlyphClassifier},
+    {"NintendoSwitch_CommandCoalescing", test_NintendoSwitch_CommandCoalescing},
+    {"NintendoSwitch_SerialReactor", test_NintendoSwitch_SerialReactor},
     {"NintendoSwitch_UpdateMenuDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdateMenuDetector, _1)},
+    {"PokemonHome_BoxSortingPlanner", test_pokemonHome_BoxSortingPlanner},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
     {"PokemonSwSh_DialogTriangleDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_DialogTriangleDetector, _1)},
@@ -234,6 +244,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSwSh_BlackDialogBoxDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BlackDialogBoxDetector, _1)},
     {"PokemonSwSh_BoxShinySymbolDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BoxShinySymbolDetector, _1)},
     {"PokemonSwSh_BoxGenderDetector", std::bind(image_int_detector_helper, test_pokemonSwSh_BoxGenderDetector, _1)},
+    {"PokemonSwSh_MaxLair_PathSearch", test_pokemonSwSh_MaxLair_PathSearch},
     {"PokemonLA_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattleMenuDetector, _1)},
     {"PokemonLA_BattlePokemonSwitchDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattlePokemonSwitchDetector, _1)},
     {"PokemonLA_TransparentDialogueDetector", std::bind(image_bool_detector_helper, test_pokemonLA_TransparentDialogueDetector, _1)},